@@ -4,12 +4,13 @@ mkdir ~/smtk-build && cd ~/smtk-build
 cmake \
   -G Ninja \
   "-DSITE:STRING=travis-ci.org" \
-  "-DBUILDNAME:STRING=${TRAVIS_OS_NAME}-${CC}-Job.${TRAVIS_JOB_NUMBER}-SMTK" \
+  "-DBUILDNAME:STRING=${TRAVIS_OS_NAME}-${CC}-Job.${TRAVIS_JOB_NUMBER}-SMTK-dense${SMTK_DENSE_HASH_STORAGE:-OFF}" \
   -DCMAKE_BUILD_TYPE:STRING=RelWithDebInfo \
   -DBUILD_SHARED_LIBS:BOOL=ON \
   -DSMTK_ENABLE_QT_SUPPORT:BOOL=ON \
   -DSMTK_ENABLE_DOCUMENTATION:BOOL=ON \
   -DSMTK_ENABLE_TESTING:BOOL=ON \
+  -DSMTK_DENSE_HASH_STORAGE:BOOL=${SMTK_DENSE_HASH_STORAGE:-OFF} \
   -DSMTK_ENABLE_CGM_SESSIONA:BOOL=ON \
   -DCGM_CFG:FILEPATH=/usr/include/cgm.make \
   -DSMTK_ENABLE_PYTHON_WRAPPING:BOOL=ON \
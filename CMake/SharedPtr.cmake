@@ -13,6 +13,11 @@ function(determineSharedPtrType type incType)
   #we mark c++11
   set(HAS_OWNER_LESS 0 PARENT_SCOPE)
 
+  #atomic access to shared pointers (used to publish
+  #model manager snapshots) is provided by boost and
+  #by c++11 standard libraries that implement it
+  set(HAS_ATOMIC_SHARED_PTR 0 PARENT_SCOPE)
+
   if(NOT ${SHARED_PTR_TYPE_FOUND})
     try_compile(SHARED_PTR_TYPE_FOUND
       ${PROJECT_BINARY_DIR}/CMakeTmp
@@ -22,6 +27,13 @@ function(determineSharedPtrType type incType)
       set(RESULT "std")
       set(INCLUDE_RESULT "#include <memory>")
       set(HAS_OWNER_LESS 1 PARENT_SCOPE)
+      try_compile(SHARED_PTR_ATOMIC_FOUND
+        ${PROJECT_BINARY_DIR}/CMakeTmp
+        ${PROJECT_SOURCE_DIR}/CMake/shared_ptr_atomic.cxx
+        )
+      if(${SHARED_PTR_ATOMIC_FOUND})
+        set(HAS_ATOMIC_SHARED_PTR 1 PARENT_SCOPE)
+      endif()
     endif()
   endif()
 
@@ -44,6 +56,7 @@ function(determineSharedPtrType type incType)
 #include <boost/smart_ptr/owner_less.hpp>")
     set(${type}_BOOST_TRUE TRUE PARENT_SCOPE)
     set(HAS_OWNER_LESS 1 PARENT_SCOPE)
+    set(HAS_ATOMIC_SHARED_PTR 1 PARENT_SCOPE)
   endif()
 
 
@@ -0,0 +1,18 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include <memory>
+
+int main(int argc, char** argv)
+{
+  std::shared_ptr<float> f(new float(1.f));
+  std::shared_ptr<float> g = std::atomic_load(&f);
+  std::atomic_store(&f, g);
+  return 0;
+}
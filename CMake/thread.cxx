@@ -0,0 +1,27 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include <atomic>
+#include <thread>
+
+static thread_local int depth = 0;
+
+static void work(std::atomic<int>* counter)
+{
+  ++depth;
+  ++(*counter);
+}
+
+int main(int argc, char** argv)
+{
+  std::atomic<int> counter(0);
+  std::thread t(work, &counter);
+  t.join();
+  return std::thread::hardware_concurrency() > 0 ? 0 : counter.load();
+}
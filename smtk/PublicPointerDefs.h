@@ -83,6 +83,11 @@ namespace smtk
     {
       class Interface;
     }
+
+    namespace native
+    {
+      class Interface;
+    }
   }
 
 
@@ -99,6 +104,7 @@ namespace smtk
     class SessionRef;
     typedef std::vector<smtk::model::SessionRef> SessionRefs;
     class SessionIO;
+    class SessionIOBinary;
     class SessionIOJSON;
     class CellEntity;
     class Chain;
@@ -178,7 +184,9 @@ namespace smtk
 
   namespace io
   {
+    class ExportBinary;
     class ExportJSON;
+    class ImportBinary;
     class ImportJSON;
     class OperatorLog;
     class Logger;
@@ -208,6 +216,11 @@ namespace smtk
     {
       typedef smtk::shared_ptr< smtk::mesh::json::Interface >     InterfacePtr;
     }
+
+    namespace native
+    {
+      typedef smtk::shared_ptr< smtk::mesh::native::Interface >   InterfacePtr;
+    }
   }
 
   //Shiboken requires that we use fully qualified namespaces for all
@@ -219,6 +232,7 @@ namespace smtk
     typedef std::map<smtk::common::UUID, smtk::shared_ptr< smtk::model::Session > > UUIDsToSessions;
     typedef smtk::shared_ptr< smtk::model::DefaultSession >         DefaultSessionPtr;
     typedef smtk::shared_ptr< smtk::model::SessionIO >              SessionIOPtr;
+    typedef smtk::shared_ptr< smtk::model::SessionIOBinary >        SessionIOBinaryPtr;
     typedef smtk::shared_ptr< smtk::model::SessionIOJSON >          SessionIOJSONPtr;
     typedef smtk::shared_ptr< smtk::model::DescriptivePhrase >     DescriptivePhrasePtr;
     typedef smtk::weak_ptr< smtk::model::DescriptivePhrase >       WeakDescriptivePhrasePtr;
@@ -231,6 +245,7 @@ namespace smtk
     typedef smtk::shared_ptr< smtk::model::SimpleModelSubphrases > SimpleModelSubphrasesPtr;
     typedef smtk::shared_ptr< smtk::model::SubphraseGenerator >    SubphraseGeneratorPtr;
     typedef smtk::shared_ptr< smtk::model::Manager >               ManagerPtr;
+    typedef smtk::shared_ptr< const smtk::model::Manager >         ConstManagerPtr;
     typedef smtk::weak_ptr< smtk::model::Manager >                 WeakManagerPtr;
     typedef smtk::shared_ptr< smtk::model::Operator >              OperatorPtr;
     typedef smtk::weak_ptr< smtk::model::Operator >                WeakOperatorPtr;
@@ -21,11 +21,43 @@
 #include "smtk/common/UUIDGenerator.h"
 #include "smtk/common/View.h"
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <queue>
 
 using namespace smtk::attribute;
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Split a name of the form "prefix-index" as createUniqueName() generates them
+bool splitIndexedName(const std::string &name, std::string &prefix, int &index)
+{
+  std::string::size_type dash = name.rfind('-');
+  if (dash == std::string::npos || dash + 1 == name.size() ||
+      name.size() - dash - 1 > 10 || (name[dash + 1] == '0' && dash + 2 != name.size()))
+    {
+    return false;
+    }
+  long long value = 0;
+  for (std::string::size_type i = dash + 1; i < name.size(); ++i)
+    {
+    if (name[i] < '0' || name[i] > '9')
+      {
+      return false;
+      }
+    value = value * 10 + (name[i] - '0');
+    }
+  if (value >= std::numeric_limits<int>::max())
+    {
+    return false;
+    }
+  prefix = name.substr(0, dash);
+  index = static_cast<int>(value);
+  return true;
+}
+}
+
 //----------------------------------------------------------------------------
 System::System()
 {
@@ -123,6 +155,7 @@ smtk::attribute::AttributePtr System::createAttribute(const std::string &name,
   this->m_attributeClusters[def->type()].insert(a);
   this->m_attributes[name] = a;
   this->m_attributeIdMap[a->id()] = a;
+  this->attributeNameAdded(name);
   return a;
 }
 
@@ -184,6 +217,7 @@ System::createAttribute(const std::string &name,
   this->m_attributeClusters[def->type()].insert(a);
   this->m_attributes[name] = a;
   this->m_attributeIdMap[id] = a;
+  this->attributeNameAdded(name);
   return a;
 }
 //----------------------------------------------------------------------------
@@ -210,6 +244,7 @@ System::createAttribute(const std::string &name,
   this->m_attributeClusters[typeName].insert(a);
   this->m_attributes[name] = a;
   this->m_attributeIdMap[id] = a;
+  this->attributeNameAdded(name);
   return a;
 }
 //----------------------------------------------------------------------------
@@ -220,7 +255,10 @@ bool System::removeAttribute(smtk::attribute::AttributePtr att)
     {
     return false;
     }
-  this->m_attributes.erase(att->name());
+  if (this->m_attributes.erase(att->name()))
+    {
+    this->attributeNameRemoved(att->name());
+    }
   this->m_attributeIdMap.erase(att->id());
   this->m_attributeClusters[att->type()].erase(att);
   return true;
@@ -336,30 +374,116 @@ bool System::rename(smtk::attribute::AttributePtr att, const std::string &newNam
     {
     return false;
     }
-  this->m_attributes.erase(att->name());
+  if (this->m_attributes.erase(att->name()))
+    {
+    this->attributeNameRemoved(att->name());
+    }
   att->setName(newName);
   this->m_attributes[newName] = att;
+  this->attributeNameAdded(newName);
   return true;
 }
 //----------------------------------------------------------------------------
+// Return "type-i" for the smallest index i not used by an attribute name.
+// The free indices of each prefix are tracked as attributes are added,
+// removed and renamed, so no names need be probed.
 std::string System::createUniqueName(const std::string &type) const
 {
   int i = 0;
-  std::string base = type, newName;
-  base.append("-");
-  while (1)
-    {
-    std::ostringstream n;
-    n << i++;
-    newName = base + n.str();
-    // Make sure that the new name doesn't exists
-    smtk::attribute::AttributePtr a = this->findAttribute(newName);
-    if (!a)
+  std::map<std::string, std::map<int, int> >::const_iterator it =
+    this->m_freeNameIndices.find(type);
+  if (it != this->m_freeNameIndices.end())
+    {
+    if (it->second.empty())
       {
-      return newName;
+      return "";
       }
+    i = it->second.begin()->first;
+    }
+  std::ostringstream n;
+  n << type << "-" << i;
+  return n.str();
+}
+//----------------------------------------------------------------------------
+void System::attributeNameAdded(const std::string &name)
+{
+  std::string prefix;
+  int index;
+  if (!splitIndexedName(name, prefix, index))
+    {
+    return;
+    }
+  std::map<std::string, std::map<int, int> >::iterator pit =
+    this->m_freeNameIndices.find(prefix);
+  if (pit == this->m_freeNameIndices.end())
+    {
+    pit = this->m_freeNameIndices.insert(
+      std::make_pair(prefix, std::map<int, int>())).first;
+    pit->second[0] = std::numeric_limits<int>::max();
+    }
+  // Find the free interval holding index and split it around index
+  std::map<int, int>& freeIndices(pit->second);
+  std::map<int, int>::iterator it = freeIndices.upper_bound(index);
+  if (it == freeIndices.begin())
+    {
+    return;
+    }
+  --it;
+  int start = it->first;
+  int end = it->second;
+  if (index >= end)
+    {
+    return;
+    }
+  freeIndices.erase(it);
+  if (start < index)
+    {
+    freeIndices[start] = index;
+    }
+  if (index + 1 < end)
+    {
+    freeIndices[index + 1] = end;
+    }
+}
+//----------------------------------------------------------------------------
+void System::attributeNameRemoved(const std::string &name)
+{
+  std::string prefix;
+  int index;
+  if (!splitIndexedName(name, prefix, index))
+    {
+    return;
+    }
+  std::map<std::string, std::map<int, int> >::iterator pit =
+    this->m_freeNameIndices.find(prefix);
+  if (pit == this->m_freeNameIndices.end())
+    {
+    return;
+    }
+  // Free index, merging it with the free intervals on either side
+  std::map<int, int>& freeIndices(pit->second);
+  int end = index + 1;
+  std::map<int, int>::iterator it = freeIndices.find(end);
+  if (it != freeIndices.end())
+    {
+    end = it->second;
+    freeIndices.erase(it);
+    }
+  it = freeIndices.lower_bound(index);
+  if (it != freeIndices.begin() && (--it)->second == index)
+    {
+    it->second = end;
+    }
+  else
+    {
+    freeIndices[index] = end;
+    }
+  // Forget prefixes that no longer have any indexed names
+  if (freeIndices.size() == 1 && freeIndices.begin()->first == 0 &&
+      freeIndices.begin()->second == std::numeric_limits<int>::max())
+    {
+    this->m_freeNameIndices.erase(pit);
     }
-  return "";
 }
 //----------------------------------------------------------------------------
 void System::
@@ -155,11 +155,17 @@ namespace smtk
                                   std::vector<smtk::attribute::AttributePtr> &result) const;
       bool copyDefinitionImpl(const smtk::attribute::DefinitionPtr sourceDef,
                               smtk::attribute::ItemDefinition::CopyInfo& info);
+      // Keep track of the indices used by names of the form "prefix-index"
+      void attributeNameAdded(const std::string &name);
+      void attributeNameRemoved(const std::string &name);
 
       std::map<std::string, smtk::attribute::DefinitionPtr> m_definitions;
       std::map<std::string, std::set<smtk::attribute::AttributePtr> > m_attributeClusters;
       std::map<std::string, smtk::attribute::AttributePtr> m_attributes;
       std::map<smtk::common::UUID, smtk::attribute::AttributePtr> m_attributeIdMap;
+      // For each name prefix with indexed attribute names, the free indices
+      // as a map from the start of each free interval to its (exclusive) end
+      std::map<std::string, std::map<int, int> > m_freeNameIndices;
       std::map<smtk::attribute::DefinitionPtr,
         smtk::attribute::WeakDefinitionPtrSet > m_derivedDefInfo;
       std::set<std::string> m_categories;
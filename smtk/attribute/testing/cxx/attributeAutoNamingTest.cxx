@@ -12,6 +12,98 @@
 #include "smtk/attribute/Definition.h"
 #include "smtk/attribute/Attribute.h"
 #include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+// The name createUniqueName() should return, found by probing every index
+std::string probeUniqueName(const smtk::attribute::System& system,
+                            const std::string& type)
+{
+  for (int i = 0; ; ++i)
+    {
+    std::ostringstream n;
+    n << type << "-" << i;
+    if (!system.findAttribute(n.str()))
+      {
+      return n.str();
+      }
+    }
+}
+
+int checkUniqueName(const smtk::attribute::System& system,
+                    const std::string& type, const std::string& expected)
+{
+  std::string name = system.createUniqueName(type);
+  if (name != expected)
+    {
+    std::cout << "ERROR: Unique name for " << type << " is " << name
+              << " rather than " << expected << "\n";
+    return -1;
+    }
+  return 0;
+}
+
+// Names should always fill the lowest free index, even as attributes
+// with indexed names are removed and renamed
+int testNameReuse()
+{
+  int status = 0;
+  smtk::attribute::System system;
+  system.createDefinition("testDef");
+  for (int i = 0; i < 3; ++i)
+    {
+    system.createAttribute("testDef");
+    }
+  status |= checkUniqueName(system, "testDef", "testDef-3");
+  system.createAttribute("testDef-4", "testDef");
+  status |= checkUniqueName(system, "testDef", "testDef-3");
+  system.removeAttribute(system.findAttribute("testDef-1"));
+  status |= checkUniqueName(system, "testDef", "testDef-1");
+  system.rename(system.findAttribute("testDef-0"), "other");
+  status |= checkUniqueName(system, "testDef", "testDef-0");
+  system.rename(system.findAttribute("other"), "testDef-1");
+  status |= checkUniqueName(system, "testDef", "testDef-0");
+  system.createAttribute("testDef");
+  system.createAttribute("testDef");
+  status |= checkUniqueName(system, "testDef", "testDef-5");
+
+  // Only names createUniqueName() could generate use up an index
+  system.createAttribute("testDef-05", "testDef");
+  system.createAttribute("testDef-", "testDef");
+  system.createAttribute("testDef--6", "testDef");
+  system.createAttribute("testDef-99999999999", "testDef");
+  status |= checkUniqueName(system, "testDef", "testDef-5");
+  system.createAttribute("testDef-5-0", "testDef");
+  status |= checkUniqueName(system, "testDef-5", "testDef-5-1");
+  status |= checkUniqueName(system, "testDef", "testDef-5");
+  status |= checkUniqueName(system, "unused", "unused-0");
+
+  // Random additions, removals and renames agree with probing
+  std::srand(7);
+  for (int step = 0; step < 2000; ++step)
+    {
+    std::vector<smtk::attribute::AttributePtr> atts;
+    system.attributes(atts);
+    int op = std::rand() % 4;
+    if (op == 0 && !atts.empty())
+      {
+      system.removeAttribute(atts[std::rand() % atts.size()]);
+      }
+    else if (op == 1 && !atts.empty())
+      {
+      std::ostringstream n;
+      n << "testDef-" << std::rand() % 64;
+      system.rename(atts[std::rand() % atts.size()], n.str());
+      }
+    else
+      {
+      system.createAttribute("testDef");
+      }
+    status |= checkUniqueName(system, "testDef", probeUniqueName(system, "testDef"));
+    }
+  return status;
+}
 
 int main()
 {
@@ -64,5 +156,6 @@ int main()
       }
     std::cout << "System destroyed\n";
     }
+  status |= testNameReuse();
     return status;
 }
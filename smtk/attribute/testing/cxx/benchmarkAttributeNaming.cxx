@@ -0,0 +1,81 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/attribute/System.h"
+#include "smtk/attribute/Definition.h"
+#include "smtk/attribute/Attribute.h"
+
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <stdlib.h>
+
+using smtk::model::testing::Timer;
+
+int main(int argc, char* argv[])
+{
+  int numAtts = argc > 1 ? atoi(argv[1]) : 100000;
+
+  smtk::attribute::System system;
+  system.createDefinition("bc");
+  Timer t;
+
+  // Create attributes with automatically generated names
+  t.mark();
+  std::vector<smtk::attribute::AttributePtr> atts;
+  atts.reserve(numAtts);
+  for (int i = 0; i < numAtts; ++i)
+    {
+    atts.push_back(system.createAttribute("bc"));
+    }
+  double deltaT = t.elapsed();
+  std::cout
+    << numAtts << " attributes named " << deltaT << " seconds "
+    << (numAtts / deltaT) << " attributes/sec\n";
+
+  // Naming alone, which no longer depends on the number of attributes
+  t.mark();
+  std::size_t totalLength = 0;
+  for (int i = 0; i < numAtts; ++i)
+    {
+    totalLength += system.createUniqueName("bc").size();
+    }
+  deltaT = t.elapsed();
+  std::cout
+    << numAtts << " unique names generated " << deltaT << " seconds "
+    << (numAtts / deltaT) << " names/sec (" << totalLength << " characters)\n";
+
+  // Remove every other attribute, then refill the gaps
+  t.mark();
+  for (int i = 0; i < numAtts; i += 2)
+    {
+    system.removeAttribute(atts[i]);
+    }
+  for (int i = 0; i < numAtts; i += 2)
+    {
+    atts[i] = system.createAttribute("bc");
+    }
+  deltaT = t.elapsed();
+  std::cout
+    << (numAtts + 1) / 2 << " attributes removed and recreated in the gaps " << deltaT << " seconds "
+    << (numAtts / 2 / deltaT) << " attributes/sec\n";
+
+  std::ostringstream next;
+  next << "bc-" << numAtts;
+  if (atts[0]->name() != "bc-0" || system.createUniqueName("bc") != next.str())
+    {
+    std::cerr << "Unexpected names after refilling gaps.\n";
+    return 1;
+    }
+  return 0;
+}
@@ -60,7 +60,7 @@ void SetProperty::setPropertyValue(const std::string& pname, typename VI::Ptr it
 
     // Add or overwrite the property with the values.
     for (it = entities.begin(); it != entities.end(); ++it)
-      (*it->properties<VD>())[pname] = values;
+      it->properties<VD>()[pname] = values;
     }
 }
 
@@ -179,8 +179,8 @@ smtk::model::OperatorResult WriteOperator::writeLabelMap()
 
   smtk::model::Model dataset = datasets[0];
   std::string labelStr;
-  StringData const& stringProps(dataset.stringProperties());
-  StringData::const_iterator sit;
+  ConstStringProperties stringProps(dataset.stringProperties());
+  ConstStringProperties::iterator sit;
   if (
     (sit = stringProps.find("type")) == stringProps.end() ||
     sit->second.empty() ||
@@ -125,6 +125,7 @@ void RemusRPCWorker::processJob(
 
   remus::worker::Worker* swapWorker = NULL;
   cJSON* result = cJSON_CreateObject();
+  int streamModelSections = -1;
   std::string content = jd.details("request");
   if (content.empty())
     {
@@ -294,13 +295,20 @@ void RemusRPCWorker::processJob(
         }
       else if (methStr == "fetch-model")
         {
-        cJSON* model = cJSON_CreateObject();
         // Never include session list or tessellation data
         // Until someone makes us.
-        smtk::io::ExportJSON::fromModelManager(model, this->m_modelMgr,
-          static_cast<smtk::io::JSONFlags>(
-            smtk::io::JSON_ENTITIES | smtk::io::JSON_PROPERTIES));
-        cJSON_AddItemToObject(result, "result", model);
+        int sections = smtk::io::JSON_ENTITIES | smtk::io::JSON_PROPERTIES;
+        if (missingIdFatal)
+          { // The reply carries an error too, so build it as a tree.
+          cJSON* model = cJSON_CreateObject();
+          smtk::io::ExportJSON::fromModelManager(model, this->m_modelMgr,
+            static_cast<smtk::io::JSONFlags>(sections));
+          cJSON_AddItemToObject(result, "result", model);
+          }
+        else
+          { // The model is the whole reply; stream it once it is complete.
+          streamModelSections = sections;
+          }
         }
       else if (methStr == "operator-able")
         {
@@ -334,9 +342,18 @@ void RemusRPCWorker::processJob(
           }
         else
           {
+          // Clients that can read compact mesh handles ask for them; older
+          // clients don't and get the dictionary form.
+          int sections = smtk::io::JSON_DEFAULT;
+          cJSON* compact = cJSON_GetObjectItem(param, "compact-handles");
+          if (compact && compact->type == cJSON_True)
+            {
+            sections |= smtk::io::JSON_COMPACT_HANDLES;
+            }
           smtk::model::OperatorResult ores = localOp->operate();
           cJSON* oresult = cJSON_CreateObject();
-          smtk::io::ExportJSON::forOperatorResult(ores, oresult);
+          smtk::io::ExportJSON::forOperatorResult(ores, oresult,
+            static_cast<smtk::io::JSONFlags>(sections));
           cJSON_AddItemToObject(result, "result", oresult);
           }
         }
@@ -394,14 +411,30 @@ void RemusRPCWorker::processJob(
   status.updateProgress(progress);
   w->updateStatus(status);
 
-  char* response = cJSON_Print(result);
+  std::string response;
+  if (streamModelSections >= 0)
+    {
+    // Print the model straight into the reply, as cJSON would have
+    // printed {"result": model}, without building a tree for it.
+    std::ostringstream reply;
+    reply << "{\n\t\"result\":\t";
+    smtk::io::ExportJSON::fromModelManagerToStream(reply, this->m_modelMgr,
+      static_cast<smtk::io::JSONFlags>(streamModelSections), 1);
+    reply << "\n}";
+    response = reply.str();
+    }
+  else
+    {
+    char* printed = cJSON_Print(result);
+    response = printed;
+    free(printed);
+    }
   cJSON_Delete(result);
   remus::proto::JobResult jobResult =
     remus::proto::make_JobResult(
       jd.id(), response, remus::common::ContentFormat::JSON);
   smtkDebugMacro(this->manager()->log(), "Response is \"" << response << "\"");
   w->returnResult(jobResult);
-  free(response);
   if (swapWorker)
     {
     //delete w;
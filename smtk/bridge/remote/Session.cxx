@@ -129,6 +129,9 @@ smtk::model::OperatorResult Session::operateDelegate(
   smtk::io::ExportJSON::forOperator(op->specification(), par);
   // Add the session's session ID so it can be properly instantiated on the server.
   cJSON_AddItemToObject(par, "sessionId", cJSON_CreateString(this->sessionId().toString().c_str()));
+  // We read either form of mesh handles in the result's mesh records, so
+  // ask for the compact one. Workers that don't know it ignore the request.
+  cJSON_AddItemToObject(par, "compact-handles", cJSON_CreateTrue());
 
   cJSON* resp = this->m_remusConn->jsonRPCRequest(req, this->m_remusWorkerReqs);
   //cJSON* resp = NULL; // this->m_proxy->jsonRPCRequest(req, this->m_remusWorkerReqs); // This deletes req and par.
@@ -0,0 +1,173 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#include "smtk/common/Parallel.h"
+
+#include "smtk/Options.h"
+#include "smtk/common/Environment.h"
+
+#include <stdlib.h>
+
+#ifdef SMTK_HAVE_STD_THREAD
+#  include <atomic>
+#  include <exception>
+#  include <mutex>
+#  include <thread>
+#  include <vector>
+#endif
+
+namespace smtk {
+  namespace common {
+
+namespace {
+
+#ifdef SMTK_HAVE_STD_THREAD
+// 0 means "not chosen yet"; see Parallel::numberOfThreads(). Pieces may
+// read it from other threads, e.g. to choose how to split nested work.
+std::atomic<std::size_t> s_numberOfThreads(0);
+
+// Set while the thread runs pieces of a forEach(), so nested calls run serially.
+thread_local bool t_inForEach = false;
+
+struct InForEach
+{
+  InForEach() { t_inForEach = true; }
+  ~InForEach() { t_inForEach = false; }
+};
+
+struct Worker
+{
+  Worker(std::size_t numberOfPieces, ParallelTask& task):
+    m_numberOfPieces(numberOfPieces),
+    m_task(task),
+    m_next(0)
+    {
+    }
+
+  void operator()()
+    {
+    InForEach guard;
+    for(std::size_t piece = m_next++; piece < m_numberOfPieces; piece = m_next++)
+      {
+      try
+        {
+        m_task.execute(piece);
+        }
+      catch(...)
+        {
+        std::lock_guard<std::mutex> lock(m_errorLock);
+        if(!m_error)
+          {
+          m_error = std::current_exception();
+          }
+        }
+      }
+    }
+
+  std::size_t m_numberOfPieces;
+  ParallelTask& m_task;
+  std::atomic<std::size_t> m_next;
+  std::mutex m_errorLock;
+  std::exception_ptr m_error;
+};
+#else
+std::size_t s_numberOfThreads = 0;
+#endif
+
+}
+
+ParallelTask::~ParallelTask()
+{
+}
+
+/**\brief Return the number of threads forEach() will use, including the caller.
+  *
+  * This is 1 inside the pieces of a forEach(), where nested calls run serially.
+  */
+std::size_t Parallel::numberOfThreads()
+{
+#ifdef SMTK_HAVE_STD_THREAD
+  if (t_inForEach)
+    {
+    return 1;
+    }
+#endif
+  std::size_t num = s_numberOfThreads;
+  if (num == 0)
+    {
+    if (Environment::hasVariable("SMTK_NUM_THREADS"))
+      {
+      num = static_cast<std::size_t>(
+        atoi(Environment::getVariable("SMTK_NUM_THREADS").c_str()));
+      }
+#ifdef SMTK_HAVE_STD_THREAD
+    if (num == 0)
+      {
+      num = std::thread::hardware_concurrency();
+      }
+#endif
+    num = num > 0 ? num : 1;
+    s_numberOfThreads = num;
+    }
+  return num;
+}
+
+/**\brief Set the number of threads forEach() will use.
+  *
+  * Passing 0 restores the default. Calls to forEach() that have already
+  * started keep the number of threads they started with.
+  */
+void Parallel::setNumberOfThreads(std::size_t numThreads)
+{
+  s_numberOfThreads = numThreads;
+}
+
+/// Call task.execute(i) for every i in [0, numberOfPieces).
+void Parallel::forEach(std::size_t numberOfPieces, ParallelTask& task)
+{
+  std::size_t numThreads = Parallel::numberOfThreads();
+  if (numThreads > numberOfPieces)
+    {
+    numThreads = numberOfPieces;
+    }
+
+#ifdef SMTK_HAVE_STD_THREAD
+  // This is 1 inside another forEach(), so nested calls run serially.
+  if (numThreads > 1)
+    {
+    Worker worker(numberOfPieces, task);
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (std::size_t i = 1; i < numThreads; ++i)
+      {
+      threads.push_back(std::thread(std::ref(worker)));
+      }
+    worker();
+    for (std::size_t i = 0; i < threads.size(); ++i)
+      {
+      threads[i].join();
+      }
+    if (worker.m_error)
+      {
+      std::rethrow_exception(worker.m_error);
+      }
+    return;
+    }
+#endif
+
+  for (std::size_t piece = 0; piece < numberOfPieces; ++piece)
+    {
+    task.execute(piece);
+    }
+}
+
+  } // namespace common
+} // namespace smtk
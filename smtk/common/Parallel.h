@@ -0,0 +1,148 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#ifndef __smtk_common_Parallel_h
+#define __smtk_common_Parallel_h
+
+#include "smtk/CoreExports.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace smtk {
+  namespace common {
+
+/**\brief A unit of work that can be split into independent pieces.
+  *
+  * Subclasses implement execute(), which is called exactly once for
+  * each piece in [0, numberOfPieces). Pieces may run concurrently, so
+  * execute() must only write to state owned by its piece.
+  */
+class SMTKCORE_EXPORT ParallelTask
+{
+public:
+  virtual ~ParallelTask();
+
+  virtual void execute(std::size_t piece) = 0;
+};
+
+/**\brief Run the pieces of a task on threads started for each call.
+  *
+  * Each call to forEach() starts its threads, shares the pieces among
+  * them and the calling thread, and joins them before returning, so it
+  * only pays off when the pieces together take much longer than starting
+  * a thread. If a piece throws, the first exception is rethrown on the
+  * calling thread after the rest of the pieces finish.
+  *
+  * A forEach() (or sort()) called from inside a piece runs its own
+  * pieces serially on that thread rather than starting more threads.
+  *
+  * The number of threads defaults to the SMTK_NUM_THREADS environment
+  * variable, or the hardware concurrency when it is unset. When SMTK is
+  * built without std::thread support, pieces run serially in order.
+  */
+class SMTKCORE_EXPORT Parallel
+{
+public:
+  static std::size_t numberOfThreads();
+  static void setNumberOfThreads(std::size_t numThreads);
+
+  static void forEach(std::size_t numberOfPieces, ParallelTask& task);
+
+  /// Sort values by sorting a piece per thread, then merging the sorted
+  /// pieces two at a time.
+  template<typename T>
+  static void sort(std::vector<T>& values);
+};
+
+namespace detail
+{
+//pieces smaller than this cost more to schedule than to sort
+const std::size_t MinimumSortPieceSize = 4096;
+
+template<typename T>
+class SortPieces : public ParallelTask
+{
+public:
+  SortPieces(std::vector<T>& values, const std::vector<std::size_t>& bounds):
+    m_values(values), m_bounds(bounds) {}
+
+  void execute(std::size_t piece)
+  {
+  std::sort(this->m_values.begin() + this->m_bounds[piece],
+            this->m_values.begin() + this->m_bounds[piece + 1]);
+  }
+
+private:
+  std::vector<T>& m_values;
+  const std::vector<std::size_t>& m_bounds;
+};
+
+template<typename T>
+class MergePieces : public ParallelTask
+{
+public:
+  MergePieces(std::vector<T>& values, const std::vector<std::size_t>& bounds):
+    m_values(values), m_bounds(bounds) {}
+
+  void execute(std::size_t piece)
+  {
+  std::inplace_merge(this->m_values.begin() + this->m_bounds[2 * piece],
+                     this->m_values.begin() + this->m_bounds[2 * piece + 1],
+                     this->m_values.begin() + this->m_bounds[2 * piece + 2]);
+  }
+
+private:
+  std::vector<T>& m_values;
+  const std::vector<std::size_t>& m_bounds;
+};
+}
+
+template<typename T>
+void Parallel::sort(std::vector<T>& values)
+{
+  std::size_t numPieces = std::min(Parallel::numberOfThreads(),
+                                   values.size() / detail::MinimumSortPieceSize);
+  if(numPieces <= 1)
+    {
+    std::sort(values.begin(), values.end());
+    return;
+    }
+
+  std::vector<std::size_t> bounds(numPieces + 1);
+  for(std::size_t i=0; i <= numPieces; ++i)
+    {
+    bounds[i] = (values.size() * i) / numPieces;
+    }
+  detail::SortPieces<T> sorter(values, bounds);
+  Parallel::forEach(numPieces, sorter);
+
+  while(bounds.size() > 2)
+    {
+    const std::size_t numRuns = bounds.size() - 1;
+    detail::MergePieces<T> merger(values, bounds);
+    Parallel::forEach(numRuns / 2, merger);
+
+    std::vector<std::size_t> merged;
+    for(std::size_t i=0; i < numRuns; i += 2)
+      {
+      merged.push_back(bounds[i]);
+      }
+    merged.push_back(bounds[numRuns]);
+    bounds.swap(merged);
+    }
+}
+
+  } // namespace common
+} // namespace smtk
+
+#endif // __smtk_common_Parallel_h
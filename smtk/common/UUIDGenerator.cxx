@@ -18,6 +18,7 @@
 #  pragma GCC diagnostic pop
 #endif
 
+#include <algorithm> // for std::copy()
 #include <ctime> // for time()
 #include <stdlib.h> // for getenv()/_dupenv_s()
 
@@ -87,6 +88,25 @@ UUID UUIDGenerator::random()
   return UUID((*this->P->m_randomGenerator)());
 }
 
+/**\brief Append \a count random UUIDs to \a result.
+  *
+  * This is faster than repeated calls to random() when many
+  * UUIDs are required at once (e.g., when a session transcribes
+  * a large model) since storage is allocated once and UUIDs are
+  * written in place rather than copied.
+  */
+void UUIDGenerator::random(std::size_t count, UUIDArray& result)
+{
+  std::size_t start = result.size();
+  result.resize(start + count);
+  boost::uuids::basic_random_generator<boost::mt19937>& gen(*this->P->m_randomGenerator);
+  for (UUIDArray::iterator it = result.begin() + start; it != result.end(); ++it)
+    {
+    boost::uuids::uuid data = gen();
+    std::copy(data.begin(), data.end(), it->begin());
+    }
+}
+
 /// Generate a nil UUID.
 UUID UUIDGenerator::null()
 {
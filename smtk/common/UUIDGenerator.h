@@ -22,6 +22,7 @@ public:
   virtual ~UUIDGenerator();
 
   UUID random();
+  void random(std::size_t count, UUIDArray& result);
   UUID null();
 
 protected:
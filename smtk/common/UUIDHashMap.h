@@ -0,0 +1,344 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_common_UUIDHashMap_h
+#define __smtk_common_UUIDHashMap_h
+
+#include "smtk/common/UUID.h"
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace smtk {
+  namespace common {
+
+/**\brief A dense, open-addressing hash table keyed on UUIDs.
+  *
+  * Values are held contiguously in a single array and each entry
+  * is given a 32-bit slot index that remains valid until the entry
+  * is erased. Lookups probe a separate, compact table of
+  * (hash tag, slot index) pairs using linear probing so that a
+  * miss rarely touches the value array at all.
+  *
+  * The interface mirrors the subset of std::map and
+  * google::sparse_hash_map used by smtk::model::Manager so it
+  * may be substituted for either as primary storage.
+  * Unlike std::map, iteration order is insertion order (with
+  * erased slots reused by later insertions).
+  * Iterators hold slot indices and thus remain valid across
+  * insertions; however, pointers and references to values are
+  * invalidated whenever an insertion grows the value array.
+  */
+template<typename T>
+class UUIDHashMap
+{
+public:
+  typedef UUID key_type;
+  typedef T mapped_type;
+  typedef std::pair<UUID,T> value_type;
+  typedef std::size_t size_type;
+  typedef boost::uint32_t index_type;
+
+  /// The slot index returned for keys that are not present.
+  static const index_type InvalidIndex = 0xffffffffu;
+
+  template<typename M, typename V>
+  class Iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef V value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V* pointer;
+    typedef V& reference;
+
+    Iterator() : m_map(NULL), m_slot(0) { }
+    Iterator(M* mm, index_type slot) : m_map(mm), m_slot(slot) { }
+    template<typename M2, typename V2>
+    Iterator(const Iterator<M2,V2>& other) : m_map(other.m_map), m_slot(other.m_slot) { }
+
+    reference operator * () const { return this->m_map->m_values[this->m_slot]; }
+    pointer operator -> () const { return &this->m_map->m_values[this->m_slot]; }
+
+    Iterator& operator ++ ()
+      {
+      this->m_slot = this->m_map->nextLiveSlot(this->m_slot + 1);
+      return *this;
+      }
+    Iterator operator ++ (int)
+      {
+      Iterator tmp(*this);
+      ++(*this);
+      return tmp;
+      }
+
+    template<typename M2, typename V2>
+    bool operator == (const Iterator<M2,V2>& other) const
+      { return this->m_slot == other.m_slot && this->m_map == other.m_map; }
+    template<typename M2, typename V2>
+    bool operator != (const Iterator<M2,V2>& other) const
+      { return !(*this == other); }
+
+    /// Return the slot index of the entry this iterator references.
+    index_type index() const { return this->m_slot; }
+
+  protected:
+    template<typename M2, typename V2> friend class Iterator;
+    friend class UUIDHashMap<T>;
+
+    M* m_map;
+    index_type m_slot;
+  };
+
+  typedef Iterator<UUIDHashMap<T>, value_type> iterator;
+  typedef Iterator<const UUIDHashMap<T>, const value_type> const_iterator;
+
+  UUIDHashMap() : m_count(0), m_deleted(0) { }
+
+  iterator begin() { return iterator(this, this->nextLiveSlot(0)); }
+  const_iterator begin() const { return const_iterator(this, this->nextLiveSlot(0)); }
+  iterator end() { return iterator(this, this->endSlot()); }
+  const_iterator end() const { return const_iterator(this, this->endSlot()); }
+
+  size_type size() const { return this->m_count; }
+  bool empty() const { return this->m_count == 0; }
+
+  iterator find(const UUID& key)
+    {
+    index_type slot = this->indexOf(key);
+    return iterator(this, slot == InvalidIndex ? this->endSlot() : slot);
+    }
+  const_iterator find(const UUID& key) const
+    {
+    index_type slot = this->indexOf(key);
+    return const_iterator(this, slot == InvalidIndex ? this->endSlot() : slot);
+    }
+  size_type count(const UUID& key) const
+    { return this->indexOf(key) == InvalidIndex ? 0 : 1; }
+
+  /**\brief Return the stable slot index of \a key or InvalidIndex if absent.
+    *
+    * The index may be passed to atIndex() to retrieve the entry without
+    * hashing or comparing UUIDs. It remains valid until the entry is erased.
+    */
+  index_type indexOf(const UUID& key) const
+    {
+    if (this->m_buckets.empty())
+      return InvalidIndex;
+    index_type tag = UUIDHashMap<T>::hashTag(key);
+    std::size_t mask = this->m_buckets.size() - 1;
+    for (std::size_t pos = tag & mask; ; pos = (pos + 1) & mask)
+      {
+      const Bucket& bucket(this->m_buckets[pos]);
+      if (bucket.slot == EmptySlot)
+        return InvalidIndex;
+      if (
+        bucket.slot != DeletedSlot &&
+        bucket.tag == tag &&
+        this->m_values[bucket.slot].first == key)
+        return bucket.slot;
+      }
+    }
+
+  /// Return an iterator to the entry at slot \a idx (or end() if the slot is unused).
+  iterator atIndex(index_type idx)
+    { return iterator(this, this->isLive(idx) ? idx : this->endSlot()); }
+  const_iterator atIndex(index_type idx) const
+    { return const_iterator(this, this->isLive(idx) ? idx : this->endSlot()); }
+
+  /// Insert \a entry unless its key is already present. Mirrors std::map::insert.
+  template<typename P>
+  std::pair<iterator,bool> insert(const P& entry)
+    {
+    index_type slot = this->indexOf(entry.first);
+    if (slot != InvalidIndex)
+      return std::make_pair(iterator(this, slot), false);
+    slot = this->insertNew(entry.first, entry.second);
+    return std::make_pair(iterator(this, slot), true);
+    }
+
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last)
+    {
+    for (; first != last; ++first)
+      this->insert(*first);
+    }
+
+  T& operator [] (const UUID& key)
+    {
+    index_type slot = this->indexOf(key);
+    if (slot == InvalidIndex)
+      slot = this->insertNew(key, T());
+    return this->m_values[slot].second;
+    }
+
+  void erase(iterator it)
+    {
+    if (it.m_map == this && this->isLive(it.m_slot))
+      this->eraseSlot(this->m_values[it.m_slot].first, it.m_slot);
+    }
+
+  size_type erase(const UUID& key)
+    {
+    index_type slot = this->indexOf(key);
+    if (slot == InvalidIndex)
+      return 0;
+    this->eraseSlot(key, slot);
+    return 1;
+    }
+
+  void clear()
+    {
+    this->m_values.clear();
+    this->m_live.clear();
+    this->m_free.clear();
+    this->m_buckets.clear();
+    this->m_count = 0;
+    this->m_deleted = 0;
+    }
+
+  /// Preallocate storage so that \a n entries may be inserted without rehashing.
+  void reserve(size_type n)
+    {
+    this->m_values.reserve(n);
+    this->m_live.reserve(n);
+    if (4 * n > 3 * this->m_buckets.size())
+      this->rehash(n);
+    }
+
+  void swap(UUIDHashMap<T>& other)
+    {
+    this->m_values.swap(other.m_values);
+    this->m_live.swap(other.m_live);
+    this->m_free.swap(other.m_free);
+    this->m_buckets.swap(other.m_buckets);
+    std::swap(this->m_count, other.m_count);
+    std::swap(this->m_deleted, other.m_deleted);
+    }
+
+protected:
+  struct Bucket
+  {
+    index_type tag;
+    index_type slot;
+  };
+
+  static const index_type EmptySlot = 0xffffffffu;
+  static const index_type DeletedSlot = 0xfffffffeu;
+
+  /// Fold UUID::hash() into 32 bits used both to place and to pre-filter entries.
+  static index_type hashTag(const UUID& key)
+    {
+    boost::uint64_t hh = static_cast<boost::uint64_t>(key.hash());
+    return static_cast<index_type>(hh ^ (hh >> 32));
+    }
+
+  index_type endSlot() const { return static_cast<index_type>(this->m_values.size()); }
+  bool isLive(index_type slot) const { return slot < this->m_live.size() && this->m_live[slot]; }
+
+  index_type nextLiveSlot(index_type slot) const
+    {
+    index_type last = this->endSlot();
+    while (slot < last && !this->m_live[slot])
+      ++slot;
+    return slot;
+    }
+
+  index_type insertNew(const UUID& key, const T& value)
+    {
+    if (4 * (this->m_count + this->m_deleted + 1) > 3 * this->m_buckets.size())
+      this->rehash(this->m_count + 1);
+
+    index_type slot;
+    if (this->m_free.empty())
+      {
+      slot = this->endSlot();
+      this->m_values.push_back(value_type(key, value));
+      this->m_live.push_back(1);
+      }
+    else
+      {
+      slot = this->m_free.back();
+      this->m_free.pop_back();
+      this->m_values[slot].first = key;
+      this->m_values[slot].second = value;
+      this->m_live[slot] = 1;
+      }
+
+    index_type tag = UUIDHashMap<T>::hashTag(key);
+    std::size_t mask = this->m_buckets.size() - 1;
+    std::size_t pos = tag & mask;
+    while (this->m_buckets[pos].slot != EmptySlot && this->m_buckets[pos].slot != DeletedSlot)
+      pos = (pos + 1) & mask;
+    if (this->m_buckets[pos].slot == DeletedSlot)
+      --this->m_deleted;
+    this->m_buckets[pos].tag = tag;
+    this->m_buckets[pos].slot = slot;
+    ++this->m_count;
+    return slot;
+    }
+
+  void eraseSlot(const UUID& key, index_type slot)
+    {
+    index_type tag = UUIDHashMap<T>::hashTag(key);
+    std::size_t mask = this->m_buckets.size() - 1;
+    std::size_t pos = tag & mask;
+    while (this->m_buckets[pos].slot != slot)
+      pos = (pos + 1) & mask;
+    this->m_buckets[pos].slot = DeletedSlot;
+    ++this->m_deleted;
+    --this->m_count;
+
+    // Release any storage held by the value but keep the slot for reuse.
+    this->m_values[slot] = value_type();
+    this->m_live[slot] = 0;
+    this->m_free.push_back(slot);
+    }
+
+  /// Resize the bucket table to hold at least \a minEntries at a load factor of 1/2 or less.
+  void rehash(size_type minEntries)
+    {
+    std::size_t nb = 16;
+    while (nb < 2 * minEntries)
+      nb *= 2;
+    Bucket empty;
+    empty.tag = 0;
+    empty.slot = EmptySlot;
+    std::vector<Bucket> buckets(nb, empty);
+    std::size_t mask = nb - 1;
+    typename std::vector<Bucket>::const_iterator bit;
+    for (bit = this->m_buckets.begin(); bit != this->m_buckets.end(); ++bit)
+      {
+      if (bit->slot == EmptySlot || bit->slot == DeletedSlot)
+        continue;
+      std::size_t pos = bit->tag & mask;
+      while (buckets[pos].slot != EmptySlot)
+        pos = (pos + 1) & mask;
+      buckets[pos] = *bit;
+      }
+    this->m_buckets.swap(buckets);
+    this->m_deleted = 0;
+    }
+
+  std::vector<value_type> m_values;
+  std::vector<unsigned char> m_live;
+  std::vector<index_type> m_free;
+  std::vector<Bucket> m_buckets;
+  size_type m_count;
+  size_type m_deleted;
+};
+
+  } // namespace common
+} // namespace smtk
+
+#endif // __smtk_common_UUIDHashMap_h
@@ -0,0 +1,92 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/common/UUIDHashMap.h"
+#include "smtk/common/UUIDGenerator.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <map>
+#include <string>
+
+using smtk::common::UUID;
+using smtk::common::UUIDGenerator;
+using smtk::common::UUIDHashMap;
+
+typedef UUIDHashMap<std::string> Storage;
+
+int main(int argc, char* argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  UUIDGenerator gen;
+  Storage storage;
+  std::map<UUID,std::string> reference;
+
+  test(storage.empty() && storage.begin() == storage.end(), "New map should be empty");
+  test(storage.find(gen.random()) == storage.end(), "Empty map should not find anything");
+
+  // Insert enough entries to force several rehashes.
+  const int numEntries = 5000;
+  std::vector<UUID> keys;
+  for (int i = 0; i < numEntries; ++i)
+    {
+    UUID uid = gen.random();
+    std::string val(1 + i % 7, static_cast<char>('a' + i % 26));
+    keys.push_back(uid);
+    reference[uid] = val;
+    test(storage.insert(std::make_pair(uid, val)).second, "Insertion of new key should succeed");
+    }
+  test(storage.size() == reference.size(), "Size mismatch after insertion");
+  test(!storage.insert(std::make_pair(keys[0], std::string("x"))).second,
+    "Insertion of duplicate key should fail");
+  test(storage[keys[0]] == reference[keys[0]], "Duplicate insertion should not overwrite");
+
+  // Slot indices should be stable and round-trip through atIndex().
+  Storage::index_type idx = storage.indexOf(keys[16]);
+  test(idx != Storage::InvalidIndex, "Expected a valid slot index");
+  test(storage.atIndex(idx)->first == keys[16], "atIndex() returned the wrong entry");
+  test(storage.indexOf(UUID::null()) == Storage::InvalidIndex, "Missing key should have no index");
+
+  // Iteration should visit every entry exactly once.
+  std::size_t visited = 0;
+  for (Storage::const_iterator it = storage.begin(); it != storage.end(); ++it, ++visited)
+    {
+    test(reference[it->first] == it->second, "Iteration returned a mismatched value");
+    }
+  test(visited == reference.size(), "Iteration visited the wrong number of entries");
+
+  // Erase every other key and verify that survivors keep their indices.
+  Storage::index_type keptIdx = storage.indexOf(keys[1]);
+  for (int i = 0; i < numEntries; i += 2)
+    {
+    test(storage.erase(keys[i]) == 1, "Erasing a present key should remove it");
+    reference.erase(keys[i]);
+    }
+  test(storage.erase(keys[0]) == 0, "Erasing a missing key should do nothing");
+  test(storage.size() == reference.size(), "Size mismatch after erasure");
+  test(storage.indexOf(keys[1]) == keptIdx, "Slot index changed after unrelated erasures");
+  test(storage.atIndex(idx) == storage.end(), "Erased slot should not be live");
+  for (int i = 0; i < numEntries; ++i)
+    {
+    test((storage.find(keys[i]) != storage.end()) == (i % 2 == 1), "Lookup after erasure failed");
+    }
+
+  // Re-insertion should reuse freed slots rather than growing storage.
+  Storage::iterator fit = storage.insert(std::make_pair(keys[0], std::string("reused"))).first;
+  test(fit->second == "reused" && storage.find(keys[0]) == fit, "Re-insertion failed");
+  storage.erase(fit);
+  test(storage.find(keys[0]) == storage.end(), "Erase by iterator failed");
+
+  storage.clear();
+  test(storage.empty() && storage.begin() == storage.end(), "clear() should empty the map");
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/extension/vtk/vtkModelMultiBlockSource.h"
+
+#include "smtk/model/Face.h"
+#include "smtk/model/Manager.h"
+#include "smtk/model/Tessellation.h"
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include "vtkActor.h"
+#include "vtkCompositePolyDataMapper.h"
+#include "vtkNew.h"
+#include "vtkRenderer.h"
+#include "vtkRenderWindow.h"
+#include "vtkSMPTools.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace smtk::model;
+using namespace smtk::model::testing;
+
+/// Give \a face a triangulated \a n x \a n grid as its tessellation, offset by \a z.
+void tessellateFace(ManagerPtr sm, const Face& face, int n, double z)
+{
+  Tessellation tess;
+  for (int j = 0; j < n; ++j)
+    for (int i = 0; i < n; ++i)
+      tess.addCoords(i, j, z);
+  for (int j = 0; j + 1 < n; ++j)
+    for (int i = 0; i + 1 < n; ++i)
+      {
+      int p = j * n + i;
+      tess.addTriangle(p, p + 1, p + n + 1);
+      tess.addTriangle(p, p + n + 1, p + n);
+      }
+  sm->setTessellation(face.entity(), tess);
+}
+
+/**\brief Time loading a model with many tessellated faces until it is first rendered.
+  *
+  * Usage: benchmarkModelMultiBlockSource [numFaces [pointsPerSide [numThreads]]]
+  */
+int main(int argc, char* argv[])
+{
+  int numFaces = argc > 1 ? atoi(argv[1]) : 10000;
+  int n = argc > 2 ? atoi(argv[2]) : 10;
+  if (argc > 3)
+    vtkSMPTools::Initialize(atoi(argv[3]));
+
+  ManagerPtr sm = Manager::create();
+  Timer t;
+  double deltaT;
+
+  t.mark();
+  std::vector<Face> faces;
+  for (int i = 0; i < numFaces; ++i)
+    {
+    faces.push_back(sm->addFace());
+    tessellateFace(sm, faces.back(), n, i);
+    }
+  deltaT = t.elapsed();
+  std::cout << numFaces << " faces with " << (2 * (n - 1) * (n - 1)) << " triangles each created in " << deltaT << " seconds\n";
+
+  vtkNew<vtkModelMultiBlockSource> src;
+  vtkNew<vtkCompositePolyDataMapper> map;
+  vtkNew<vtkActor> act;
+  vtkNew<vtkRenderer> ren;
+  vtkNew<vtkRenderWindow> win;
+  win->SetOffScreenRendering(1);
+  src->SetModelManager(sm);
+  map->SetInputConnection(src->GetOutputPort());
+  act->SetMapper(map.GetPointer());
+  win->AddRenderer(ren.GetPointer());
+  ren->AddActor(act.GetPointer());
+
+  // ### Benchmark conversion to VTK ###
+  t.mark();
+  src->Update();
+  double convertTime = t.elapsed();
+
+  // ### Benchmark load-to-first-render ###
+  t.mark();
+  win->Render();
+  deltaT = t.elapsed();
+  std::cout
+    << src->GetNumberOfRegeneratedBlocks() << " blocks generated in " << convertTime << " seconds, "
+    << "first render " << deltaT << " seconds, load-to-first-render " << (convertTime + deltaT) << " seconds\n";
+
+  // ### Benchmark an update after a single face changes ###
+  tessellateFace(sm, faces.front(), n, -1.);
+  src->Dirty();
+  t.mark();
+  src->Update();
+  deltaT = t.elapsed();
+  std::cout
+    << src->GetNumberOfRegeneratedBlocks() << " blocks regenerated after one face changed in " << deltaT << " seconds\n";
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/extension/vtk/vtkModelMultiBlockSource.h"
+
+#include "smtk/model/Face.h"
+#include "smtk/model/Manager.h"
+#include "smtk/model/Tessellation.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include "vtkFieldData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+
+#include <map>
+#include <vector>
+
+using namespace smtk::model;
+
+/// Give \a face a triangulated \a n x \a n grid as its tessellation, offset by \a z.
+void tessellateFace(ManagerPtr sm, const Face& face, int n, double z)
+{
+  Tessellation tess;
+  for (int j = 0; j < n; ++j)
+    for (int i = 0; i < n; ++i)
+      tess.addCoords(i, j, z);
+  for (int j = 0; j + 1 < n; ++j)
+    for (int i = 0; i + 1 < n; ++i)
+      {
+      int p = j * n + i;
+      tess.addTriangle(p, p + 1, p + n + 1);
+      tess.addTriangle(p, p + n + 1, p + n);
+      }
+  sm->setTessellation(face.entity(), tess);
+}
+
+/// Return the block of \a src's output holding \a face's tessellation.
+vtkPolyData* blockOf(vtkModelMultiBlockSource* src, const Face& face)
+{
+  std::map<smtk::common::UUID, unsigned int> uuid2block;
+  src->GetUUID2BlockIdMap(uuid2block);
+  std::map<smtk::common::UUID, unsigned int>::const_iterator it = uuid2block.find(face.entity());
+  test(it != uuid2block.end(), "Expected every tessellated face to have a block.");
+  return vtkPolyData::SafeDownCast(src->GetOutput()->GetBlock(it->second));
+}
+
+/// Verify that \a block has normals and is tagged with \a face's UUID.
+void verifyBlock(vtkPolyData* block, const Face& face)
+{
+  test(block != NULL, "Expected a polydata block.");
+  test(block->GetPointData()->GetNormals() != NULL, "Expected generated normals.");
+  vtkStringArray* tag = vtkStringArray::SafeDownCast(
+    block->GetFieldData()->GetAbstractArray(vtkModelMultiBlockSource::GetEntityTagName()));
+  test(tag != NULL, "Expected block info to survive normal generation.");
+  test(tag->GetValue(0) == face.entity().toString(), "Expected block to be tagged with its face.");
+}
+
+/**\brief Verify that only the block of a face whose tessellation changed is regenerated.
+  *
+  * Block info (field data) must be present on regenerated blocks even
+  * though normal generation replaces their contents.
+  */
+int main()
+{
+  const int numFaces = 4;
+  const int n = 3;
+
+  ManagerPtr sm = Manager::create();
+  std::vector<Face> faces;
+  for (int i = 0; i < numFaces; ++i)
+    {
+    faces.push_back(sm->addFace());
+    tessellateFace(sm, faces.back(), n, i);
+    }
+
+  vtkNew<vtkModelMultiBlockSource> src;
+  src->SetModelManager(sm);
+  src->AllowNormalGenerationOn();
+  src->Update();
+  test(src->GetNumberOfRegeneratedBlocks() == numFaces, "Expected every block to be generated initially.");
+
+  std::vector<vtkPolyData*> before;
+  for (int i = 0; i < numFaces; ++i)
+    {
+    before.push_back(blockOf(src.GetPointer(), faces[i]));
+    verifyBlock(before.back(), faces[i]);
+    }
+
+  // Split the first face into finer triangles; this bumps its tessellation generation.
+  tessellateFace(sm, faces[0], 2 * n, -1.);
+  src->Dirty();
+  src->Update();
+  test(src->GetNumberOfRegeneratedBlocks() == 1, "Expected only the split face to be regenerated.");
+
+  vtkPolyData* split = blockOf(src.GetPointer(), faces[0]);
+  test(split != before[0], "Expected the split face to have a new block.");
+  test(split->GetNumberOfPolys() == 2 * (2 * n - 1) * (2 * n - 1), "Expected the split face's new triangles.");
+  verifyBlock(split, faces[0]);
+  for (int i = 1; i < numFaces; ++i)
+    {
+    vtkPolyData* block = blockOf(src.GetPointer(), faces[i]);
+    test(block == before[i], "Expected unchanged faces to reuse their blocks.");
+    verifyBlock(block, faces[i]);
+    }
+
+  return 0;
+}
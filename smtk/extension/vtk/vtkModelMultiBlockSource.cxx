@@ -34,7 +34,10 @@
 #include "vtkProperty.h"
 #include "vtkStringArray.h"
 #include "vtkPolyDataNormals.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <inttypes.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -55,6 +58,7 @@ vtkModelMultiBlockSource::vtkModelMultiBlockSource()
   this->ModelEntityID = NULL;
   this->AllowNormalGeneration = 0;
   this->ShowAnalysisTessellation = 0;
+  this->NumberOfRegeneratedBlocks = 0;
 }
 
 vtkModelMultiBlockSource::~vtkModelMultiBlockSource()
@@ -72,6 +76,8 @@ void vtkModelMultiBlockSource::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ModelEntityID: " << this->ModelEntityID << "\n";
   os << indent << "AllowNormalGeneration: " << (this->AllowNormalGeneration ? "ON" : "OFF") << "\n";
   os << indent << "ShowAnalysisTessellation: " << this->ShowAnalysisTessellation << "\n";
+  os << indent << "CachedBlocks: " << this->CachedBlocks.size() << "\n";
+  os << indent << "NumberOfRegeneratedBlocks: " << this->NumberOfRegeneratedBlocks << "\n";
 }
 
 /**\brief For Python users, this method is the only way to bridge VTK and SMTK wrappings.
@@ -133,6 +139,7 @@ void vtkModelMultiBlockSource::SetModelManager(smtk::model::ManagerPtr model)
     return;
     }
   this->ModelMgr = model;
+  this->ClearBlockCache();
   this->Modified();
 }
 
@@ -149,7 +156,13 @@ void vtkModelMultiBlockSource::GetUUID2BlockIdMap(std::map<smtk::common::UUID, u
   uuid2mid.insert(this->UUID2BlockIdMap.begin(), this->UUID2BlockIdMap.end());
 }
 
-/// Indicate that the model has changed and should have its VTK representation updated.
+/**\brief Indicate that the model has changed and should have its VTK representation updated.
+  *
+  * Only blocks for entities whose tessellation generation number
+  * (see SMTK_TESS_GEN_PROP), color, or normal-generation setting has
+  * changed are regenerated; other blocks are reused from the cache.
+  * Call ClearBlockCache() as well to force every block to be regenerated.
+  */
 void vtkModelMultiBlockSource::Dirty()
 {
   // This both clears the output and marks this filter
@@ -158,6 +171,13 @@ void vtkModelMultiBlockSource::Dirty()
   this->SetCachedOutput(NULL);
 }
 
+/// Discard the polydata cached for each entity and mark the output as dirty.
+void vtkModelMultiBlockSource::ClearBlockCache()
+{
+  this->CachedBlocks.clear();
+  this->SetCachedOutput(NULL);
+}
+
 /*! \fn vtkModelMultiBlockSource::GetDefaultColor()
  *  \brief Get the RGBA color for model entities that do not have a color property set.
  *
@@ -223,62 +243,171 @@ void vtkModelMultiBlockSource::Dirty()
  *  \brief Request the display tessellation be shown.
  */
 
-static void AddEntityTessToPolyData(
-  const smtk::model::EntityRef& entityref, vtkPoints* pts, vtkPolyData* pd,
-  int showAnalysisTessellation)
+namespace {
+
+// The kinds of vtkCellArray a tessellation's cells are sorted into.
+enum BlockCellKind
 {
-  // gotMesh fetches Analysis mesh if it exists, falling back
-  // to model tessellation if not.
-  const smtk::model::Tessellation* tess = showAnalysisTessellation ?
-    entityref.hasAnalysisMesh() :
-    entityref.hasTessellation();
+  BLOCK_VERTS,
+  BLOCK_LINES,
+  BLOCK_POLYS,
+  BLOCK_STRIPS,
+  BLOCK_NUMBER_OF_KINDS
+};
+
+/// Return the kind of cell array that holds cells of the given tessellation \a shape (or -1).
+int internal_CellKindOfShape(Tessellation::size_type shape)
+{
+  switch (shape)
+    {
+  case TESS_VERTEX:
+  case TESS_POLYVERTEX:      return BLOCK_VERTS;
+  case TESS_POLYLINE:        return BLOCK_LINES;
+  case TESS_TRIANGLE:
+  case TESS_QUAD:
+  case TESS_POLYGON:         return BLOCK_POLYS;
+  case TESS_TRIANGLE_STRIP:  return BLOCK_STRIPS;
+  default:
+    break;
+    }
+  return -1;
+}
+
+} // namespace
+
+/**\brief Convert \a tess into points, cells and (optionally) colors of \a block's polydata.
+  *
+  * Points and cell arrays are sized by a counting pass and then filled
+  * directly rather than inserted one at a time.
+  * This does not modify the model or the filter, so it may be called
+  * for different blocks concurrently.
+  */
+void vtkModelMultiBlockSource::GenerateBlock(const Tessellation* tess, const CachedBlock& block)
+{
+  vtkPolyData* pd = block.Block.GetPointer();
+  vtkNew<vtkPoints> pts;
+  pts->SetDataTypeToDouble();
+  pd->SetPoints(pts.GetPointer());
   if (!tess)
     return;
 
-  vtkIdType i;
-  //vtkIdType connOffset = pts->GetNumberOfPoints();
-  std::vector<vtkIdType> conn;
-  std::string uuidStr = entityref.entity().toString();
-  vtkIdType npts = tess->coords().size() / 3;
-  for (i = 0; i < npts; ++i)
-    {
-    pts->InsertNextPoint(&tess->coords()[3*i]);
-    }
+  vtkIdType npts = static_cast<vtkIdType>(tess->coords().size() / 3);
+  pts->SetNumberOfPoints(npts);
+  if (npts > 0)
+    std::copy(
+      tess->coords().begin(), tess->coords().begin() + 3 * npts,
+      static_cast<double*>(pts->GetVoidPointer(0)));
+
+  // Count the cells of each kind and the size of their connectivity.
   Tessellation::size_type off;
-  vtkNew<vtkCellArray> verts;
-  vtkNew<vtkCellArray> lines;
-  vtkNew<vtkCellArray> polys;
-  vtkNew<vtkCellArray> strip;
-  bool have_verts = false;
-  bool have_lines = false;
-  bool have_polys = false;
-  bool have_strip = false;
+  Tessellation::size_type cellType;
+  vtkIdType numCells[BLOCK_NUMBER_OF_KINDS] = { 0, 0, 0, 0 };
+  vtkIdType connSize[BLOCK_NUMBER_OF_KINDS] = { 0, 0, 0, 0 };
   for (off = tess->begin(); off != tess->end(); off = tess->nextCellOffset(off))
     {
-    Tessellation::size_type cell_type = tess->cellType(off);
-    Tessellation::size_type cell_shape = tess->cellShapeFromType(cell_type);
-    std::vector<int> cell_conn;
-    Tessellation::size_type num_verts = tess->vertexIdsOfCell(off, cell_conn);
-    std::vector<vtkIdType> vtk_conn(cell_conn.begin(), cell_conn.end());
-    switch (cell_shape)
+    Tessellation::size_type numVerts = tess->numberOfCellVertices(off, &cellType);
+    int kind = internal_CellKindOfShape(tess->cellShapeFromType(cellType));
+    if (kind < 0)
       {
-    case TESS_VERTEX:          have_verts = true; verts->InsertNextCell(1, &vtk_conn[0]); break;
-    case TESS_TRIANGLE:        have_polys = true; polys->InsertNextCell(3, &vtk_conn[0]); break;
-    case TESS_QUAD:            have_polys = true; polys->InsertNextCell(4, &vtk_conn[0]); break;
-    case TESS_POLYVERTEX:      have_verts = true; verts->InsertNextCell(num_verts, &vtk_conn[0]); break;
-    case TESS_POLYLINE:        have_lines = true; lines->InsertNextCell(num_verts, &vtk_conn[0]); break;
-    case TESS_POLYGON:         have_polys = true; polys->InsertNextCell(num_verts, &vtk_conn[0]); break;
-    case TESS_TRIANGLE_STRIP:  have_strip = true; strip->InsertNextCell(num_verts, &vtk_conn[0]); break;
-    default:
-      std::cerr << "Invalid cell shape " << cell_shape << " at offset " << off << ". Skipping.\n";
+      std::cerr << "Invalid cell shape " << tess->cellShapeFromType(cellType) << " at offset " << off << ". Skipping.\n";
+      continue;
+      }
+    ++numCells[kind];
+    connSize[kind] += 1 + numVerts;
+    }
+
+  // Copy connectivity into preallocated arrays.
+  vtkSmartPointer<vtkIdTypeArray> cellConn[BLOCK_NUMBER_OF_KINDS];
+  vtkIdType* dest[BLOCK_NUMBER_OF_KINDS];
+  for (int kind = 0; kind < BLOCK_NUMBER_OF_KINDS; ++kind)
+    {
+    cellConn[kind] = vtkSmartPointer<vtkIdTypeArray>::New();
+    cellConn[kind]->SetNumberOfTuples(connSize[kind]);
+    dest[kind] = connSize[kind] > 0 ? cellConn[kind]->GetPointer(0) : NULL;
+    }
+  const std::vector<int>& conn(tess->conn());
+  for (off = tess->begin(); off != tess->end(); off = tess->nextCellOffset(off))
+    {
+    Tessellation::size_type numVerts = tess->numberOfCellVertices(off, &cellType);
+    int kind = internal_CellKindOfShape(tess->cellShapeFromType(cellType));
+    if (kind < 0)
+      continue;
+    Tessellation::size_type first = off + (cellType & TESS_VARYING_VERT_CELL ? 2 : 1);
+    *dest[kind]++ = numVerts;
+    dest[kind] = std::copy(conn.begin() + first, conn.begin() + first + numVerts, dest[kind]);
+    }
+  for (int kind = 0; kind < BLOCK_NUMBER_OF_KINDS; ++kind)
+    {
+    if (!numCells[kind])
       continue;
-      break;
+    vtkNew<vtkCellArray> cells;
+    cells->SetCells(numCells[kind], cellConn[kind]);
+    switch (kind)
+      {
+    case BLOCK_VERTS: pd->SetVerts(cells.GetPointer()); break;
+    case BLOCK_LINES: pd->SetLines(cells.GetPointer()); break;
+    case BLOCK_POLYS: pd->SetPolys(cells.GetPointer()); break;
+    case BLOCK_STRIPS: pd->SetStrips(cells.GetPointer()); break;
+      }
+    }
+
+  // Only create the color array if there is a valid default:
+  if (block.Color[3] >= 0.)
+    {
+    vtkNew<vtkUnsignedCharArray> cellColor;
+    cellColor->SetNumberOfComponents(4);
+    cellColor->SetNumberOfTuples(pd->GetNumberOfCells());
+    cellColor->SetName("Entity Color");
+    for (int i = 0; i < 4; ++i)
+      {
+      cellColor->FillComponent(i, block.Color[i] * 255.);
       }
+    pd->GetCellData()->AddArray(cellColor.GetPointer());
+    pd->GetCellData()->SetScalars(cellColor.GetPointer());
+    }
+}
+
+/// Generate blocks from tessellations concurrently.
+struct vtkModelMultiBlockSource::GenerateBlocksFunctor
+{
+  GenerateBlocksFunctor(const PendingBlocks& pending)
+    : Pending(pending)
+    {
+    }
+
+  void operator () (vtkIdType begin, vtkIdType end) const
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      vtkModelMultiBlockSource::GenerateBlock(this->Pending[i].first, this->Pending[i].second);
+    }
+
+  const PendingBlocks& Pending;
+};
+
+/**\brief Generate the polydata for each entry of \a pending.
+  *
+  * Tessellations are converted in parallel with vtkSMPTools.
+  * Surface normals, when requested, are then computed one block
+  * at a time since pipeline updates are not thread-safe.
+  */
+void vtkModelMultiBlockSource::GeneratePendingBlocks(const PendingBlocks& pending)
+{
+  GenerateBlocksFunctor generate(pending);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pending.size()), generate);
+  for (PendingBlocks::const_iterator it = pending.begin(); it != pending.end(); ++it)
+    this->GenerateNormals(it->second);
+}
+
+/// Replace \a block's polydata with a copy that has surface normals if they were requested.
+void vtkModelMultiBlockSource::GenerateNormals(const CachedBlock& block)
+{
+  vtkPolyData* pd = block.Block.GetPointer();
+  if (block.Normals && pd->GetPolys()->GetSize() > 0)
+    {
+    this->NormalGenerator->SetInputDataObject(pd);
+    this->NormalGenerator->Update();
+    pd->ShallowCopy(this->NormalGenerator->GetOutput());
     }
-  if (have_verts) pd->SetVerts(verts.GetPointer());
-  if (have_lines) pd->SetLines(lines.GetPointer());
-  if (have_polys) pd->SetPolys(polys.GetPointer());
-  if (have_strip) pd->SetStrips(strip.GetPointer());
 }
 
 /// Add customized block info.
@@ -318,60 +447,112 @@ static void internal_AddBlockInfo(smtk::model::ManagerPtr manager,
     volArray->SetName(vtkModelMultiBlockSource::GetVolumeTagName());
     poly->GetFieldData()->AddArray(volArray.GetPointer());
     }
+  else
+    { // Blocks may be reused from a previous update; remove any stale volume.
+    poly->GetFieldData()->RemoveArray(vtkModelMultiBlockSource::GetVolumeTagName());
+    }
 }
 
+/// Arguments to internal_AddBlockInfo, held until a block's polydata is final.
+struct internal_BlockInfo
+{
+  internal_BlockInfo(
+    const smtk::model::EntityRef& entityref, const smtk::model::EntityRef& bordantCell,
+    vtkIdType blockId, vtkPolyData* poly)
+    : EntityRefOfBlock(entityref), BordantCell(bordantCell), BlockId(blockId), Poly(poly)
+    { }
+
+  smtk::model::EntityRef EntityRefOfBlock;
+  smtk::model::EntityRef BordantCell;
+  vtkIdType BlockId;
+  vtkPolyData* Poly;
+};
+
 /// Loop over the model generating blocks of polydata.
 void vtkModelMultiBlockSource::GenerateRepresentationFromModel(
   vtkPolyData* pd, const smtk::model::EntityRef& entityref, bool genNormals)
 {
-  vtkNew<vtkPoints> pts;
-  pd->SetPoints(pts.GetPointer());
-  const smtk::model::Tessellation* tess;
-  if (!(tess = entityref.hasTessellation()))
-    { // Oops.
-    return;
+  CachedBlock block;
+  this->DescribeBlock(entityref, genNormals, block);
+  block.Block = pd;
+  GenerateBlock(this->TessellationToShow(entityref), block);
+  this->GenerateNormals(block);
+}
+
+/// Return the generation number stored in \a prop on \a entityref (or -1 if there is none).
+static int internal_GenerationOf(const smtk::model::EntityRef& entityref, const std::string& prop)
+{
+  if (!entityref.hasIntegerProperty(prop))
+    return -1;
+  const IntegerList& gen(entityref.integerProperty(prop));
+  return gen.empty() ? -1 : static_cast<int>(gen[0]);
+}
+
+/// Return the tessellation of \a entityref that should be shown (or NULL).
+const Tessellation* vtkModelMultiBlockSource::TessellationToShow(const smtk::model::EntityRef& entityref) const
+{
+  if (!entityref.isValid() || !entityref.hasTessellation())
+    return NULL;
+  return this->ShowAnalysisTessellation ?
+    entityref.hasAnalysisMesh() :
+    entityref.hasTessellation();
+}
+
+/**\brief Record what the polydata for \a entityref depends upon in \a block.
+  *
+  * This includes the entity's tessellation generation number(s),
+  * the color its cells should be given and whether normals should
+  * be generated.
+  */
+void vtkModelMultiBlockSource::DescribeBlock(
+  const smtk::model::EntityRef& entityref, bool genNormals, CachedBlock& block) const
+{
+  block.Generation[0] = internal_GenerationOf(entityref, SMTK_TESS_GEN_PROP);
+  block.Generation[1] = this->ShowAnalysisTessellation ?
+    internal_GenerationOf(entityref, SMTK_MESH_GEN_PROP) : -1;
+  FloatList rgba = entityref.color();
+  for (int i = 0; i < 4; ++i)
+    block.Color[i] = this->DefaultColor[3] < 0. ? -1. :
+      (rgba[3] >= 0 ? rgba[i] : this->DefaultColor[i]);
+  block.Normals = this->AllowNormalGeneration && genNormals;
+  if (this->AllowNormalGeneration && entityref.hasIntegerProperty("generate normals"))
+    { // Allow per-entity setting to override per-model setting
+    const IntegerList& prop(entityref.integerProperty("generate normals"));
+    block.Normals = !prop.empty() && prop[0];
     }
-  vtkIdType npts = tess->coords().size() / 3;
-  pts->Allocate(npts);
-  smtk::model::Entity* entity;
-  if (entityref.isValid(&entity))
+}
+
+/**\brief Return polydata for \a entityref, reusing the block generated by the previous update if possible.
+  *
+  * A cached block is reused when the entity's tessellation generation
+  * number(s), color, and normal-generation setting all match those it
+  * was generated with. Entities without a generation number are always
+  * regenerated since changes to their tessellation cannot be detected.
+  * The block (new or reused) is entered into \a nextCache; new blocks
+  * are empty until the entries appended to \a pending are generated.
+  */
+vtkPolyData* vtkModelMultiBlockSource::GenerateCachedRepresentation(
+  const smtk::model::EntityRef& entityref, bool genNormals,
+  BlockCache& nextCache, PendingBlocks& pending)
+{
+  CachedBlock key;
+  this->DescribeBlock(entityref, genNormals, key);
+
+  BlockCache::iterator it = this->CachedBlocks.find(entityref.entity());
+  if (
+    key.Generation[0] >= 0 &&
+    it != this->CachedBlocks.end() &&
+    it->second.Generation[0] == key.Generation[0] &&
+    it->second.Generation[1] == key.Generation[1] &&
+    std::equal(key.Color, key.Color + 4, it->second.Color) &&
+    it->second.Normals == key.Normals)
     {
-    AddEntityTessToPolyData(
-      entityref, pts.GetPointer(), pd, this->ShowAnalysisTessellation);
-    // Only create the color array if there is a valid default:
-    if (this->DefaultColor[3] >= 0.)
-      {
-      FloatList rgba = entityref.color();
-      vtkNew<vtkUnsignedCharArray> cellColor;
-      cellColor->SetNumberOfComponents(4);
-      cellColor->SetNumberOfTuples(pd->GetNumberOfCells());
-      cellColor->SetName("Entity Color");
-      for (int i = 0; i < 4; ++i)
-        {
-        cellColor->FillComponent(i,
-          (rgba[3] >= 0 ? rgba[i] : this->DefaultColor[i])* 255.);
-        }
-      pd->GetCellData()->AddArray(cellColor.GetPointer());
-      pd->GetCellData()->SetScalars(cellColor.GetPointer());
-      }
-    if (this->AllowNormalGeneration && pd->GetPolys()->GetSize() > 0)
-      {
-      bool reallyNeedNormals = genNormals;
-      if ( entityref.hasIntegerProperty("generate normals"))
-        { // Allow per-entity setting to override per-model setting
-        const IntegerList& prop(
-          entityref.integerProperty(
-            "generate normals"));
-        reallyNeedNormals = (!prop.empty() && prop[0]);
-        }
-      if (reallyNeedNormals)
-        {
-        this->NormalGenerator->SetInputDataObject(pd);
-        this->NormalGenerator->Update();
-        pd->ShallowCopy(this->NormalGenerator->GetOutput());
-        }
-      }
+    return (nextCache[entityref.entity()] = it->second).Block.GetPointer();
     }
+
+  key.Block = vtkSmartPointer<vtkPolyData>::New();
+  pending.push_back(std::make_pair(this->TessellationToShow(entityref), key));
+  return (nextCache[entityref.entity()] = key).Block.GetPointer();
 }
 
 /// Recursively find all the entities with tessellation
@@ -415,6 +596,11 @@ void vtkModelMultiBlockSource::FindEntitiesWithTessellation(
 void vtkModelMultiBlockSource::GenerateRepresentationFromModel(
   vtkMultiBlockDataSet* mbds, smtk::model::ManagerPtr manager)
 {
+  // Blocks for entities not visited below are dropped from the cache.
+  // Blocks that must be regenerated are filled in once all have been found.
+  BlockCache nextCache;
+  PendingBlocks pending;
+  std::vector<internal_BlockInfo> blockInfo;
   if(this->ModelEntityID && this->ModelEntityID[0])
     {
     smtk::common::UUID uid(this->ModelEntityID);
@@ -450,16 +636,16 @@ void vtkModelMultiBlockSource::GenerateRepresentationFromModel(
       std::map<smtk::model::EntityRef, smtk::model::EntityRef>::iterator cit;
       for (i = 0, cit = entityrefMap.begin(); cit != entityrefMap.end(); ++cit, ++i)
         {
-        vtkNew<vtkPolyData> poly;
-        mbds->SetBlock(i, poly.GetPointer());
+        vtkPolyData* poly = this->GenerateCachedRepresentation(
+          cit->first, modelRequiresNormals, nextCache, pending);
+        mbds->SetBlock(i, poly);
         // Set the block name to the entity UUID.
         mbds->GetMetaData(i)->Set(vtkCompositeDataSet::NAME(), cit->first.name().c_str());
-        this->GenerateRepresentationFromModel(poly.GetPointer(), cit->first, modelRequiresNormals);
         // std::cout << "UUID: " << (*cit).entity().toString().c_str() << " Block: " << i << std::endl;
         // as a convenient method to get the flat block index in multiblock
         if(!(cit->first.entity().isNull()))
           {
-          internal_AddBlockInfo(manager, cit->first, cit->second, i, poly.GetPointer(), this->UUID2BlockIdMap);
+          blockInfo.push_back(internal_BlockInfo(cit->first, cit->second, i, poly));
           }
         }
 
@@ -498,17 +684,28 @@ void vtkModelMultiBlockSource::GenerateRepresentationFromModel(
     smtk::model::UUIDWithTessellation it;
     for (i = 0, it = manager->tessellations().begin(); it != manager->tessellations().end(); ++it, ++i)
       {
-      vtkNew<vtkPolyData> poly;
-      mbds->SetBlock(i, poly.GetPointer());
       smtk::model::EntityRef entityref(manager, it->first);
+      vtkPolyData* poly = this->GenerateCachedRepresentation(
+        entityref, this->AllowNormalGeneration != 0, nextCache, pending);
+      mbds->SetBlock(i, poly);
       // Set the block name to the entity UUID.
       mbds->GetMetaData(i)->Set(vtkCompositeDataSet::NAME(), entityref.name().c_str());
-      this->GenerateRepresentationFromModel(poly.GetPointer(), entityref, this->AllowNormalGeneration);
 
       // as a convenient method to get the flat block_index in multiblock
-      internal_AddBlockInfo(manager, entityref, smtk::model::EntityRef(), i, poly.GetPointer(), this->UUID2BlockIdMap);
+      blockInfo.push_back(internal_BlockInfo(entityref, smtk::model::EntityRef(), i, poly));
       }
     }
+  this->GeneratePendingBlocks(pending);
+  // Generating normals shallow-copies over a block's field data,
+  // so block info may only be added once every block is complete.
+  std::vector<internal_BlockInfo>::const_iterator bit;
+  for (bit = blockInfo.begin(); bit != blockInfo.end(); ++bit)
+    {
+    internal_AddBlockInfo(
+      manager, bit->EntityRefOfBlock, bit->BordantCell, bit->BlockId, bit->Poly, this->UUID2BlockIdMap);
+    }
+  this->NumberOfRegeneratedBlocks = static_cast<vtkIdType>(pending.size());
+  this->CachedBlocks.swap(nextCache);
 }
 
 /// Generate polydata from an smtk::model with tessellation information.
@@ -18,8 +18,10 @@
 #include "vtkMultiBlockDataSetAlgorithm.h"
 
 #include "vtkNew.h"
+#include "vtkSmartPointer.h"
 
 #include <map>
+#include <vector>
 
 class vtkPolyData;
 class vtkPolyDataNormals;
@@ -28,6 +30,13 @@ class vtkPolyDataNormals;
   *
   * This filter generates a single block per UUID, for every UUID
   * in model manager with a tessellation entry.
+  *
+  * The polydata generated for each entity is cached along with the
+  * entity's tessellation generation number (SMTK_TESS_GEN_PROP), so
+  * that updates after Dirty() only regenerate blocks whose tessellation
+  * (or color) has changed.
+  * Blocks that must be regenerated are converted from tessellations
+  * in parallel (using vtkSMPTools).
   */
 class VTKSMTKEXT_EXPORT vtkModelMultiBlockSource : public vtkMultiBlockDataSetAlgorithm
 {
@@ -61,6 +70,12 @@ public:
   vtkSetMacro(AllowNormalGeneration,int);
   vtkBooleanMacro(AllowNormalGeneration,int);
 
+  // Description:
+  // The number of blocks whose polydata was generated (rather than
+  // reused from the per-entity cache) by the last RequestData().
+  vtkGetMacro(NumberOfRegeneratedBlocks,vtkIdType);
+  void ClearBlockCache();
+
   // Description:
   // Functions get string names used to store cell/field data.
   static const char* GetEntityTagName() { return "Entity"; }
@@ -79,6 +94,27 @@ protected:
   void GenerateRepresentationFromModel(
     vtkMultiBlockDataSet* mbds, smtk::model::ManagerPtr model);
 
+  /// Polydata generated for one entity and what it was generated from.
+  struct CachedBlock
+    {
+    int Generation[2]; // display and (when shown) analysis tessellation generation numbers
+    double Color[4];   // cell color (all -1 when no color array is generated)
+    bool Normals;      // were normals requested?
+    vtkSmartPointer<vtkPolyData> Block;
+    };
+  typedef std::map<smtk::common::UUID, CachedBlock> BlockCache;
+  typedef std::vector<std::pair<const smtk::model::Tessellation*, CachedBlock> > PendingBlocks;
+  struct GenerateBlocksFunctor;
+
+  const smtk::model::Tessellation* TessellationToShow(const smtk::model::EntityRef& entity) const;
+  void DescribeBlock(const smtk::model::EntityRef& entity, bool genNormals, CachedBlock& block) const;
+  vtkPolyData* GenerateCachedRepresentation(
+    const smtk::model::EntityRef& entity, bool genNormals,
+    BlockCache& nextCache, PendingBlocks& pending);
+  void GeneratePendingBlocks(const PendingBlocks& pending);
+  void GenerateNormals(const CachedBlock& block);
+  static void GenerateBlock(const smtk::model::Tessellation* tess, const CachedBlock& block);
+
   //virtual int FillInputPortInformation(int port, vtkInformation* request);
   //virtual int FillOutputPortInformation(int port, vtkInformation* request);
 
@@ -105,6 +141,9 @@ protected:
   int ShowAnalysisTessellation;
   vtkNew<vtkPolyDataNormals> NormalGenerator;
 
+  BlockCache CachedBlocks;
+  vtkIdType NumberOfRegeneratedBlocks;
+
 private:
   vtkModelMultiBlockSource(const vtkModelMultiBlockSource&); // Not implemented.
   void operator = (const vtkModelMultiBlockSource&); // Not implemented.
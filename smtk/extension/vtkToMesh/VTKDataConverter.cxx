@@ -14,6 +14,7 @@
 #include "smtk/mesh/Collection.h"
 #include "smtk/mesh/Manager.h"
 #include "smtk/mesh/CellTraits.h"
+#include "smtk/mesh/WeldPoints.h"
 
 #include "vtkPolyData.h"
 #include "vtkUnstructuredGrid.h"
@@ -28,6 +29,9 @@
 #include "smtk/mesh/moab/Interface.h"
 #include "smtk/mesh/moab/CellTypeToType.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace smtk {
 namespace extension {
 namespace vtkToMesh {
@@ -75,27 +79,61 @@ smtk::mesh::CellType vtkToSMTKCell(int t)
   }
 
 //----------------------------------------------------------------------------
+//When weldTolerance isn't negative the points are welded first, and only
+//the kept points are allocated. pointIds then maps each vtk point id to
+//the index of the point it was welded to, otherwise it is left empty.
 bool convertVTKPoints(vtkPoints* points,
                       const smtk::mesh::AllocatorPtr& ialloc,
-                      smtk::mesh::Handle& firstVertHandle)
+                      double weldTolerance,
+                      smtk::mesh::Handle& firstVertHandle,
+                      std::vector<std::size_t>& pointIds)
 {
   const vtkIdType numberOfPoints = points->GetNumberOfPoints();
+
+  //note this could become a performance bottleneck. If that occurs
+  //we will need to move to a template dispatch solution to handle floats,
+  //doubles, and vtk Mapped Arrays
+  std::vector<double> xyz(3 * numberOfPoints);
+  for(vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+    points->GetPoint(i, &xyz[3*i]);
+    }
+
+  std::size_t numberOfPointsToAlloc = static_cast<std::size_t>(numberOfPoints);
+  pointIds.clear();
+  if(weldTolerance >= 0 && numberOfPoints > 0)
+    {
+    //number the kept points in order, and move their coordinates to match
+    std::vector<std::size_t> remap;
+    smtk::mesh::weldPoints(&xyz[0], numberOfPointsToAlloc, weldTolerance, remap);
+    pointIds.resize(numberOfPointsToAlloc);
+    std::size_t numKept = 0;
+    for(std::size_t i = 0; i < numberOfPointsToAlloc; ++i)
+      {
+      if(remap[i] == i)
+        {
+        std::copy(&xyz[3*i], &xyz[3*i] + 3, &xyz[3*numKept]);
+        pointIds[i] = numKept++;
+        }
+      else
+        {
+        pointIds[i] = pointIds[remap[i]];
+        }
+      }
+    numberOfPointsToAlloc = numKept;
+    }
+
   std::vector<double *> coords;
-  const bool pointsAllocated = ialloc->allocatePoints( numberOfPoints,
+  const bool pointsAllocated = ialloc->allocatePoints( numberOfPointsToAlloc,
                                                        firstVertHandle,
                                                        coords);
   if(pointsAllocated)
     {
-    double point[3];
-    for(vtkIdType i = 0; i < numberOfPoints; ++i)
+    for(std::size_t i = 0; i < numberOfPointsToAlloc; ++i)
       {
-      //note this could become a performance bottleneck. If that occurs
-      //we will need to move to a template dispatch solution to handle floats,
-      //doubles, and vtk Mapped Arrays
-      points->GetPoint(i, point);
-      coords[0][i] = point[0];
-      coords[1][i] = point[1];
-      coords[2][i] = point[2];
+      coords[0][i] = xyz[3*i];
+      coords[1][i] = xyz[3*i+1];
+      coords[2][i] = xyz[3*i+2];
       }
     }
   return pointsAllocated;
@@ -106,6 +144,7 @@ template<typename VTKDataSetType>
 bool convertVTKCells( VTKDataSetType* dataset,
                       const smtk::mesh::AllocatorPtr& ialloc,
                       smtk::mesh::Handle firstVertHandle,
+                      const std::vector<std::size_t>& pointIds,
                       smtk::mesh::HandleRange& newlyCreatedCells)
 {
   //iterate the dataset collecting cells of the same
@@ -179,9 +218,19 @@ bool convertVTKCells( VTKDataSetType* dataset,
         {
         dataset->GetCellPoints( i, npts, pts );
         //currently only supports linear elements
-        for(vtkIdType j=0; j < npts; ++j)
+        if(pointIds.empty())
+          {
+          for(vtkIdType j=0; j < npts; ++j)
+            {
+            currentConnLoc[j] = firstVertHandle + pts[j];
+            }
+          }
+        else
           {
-          currentConnLoc[j] = firstVertHandle + pts[j];
+          for(vtkIdType j=0; j < npts; ++j)
+            {
+            currentConnLoc[j] = firstVertHandle + pointIds[pts[j]];
+            }
           }
         currentConnLoc += npts;
         }
@@ -265,7 +314,8 @@ bool convertDomain(vtkCellData* cellData,
 
 //----------------------------------------------------------------------------
 VTKDataConverter::VTKDataConverter(const smtk::mesh::ManagerPtr& manager):
-  m_manager( manager )
+  m_manager( manager ),
+  m_weldTolerance( -1 )
 {
 
 }
@@ -307,9 +357,12 @@ VTKDataConverter::operator()(vtkPolyData* polydata,
   smtk::mesh::AllocatorPtr ialloc = iface->allocator();
 
   smtk::mesh::Handle firstVertHandle;
+  std::vector<std::size_t> pointIds;
   pointsConverted = detail::convertVTKPoints(polydata->GetPoints(),
                                              ialloc,
-                                             firstVertHandle);
+                                             this->m_weldTolerance,
+                                             firstVertHandle,
+                                             pointIds);
 
 
   //step 3 allocate and fill connectivity
@@ -317,6 +370,7 @@ VTKDataConverter::operator()(vtkPolyData* polydata,
   cellsConverted = detail::convertVTKCells( polydata,
                                             ialloc,
                                             firstVertHandle,
+                                            pointIds,
                                             newlyCreatedCells );
 
   if(pointsConverted && cellsConverted)
@@ -385,15 +439,19 @@ VTKDataConverter::operator()(vtkUnstructuredGrid* ugrid,
   smtk::mesh::AllocatorPtr ialloc = iface->allocator();
 
   smtk::mesh::Handle firstVertHandle;
+  std::vector<std::size_t> pointIds;
   pointsConverted = detail::convertVTKPoints(ugrid->GetPoints(),
                                                ialloc,
-                                               firstVertHandle);
+                                               this->m_weldTolerance,
+                                               firstVertHandle,
+                                               pointIds);
 
   //step 3 allocate and fill connectivity
   smtk::mesh::HandleRange newlyCreatedCells;
   cellsConverted = detail::convertVTKCells( ugrid,
                                             ialloc,
                                             firstVertHandle,
+                                            pointIds,
                                             newlyCreatedCells );
 
   if(pointsConverted && cellsConverted)
@@ -37,6 +37,13 @@ public:
   //that all conversion will be added as new collections to this manager
   explicit VTKDataConverter(const smtk::mesh::ManagerPtr& manager);
 
+  //Weld the points of the data set that are within tolerance of each other
+  //before converting, so that only one point is created for each group of
+  //coincident points. A negative tolerance, the default, welds nothing, and
+  //zero welds only identical points.
+  void setWeldTolerance(double tolerance) { this->m_weldTolerance = tolerance; }
+  double weldTolerance() const { return this->m_weldTolerance; }
+
   //convert a polydata to a collection.
   //Optionally specify the cell property name to be used to split
   //the mesh into muliple domain.
@@ -56,6 +63,8 @@ private:
 
   //holds a weak reference to the manager
   smtk::weak_ptr<smtk::mesh::Manager> m_manager;
+
+  double m_weldTolerance;
 };
 
 }
@@ -0,0 +1,520 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/io/ExportBinary.h"
+
+#include "smtk/common/UUIDHashMap.h"
+
+#include "smtk/model/Arrangement.h"
+#include "smtk/model/Entity.h"
+#include "smtk/model/Manager.h"
+#include "smtk/model/Session.h"
+#include "smtk/model/SessionIOBinary.h"
+#include "smtk/model/SessionRef.h"
+#include "smtk/model/Tessellation.h"
+
+#include <boost/cstdint.hpp>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace smtk::io;
+using namespace smtk::common;
+using namespace smtk::model;
+
+namespace {
+
+const char ArchiveMagic[] = "SMTKARCH";
+const boost::uint32_t ArchiveVersion = 1;
+const boost::uint32_t ByteOrderMark = 0x01020304;
+
+typedef std::vector<boost::uint32_t> IndexArray;
+typedef std::vector<boost::uint64_t> OffsetArray;
+
+/// Write counts, arrays and sections, keeping arrays 8-byte aligned.
+class ArchiveWriter
+{
+public:
+  ArchiveWriter(std::ostream& out) : m_out(out), m_offset(0)
+    {
+    }
+
+  void bytes(const void* data, std::size_t size)
+    {
+    if (size)
+      {
+      this->m_out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+      this->m_offset += size;
+      }
+    }
+
+  template<typename T>
+  void value(T val)
+    {
+    this->bytes(&val, sizeof(T));
+    }
+
+  void count(std::size_t num)
+    {
+    this->value(static_cast<boost::uint64_t>(num));
+    }
+
+  template<typename T>
+  void array(const std::vector<T>& values)
+    {
+    if (!values.empty())
+      {
+      this->bytes(&values[0], values.size() * sizeof(T));
+      }
+    this->pad();
+    }
+
+  void array(const std::string& chars)
+    {
+    this->bytes(chars.data(), chars.size());
+    this->pad();
+    }
+
+  void pad()
+    {
+    static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    std::size_t extra = static_cast<std::size_t>(this->m_offset % 8);
+    if (extra)
+      {
+      this->bytes(zeros, 8 - extra);
+      }
+    }
+
+  void beginSection(BinarySection kind)
+    {
+    this->pad();
+    Section entry = { static_cast<boost::uint32_t>(kind), this->m_offset, 0 };
+    this->m_sections.push_back(entry);
+    }
+
+  void endSection()
+    {
+    this->pad();
+    this->m_sections.back().size = this->m_offset - this->m_sections.back().offset;
+    }
+
+  void header()
+    {
+    this->bytes(ArchiveMagic, 8);
+    this->value(ArchiveVersion);
+    this->value(ByteOrderMark);
+    }
+
+  void trailer()
+    {
+    this->pad();
+    boost::uint64_t tableOffset = this->m_offset;
+    for (std::size_t i = 0; i < this->m_sections.size(); ++i)
+      {
+      this->value(this->m_sections[i].kind);
+      this->value(static_cast<boost::uint32_t>(0));
+      this->value(this->m_sections[i].offset);
+      this->value(this->m_sections[i].size);
+      }
+    this->value(tableOffset);
+    this->count(this->m_sections.size());
+    this->bytes(ArchiveMagic, 8);
+    }
+
+protected:
+  struct Section
+    {
+    boost::uint32_t kind;
+    boost::uint64_t offset;
+    boost::uint64_t size;
+    };
+
+  std::ostream& m_out;
+  boost::uint64_t m_offset;
+  std::vector<Section> m_sections;
+};
+
+/// Number the UUIDs of the archive, starting with the entities.
+class UUIDTable
+{
+public:
+  boost::uint32_t index(const UUID& uid)
+    {
+    std::pair<UUIDHashMap<boost::uint32_t>::iterator, bool> entry =
+      this->m_indices.insert(
+        std::make_pair(uid, static_cast<boost::uint32_t>(this->m_uids.size())));
+    if (entry.second)
+      {
+      this->m_uids.push_back(uid);
+      }
+    return entry.first->second;
+    }
+
+  void write(ArchiveWriter& writer) const
+    {
+    writer.beginSection(BINARY_UUIDS);
+    writer.count(this->m_uids.size());
+    std::vector<unsigned char> raw(this->m_uids.size() * UUID::SIZE);
+    for (std::size_t i = 0; i < this->m_uids.size(); ++i)
+      {
+      std::copy(this->m_uids[i].begin(), this->m_uids[i].end(), raw.begin() + i * UUID::SIZE);
+      }
+    writer.array(raw);
+    writer.endSection();
+    }
+
+protected:
+  UUIDHashMap<boost::uint32_t> m_indices;
+  UUIDArray m_uids;
+};
+
+/// Intern property names so each is stored once.
+class NameTable
+{
+public:
+  boost::uint32_t index(const std::string& name)
+    {
+    std::pair<std::map<std::string, boost::uint32_t>::iterator, bool> entry =
+      this->m_indices.insert(
+        std::make_pair(name, static_cast<boost::uint32_t>(this->m_starts.size())));
+    if (entry.second)
+      {
+      this->m_starts.push_back(this->m_chars.size());
+      this->m_chars += name;
+      }
+    return entry.first->second;
+    }
+
+  void write(ArchiveWriter& writer)
+    {
+    writer.beginSection(BINARY_PROPERTY_NAMES);
+    writer.count(this->m_starts.size());
+    OffsetArray starts(this->m_starts);
+    starts.push_back(this->m_chars.size());
+    writer.array(starts);
+    writer.array(this->m_chars);
+    writer.endSection();
+    }
+
+protected:
+  std::map<std::string, boost::uint32_t> m_indices;
+  OffsetArray m_starts;
+  std::string m_chars;
+};
+
+/// Gather one kind of property for the entities, in entity order.
+template<typename V>
+class PropertyColumns
+{
+public:
+  PropertyColumns()
+    {
+    this->m_starts.push_back(0);
+    }
+
+  template<typename I>
+  void add(boost::uint32_t entity, I begin, I end, NameTable& names)
+    {
+    for (I entry = begin; entry != end; ++entry)
+      {
+      this->m_entities.push_back(entity);
+      this->m_names.push_back(names.index(entry->first));
+      this->m_values.insert(this->m_values.end(), entry->second.begin(), entry->second.end());
+      this->m_starts.push_back(this->m_values.size());
+      }
+    }
+
+  void write(ArchiveWriter& writer, BinarySection kind)
+    {
+    writer.beginSection(kind);
+    writer.count(this->m_entities.size());
+    writer.array(this->m_entities);
+    writer.array(this->m_names);
+    writer.array(this->m_starts);
+    this->writeValues(writer);
+    writer.endSection();
+    }
+
+protected:
+  void writeValues(ArchiveWriter& writer)
+    {
+    writer.array(this->m_values);
+    }
+
+  IndexArray m_entities;
+  IndexArray m_names;
+  OffsetArray m_starts;
+  std::vector<V> m_values;
+};
+
+template<>
+void PropertyColumns<std::string>::writeValues(ArchiveWriter& writer)
+{
+  OffsetArray charStarts;
+  std::string chars;
+  charStarts.reserve(this->m_values.size() + 1);
+  for (std::size_t i = 0; i < this->m_values.size(); ++i)
+    {
+    charStarts.push_back(chars.size());
+    chars += this->m_values[i];
+    }
+  charStarts.push_back(chars.size());
+  writer.array(charStarts);
+  writer.array(chars);
+}
+
+/// Gather the tessellations of the entities, to be written as flat arrays.
+class TessellationColumns
+{
+public:
+  TessellationColumns()
+    {
+    this->m_coordStarts.push_back(0);
+    this->m_connStarts.push_back(0);
+    }
+
+  void add(boost::uint32_t entity, const Tessellation& tess)
+    {
+    this->m_entities.push_back(entity);
+    this->m_tessellations.push_back(&tess);
+    this->m_coordStarts.push_back(this->m_coordStarts.back() + tess.coords().size());
+    this->m_connStarts.push_back(this->m_connStarts.back() + tess.conn().size());
+    }
+
+  // Coordinates and connectivity are copied straight from each
+  // tessellation; doubles and 32-bit integers need no padding between
+  // tessellations.
+  void write(ArchiveWriter& writer, BinarySection kind)
+    {
+    writer.beginSection(kind);
+    writer.count(this->m_entities.size());
+    writer.array(this->m_entities);
+    writer.array(this->m_coordStarts);
+    writer.array(this->m_connStarts);
+    std::vector<const Tessellation*>::const_iterator it;
+    for (it = this->m_tessellations.begin(); it != this->m_tessellations.end(); ++it)
+      {
+      const std::vector<double>& coords((*it)->coords());
+      writer.bytes(coords.empty() ? NULL : &coords[0], coords.size() * sizeof(double));
+      }
+    writer.pad();
+    for (it = this->m_tessellations.begin(); it != this->m_tessellations.end(); ++it)
+      {
+      const std::vector<int>& conn((*it)->conn());
+      writer.bytes(conn.empty() ? NULL : &conn[0], conn.size() * sizeof(int));
+      }
+    writer.pad();
+    writer.endSection();
+    }
+
+protected:
+  IndexArray m_entities;
+  std::vector<const Tessellation*> m_tessellations;
+  OffsetArray m_coordStarts;
+  OffsetArray m_connStarts;
+};
+
+}
+
+namespace smtk {
+  namespace io {
+
+/**\brief Write a binary archive of \a modelMgr to \a out.
+  *
+  * Returns 1 on success and 0 if the manager is invalid or a session's
+  * SessionIOBinary delegate fails. The stream need not be seekable.
+  */
+int ExportBinary::fromModelManager(std::ostream& out, ManagerPtr modelMgr)
+{
+  if (!modelMgr)
+    {
+    return 0;
+    }
+
+  int status = 1;
+  UUIDTable uids;
+  NameTable names;
+  IndexArray flags;
+  std::vector<boost::int32_t> dims;
+  OffsetArray relationStarts(1, 0);
+  IndexArray relations;
+  IndexArray arrEntities;
+  IndexArray arrKinds;
+  OffsetArray arrStarts(1, 0);
+  OffsetArray detailStarts(1, 0);
+  std::vector<boost::int32_t> details;
+  TessellationColumns tessellations;
+  TessellationColumns analysisMeshes;
+  PropertyColumns<double> floats;
+  PropertyColumns<std::string> strings;
+  PropertyColumns<boost::int64_t> integers;
+
+  // Entities take the first indices of the UUID table.
+  UUIDWithEntity it;
+  for (it = modelMgr->topology().begin(); it != modelMgr->topology().end(); ++it)
+    {
+    uids.index(it->first);
+    }
+  flags.reserve(modelMgr->topology().size());
+  dims.reserve(modelMgr->topology().size());
+
+  boost::uint32_t entity = 0;
+  for (it = modelMgr->topology().begin(); it != modelMgr->topology().end(); ++it, ++entity)
+    {
+    flags.push_back(it->second.entityFlags());
+    dims.push_back(it->second.dimension());
+    const UUIDArray& rels(it->second.relations());
+    for (UUIDArray::const_iterator rit = rels.begin(); rit != rels.end(); ++rit)
+      {
+      relations.push_back(uids.index(*rit));
+      }
+    relationStarts.push_back(relations.size());
+
+    UUIDWithArrangementDictionary arrIt = modelMgr->arrangements().find(it->first);
+    if (arrIt != modelMgr->arrangements().end())
+      {
+      if (arrIt->second.empty())
+        { // Keep the (empty) dictionary itself.
+        arrEntities.push_back(entity);
+        arrKinds.push_back(static_cast<boost::uint32_t>(KINDS_OF_ARRANGEMENTS));
+        arrStarts.push_back(detailStarts.size() - 1);
+        }
+      ArrangementKindWithArrangements kit;
+      for (kit = arrIt->second.begin(); kit != arrIt->second.end(); ++kit)
+        {
+        arrEntities.push_back(entity);
+        arrKinds.push_back(static_cast<boost::uint32_t>(kit->first));
+        Arrangements::const_iterator ait;
+        for (ait = kit->second.begin(); ait != kit->second.end(); ++ait)
+          {
+          details.insert(details.end(), ait->details().begin(), ait->details().end());
+          detailStarts.push_back(details.size());
+          }
+        arrStarts.push_back(detailStarts.size() - 1);
+        }
+      }
+
+    UUIDWithTessellation tessIt = modelMgr->tessellations().find(it->first);
+    if (tessIt != modelMgr->tessellations().end())
+      {
+      tessellations.add(entity, tessIt->second);
+      }
+    tessIt = modelMgr->analysisMesh().find(it->first);
+    if (tessIt != modelMgr->analysisMesh().end())
+      {
+      analysisMeshes.add(entity, tessIt->second);
+      }
+
+    UUIDWithFloatProperties fit = modelMgr->floatProperties().find(it->first);
+    if (fit != modelMgr->floatProperties().end())
+      {
+      floats.add(entity, fit->second.begin(), fit->second.end(), names);
+      }
+    UUIDWithStringProperties sit = modelMgr->stringProperties().find(it->first);
+    if (sit != modelMgr->stringProperties().end())
+      {
+      strings.add(entity, sit->second.begin(), sit->second.end(), names);
+      }
+    UUIDWithIntegerProperties iit = modelMgr->integerProperties().find(it->first);
+    if (iit != modelMgr->integerProperties().end())
+      {
+      integers.add(entity, iit->second.begin(), iit->second.end(), names);
+      }
+    }
+
+  // Ask each session for the data its delegate wants to keep.
+  IndexArray sessionEntities;
+  OffsetArray sessionNameStarts(1, 0);
+  std::string sessionNames;
+  OffsetArray sessionDataStarts(1, 0);
+  std::string sessionData;
+  SessionRefs sessions = modelMgr->sessions();
+  for (SessionRefs::iterator bit = sessions.begin(); bit != sessions.end(); ++bit)
+    {
+    SessionPtr session = bit->session();
+    if (!session)
+      {
+      continue;
+      }
+    sessionEntities.push_back(uids.index(bit->entity()));
+    sessionNames += session->name();
+    sessionNameStarts.push_back(sessionNames.size());
+    SessionIOBinaryPtr delegate =
+      smtk::dynamic_pointer_cast<SessionIOBinary>(
+        session->createIODelegate("binary"));
+    if (delegate)
+      {
+      std::string data;
+      status &= delegate->exportBinary(modelMgr, data);
+      sessionData += data;
+      }
+    sessionDataStarts.push_back(sessionData.size());
+    }
+
+  ArchiveWriter writer(out);
+  writer.header();
+  uids.write(writer);
+
+  writer.beginSection(BINARY_ENTITIES);
+  writer.count(flags.size());
+  writer.array(flags);
+  writer.array(dims);
+  writer.endSection();
+
+  writer.beginSection(BINARY_RELATIONS);
+  writer.count(relations.size());
+  writer.array(relationStarts);
+  writer.array(relations);
+  writer.endSection();
+
+  writer.beginSection(BINARY_ARRANGEMENTS);
+  writer.count(arrEntities.size());
+  writer.count(details.size());
+  writer.array(arrEntities);
+  writer.array(arrKinds);
+  writer.array(arrStarts);
+  writer.array(detailStarts);
+  writer.array(details);
+  writer.endSection();
+
+  tessellations.write(writer, BINARY_TESSELLATIONS);
+  analysisMeshes.write(writer, BINARY_ANALYSISMESH);
+
+  names.write(writer);
+  floats.write(writer, BINARY_FLOAT_PROPERTIES);
+  strings.write(writer, BINARY_STRING_PROPERTIES);
+  integers.write(writer, BINARY_INTEGER_PROPERTIES);
+
+  writer.beginSection(BINARY_SESSIONS);
+  writer.count(sessionEntities.size());
+  writer.array(sessionEntities);
+  writer.array(sessionNameStarts);
+  writer.array(sessionNames);
+  writer.array(sessionDataStarts);
+  writer.array(sessionData);
+  writer.endSection();
+
+  writer.trailer();
+  return out.good() ? status : 0;
+}
+
+/// Write a binary archive of \a modelMgr to the file named \a filename.
+bool ExportBinary::fromModelManagerToFile(ManagerPtr modelMgr, const char* filename)
+{
+  if (!filename || !modelMgr)
+    return false;
+
+  std::ofstream file(filename, std::ios::out | std::ios::binary);
+  return ExportBinary::fromModelManager(file, modelMgr) && file.good();
+}
+
+  } // namespace io
+} // namespace smtk
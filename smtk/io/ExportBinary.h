@@ -0,0 +1,69 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_io_ExportBinary_h
+#define __smtk_io_ExportBinary_h
+
+#include "smtk/CoreExports.h" // For SMTKCORE_EXPORT macro.
+#include "smtk/PublicPointerDefs.h"
+
+#include <iosfwd>
+
+namespace smtk {
+  namespace io {
+
+/**\brief Sections of a binary model archive.
+  *
+  * An archive starts with a 16-byte header: the 8 bytes "SMTKARCH",
+  * a 32-bit format version and the 32-bit value 0x01020304 written
+  * in the byte order of the machine that wrote it.
+  * Sections follow, each starting on an 8-byte boundary.
+  * The archive ends with a table holding the kind, offset and size
+  * of each section, followed by the offset of the table, the number
+  * of sections and "SMTKARCH" again.
+  *
+  * Sections are made of 64-bit counts and arrays of fixed-size values.
+  * Every array is padded to a multiple of 8 bytes, so arrays of
+  * doubles (like tessellation coordinates) are aligned and may be
+  * used in place when the archive is memory-mapped.
+  * Entities are referred to by their index in the UUID table.
+  */
+enum BinarySection
+{
+  BINARY_UUIDS              = 1, //!< Every UUID in the archive, entities first.
+  BINARY_ENTITIES           = 2, //!< Entity flags and dimensions.
+  BINARY_RELATIONS          = 3, //!< Per-entity offsets into an array of UUID indices.
+  BINARY_ARRANGEMENTS       = 4, //!< Arrangements grouped by entity and kind.
+  BINARY_TESSELLATIONS      = 5, //!< Raw tessellation coordinates and connectivity.
+  BINARY_ANALYSISMESH       = 6, //!< Raw analysis mesh coordinates and connectivity.
+  BINARY_PROPERTY_NAMES     = 7, //!< The interned names of all properties.
+  BINARY_FLOAT_PROPERTIES   = 8, //!< Float property values.
+  BINARY_STRING_PROPERTIES  = 9, //!< String property values.
+  BINARY_INTEGER_PROPERTIES = 10, //!< Integer property values, as 64-bit integers.
+  BINARY_SESSIONS           = 11  //!< Session names and the data of their SessionIOBinary delegates.
+};
+
+/**\brief Export an SMTK model manager into a binary archive.
+  *
+  * The archive holds the same information as the JSON written by
+  * ExportJSON except for mesh collections, but UUIDs, numbers and
+  * tessellations are stored as raw binary arrays.
+  * Use ImportBinary to read it.
+  */
+class SMTKCORE_EXPORT ExportBinary
+{
+public:
+  static int fromModelManager(std::ostream& out, smtk::model::ManagerPtr modelMgr);
+  static bool fromModelManagerToFile(smtk::model::ManagerPtr modelMgr, const char* filename);
+};
+
+  } // namespace io
+} // namespace smtk
+
+#endif // __smtk_io_ExportBinary_h
@@ -10,6 +10,7 @@
 #include "smtk/io/ExportJSON.h"
 #include "smtk/io/ExportJSON.txx"
 
+#include "smtk/common/Parallel.h"
 #include "smtk/common/Version.h"
 
 #include "smtk/model/SessionRegistrar.h"
@@ -35,8 +36,16 @@
 
 #include "cJSON.h"
 
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
 #include <stdlib.h> // for free()
 
 using namespace smtk::io;
@@ -141,6 +150,666 @@ namespace {
       }
     return a;
     }
+
+  // Property dictionaries may be held in std::map-like containers
+  // (for meshes) or viewed as rows of a columnar PropertyStore (for
+  // model entities); these accept an iterator range over either.
+  template<typename I>
+  int cJSON_AddFloatProperties(cJSON* dict, I begin, I end)
+    {
+    cJSON* pdict = cJSON_CreateObject();
+    cJSON_AddItemToObject(dict, "f", pdict);
+    for (I entry = begin; entry != end; ++entry)
+      {
+      if (entry->second.empty())
+        {
+        continue;
+        }
+      cJSON_AddItemToObject(pdict, entry->first.c_str(),
+        cJSON_CreateDoubleArray(
+          &entry->second[0], static_cast<int>(entry->second.size())));
+      }
+    return 1;
+    }
+
+  template<typename I>
+  int cJSON_AddStringProperties(cJSON* dict, I begin, I end)
+    {
+    cJSON* pdict = cJSON_CreateObject();
+    cJSON_AddItemToObject(dict, "s", pdict);
+    for (I entry = begin; entry != end; ++entry)
+      {
+      if (entry->second.empty())
+        {
+        continue;
+        }
+      cJSON_AddItemToObject(pdict, entry->first.c_str(),
+        cJSON_CreateStringArray(
+          &entry->second[0], static_cast<unsigned int>(entry->second.size())));
+      }
+    return 1;
+    }
+
+  template<typename I>
+  int cJSON_AddIntegerProperties(cJSON* dict, I begin, I end)
+    {
+    cJSON* pdict = cJSON_CreateObject();
+    cJSON_AddItemToObject(dict, "i", pdict);
+    for (I entry = begin; entry != end; ++entry)
+      {
+      if (entry->second.empty())
+        {
+        continue;
+        }
+      cJSON_AddItemToObject(pdict, entry->first.c_str(),
+        cJSON_CreateLongArray(
+          &entry->second[0], static_cast<unsigned int>(entry->second.size())));
+      }
+    return 1;
+    }
+}
+
+// A writer that prints JSON straight to a stream, in exactly the format
+// cJSON_Print would give the equivalent cJSON tree, without building the
+// tree. Output is collected in a buffer that is handed to the stream
+// whenever it grows past a threshold, so whole models can be written in
+// bounded memory.
+namespace {
+
+class JSONStreamWriter
+{
+public:
+  // When \a out is NULL, output accumulates in buffer() until the caller
+  // takes it. \a depth is the nesting depth of the first value written,
+  // for values that are spliced into an enclosing document.
+  JSONStreamWriter(std::ostream* out, int depth = 0)
+    : m_out(out), m_baseDepth(depth)
+    {
+    }
+
+  ~JSONStreamWriter()
+    {
+    this->flush();
+    }
+
+  void beginObject()
+    {
+    this->beginValue();
+    Level level = { true, this->nextDepth(), 0 };
+    this->m_buffer += '{';
+    this->m_levels.push_back(level);
+    }
+
+  void endObject()
+    {
+    const Level& level(this->m_levels.back());
+    // cJSON indents the brace of an empty object one level less.
+    this->m_buffer += '\n';
+    this->indent(level.count ? level.depth : level.depth - 1);
+    this->m_buffer += '}';
+    this->m_levels.pop_back();
+    this->flushIfFull();
+    }
+
+  void beginArray()
+    {
+    this->beginValue();
+    Level level = { false, this->nextDepth(), 0 };
+    this->m_buffer += '[';
+    this->m_levels.push_back(level);
+    }
+
+  void endArray()
+    {
+    this->m_buffer += ']';
+    this->m_levels.pop_back();
+    this->flushIfFull();
+    }
+
+  // Continue an object that another writer has started, at \a depth and
+  // with \a count members already written, so that a run of its members
+  // can be encoded separately. Call suspendObject() after the run.
+  void resumeObject(int depth, std::size_t count)
+    {
+    Level level = { true, depth, count };
+    this->m_levels.push_back(level);
+    }
+
+  void suspendObject()
+    {
+    this->m_levels.pop_back();
+    }
+
+  // Append \a count members of the open object that were encoded by
+  // another writer.
+  void appendMembers(const std::string& encoded, std::size_t count)
+    {
+    this->m_buffer += encoded;
+    this->m_levels.back().count += count;
+    this->flushIfFull();
+    }
+
+  std::size_t memberCount() const
+    {
+    return this->m_levels.back().count;
+    }
+
+  // The nesting depth of the open object or array.
+  int currentDepth() const
+    {
+    return this->m_levels.back().depth;
+    }
+
+  void key(const std::string& name)
+    {
+    Level& level(this->m_levels.back());
+    this->m_buffer += level.count++ ? ",\n" : "\n";
+    this->indent(level.depth + 1);
+    this->appendString(name.c_str());
+    this->m_buffer += ":\t";
+    }
+
+  void value(double number)
+    {
+    this->beginValue();
+    char digits[64];
+    this->m_buffer.append(digits, formatNumber(number, digits));
+    }
+
+  void value(int number)
+    {
+    this->beginValue();
+    char digits[24];
+    this->m_buffer.append(digits, formatInteger(number, digits));
+    }
+
+  void value(const std::string& text)
+    {
+    this->beginValue();
+    this->appendString(text.c_str());
+    }
+
+  // Print a cJSON tree as cJSON_Print would at this position.
+  void value(cJSON* node)
+    {
+    switch (node->type & 255)
+      {
+    case cJSON_NULL: this->beginValue(); this->m_buffer += "null"; break;
+    case cJSON_False: this->beginValue(); this->m_buffer += "false"; break;
+    case cJSON_True: this->beginValue(); this->m_buffer += "true"; break;
+    case cJSON_Number:
+        {
+        this->beginValue();
+        char digits[64];
+        this->m_buffer.append(digits,
+          formatNumber(node->valuedouble, node->valueint, digits));
+        }
+      break;
+    case cJSON_String:
+      this->beginValue();
+      this->appendString(node->valuestring);
+      break;
+    case cJSON_Array:
+      this->beginArray();
+      for (cJSON* child = node->child; child; child = child->next)
+        this->value(child);
+      this->endArray();
+      break;
+    case cJSON_Object:
+      this->beginObject();
+      this->members(node);
+      this->endObject();
+      break;
+    default:
+      break;
+      }
+    }
+
+  // Print the members of a cJSON object as members of the open object.
+  void members(cJSON* node)
+    {
+    for (cJSON* child = node->child; child; child = child->next)
+      {
+      this->key(child->string ? child->string : "");
+      this->value(child);
+      }
+    }
+
+  template<typename T>
+  void array(const std::vector<T>& values)
+    {
+    this->beginArray();
+    typename std::vector<T>::const_iterator it;
+    for (it = values.begin(); it != values.end(); ++it)
+      this->value(*it);
+    this->endArray();
+    }
+
+  void array(const std::vector<long>& values)
+    {
+    this->beginArray();
+    for (std::size_t i = 0; i < values.size(); ++i)
+      {
+      if (values[i] > 9007199254740991.0) //== 2^53 - 1, max integer-accurate double
+        {
+        std::cerr << "Error exporting array: integer value " << i << " (" << values[i] << ") out of range for cJSON\n";
+        }
+      this->value(static_cast<double>(values[i]));
+      }
+    this->endArray();
+    }
+
+  void array(const std::vector<smtk::common::UUID>& values)
+    {
+    this->beginArray();
+    std::vector<smtk::common::UUID>::const_iterator it;
+    for (it = values.begin(); it != values.end(); ++it)
+      this->value(it->toString());
+    this->endArray();
+    }
+
+  std::string& buffer()
+    {
+    return this->m_buffer;
+    }
+
+  void flush()
+    {
+    if (this->m_out && !this->m_buffer.empty())
+      {
+      this->m_out->write(this->m_buffer.data(), this->m_buffer.size());
+      this->m_buffer.clear();
+      }
+    }
+
+  // Format a number as cJSON's print_number does, where \a valueint is
+  // the truncated integer cJSON keeps alongside each number. Integers and
+  // the usual "%f" case are formatted by hand; the rest use sprintf.
+  static std::size_t formatNumber(double d, int valueint, char* digits)
+    {
+    if (fabs(static_cast<double>(valueint) - d) <= DBL_EPSILON && d <= INT_MAX && d >= INT_MIN)
+      {
+      return formatInteger(valueint, digits);
+      }
+    if (fabs(floor(d) - d) <= DBL_EPSILON && fabs(d) < 1.0e60)
+      {
+      if (fabs(d) < 9.0e18)
+        {
+        return formatInteger(static_cast<boost::int64_t>(d), digits);
+        }
+      return static_cast<std::size_t>(sprintf(digits, "%.0f", d));
+      }
+    if (fabs(d) < 1.0e-6 || fabs(d) > 1.0e9)
+      {
+      return static_cast<std::size_t>(sprintf(digits, "%e", d));
+      }
+    // Scaling by 10^6 is off by at most half a unit in the last place, so
+    // rounding to 6 decimals matches sprintf except near a tie.
+    double scaled = fabs(d) * 1.0e6;
+    double whole = floor(scaled);
+    double frac = scaled - whole;
+    if (!(fabs(frac - 0.5) > scaled * 4.0e-16))
+      {
+      return static_cast<std::size_t>(sprintf(digits, "%f", d));
+      }
+    boost::uint64_t rounded = static_cast<boost::uint64_t>(whole) + (frac > 0.5 ? 1 : 0);
+    char* end = digits;
+    if (d < 0)
+      *end++ = '-';
+    end += formatInteger(static_cast<boost::int64_t>(rounded / 1000000), end);
+    *end++ = '.';
+    boost::uint64_t decimals = rounded % 1000000;
+    for (int i = 5; i >= 0; --i, decimals /= 10)
+      end[i] = static_cast<char>('0' + decimals % 10);
+    end += 6;
+    *end = '\0';
+    return static_cast<std::size_t>(end - digits);
+    }
+
+  static std::size_t formatNumber(double d, char* digits)
+    {
+    // cJSON_CreateNumber keeps (int)d, which only matters in range.
+    int valueint = (d <= INT_MAX && d >= INT_MIN) ? static_cast<int>(d) : INT_MIN;
+    return formatNumber(d, valueint, digits);
+    }
+
+  static std::size_t formatInteger(boost::int64_t number, char* digits)
+    {
+    char reversed[24];
+    std::size_t len = 0;
+    boost::uint64_t magnitude = number < 0 ?
+      static_cast<boost::uint64_t>(-(number + 1)) + 1 :
+      static_cast<boost::uint64_t>(number);
+    do
+      {
+      reversed[len++] = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+      }
+    while (magnitude);
+    std::size_t pos = 0;
+    if (number < 0)
+      digits[pos++] = '-';
+    while (len)
+      digits[pos++] = reversed[--len];
+    digits[pos] = '\0';
+    return pos;
+    }
+
+protected:
+  struct Level
+    {
+    bool isObject;
+    int depth;
+    std::size_t count;
+    };
+
+  int nextDepth() const
+    {
+    return this->m_levels.empty() ? this->m_baseDepth : this->m_levels.back().depth + 1;
+    }
+
+  // Array elements are separated here; object members by key().
+  void beginValue()
+    {
+    if (!this->m_levels.empty() && !this->m_levels.back().isObject)
+      {
+      if (this->m_levels.back().count++)
+        this->m_buffer += ", ";
+      }
+    }
+
+  void indent(int depth)
+    {
+    if (depth > 0)
+      this->m_buffer.append(static_cast<std::size_t>(depth), '\t');
+    }
+
+  // Escape a string as cJSON's print_string_ptr does.
+  void appendString(const char* str)
+    {
+    if (!str)
+      return;
+    static const char hex[] = "0123456789abcdef";
+    this->m_buffer += '\"';
+    const char* run = str;
+    for (const char* ptr = str; ; ++ptr)
+      {
+      unsigned char token = static_cast<unsigned char>(*ptr);
+      if (token > 31 && token != '\"' && token != '\\')
+        continue;
+      this->m_buffer.append(run, ptr);
+      if (!token)
+        break;
+      run = ptr + 1;
+      this->m_buffer += '\\';
+      switch (token)
+        {
+      case '\\': this->m_buffer += '\\'; break;
+      case '\"': this->m_buffer += '\"'; break;
+      case '\b': this->m_buffer += 'b'; break;
+      case '\f': this->m_buffer += 'f'; break;
+      case '\n': this->m_buffer += 'n'; break;
+      case '\r': this->m_buffer += 'r'; break;
+      case '\t': this->m_buffer += 't'; break;
+      default:
+        this->m_buffer += "u00";
+        this->m_buffer += hex[token >> 4];
+        this->m_buffer += hex[token & 0xf];
+        break;
+        }
+      }
+    this->m_buffer += '\"';
+    }
+
+  void flushIfFull()
+    {
+    if (this->m_buffer.size() >= 65536)
+      this->flush();
+    }
+
+  std::ostream* m_out;
+  int m_baseDepth;
+  std::vector<Level> m_levels;
+  std::string m_buffer;
+};
+
+template<typename I>
+void writeProperties(JSONStreamWriter& writer, const char* kind, I begin, I end)
+{
+  writer.key(kind);
+  writer.beginObject();
+  for (I entry = begin; entry != end; ++entry)
+    {
+    if (entry->second.empty())
+      {
+      continue;
+      }
+    writer.key(entry->first);
+    writer.array(entry->second);
+    }
+  writer.endObject();
+}
+
+void writeTessellation(JSONStreamWriter& writer, const char* kind, const Tessellation& tess)
+{
+  writer.key(kind);
+  writer.beginObject();
+  writer.key("metadata");
+  writer.beginObject();
+  writer.key("formatVersion");
+  writer.value(3);
+  writer.endObject();
+  writer.key("vertices");
+  writer.array(tess.coords());
+  writer.key("faces");
+  writer.array(tess.conn());
+  writer.endObject();
+}
+
+// Write the record of one entity as ExportJSON::forManager would build
+// it, as the value of a member of the open "topo" object.
+int writeEntityRecord(
+  JSONStreamWriter& writer, UUIDWithEntity& it, ManagerPtr modelMgr, JSONFlags sections)
+{
+  writer.beginObject();
+  if (sections & JSON_ENTITIES)
+    {
+    writer.key("e");
+    writer.value(static_cast<double>(it->second.entityFlags()));
+    writer.key("d");
+    writer.value(it->second.dimension());
+    if (!it->second.relations().empty())
+      {
+      writer.key("r");
+      writer.array(it->second.relations());
+      }
+    UUIDWithArrangementDictionary arrIt = modelMgr->arrangements().find(it->first);
+    if (arrIt != modelMgr->arrangements().end())
+      {
+      writer.key("a");
+      writer.beginObject();
+      ArrangementKindWithArrangements kit;
+      for (kit = arrIt->second.begin(); kit != arrIt->second.end(); ++kit)
+        {
+        Arrangements& arr(kit->second);
+        if (arr.empty())
+          {
+          continue;
+          }
+        writer.key(smtk::model::AbbreviationForArrangementKind(kit->first));
+        writer.beginArray();
+        Arrangements::iterator ait;
+        for (ait = arr.begin(); ait != arr.end(); ++ait)
+          {
+          if (!ait->details().empty())
+            {
+            writer.array(ait->details());
+            }
+          }
+        writer.endArray();
+        }
+      writer.endObject();
+      }
+    }
+  if (sections & JSON_TESSELLATIONS)
+    {
+    UUIDWithTessellation tessIt = modelMgr->tessellations().find(it->first);
+    if (tessIt != modelMgr->tessellations().end() && !tessIt->second.coords().empty())
+      {
+      writeTessellation(writer, "t", tessIt->second);
+      }
+    }
+  if (sections & JSON_ANALYSISMESH)
+    {
+    UUIDWithTessellation meshIt = modelMgr->analysisMesh().find(it->first);
+    if (meshIt != modelMgr->analysisMesh().end() && !meshIt->second.coords().empty())
+      {
+      writeTessellation(writer, "m", meshIt->second);
+      }
+    }
+  if (sections & JSON_PROPERTIES)
+    {
+    UUIDWithFloatProperties fit = modelMgr->floatProperties().find(it->first);
+    if (fit != modelMgr->floatProperties().end() && !fit->second.empty())
+      {
+      writeProperties(writer, "f", fit->second.begin(), fit->second.end());
+      }
+    UUIDWithStringProperties sit = modelMgr->stringProperties().find(it->first);
+    if (sit != modelMgr->stringProperties().end() && !sit->second.empty())
+      {
+      writeProperties(writer, "s", sit->second.begin(), sit->second.end());
+      }
+    UUIDWithIntegerProperties iit = modelMgr->integerProperties().find(it->first);
+    if (iit != modelMgr->integerProperties().end() && !iit->second.empty())
+      {
+      writeProperties(writer, "i", iit->second.begin(), iit->second.end());
+      }
+    }
+  writer.endObject();
+  return 1;
+}
+
+// Encodes runs of entity records, each into its own buffer, as members
+// of the "topo" object.
+class EncodeRecords : public smtk::common::ParallelTask
+{
+public:
+  EncodeRecords(
+    std::vector<UUIDWithEntity>& records,
+    const std::vector<std::size_t>& bounds,
+    int depth,
+    std::size_t membersBefore,
+    ManagerPtr modelMgr,
+    JSONFlags sections,
+    std::vector<std::string>& encoded,
+    std::vector<int>& status)
+    : m_records(records), m_bounds(bounds), m_depth(depth), m_membersBefore(membersBefore),
+    m_modelMgr(modelMgr), m_sections(sections), m_encoded(encoded), m_status(status)
+    {
+    }
+
+  void execute(std::size_t piece)
+    {
+    JSONStreamWriter writer(NULL);
+    writer.resumeObject(this->m_depth, this->m_membersBefore + this->m_bounds[piece]);
+    int status = 1;
+    for (std::size_t i = this->m_bounds[piece]; i < this->m_bounds[piece + 1]; ++i)
+      {
+      writer.key(this->m_records[i]->first.toString());
+      status &= writeEntityRecord(writer, this->m_records[i], this->m_modelMgr, this->m_sections);
+      }
+    writer.suspendObject();
+    this->m_encoded[piece].swap(writer.buffer());
+    this->m_status[piece] = status;
+    }
+
+protected:
+  std::vector<UUIDWithEntity>& m_records;
+  const std::vector<std::size_t>& m_bounds;
+  int m_depth;
+  std::size_t m_membersBefore;
+  ManagerPtr m_modelMgr;
+  JSONFlags m_sections;
+  std::vector<std::string>& m_encoded;
+  std::vector<int>& m_status;
+};
+
+// Write the records of the manager's entities as members of the open
+// "topo" object. With more than one thread, the records are taken
+// a batch at a time, each batch is split into runs that are encoded in
+// parallel, and the runs are appended in order. Batches keep the memory
+// held by encoded text bounded.
+int writeEntityRecords(
+  JSONStreamWriter& writer, ManagerPtr modelMgr, JSONFlags sections)
+{
+  int status = 1;
+  UUIDWithEntity it = modelMgr->topology().begin();
+  UUIDWithEntity end = modelMgr->topology().end();
+  const std::size_t numThreads = smtk::common::Parallel::numberOfThreads();
+  if (numThreads <= 1)
+    {
+    for (; it != end; ++it)
+      {
+      if ((it->second.entityFlags() & SESSION) && !(sections & JSON_SESSIONS))
+        continue;
+
+      writer.key(it->first.toString());
+      status &= writeEntityRecord(writer, it, modelMgr, sections);
+      }
+    return status;
+    }
+
+  const std::size_t numPieces = 4 * numThreads;
+  const std::size_t batchSize = 64 * numPieces;
+  std::vector<UUIDWithEntity> records;
+  std::vector<std::size_t> bounds;
+  std::vector<std::string> encoded;
+  std::vector<int> pieceStatus;
+  records.reserve(batchSize);
+  while (it != end)
+    {
+    records.clear();
+    for (; it != end && records.size() < batchSize; ++it)
+      {
+      if ((it->second.entityFlags() & SESSION) && !(sections & JSON_SESSIONS))
+        continue;
+
+      records.push_back(it);
+      }
+    if (records.empty())
+      {
+      break;
+      }
+
+    std::size_t batchPieces = std::min(numPieces, records.size());
+    bounds.resize(batchPieces + 1);
+    for (std::size_t i = 0; i <= batchPieces; ++i)
+      {
+      bounds[i] = (records.size() * i) / batchPieces;
+      }
+    encoded.assign(batchPieces, std::string());
+    pieceStatus.assign(batchPieces, 1);
+    EncodeRecords encoder(
+      records, bounds, writer.currentDepth(), writer.memberCount(), modelMgr, sections, encoded, pieceStatus);
+    smtk::common::Parallel::forEach(batchPieces, encoder);
+
+    for (std::size_t i = 0; i < batchPieces; ++i)
+      {
+      writer.appendMembers(encoded[i], bounds[i + 1] - bounds[i]);
+      status &= pieceStatus[i];
+      }
+    }
+  return status;
+}
+
+// Write the members a cJSON-building function adds to \a node into the
+// open object, then free them.
+void writeMembers(JSONStreamWriter& writer, cJSON* node)
+{
+  writer.members(node);
+  cJSON_Delete(node);
+}
+
 }
 
 namespace smtk {
@@ -199,13 +868,9 @@ int ExportJSON::fromModelManager(cJSON* json, ManagerPtr modelMgr, JSONFlags sec
 
 std::string ExportJSON::fromModelManager(ManagerPtr modelMgr, JSONFlags sections)
 {
-  cJSON* top = cJSON_CreateObject();
-  ExportJSON::fromModelManager(top, modelMgr, sections);
-  char* json = cJSON_Print(top);
-  std::string result(json);
-  free(json);
-  cJSON_Delete(top);
-  return result;
+  std::ostringstream result;
+  ExportJSON::fromModelManagerToStream(result, modelMgr, sections);
+  return result.str();
 }
 
 bool ExportJSON::fromModelManagerToFile(smtk::model::ManagerPtr modelMgr, const char* filename)
@@ -214,8 +879,77 @@ bool ExportJSON::fromModelManagerToFile(smtk::model::ManagerPtr modelMgr, const
     return false;
 
   std::ofstream file(filename);
-  file << ExportJSON::fromModelManager(modelMgr, JSON_DEFAULT);
-  return true;
+  ExportJSON::fromModelManagerToStream(file, modelMgr, JSON_DEFAULT);
+  return file.good();
+}
+
+/**\brief Write the JSON for a model manager straight to a stream.
+  *
+  * The output is identical to printing the tree that fromModelManager
+  * builds with cJSON_Print, but entity records are written as the
+  * manager's storage is walked, so memory use does not grow with the
+  * size of the model. When more than one thread is available, runs of
+  * entity records are encoded in parallel and written in order.
+  * Sessions and mesh collections are still built as cJSON trees, one
+  * at a time.
+  *
+  * Pass a \a depth greater than 0 to indent the output for use as the
+  * value of a member that is that deep in an enclosing document.
+  */
+int ExportJSON::fromModelManagerToStream(
+  std::ostream& out, ManagerPtr modelMgr, JSONFlags sections, int depth)
+{
+  JSONStreamWriter writer(&out, depth);
+  writer.beginObject();
+  if (!modelMgr)
+    {
+    std::cerr << "Invalid arguments.\n";
+    writer.endObject();
+    return 0;
+    }
+
+  int status = 1;
+  writer.key("topo");
+  writer.beginObject();
+  if (sections != JSON_NOTHING)
+    {
+    status &= writeEntityRecords(writer, modelMgr, sections);
+    }
+  writer.endObject();
+
+  writer.key("sessions");
+  writer.beginObject();
+  if (sections & JSON_SESSIONS)
+    {
+    smtk::model::SessionRefs sessions = modelMgr->sessions();
+    for (smtk::model::SessionRefs::iterator bit = sessions.begin(); bit != sessions.end(); ++bit)
+      {
+      cJSON* sess = cJSON_CreateObject();
+      status &= ExportJSON::forManagerSession(bit->entity(), sess, modelMgr);
+      writeMembers(writer, sess);
+      }
+    }
+  writer.endObject();
+
+  writer.key("mesh_collections");
+  writer.beginObject();
+  if (sections & JSON_MESHES)
+    {
+    smtk::mesh::ManagerPtr meshes = modelMgr->meshes();
+    typedef smtk::mesh::Manager::const_iterator cit;
+    for (cit it = meshes->collectionBegin(); it != meshes->collectionEnd(); ++it)
+      {
+      cJSON* mesh = cJSON_CreateObject();
+      status &= ExportJSON::forSingleCollection(mesh, it->second, sections);
+      writeMembers(writer, mesh);
+      }
+    }
+  writer.endObject();
+
+  writer.key("type");
+  writer.value(std::string("Manager"));
+  writer.endObject();
+  return status;
 }
 
 int ExportJSON::forManager(
@@ -271,7 +1005,7 @@ int ExportJSON::forManager(
   if (sections & JSON_MESHES)
     {
     smtk::mesh::ManagerPtr meshPtr = modelMgr->meshes();
-    status &= ExportJSON::forManagerMeshes(meshPtr, mesh, modelMgr);
+    status &= ExportJSON::forManagerMeshes(meshPtr, mesh, modelMgr, sections);
     }
   return status;
 }
@@ -401,56 +1135,32 @@ int ExportJSON::forManagerAnalysis(
 
 int ExportJSON::forFloatData(cJSON* dict, const FloatData& fdata)
 {
-  cJSON* pdict = cJSON_CreateObject();
-  cJSON_AddItemToObject(dict, "f", pdict);
-  PropertyNameWithConstFloats entry;
-  for (entry = fdata.begin(); entry != fdata.end(); ++entry)
-    {
-    if (entry->second.empty())
-      {
-      continue;
-      }
-    cJSON_AddItemToObject(pdict, entry->first.c_str(),
-      cJSON_CreateDoubleArray(
-        &entry->second[0], static_cast<int>(entry->second.size())));
-    }
-  return 1;
+  return cJSON_AddFloatProperties(dict, fdata.begin(), fdata.end());
+}
+
+int ExportJSON::forFloatData(cJSON* dict, const ConstFloatProperties& fdata)
+{
+  return cJSON_AddFloatProperties(dict, fdata.begin(), fdata.end());
 }
 
 int ExportJSON::forStringData(cJSON* dict, const StringData& sdata)
 {
-  cJSON* pdict = cJSON_CreateObject();
-  cJSON_AddItemToObject(dict, "s", pdict);
-  PropertyNameWithConstStrings entry;
-  for (entry = sdata.begin(); entry != sdata.end(); ++entry)
-    {
-    if (entry->second.empty())
-      {
-      continue;
-      }
-    cJSON_AddItemToObject(pdict, entry->first.c_str(),
-      cJSON_CreateStringArray(
-        &entry->second[0], static_cast<unsigned int>(entry->second.size())));
-    }
-  return 1;
+  return cJSON_AddStringProperties(dict, sdata.begin(), sdata.end());
+}
+
+int ExportJSON::forStringData(cJSON* dict, const ConstStringProperties& sdata)
+{
+  return cJSON_AddStringProperties(dict, sdata.begin(), sdata.end());
 }
 
 int ExportJSON::forIntegerData(cJSON* dict, const IntegerData& idata)
 {
-  cJSON* pdict = cJSON_CreateObject();
-  cJSON_AddItemToObject(dict, "i", pdict);
-  PropertyNameWithConstIntegers entry;
-  for (entry = idata.begin(); entry != idata.end(); ++entry)
-    {
-    if (entry->second.empty())
-      {
-      continue;
-      }
-    cJSON_AddItemToObject(pdict, entry->first.c_str(),
-      cJSON_CreateLongArray(
-        &entry->second[0], static_cast<unsigned int>(entry->second.size())));
-    }
-  return 1;
+  return cJSON_AddIntegerProperties(dict, idata.begin(), idata.end());
+}
+
+int ExportJSON::forIntegerData(cJSON* dict, const ConstIntegerProperties& idata)
+{
+  return cJSON_AddIntegerProperties(dict, idata.begin(), idata.end());
 }
 
 int ExportJSON::forManagerFloatProperties(const smtk::common::UUID& uid, cJSON* dict, ManagerPtr model)
@@ -580,7 +1290,13 @@ int ExportJSON::forOperator(smtk::attribute::AttributePtr op, cJSON* entRec)
   return 1;
 }
 
-int ExportJSON::forOperatorResult(OperatorResult res, cJSON* entRec)
+/**\brief Serialize the result of an operator.
+  *
+  * The collections holding meshes the operator created or modified are
+  * written as "mesh_records" using \a sections, so that passing
+  * JSON_COMPACT_HANDLES writes their handle ranges compactly.
+  */
+int ExportJSON::forOperatorResult(OperatorResult res, cJSON* entRec, JSONFlags sections)
 {
   cJSON_AddItemToObject(entRec, "name", cJSON_CreateString(res->type().c_str()));
   cJSON_AddAttributeSpec(entRec, "result", "resultXML", res);
@@ -624,7 +1340,7 @@ int ExportJSON::forOperatorResult(OperatorResult res, cJSON* entRec)
     if(collectionIds.size() > 0)
       {
       cJSON* mesh_records = cJSON_CreateObject();
-      ExportJSON::forMeshes(mesh_records, collectionIds, meshMgr);
+      ExportJSON::forMeshes(mesh_records, collectionIds, meshMgr, sections);
       cJSON_AddItemToObject(entRec, "mesh_records", mesh_records);
       }
     }
@@ -716,7 +1432,8 @@ int ExportJSON::forModelWorker(
 int ExportJSON::forManagerMeshes(
                      smtk::mesh::ManagerPtr meshes,
                      cJSON* mdesc,
-                     smtk::model::ManagerPtr modelMgr)
+                     smtk::model::ManagerPtr modelMgr,
+                     JSONFlags sections)
 {
   (void)modelMgr;
   //current issue is that a mesh Manager needs to know where to write
@@ -736,7 +1453,7 @@ int ExportJSON::forManagerMeshes(
   for (cit it = meshes->collectionBegin();
        it != meshes->collectionEnd(); ++it)
     {
-    status &= forSingleCollection(mdesc, it->second);
+    status &= forSingleCollection(mdesc, it->second, sections);
     }
 
   return status;
@@ -752,7 +1469,8 @@ int ExportJSON::forManagerMeshes(
 int ExportJSON::forMeshes(
                      cJSON* pnode,
                      const smtk::common::UUIDs& collectionIds,
-                     smtk::mesh::ManagerPtr meshMgr)
+                     smtk::mesh::ManagerPtr meshMgr,
+                     JSONFlags sections)
 {
   if (!pnode || pnode->type != cJSON_Object)
     {
@@ -770,7 +1488,7 @@ int ExportJSON::forMeshes(
   smtk::common::UUIDs::const_iterator cit;
   for(cit = collectionIds.begin(); cit != collectionIds.end(); ++cit)
     {
-    status &= forSingleCollection(mesh, meshMgr->collection(*cit));
+    status &= forSingleCollection(mesh, meshMgr->collection(*cit), sections);
     }
 
   return status;
@@ -793,13 +1511,19 @@ void writeIntegerValues( cJSON* parent,
   cJSON_AddItemToObject(parent, name.c_str(), a);
 }
 
+//--------------------------------------------------------------------------
+cJSON* handlesToJSON( smtk::mesh::HandleRange const& values, bool compact )
+{
+  return compact ? smtk::mesh::to_compact_json(values) : smtk::mesh::to_json(values);
+}
+
 //--------------------------------------------------------------------------
 void writeHandleValues( cJSON* parent,
                         smtk::mesh::HandleRange const& values,
-                        std::string name )
+                        std::string name,
+                        bool compact )
 {
-  //need to implement a free method like:
-  cJSON* json = smtk::mesh::to_json(values);
+  cJSON* json = handlesToJSON(values, compact);
   cJSON_AddItemToObject(parent,
                         name.c_str(),
                         json);
@@ -857,10 +1581,11 @@ void writeUUIDValues( cJSON* parent,
 class ForMeshset : public smtk::mesh::MeshForEach
 {
 public:
-  ForMeshset(cJSON* json):
+  ForMeshset(cJSON* json, bool compactHandles):
     smtk::mesh::MeshForEach(),
     m_json(json),
-    m_index(0)
+    m_index(0),
+    m_compactHandles(compactHandles)
   {
   }
 
@@ -878,16 +1603,19 @@ public:
       {
       smtk::mesh::HandleRange meshes = mesh.range();
       //note we uses meshIds, since 'meshes' is used by the actual mesh dict
-      writeHandleValues(parent, meshes, std::string("meshIds") );
+      writeHandleValues(parent, meshes, std::string("meshIds"),
+                        this->m_compactHandles );
       }
 
     if(writeCellAndPoints)
       {
       smtk::mesh::HandleRange cells = mesh.cells().range();
-      writeHandleValues(parent, cells, std::string("cells") );
+      writeHandleValues(parent, cells, std::string("cells"),
+                        this->m_compactHandles );
 
       smtk::mesh::HandleRange points = mesh.points().range();
-      writeHandleValues(parent, points, std::string("points") );
+      writeHandleValues(parent, points, std::string("points"),
+                        this->m_compactHandles );
       }
 
     //list out the domains that this mesheset contains
@@ -976,14 +1704,20 @@ public:
 private:
   cJSON* m_json;
   int m_index;
+  bool m_compactHandles;
 };
 
 }
 /**\brief Serialize a single mesh colelction
   *
+  * When \a sections has JSON_COMPACT_HANDLES set, the handle ranges of
+  * the meshes, cells and points are written as compact strings. Mesh
+  * properties keep the dictionary form, since their values are stored in
+  * the same node as the range.
   */
 int ExportJSON::forSingleCollection(cJSON* mdesc,
-                                    smtk::mesh::CollectionPtr collection)
+                                    smtk::mesh::CollectionPtr collection,
+                                    JSONFlags sections)
 {
   cJSON* jsonCollection = cJSON_CreateObject();
 
@@ -1016,7 +1750,8 @@ int ExportJSON::forSingleCollection(cJSON* mdesc,
 
   ///now to dump everything inside the collection by reusing the class
   //that writes out a single meshset, but instead pass it all meshsets
-  ForMeshset addInfoAboutCollection(jsonCollection);
+  const bool compactHandles = (sections & JSON_COMPACT_HANDLES) != 0;
+  ForMeshset addInfoAboutCollection(jsonCollection, compactHandles);
   const bool writeMeshes = true;
   const bool writeCellAndPoints = false;
   addInfoAboutCollection.write(collection->meshes(), jsonCollection,
@@ -1030,7 +1765,7 @@ int ExportJSON::forSingleCollection(cJSON* mdesc,
   cJSON_AddItemToObject(jsonCollection, "meshes", jsonMeshes);
 
   smtk::mesh::MeshSet meshes = collection->meshes();
-  ForMeshset perMeshExportToJson(jsonMeshes);
+  ForMeshset perMeshExportToJson(jsonMeshes, compactHandles);
   smtk::mesh::for_each(meshes, perMeshExportToJson);
 
   return 1;
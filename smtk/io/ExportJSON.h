@@ -22,6 +22,8 @@
 #  include "cJSON.h"
 #endif // SHIBOKEN_SKIP
 
+#include <iosfwd>
+
 namespace smtk {
   namespace io {
 
@@ -41,6 +43,8 @@ enum JSONFlags
   JSON_ANALYSISMESH  = 0x20, //!< Export tessellations of model-entity entries in the Manager.
   JSON_MESHES        = 0x40, //!< Export smtk::mesh of model-entity entries in the Manager.
 
+  JSON_COMPACT_HANDLES = 0x100, //!< Export smtk::mesh handle ranges with smtk::mesh::to_compact_json; readers accept either form.
+
   JSON_CLIENT_DATA   = 0x07, //!< Export everything but tessellation data to clients.
   JSON_DEFAULT       = 0xff  //!< By default, export everything.
 };
@@ -61,6 +65,7 @@ public:
   static int fromModelManager(cJSON* json, smtk::model::ManagerPtr modelMgr, JSONFlags sections = JSON_DEFAULT);
   static std::string fromModelManager(smtk::model::ManagerPtr modelMgr, JSONFlags sections = JSON_DEFAULT);
   static bool fromModelManagerToFile(smtk::model::ManagerPtr modelMgr, const char* filename);
+  static int fromModelManagerToStream(std::ostream& out, smtk::model::ManagerPtr modelMgr, JSONFlags sections = JSON_DEFAULT, int depth = 0);
 
   template<typename T>
   static int forEntities(
@@ -82,14 +87,14 @@ public:
   static int forManagerFloatProperties(const smtk::common::UUID& uid, cJSON*, smtk::model::ManagerPtr modelMgr);
   static int forManagerStringProperties(const smtk::common::UUID& uid, cJSON*, smtk::model::ManagerPtr modelMgr);
   static int forManagerIntegerProperties(const smtk::common::UUID& uid, cJSON*, smtk::model::ManagerPtr modelMgr);
-  static int forManagerMeshes(smtk::mesh::ManagerPtr meshes, cJSON*, smtk::model::ManagerPtr modelMgr);
+  static int forManagerMeshes(smtk::mesh::ManagerPtr meshes, cJSON*, smtk::model::ManagerPtr modelMgr, JSONFlags sections = JSON_DEFAULT);
   static int forManagerSession(const smtk::common::UUID& uid, cJSON*, smtk::model::ManagerPtr modelMgr);
   static int forManagerSessionPartial(const smtk::common::UUID& sessionId, const common::UUIDs &modelIds, cJSON*, smtk::model::ManagerPtr modelMgrId);
   //static int forModelOperators(const smtk::common::UUID& uid, cJSON*, smtk::model::ManagerPtr modelMgr);
   static int forOperatorDefinitions(smtk::attribute::System* opSys, cJSON*);
   static int forOperator(smtk::model::OperatorSpecification op, cJSON*);
   static int forOperator(smtk::model::OperatorPtr op, cJSON*);
-  static int forOperatorResult(smtk::model::OperatorResult res, cJSON*);
+  static int forOperatorResult(smtk::model::OperatorResult res, cJSON*, JSONFlags sections = JSON_DEFAULT);
   static int forDanglingEntities(const smtk::common::UUID& sessionId, cJSON* node, smtk::model::ManagerPtr modelMgr);
 
   static int forModelWorker(
@@ -101,13 +106,15 @@ public:
 
   //write out a all the information about a single mesh collection
   static int forSingleCollection(cJSON* mdesc,
-                                 smtk::mesh::CollectionPtr collection);
+                                 smtk::mesh::CollectionPtr collection,
+                                 JSONFlags sections = JSON_DEFAULT);
 
   // Serialize all the smtk::mesh associated with given EntityRefs.
   static int forMeshes(
                      cJSON* pnode,
                      const smtk::common::UUIDs& collectionIds,
-                     smtk::mesh::ManagerPtr meshMgr);
+                     smtk::mesh::ManagerPtr meshMgr,
+                     JSONFlags sections = JSON_DEFAULT);
 
   static int forLog(
     cJSON* logrecordarray,
@@ -132,6 +139,9 @@ public:
   static int forFloatData(cJSON* dict, const smtk::model::FloatData& fdata);
   static int forStringData(cJSON* dict, const smtk::model::StringData& sdata);
   static int forIntegerData(cJSON* dict, const smtk::model::IntegerData& idata);
+  static int forFloatData(cJSON* dict, const smtk::model::ConstFloatProperties& fdata);
+  static int forStringData(cJSON* dict, const smtk::model::ConstStringProperties& sdata);
+  static int forIntegerData(cJSON* dict, const smtk::model::ConstIntegerProperties& idata);
 };
 
   } // namespace model
@@ -0,0 +1,743 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/io/ImportBinary.h"
+
+#include "smtk/io/ExportBinary.h"
+
+#include "smtk/common/UUIDHashMap.h"
+
+#include "smtk/model/Arrangement.h"
+#include "smtk/model/Entity.h"
+#include "smtk/model/Manager.h"
+#include "smtk/model/Session.h"
+#include "smtk/model/SessionIOBinary.h"
+#include "smtk/model/SessionRef.h"
+#include "smtk/model/Tessellation.h"
+
+#include <boost/cstdint.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+using namespace smtk::io;
+using namespace smtk::common;
+using namespace smtk::model;
+
+namespace {
+
+const char ArchiveMagic[] = "SMTKARCH";
+const boost::uint32_t ArchiveVersion = 1;
+const boost::uint32_t ByteOrderMark = 0x01020304;
+const boost::uint64_t HeaderSize = 16;
+const boost::uint64_t TrailerSize = 24;
+const boost::uint64_t TableEntrySize = 24;
+const int NumberOfSections = BINARY_SESSIONS + 1;
+
+/// Read the \a i-th value of type T from an array that may not be aligned.
+template<typename T>
+T readValue(const char* data, std::size_t i = 0)
+{
+  T val;
+  std::memcpy(&val, data + i * sizeof(T), sizeof(T));
+  return val;
+}
+
+/// Copy \a num values of type T starting at \a first into \a values.
+template<typename T>
+void readValues(const char* data, std::size_t first, std::size_t num, std::vector<T>& values)
+{
+  values.resize(num);
+  if (num)
+    {
+    std::memcpy(&values[0], data + first * sizeof(T), num * sizeof(T));
+    }
+}
+
+/// Hand out the counts and arrays of one section, checking that each fits.
+class SectionReader
+{
+public:
+  SectionReader() : m_pos(NULL), m_end(NULL), m_ok(false)
+    {
+    }
+
+  SectionReader(const char* begin, const char* end) : m_pos(begin), m_end(end), m_ok(true)
+    {
+    }
+
+  bool ok() const
+    {
+    return this->m_ok;
+    }
+
+  // Counts are bounded by the size of the section since each counts
+  // values of at least one byte.
+  bool count(std::size_t& num)
+    {
+    const char* raw = this->array<boost::uint64_t>(1);
+    if (!raw)
+      {
+      return false;
+      }
+    boost::uint64_t val = readValue<boost::uint64_t>(raw);
+    if (val > static_cast<boost::uint64_t>(this->m_end - this->m_pos))
+      {
+      this->m_ok = false;
+      return false;
+      }
+    num = static_cast<std::size_t>(val);
+    return true;
+    }
+
+  /// Return the start of an array of \a num values of type T, or NULL.
+  template<typename T>
+  const char* array(boost::uint64_t num)
+    {
+    boost::uint64_t remaining = static_cast<boost::uint64_t>(this->m_end - this->m_pos);
+    if (!this->m_ok || num > remaining / sizeof(T))
+      {
+      this->m_ok = false;
+      return NULL;
+      }
+    boost::uint64_t size = (num * sizeof(T) + 7) & ~static_cast<boost::uint64_t>(7);
+    if (size > remaining)
+      {
+      this->m_ok = false;
+      return NULL;
+      }
+    const char* result = this->m_pos;
+    this->m_pos += size;
+    return result;
+    }
+
+protected:
+  const char* m_pos;
+  const char* m_end;
+  bool m_ok;
+};
+
+/// True when \a num + 1 offsets start at 0 and never decrease; sets \a total to the last.
+bool validStarts(const char* starts, std::size_t num, boost::uint64_t& total)
+{
+  if (!starts || readValue<boost::uint64_t>(starts) != 0)
+    {
+    return false;
+    }
+  boost::uint64_t prev = 0;
+  for (std::size_t i = 1; i <= num; ++i)
+    {
+    boost::uint64_t next = readValue<boost::uint64_t>(starts, i);
+    if (next < prev)
+      {
+      return false;
+      }
+    prev = next;
+    }
+  total = prev;
+  return true;
+}
+
+/// True when all \a num indices are below \a limit.
+bool validIndices(const char* indices, std::size_t num, std::size_t limit)
+{
+  if (!indices)
+    {
+    return false;
+    }
+  for (std::size_t i = 0; i < num; ++i)
+    {
+    if (readValue<boost::uint32_t>(indices, i) >= limit)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+/// Offsets into a list of variable-length runs of type T.
+template<typename T>
+struct Runs
+{
+  Runs() : starts(NULL), values(NULL) { }
+
+  bool read(SectionReader& section, boost::uint64_t num)
+    {
+    boost::uint64_t total = 0;
+    this->starts = num + 1 > num ? section.array<boost::uint64_t>(num + 1) : NULL;
+    if (!validStarts(this->starts, static_cast<std::size_t>(num), total))
+      {
+      return false;
+      }
+    this->values = section.array<T>(total);
+    return this->values != NULL;
+    }
+
+  std::size_t begin(std::size_t i) const
+    {
+    return static_cast<std::size_t>(readValue<boost::uint64_t>(this->starts, i));
+    }
+
+  std::size_t size(std::size_t i) const
+    {
+    return this->begin(i + 1) - this->begin(i);
+    }
+
+  void copy(std::size_t i, std::vector<T>& out) const
+    {
+    readValues(this->values, this->begin(i), this->size(i), out);
+    }
+
+  std::string string(std::size_t i) const
+    {
+    return std::string(this->values + this->begin(i), this->size(i));
+    }
+
+  const char* starts;
+  const char* values;
+};
+
+/// The tessellations or analysis meshes of an archive.
+struct TessellationSection
+{
+  bool read(SectionReader section, std::size_t numEntities)
+    {
+    return
+      section.count(this->num) &&
+      validIndices(this->entities = section.array<boost::uint32_t>(this->num), this->num, numEntities) &&
+      (this->coordStarts = section.array<boost::uint64_t>(this->num + 1)) != NULL &&
+      (this->connStarts = section.array<boost::uint64_t>(this->num + 1)) != NULL &&
+      validStarts(this->coordStarts, this->num, this->numCoords) &&
+      validStarts(this->connStarts, this->num, this->numConn) &&
+      (this->coords = section.array<double>(this->numCoords)) != NULL &&
+      (this->conn = section.array<int>(this->numConn)) != NULL;
+    }
+
+  void apply(const UUIDArray& uids, UUIDsToTessellations& tessellations) const
+    {
+    for (std::size_t i = 0; i < this->num; ++i)
+      {
+      const UUID& uid(uids[readValue<boost::uint32_t>(this->entities, i)]);
+      UUIDsToTessellations::iterator tessIt = tessellations.find(uid);
+      if (tessIt == tessellations.end())
+        {
+        tessIt = tessellations.insert(
+          std::pair<UUID,Tessellation>(uid, Tessellation())).first;
+        }
+      std::size_t first = static_cast<std::size_t>(readValue<boost::uint64_t>(this->coordStarts, i));
+      std::size_t last = static_cast<std::size_t>(readValue<boost::uint64_t>(this->coordStarts, i + 1));
+      readValues(this->coords, first, last - first, tessIt->second.coords());
+      first = static_cast<std::size_t>(readValue<boost::uint64_t>(this->connStarts, i));
+      last = static_cast<std::size_t>(readValue<boost::uint64_t>(this->connStarts, i + 1));
+      readValues(this->conn, first, last - first, tessIt->second.conn());
+      }
+    }
+
+  std::size_t num;
+  const char* entities;
+  const char* coordStarts;
+  const char* connStarts;
+  boost::uint64_t numCoords;
+  boost::uint64_t numConn;
+  const char* coords;
+  const char* conn;
+};
+
+/// One kind of property, stored as runs of values of type T.
+template<typename T>
+struct PropertySection
+{
+  bool read(SectionReader section, std::size_t numEntities, std::size_t numNames)
+    {
+    return
+      section.count(this->num) &&
+      validIndices(this->entities = section.array<boost::uint32_t>(this->num), this->num, numEntities) &&
+      validIndices(this->names = section.array<boost::uint32_t>(this->num), this->num, numNames) &&
+      this->readValues(section) &&
+      section.ok();
+    }
+
+  bool readValues(SectionReader& section)
+    {
+    return this->values.read(section, this->num);
+    }
+
+  boost::uint32_t entity(std::size_t i) const
+    {
+    return readValue<boost::uint32_t>(this->entities, i);
+    }
+
+  boost::uint32_t name(std::size_t i) const
+    {
+    return readValue<boost::uint32_t>(this->names, i);
+    }
+
+  std::size_t num;
+  const char* entities;
+  const char* names;
+  Runs<T> values;
+  Runs<char> chars;
+};
+
+// String values are runs of strings, each a run of characters.
+template<>
+bool PropertySection<std::string>::readValues(SectionReader& section)
+{
+  boost::uint64_t numStrings = 0;
+  this->values.starts = section.array<boost::uint64_t>(this->num + 1);
+  return
+    validStarts(this->values.starts, this->num, numStrings) &&
+    this->chars.read(section, numStrings);
+}
+
+/// Pointers to every section of an archive, checked for consistency.
+class Archive
+{
+public:
+  bool read(const char* data, std::size_t size)
+    {
+    return
+      this->readTable(data, size) &&
+      this->readEntities() &&
+      this->readArrangements() &&
+      this->tessellations.read(this->m_sections[BINARY_TESSELLATIONS], this->numEntities) &&
+      this->analysisMeshes.read(this->m_sections[BINARY_ANALYSISMESH], this->numEntities) &&
+      this->readProperties() &&
+      this->readSessions();
+    }
+
+  std::size_t numUUIDs;
+  const char* uids;
+  std::size_t numEntities;
+  const char* flags;
+  const char* dims;
+  Runs<boost::uint32_t> relations;
+  std::size_t numGroups;
+  const char* arrEntities;
+  const char* arrKinds;
+  const char* arrStarts;
+  Runs<boost::int32_t> details;
+  TessellationSection tessellations;
+  TessellationSection analysisMeshes;
+  std::size_t numNames;
+  Runs<char> names;
+  PropertySection<double> floats;
+  PropertySection<std::string> strings;
+  PropertySection<boost::int64_t> integers;
+  std::size_t numSessions;
+  const char* sessionEntities;
+  Runs<char> sessionNames;
+  Runs<char> sessionData;
+
+protected:
+  bool readTable(const char* data, std::size_t size)
+    {
+    if (!data || size < HeaderSize + TrailerSize ||
+      std::memcmp(data, ArchiveMagic, 8) ||
+      readValue<boost::uint32_t>(data + 8) != ArchiveVersion ||
+      readValue<boost::uint32_t>(data + 12) != ByteOrderMark ||
+      std::memcmp(data + size - 8, ArchiveMagic, 8))
+      {
+      return false;
+      }
+    boost::uint64_t tableOffset = readValue<boost::uint64_t>(data + size - TrailerSize);
+    boost::uint64_t numSections = readValue<boost::uint64_t>(data + size - 16);
+    boost::uint64_t tableEnd = size - TrailerSize;
+    if (tableOffset < HeaderSize || tableOffset > tableEnd ||
+      numSections != (tableEnd - tableOffset) / TableEntrySize ||
+      (tableEnd - tableOffset) % TableEntrySize)
+      {
+      return false;
+      }
+    for (boost::uint64_t i = 0; i < numSections; ++i)
+      {
+      const char* entry = data + tableOffset + i * TableEntrySize;
+      boost::uint32_t kind = readValue<boost::uint32_t>(entry);
+      boost::uint64_t offset = readValue<boost::uint64_t>(entry + 8);
+      boost::uint64_t length = readValue<boost::uint64_t>(entry + 16);
+      if (offset < HeaderSize || offset > tableOffset || length > tableOffset - offset)
+        {
+        return false;
+        }
+      if (kind == 0 || kind >= static_cast<boost::uint32_t>(NumberOfSections))
+        { // Skip sections this version does not know about.
+        continue;
+        }
+      if (this->m_sections[kind].ok())
+        { // Each section may appear only once.
+        return false;
+        }
+      this->m_sections[kind] = SectionReader(data + offset, data + offset + length);
+      }
+    for (int kind = BINARY_UUIDS; kind < NumberOfSections; ++kind)
+      {
+      if (!this->m_sections[kind].ok())
+        {
+        return false;
+        }
+      }
+    return true;
+    }
+
+  bool readEntities()
+    {
+    SectionReader& uidSection(this->m_sections[BINARY_UUIDS]);
+    SectionReader& entitySection(this->m_sections[BINARY_ENTITIES]);
+    SectionReader& relationSection(this->m_sections[BINARY_RELATIONS]);
+    std::size_t numRelations;
+    if (!uidSection.count(this->numUUIDs) ||
+      !(this->uids = uidSection.array<unsigned char>(
+          static_cast<boost::uint64_t>(this->numUUIDs) * UUID::SIZE)) ||
+      !entitySection.count(this->numEntities) ||
+      this->numEntities > this->numUUIDs ||
+      !(this->flags = entitySection.array<boost::uint32_t>(this->numEntities)) ||
+      !(this->dims = entitySection.array<boost::int32_t>(this->numEntities)) ||
+      !relationSection.count(numRelations) ||
+      !this->relations.read(relationSection, this->numEntities) ||
+      this->relations.begin(this->numEntities) != numRelations ||
+      !validIndices(this->relations.values, numRelations, this->numUUIDs))
+      {
+      return false;
+      }
+    return true;
+    }
+
+  bool readArrangements()
+    {
+    SectionReader& section(this->m_sections[BINARY_ARRANGEMENTS]);
+    std::size_t numDetails;
+    boost::uint64_t numArrangements = 0;
+    if (!section.count(this->numGroups) ||
+      !section.count(numDetails) ||
+      !validIndices(this->arrEntities = section.array<boost::uint32_t>(this->numGroups),
+        this->numGroups, this->numEntities) ||
+      !validIndices(this->arrKinds = section.array<boost::uint32_t>(this->numGroups),
+        this->numGroups, KINDS_OF_ARRANGEMENTS + 1) ||
+      !validStarts(this->arrStarts = section.array<boost::uint64_t>(this->numGroups + 1),
+        this->numGroups, numArrangements) ||
+      !this->details.read(section, numArrangements) ||
+      this->details.begin(static_cast<std::size_t>(numArrangements)) != numDetails)
+      {
+      return false;
+      }
+    return true;
+    }
+
+  bool readProperties()
+    {
+    SectionReader& section(this->m_sections[BINARY_PROPERTY_NAMES]);
+    return
+      section.count(this->numNames) &&
+      this->names.read(section, this->numNames) &&
+      this->floats.read(this->m_sections[BINARY_FLOAT_PROPERTIES], this->numEntities, this->numNames) &&
+      this->strings.read(this->m_sections[BINARY_STRING_PROPERTIES], this->numEntities, this->numNames) &&
+      this->integers.read(this->m_sections[BINARY_INTEGER_PROPERTIES], this->numEntities, this->numNames);
+    }
+
+  bool readSessions()
+    {
+    SectionReader& section(this->m_sections[BINARY_SESSIONS]);
+    return
+      section.count(this->numSessions) &&
+      validIndices(this->sessionEntities = section.array<boost::uint32_t>(this->numSessions),
+        this->numSessions, this->numUUIDs) &&
+      this->sessionNames.read(section, this->numSessions) &&
+      this->sessionData.read(section, this->numSessions);
+    }
+
+  SectionReader m_sections[NumberOfSections];
+};
+
+/// The contents of a file, mapped read-only where the platform supports it.
+class MappedFile
+{
+public:
+  MappedFile() : m_data(NULL), m_size(0), m_mapped(false)
+    {
+    }
+
+  ~MappedFile()
+    {
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    if (this->m_mapped)
+      {
+      ::munmap(const_cast<char*>(this->m_data), this->m_size);
+      }
+#endif
+    }
+
+  bool open(const char* filename)
+    {
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0)
+      {
+      return false;
+      }
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0)
+      {
+      void* data = ::mmap(NULL, static_cast<std::size_t>(info.st_size),
+        PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED)
+        {
+        this->m_data = static_cast<const char*>(data);
+        this->m_size = static_cast<std::size_t>(info.st_size);
+        this->m_mapped = true;
+        }
+      }
+    ::close(fd);
+    if (this->m_mapped)
+      {
+      return true;
+      }
+#endif
+
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file)
+      {
+      return false;
+      }
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (size <= 0)
+      {
+      return false;
+      }
+    this->m_memory.resize(static_cast<std::size_t>(size));
+    if (!file.read(&this->m_memory[0], size))
+      {
+      return false;
+      }
+    this->m_data = &this->m_memory[0];
+    this->m_size = this->m_memory.size();
+    return true;
+    }
+
+  const char* data() const { return this->m_data; }
+  std::size_t size() const { return this->m_size; }
+
+protected:
+  const char* m_data;
+  std::size_t m_size;
+  bool m_mapped;
+  std::vector<char> m_memory;
+};
+
+}
+
+namespace smtk {
+  namespace io {
+
+/**\brief Add the entities held by a binary archive to \a manager.
+  *
+  * Entities the manager does not yet hold are inserted in a single
+  * batch; existing entities are updated the way ImportJSON updates them.
+  * Returns 1 on success and 0 if the archive is invalid (in which case
+  * the manager is not modified) or a session could not be restored.
+  */
+int ImportBinary::intoModelManager(const char* data, std::size_t size, ManagerPtr manager)
+{
+  Archive archive;
+  if (!manager || !archive.read(data, size))
+    {
+    std::cerr << "Invalid binary model archive.\n";
+    return 0;
+    }
+
+  UUIDArray uids(archive.numUUIDs);
+  for (std::size_t i = 0; i < archive.numUUIDs; ++i)
+    {
+    std::memcpy(uids[i].begin(), archive.uids + i * UUID::SIZE, UUID::SIZE);
+    }
+
+  // Entity UUIDs must be valid and unique; check before changing anything.
+  UUIDHashMap<std::size_t> entityIndices;
+  for (std::size_t i = 0; i < archive.numEntities; ++i)
+    {
+    if (uids[i].isNull() || !entityIndices.insert(std::make_pair(uids[i], i)).second)
+      {
+      std::cerr << "Invalid entity UUID " << uids[i] << " in binary model archive.\n";
+      return 0;
+      }
+    }
+
+  std::vector<KindsToArrangements> arrangements(archive.numEntities);
+  std::vector<char> emptyDictionary(archive.numEntities, 0);
+  for (std::size_t g = 0; g < archive.numGroups; ++g)
+    {
+    boost::uint32_t entity = readValue<boost::uint32_t>(archive.arrEntities, g);
+    boost::uint32_t kind = readValue<boost::uint32_t>(archive.arrKinds, g);
+    if (kind == static_cast<boost::uint32_t>(KINDS_OF_ARRANGEMENTS))
+      { // An empty dictionary, kept as such.
+      emptyDictionary[entity] = 1;
+      continue;
+      }
+    Arrangements& arr(arrangements[entity][static_cast<ArrangementKind>(kind)]);
+    std::size_t first = static_cast<std::size_t>(readValue<boost::uint64_t>(archive.arrStarts, g));
+    std::size_t last = static_cast<std::size_t>(readValue<boost::uint64_t>(archive.arrStarts, g + 1));
+    arr.resize(arr.size() + last - first);
+    Arrangements::iterator ait = arr.end() - (last - first);
+    for (std::size_t a = first; a < last; ++a, ++ait)
+      {
+      archive.details.copy(a, ait->details());
+      }
+    }
+
+  UUIDArray newUids;
+  std::vector<Entity> newRecords;
+  std::vector<KindsToArrangements> newArrangements;
+  std::vector<std::size_t> existing;
+  newUids.reserve(archive.numEntities);
+  newRecords.reserve(archive.numEntities);
+  newArrangements.reserve(archive.numEntities);
+  for (std::size_t i = 0; i < archive.numEntities; ++i)
+    {
+    if (manager->topology().find(uids[i]) != manager->topology().end())
+      {
+      existing.push_back(i);
+      continue;
+      }
+    newUids.push_back(uids[i]);
+    newRecords.push_back(Entity(
+        readValue<boost::uint32_t>(archive.flags, i),
+        readValue<boost::int32_t>(archive.dims, i)));
+    UUIDArray& relations(newRecords.back().relations());
+    relations.reserve(archive.relations.size(i));
+    for (std::size_t r = archive.relations.begin(i); r < archive.relations.begin(i + 1); ++r)
+      {
+      relations.push_back(uids[readValue<boost::uint32_t>(archive.relations.values, r)]);
+      }
+    newArrangements.push_back(KindsToArrangements());
+    newArrangements.back().swap(arrangements[i]);
+    }
+  manager->insertEntities(newUids, newRecords, newArrangements);
+
+  for (std::vector<std::size_t>::const_iterator eit = existing.begin(); eit != existing.end(); ++eit)
+    {
+    std::size_t i = *eit;
+    UUIDWithEntity iter = manager->setEntityOfTypeAndDimension(uids[i],
+      readValue<boost::uint32_t>(archive.flags, i),
+      readValue<boost::int32_t>(archive.dims, i));
+    UUIDArray& relations(iter->second.relations());
+    for (std::size_t r = archive.relations.begin(i); r < archive.relations.begin(i + 1); ++r)
+      {
+      relations.push_back(uids[readValue<boost::uint32_t>(archive.relations.values, r)]);
+      }
+    KindsToArrangements::const_iterator kit;
+    for (kit = arrangements[i].begin(); kit != arrangements[i].end(); ++kit)
+      {
+      // First, erase any pre-existing arrangements to avoid duplicates.
+      manager->arrangementsOfKindForEntity(uids[i], kit->first).clear();
+      for (Arrangements::const_iterator a = kit->second.begin(); a != kit->second.end(); ++a)
+        {
+        manager->arrangeEntity(uids[i], kit->first, *a);
+        }
+      }
+    }
+  for (std::size_t i = 0; i < archive.numEntities; ++i)
+    {
+    if (emptyDictionary[i])
+      {
+      manager->arrangements()[uids[i]];
+      }
+    }
+
+  archive.tessellations.apply(uids, manager->tessellations());
+  archive.analysisMeshes.apply(uids, manager->analysisMesh());
+
+  std::vector<std::string> names(archive.numNames);
+  for (std::size_t i = 0; i < archive.numNames; ++i)
+    {
+    names[i] = archive.names.string(i);
+    }
+  // Fill values in place rather than building lists to copy.
+  for (std::size_t i = 0; i < archive.floats.num; ++i)
+    {
+    archive.floats.values.copy(i, manager->floatProperty(
+        uids[archive.floats.entity(i)], names[archive.floats.name(i)]));
+    }
+  for (std::size_t i = 0; i < archive.strings.num; ++i)
+    {
+    StringList& values(manager->stringProperty(
+        uids[archive.strings.entity(i)], names[archive.strings.name(i)]));
+    values.resize(archive.strings.values.size(i));
+    std::size_t first = archive.strings.values.begin(i);
+    for (std::size_t s = 0; s < values.size(); ++s)
+      {
+      values[s] = archive.strings.chars.string(first + s);
+      }
+    }
+  for (std::size_t i = 0; i < archive.integers.num; ++i)
+    {
+    IntegerList& values(manager->integerProperty(
+        uids[archive.integers.entity(i)], names[archive.integers.name(i)]));
+    values.resize(archive.integers.values.size(i));
+    std::size_t first = archive.integers.values.begin(i);
+    for (std::size_t v = 0; v < values.size(); ++v)
+      {
+      values[v] = static_cast<Integer>(
+        readValue<boost::int64_t>(archive.integers.values.values, first + v));
+      }
+    }
+
+  int status = 1;
+  for (std::size_t i = 0; i < archive.numSessions; ++i)
+    {
+    SessionRef sref(manager, uids[readValue<boost::uint32_t>(archive.sessionEntities, i)]);
+    sref = manager->createSession(archive.sessionNames.string(i), sref);
+    if (!sref.isValid())
+      {
+      status = 0;
+      continue;
+      }
+
+    // Sessions may use their data to load native-kernel model files.
+    SessionIOBinaryPtr delegate =
+      smtk::dynamic_pointer_cast<SessionIOBinary>(
+        sref.session()->createIODelegate("binary"));
+    if (delegate)
+      {
+      status &= delegate->importBinary(manager,
+        archive.sessionData.values + archive.sessionData.begin(i),
+        archive.sessionData.size(i));
+      }
+    }
+  return status;
+}
+
+/**\brief Add the entities held by the binary archive \a filename to \a manager.
+  *
+  * The file is memory-mapped where possible so that its arrays are
+  * copied straight into the manager.
+  */
+int ImportBinary::intoModelManagerFromFile(const char* filename, ManagerPtr manager)
+{
+  MappedFile file;
+  if (!filename || !file.open(filename))
+    {
+    std::cerr << "Could not read \"" << (filename ? filename : "(null)") << "\".\n";
+    return 0;
+    }
+  return ImportBinary::intoModelManager(file.data(), file.size(), manager);
+}
+
+  } // namespace io
+} // namespace smtk
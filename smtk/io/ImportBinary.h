@@ -0,0 +1,37 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_io_ImportBinary_h
+#define __smtk_io_ImportBinary_h
+
+#include "smtk/CoreExports.h" // For SMTKCORE_EXPORT macro.
+#include "smtk/PublicPointerDefs.h" // For ManagerPtr
+
+#include <cstddef>
+
+namespace smtk {
+  namespace io {
+
+/**\brief Import an SMTK model from a binary archive written by ExportBinary.
+  *
+  * The whole archive is checked before anything is added to the
+  * manager, so a truncated or corrupt archive leaves the manager
+  * untouched. Records are added just as ImportJSON would add them.
+  */
+class SMTKCORE_EXPORT ImportBinary
+{
+public:
+  static int intoModelManager(const char* data, std::size_t size, smtk::model::ManagerPtr manager);
+  static int intoModelManagerFromFile(const char* filename, smtk::model::ManagerPtr manager);
+};
+
+  } // namespace io
+} // namespace smtk
+
+#endif // __smtk_io_ImportBinary_h
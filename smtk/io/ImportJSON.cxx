@@ -19,6 +19,8 @@
 #include "smtk/model/StringData.h"
 #include "smtk/model/Tessellation.h"
 
+#include "smtk/common/Parallel.h"
+
 #include "smtk/attribute/Attribute.h"
 #include "smtk/attribute/Definition.h"
 #include "smtk/attribute/System.h"
@@ -34,6 +36,10 @@
 
 #include "cJSON.h"
 
+#include <algorithm>
+#include <locale>
+#include <sstream>
+
 #include <stdio.h>
 #include <string.h>
 
@@ -309,6 +315,918 @@ namespace {
     }
 }
 
+// Streaming import of a model manager, which decodes the JSON text
+// straight into records without building a cJSON tree.
+namespace {
+  /**\brief A cursor over NUL-terminated JSON text.
+    *
+    * Values are decoded as the cursor passes over them. Methods return
+    * false on malformed text, after which ok() is false.
+    */
+  class JSONCursor
+    {
+  public:
+    JSONCursor(const char* text) : m_pos(text), m_ok(true) { }
+
+    bool ok() const { return this->m_ok; }
+    const char* position() const { return this->m_pos; }
+
+    bool fail()
+      {
+      this->m_ok = false;
+      return false;
+      }
+
+    /// Skip whitespace and return the next character.
+    char peek()
+      {
+      while (*this->m_pos == ' ' || *this->m_pos == '\t' ||
+             *this->m_pos == '\n' || *this->m_pos == '\r')
+        {
+        ++this->m_pos;
+        }
+      return *this->m_pos;
+      }
+
+    bool expect(char c)
+      {
+      if (this->peek() != c)
+        {
+        return this->fail();
+        }
+      ++this->m_pos;
+      return true;
+      }
+
+    /**\brief Advance to the next member of an object, reading its key.
+      *
+      * Pass \a first as true before the first member. Returns false
+      * after the closing brace or on an error.
+      */
+    bool nextMember(std::string& key, bool& first)
+      {
+      if (!this->m_ok)
+        {
+        return false;
+        }
+      if (this->peek() == '}')
+        {
+        ++this->m_pos;
+        return false;
+        }
+      if (!first && !this->expect(','))
+        {
+        return false;
+        }
+      first = false;
+      return this->readString(key) && this->expect(':');
+      }
+
+    /// Like nextMember(), for the elements of an array.
+    bool nextElement(bool& first)
+      {
+      if (!this->m_ok)
+        {
+        return false;
+        }
+      if (this->peek() == ']')
+        {
+        ++this->m_pos;
+        return false;
+        }
+      if (!first && !this->expect(','))
+        {
+        return false;
+        }
+      first = false;
+      return true;
+      }
+
+    bool readString(std::string& str)
+      {
+      if (!this->expect('"'))
+        {
+        return false;
+        }
+      str.clear();
+      const char* run = this->m_pos;
+      for (;;)
+        {
+        const char c = *this->m_pos;
+        if (c == '"')
+          {
+          str.append(run, this->m_pos);
+          ++this->m_pos;
+          return true;
+          }
+        else if (c == '\\')
+          {
+          str.append(run, this->m_pos);
+          ++this->m_pos;
+          if (!this->readEscape(str))
+            {
+            return false;
+            }
+          run = this->m_pos;
+          }
+        else if (c == '\0')
+          {
+          return this->fail();
+          }
+        else
+          {
+          ++this->m_pos;
+          }
+        }
+      }
+
+    bool readNumber(double& value)
+      {
+      const char* start = this->m_pos;
+      if (!this->scanNumber())
+        {
+        return false;
+        }
+      // Decimal numbers with few digits convert exactly; anything else is
+      // left to the stream library. Neither depends on the C locale.
+      const char* p = start;
+      bool negative = (*p == '-');
+      if (negative)
+        {
+        ++p;
+        }
+      unsigned long long mantissa = 0;
+      int digits = 0;
+      int exponent = 0;
+      for (; *p >= '0' && *p <= '9'; ++p, ++digits)
+        {
+        mantissa = 10 * mantissa + (*p - '0');
+        }
+      if (*p == '.')
+        {
+        for (++p; *p >= '0' && *p <= '9'; ++p, ++digits, --exponent)
+          {
+          mantissa = 10 * mantissa + (*p - '0');
+          }
+        }
+      static const double powersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+      if (p == this->m_pos && digits <= 15 && exponent >= -22)
+        {
+        value = exponent < 0 ?
+          static_cast<double>(mantissa) / powersOfTen[-exponent] :
+          static_cast<double>(mantissa);
+        }
+      else
+        {
+        std::istringstream str(std::string(start, this->m_pos));
+        str.imbue(std::locale::classic());
+        str >> value;
+        return true;
+        }
+      if (negative)
+        {
+        value = -value;
+        }
+      return true;
+      }
+
+    /// Skip over the next value, checking that it is well formed.
+    bool skipValue()
+      {
+      bool first = true;
+      switch (this->peek())
+        {
+      case '{':
+        ++this->m_pos;
+        while (this->m_ok)
+          {
+          if (this->peek() == '}')
+            {
+            ++this->m_pos;
+            return true;
+            }
+          if (!first && !this->expect(','))
+            {
+            return false;
+            }
+          first = false;
+          if (!this->skipString() || !this->expect(':') || !this->skipValue())
+            {
+            return false;
+            }
+          }
+        return false;
+      case '[':
+        ++this->m_pos;
+        while (this->nextElement(first))
+          {
+          this->skipValue();
+          }
+        return this->m_ok;
+      case '"':
+        return this->skipString();
+      case 't':
+        return this->skipLiteral("true");
+      case 'f':
+        return this->skipLiteral("false");
+      case 'n':
+        return this->skipLiteral("null");
+      default:
+        return this->scanNumber();
+        }
+      }
+
+    /// Count the elements of the array that is next, without moving.
+    std::size_t countElements() const
+      {
+      JSONCursor copy(*this);
+      std::size_t count = 0;
+      bool first = true;
+      if (copy.expect('['))
+        {
+        for (; copy.nextElement(first); ++count)
+          {
+          copy.skipValue();
+          }
+        }
+      return count;
+      }
+
+  private:
+    bool readEscape(std::string& str)
+      {
+      const char c = *this->m_pos++;
+      switch (c)
+        {
+      case 'b': str += '\b'; return true;
+      case 'f': str += '\f'; return true;
+      case 'n': str += '\n'; return true;
+      case 'r': str += '\r'; return true;
+      case 't': str += '\t'; return true;
+      case 'u':
+          {
+          unsigned long code;
+          if (!this->readHex(code))
+            {
+            return false;
+            }
+          if (code >= 0xD800 && code <= 0xDBFF &&
+              this->m_pos[0] == '\\' && this->m_pos[1] == 'u')
+            { // a surrogate pair
+            unsigned long low;
+            this->m_pos += 2;
+            if (!this->readHex(low))
+              {
+              return false;
+              }
+            if (low >= 0xDC00 && low <= 0xDFFF)
+              {
+              code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+              }
+            else
+              {
+              appendUTF8(str, code);
+              code = low;
+              }
+            }
+          appendUTF8(str, code);
+          return true;
+          }
+      case '\0':
+        --this->m_pos;
+        return this->fail();
+      default: // like cJSON, other escaped characters stand for themselves
+        str += c;
+        return true;
+        }
+      }
+
+    bool readHex(unsigned long& code)
+      {
+      code = 0;
+      for (int i = 0; i < 4; ++i, ++this->m_pos)
+        {
+        const char c = *this->m_pos;
+        code <<= 4;
+        if (c >= '0' && c <= '9')      { code |= c - '0'; }
+        else if (c >= 'a' && c <= 'f') { code |= c - 'a' + 10; }
+        else if (c >= 'A' && c <= 'F') { code |= c - 'A' + 10; }
+        else                           { return this->fail(); }
+        }
+      return true;
+      }
+
+    static void appendUTF8(std::string& str, unsigned long code)
+      {
+      if (code < 0x80)
+        {
+        str += static_cast<char>(code);
+        }
+      else if (code < 0x800)
+        {
+        str += static_cast<char>(0xC0 | (code >> 6));
+        str += static_cast<char>(0x80 | (code & 0x3F));
+        }
+      else if (code < 0x10000)
+        {
+        str += static_cast<char>(0xE0 | (code >> 12));
+        str += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (code & 0x3F));
+        }
+      else
+        {
+        str += static_cast<char>(0xF0 | (code >> 18));
+        str += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        str += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (code & 0x3F));
+        }
+      }
+
+    bool skipString()
+      {
+      if (!this->expect('"'))
+        {
+        return false;
+        }
+      for (;;)
+        {
+        const char c = *this->m_pos++;
+        if (c == '"')
+          {
+          return true;
+          }
+        else if (c == '\0' || (c == '\\' && *this->m_pos++ == '\0'))
+          {
+          --this->m_pos;
+          return this->fail();
+          }
+        }
+      }
+
+    bool skipLiteral(const char* literal)
+      {
+      const std::size_t length = strlen(literal);
+      if (strncmp(this->m_pos, literal, length) != 0)
+        {
+        return this->fail();
+        }
+      this->m_pos += length;
+      return true;
+      }
+
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    /// Move past a number, checking its syntax.
+    bool scanNumber()
+      {
+      const char* p = this->m_pos;
+      if (*p == '-')
+        {
+        ++p;
+        }
+      if (!isDigit(*p))
+        {
+        return this->fail();
+        }
+      while (isDigit(*p))
+        {
+        ++p;
+        }
+      if (*p == '.')
+        {
+        if (!isDigit(*++p))
+          {
+          return this->fail();
+          }
+        while (isDigit(*p))
+          {
+          ++p;
+          }
+        }
+      if (*p == 'e' || *p == 'E')
+        {
+        ++p;
+        if (*p == '+' || *p == '-')
+          {
+          ++p;
+          }
+        if (!isDigit(*p))
+          {
+          return this->fail();
+          }
+        while (isDigit(*p))
+          {
+          ++p;
+          }
+        }
+      this->m_pos = p;
+      return true;
+      }
+
+    const char* m_pos;
+    bool m_ok;
+    };
+
+  // Value readers matching cJSON_GetIntegerValue, cJSON_GetRealValue and
+  // cJSON_GetStringValue. Values of the wrong type are skipped and give
+  // false.
+  bool readIntegerValue(JSONCursor& cur, long& val)
+    {
+    const char c = cur.peek();
+    if (c == '"')
+      {
+      std::string text;
+      cur.readString(text);
+      char* strEnd;
+      long tmp = strtol(text.c_str(), &strEnd, 10);
+      if (!text.empty() && !*strEnd)
+        {
+        val = tmp;
+        return true;
+        }
+      return false;
+      }
+    else if (c == '-' || (c >= '0' && c <= '9'))
+      {
+      double number;
+      cur.readNumber(number);
+      val = static_cast<long>(number);
+      return true;
+      }
+    cur.skipValue();
+    return false;
+    }
+
+  bool readRealValue(JSONCursor& cur, double& val)
+    {
+    const char c = cur.peek();
+    if (c == '"')
+      {
+      std::string text;
+      cur.readString(text);
+      char* strEnd;
+      double tmp = strtod(text.c_str(), &strEnd);
+      if (!text.empty() && !*strEnd)
+        {
+        val = tmp;
+        return true;
+        }
+      return false;
+      }
+    else if (c == '-' || (c >= '0' && c <= '9'))
+      {
+      cur.readNumber(val);
+      return true;
+      }
+    cur.skipValue();
+    return false;
+    }
+
+  bool readStringValue(JSONCursor& cur, std::string& val)
+    {
+    const char c = cur.peek();
+    if (c == '"')
+      {
+      std::string text;
+      cur.readString(text);
+      if (!text.empty())
+        {
+        val.swap(text);
+        return true;
+        }
+      return false;
+      }
+    else if (c == '-' || (c >= '0' && c <= '9'))
+      {
+      double number;
+      cur.readNumber(number);
+      char valtext[64];
+      snprintf(valtext, 64, "%.17g", number);
+      val = valtext;
+      return true;
+      }
+    cur.skipValue();
+    return false;
+    }
+
+  /**\brief Read an array of values into a vector reserved to fit it.
+    *
+    * Like cJSON_GetRealArray and its siblings, entries of the wrong type
+    * are skipped, and a single value is read as a list of one unless
+    * \a arrayOnly is set.
+    */
+  template<typename T, typename V>
+  void readList(JSONCursor& cur, std::vector<T>& values,
+                bool (*readValue)(JSONCursor&, V&), bool arrayOnly)
+    {
+    V val;
+    if (cur.peek() == '[')
+      {
+      values.reserve(values.size() + cur.countElements());
+      cur.expect('[');
+      bool first = true;
+      while (cur.nextElement(first))
+        {
+        if (readValue(cur, val))
+          {
+          values.push_back(static_cast<T>(val));
+          }
+        }
+      }
+    else if (arrayOnly)
+      {
+      cur.skipValue();
+      }
+    else if (readValue(cur, val))
+      {
+      values.push_back(static_cast<T>(val));
+      }
+    }
+
+  /// The tessellation or analysis mesh of a record.
+  struct TessellationRecord
+    {
+    TessellationRecord()
+      : present(false), valid(false), hasVertices(false), hasFaces(false) { }
+
+    bool present;
+    bool valid;
+    bool hasVertices;
+    bool hasFaces;
+    smtk::model::Tessellation tess;
+    };
+
+  /**\brief Everything the "topo" dictionary holds for one UUID.
+    *
+    * Records are decoded in parallel, and then applied to the manager in
+    * order the way ImportJSON::ofManager() would.
+    */
+  struct ModelRecord
+    {
+    ModelRecord()
+      : hasFlags(false), hasDimension(false), arrangementsValid(true),
+        entityFlags(0), dimension(0)
+      {
+      for (int i = 0; i < smtk::model::KINDS_OF_ARRANGEMENTS; ++i)
+        {
+        this->hasArrangements[i] = false;
+        }
+      }
+
+    bool hasFlags;
+    bool hasDimension;
+    bool arrangementsValid;
+    long entityFlags;
+    long dimension;
+    smtk::common::UUIDArray relations;
+    bool hasArrangements[smtk::model::KINDS_OF_ARRANGEMENTS];
+    smtk::model::Arrangements arrangements[smtk::model::KINDS_OF_ARRANGEMENTS];
+    TessellationRecord tessellation;
+    TessellationRecord analysis;
+    std::vector<std::pair<std::string, smtk::model::FloatList> > floatProperties;
+    std::vector<std::pair<std::string, smtk::model::StringList> > stringProperties;
+    std::vector<std::pair<std::string, smtk::model::IntegerList> > integerProperties;
+    };
+
+  /// Where the value of each record of the "topo" dictionary starts.
+  struct RecordLocation
+    {
+    std::string key;
+    const char* value;
+    };
+
+  void readRelations(JSONCursor& cur, smtk::common::UUIDArray& relations)
+    {
+    if (cur.peek() != '[')
+      {
+      cur.skipValue();
+      return;
+      }
+    // Like cJSON_GetUUIDArray, stop at the first entry that isn't a UUID.
+    relations.reserve(cur.countElements());
+    cur.expect('[');
+    bool first = true;
+    bool stopped = false;
+    std::string text;
+    while (cur.nextElement(first))
+      {
+      if (!stopped && cur.peek() == '"' && cur.readString(text) && !text.empty())
+        {
+        relations.push_back(smtk::common::UUID(text));
+        }
+      else
+        {
+        stopped = true;
+        cur.skipValue();
+        }
+      }
+    }
+
+  void readArrangements(JSONCursor& cur, ModelRecord& record)
+    {
+    if (cur.peek() != '{')
+      { // An improper arrangement is an error.
+      record.arrangementsValid = false;
+      cur.skipValue();
+      return;
+      }
+    bool seen[smtk::model::KINDS_OF_ARRANGEMENTS] = { false };
+    bool first = true;
+    std::string abbr;
+    cur.expect('{');
+    while (cur.nextMember(abbr, first))
+      {
+      smtk::model::ArrangementKind k = smtk::model::ArrangementKindFromAbbreviation(abbr);
+      if (k == smtk::model::KINDS_OF_ARRANGEMENTS || seen[k] || cur.peek() != '[')
+        {
+        if (k != smtk::model::KINDS_OF_ARRANGEMENTS)
+          {
+          seen[k] = true;
+          }
+        cur.skipValue();
+        continue;
+        }
+      seen[k] = true;
+      record.hasArrangements[k] = true;
+      cur.expect('[');
+      bool firstArr = true;
+      while (cur.nextElement(firstArr))
+        {
+        smtk::model::Arrangement a;
+        if (cur.peek() == '[')
+          {
+          readList(cur, a.details(), readIntegerValue, true);
+          }
+        else
+          {
+          cur.skipValue();
+          }
+        if (!a.details().empty())
+          {
+          record.arrangements[k].push_back(a);
+          }
+        }
+      }
+    }
+
+  void readTessellation(JSONCursor& cur, TessellationRecord& record)
+    {
+    record.present = true;
+    if (cur.peek() != '{')
+      { // An improper tessellation is an error.
+      cur.skipValue();
+      return;
+      }
+    record.valid = true;
+    bool first = true;
+    std::string key;
+    cur.expect('{');
+    while (cur.nextMember(key, first))
+      {
+      if (key == "vertices" && !record.hasVertices)
+        {
+        record.hasVertices = true;
+        readList(cur, record.tess.coords(), readRealValue, true);
+        }
+      else if (key == "faces" && !record.hasFaces)
+        {
+        record.hasFaces = true;
+        readList(cur, record.tess.conn(), readIntegerValue, true);
+        }
+      else
+        {
+        cur.skipValue();
+        }
+      }
+    }
+
+  template<typename T, typename V>
+  void readProperties(JSONCursor& cur,
+                      std::vector<std::pair<std::string, std::vector<T> > >& props,
+                      bool (*readValue)(JSONCursor&, V&))
+    {
+    if (cur.peek() != '{')
+      {
+      cur.skipValue();
+      return;
+      }
+    bool first = true;
+    std::string name;
+    cur.expect('{');
+    while (cur.nextMember(name, first))
+      {
+      if (name.empty())
+        { // skip un-named property arrays.
+        cur.skipValue();
+        continue;
+        }
+      props.push_back(std::make_pair(name, std::vector<T>()));
+      readList(cur, props.back().second, readValue, false);
+      }
+    }
+
+  void readRecord(const char* text, ModelRecord& record)
+    {
+    JSONCursor cur(text);
+    if (cur.peek() != '{')
+      {
+      return;
+      }
+    bool seen[9] = { false };
+    const char* keys[9] = { "e", "d", "r", "a", "t", "m", "f", "s", "i" };
+    bool first = true;
+    std::string key;
+    cur.expect('{');
+    while (cur.nextMember(key, first))
+      {
+      int which = 0;
+      while (which < 9 && key != keys[which])
+        {
+        ++which;
+        }
+      if (which == 9 || seen[which])
+        {
+        cur.skipValue();
+        continue;
+        }
+      seen[which] = true;
+      switch (which)
+        {
+      case 0: record.hasFlags = readIntegerValue(cur, record.entityFlags); break;
+      case 1: record.hasDimension = readIntegerValue(cur, record.dimension); break;
+      case 2: readRelations(cur, record.relations); break;
+      case 3: readArrangements(cur, record); break;
+      case 4: readTessellation(cur, record.tessellation); break;
+      case 5: readTessellation(cur, record.analysis); break;
+      case 6: readProperties(cur, record.floatProperties, readRealValue); break;
+      case 7: readProperties(cur, record.stringProperties, readStringValue); break;
+      case 8: readProperties(cur, record.integerProperties, readIntegerValue); break;
+        }
+      }
+    }
+
+  /// Read the records of a batch, a record per piece.
+  class ReadRecords : public smtk::common::ParallelTask
+    {
+  public:
+    ReadRecords(const std::vector<RecordLocation>& locations, std::size_t offset,
+                std::vector<ModelRecord>& records)
+      : m_locations(locations), m_offset(offset), m_records(records) { }
+
+    void execute(std::size_t piece)
+      {
+      readRecord(this->m_locations[this->m_offset + piece].value, this->m_records[piece]);
+      }
+
+  private:
+    const std::vector<RecordLocation>& m_locations;
+    std::size_t m_offset;
+    std::vector<ModelRecord>& m_records;
+    };
+
+  int applyTessellation(const UUID& uid, TessellationRecord& record,
+                        UUIDsToTessellations& tessellations)
+    {
+    if (!record.present)
+      { // Missing tessellation is not an error.
+      return 1;
+      }
+    if (!record.valid)
+      { // An improper tessellation is an error.
+      return 0;
+      }
+    UUIDsToTessellations::iterator tessIt = tessellations.find(uid);
+    if (tessIt == tessellations.end())
+      {
+      Tessellation blank;
+      tessIt = tessellations.insert(
+        std::pair<UUID,Tessellation>(uid, blank)).first;
+      }
+    if (record.hasVertices)
+      {
+      tessIt->second.coords().swap(record.tess.coords());
+      }
+    if (record.hasFaces)
+      {
+      tessIt->second.conn().swap(record.tess.conn());
+      }
+    return 1;
+    }
+
+  /// Apply a record the way ImportJSON::ofManager() applies a cJSON node.
+  int applyRecord(const UUID& uid, ModelRecord& record, ManagerPtr manager)
+    {
+    int status = 1;
+    if (record.hasFlags && record.hasDimension)
+      {
+      UUIDWithEntity iter = manager->setEntityOfTypeAndDimension(
+        uid, record.entityFlags, record.dimension);
+      UUIDArray& relations = iter->second.relations();
+      relations.insert(relations.end(), record.relations.begin(), record.relations.end());
+      }
+    else
+      {
+      status = 0;
+      }
+
+    if (record.arrangementsValid)
+      {
+      for (int i = 0; i < smtk::model::KINDS_OF_ARRANGEMENTS; ++i)
+        {
+        if (!record.hasArrangements[i])
+          {
+          continue;
+          }
+        ArrangementKind k = static_cast<ArrangementKind>(i);
+        // First, erase any pre-existing arrangements to avoid duplicates.
+        manager->arrangementsOfKindForEntity(uid, k).clear();
+        for (Arrangements::const_iterator a = record.arrangements[i].begin();
+             a != record.arrangements[i].end(); ++a)
+          {
+          manager->arrangeEntity(uid, k, *a);
+          }
+        }
+      }
+    else
+      {
+      status = 0;
+      }
+
+    status &= applyTessellation(uid, record.tessellation, manager->tessellations());
+    status &= applyTessellation(uid, record.analysis, manager->analysisMesh());
+
+    for (std::size_t i = 0; i < record.floatProperties.size(); ++i)
+      {
+      manager->setFloatProperty(uid,
+        record.floatProperties[i].first, record.floatProperties[i].second);
+      }
+    for (std::size_t i = 0; i < record.stringProperties.size(); ++i)
+      {
+      manager->setStringProperty(uid,
+        record.stringProperties[i].first, record.stringProperties[i].second);
+      }
+    for (std::size_t i = 0; i < record.integerProperties.size(); ++i)
+      {
+      manager->setIntegerProperty(uid,
+        record.integerProperties[i].first, record.integerProperties[i].second);
+      }
+    return status;
+    }
+
+  /// Find where each record of the "topo" dictionary starts.
+  bool locateRecords(JSONCursor& cur, std::vector<RecordLocation>& locations)
+    {
+    if (cur.peek() != '{')
+      {
+      return cur.skipValue();
+      }
+    bool first = true;
+    RecordLocation location;
+    cur.expect('{');
+    while (cur.nextMember(location.key, first))
+      {
+      location.value = cur.position();
+      locations.push_back(location);
+      cur.skipValue();
+      }
+    return cur.ok();
+    }
+
+  /// Decode and apply the records in batches, stopping like ofManager().
+  int applyRecords(const std::vector<RecordLocation>& locations, ManagerPtr manager)
+    {
+    const std::size_t batchSize = 1024 * smtk::common::Parallel::numberOfThreads();
+    int status = 1;
+    for (std::size_t offset = 0; offset < locations.size() && status; offset += batchSize)
+      {
+      std::vector<ModelRecord> records(
+        std::min(batchSize, locations.size() - offset));
+      ReadRecords reader(locations, offset, records);
+      smtk::common::Parallel::forEach(records.size(), reader);
+
+      for (std::size_t i = 0; i < records.size() && status; ++i)
+        {
+        const std::string& key = locations[offset + i].key;
+        if (key.empty())
+          {
+          std::cerr << "Empty dictionary key.\n";
+          continue;
+          }
+        UUID uid(key);
+        if (uid.isNull())
+          {
+          std::cerr << "Skipping malformed UUID: " << key << "\n";
+          continue;
+          }
+        status &= applyRecord(uid, records[i], manager);
+        }
+      }
+    return status;
+    }
+}
+
 namespace smtk {
   namespace io {
 
@@ -353,6 +1271,11 @@ int cJSON_GetObjectParameters(cJSON* node, T& obj, smtk::attribute::System* sys,
   *
   * The top level JSON object must be a dictionary with key "type" set to "Manager"
   * and key "topo" set to a dictionary of UUIDs with matching entries.
+  *
+  * Rather than parsing the text into cJSON nodes, the records of "topo"
+  * are decoded straight from the text, in parallel, and then added to the
+  * manager in order just as ofManager() would add them. Nothing is added
+  * when the text is not valid JSON.
   */
 int ImportJSON::intoModelManager(
   const char* json, ManagerPtr manager)
@@ -364,38 +1287,64 @@ int ImportJSON::intoModelManager(
     return status;
     }
 
-  cJSON* root = cJSON_Parse(json);
-  if (!root)
+  JSONCursor cur(json);
+  if (cur.peek() != '{')
     {
+    if (cur.skipValue())
+      {
+      std::cerr << "Invalid toplevel JSON type.\n";
+      }
     return status;
     }
-  switch(root->type)
+
+  // Find the type and the records of the top level dictionary, checking
+  // the text on the way.
+  std::vector<RecordLocation> locations;
+  bool haveType = false;
+  bool haveTopo = false;
+  bool isManager = false;
+  bool first = true;
+  std::string key;
+  cur.expect('{');
+  while (cur.nextMember(key, first))
+    {
+    if (key == "type" && !haveType)
+      {
+      haveType = true;
+      std::string mtyp;
+      if (cur.peek() == '"')
+        {
+        isManager = cur.readString(mtyp) && mtyp == "Manager";
+        }
+      else
+        {
+        cur.skipValue();
+        }
+      }
+    else if (key == "topo" && !haveTopo)
+      {
+      haveTopo = true;
+      locateRecords(cur, locations);
+      }
+    else
+      {
+      cur.skipValue();
+      }
+    }
+  if (!cur.ok())
     {
-  case cJSON_Object:
-    if (!root->child)
-      {
-      std::cerr << "Empty JSON object.\n";
-      return status;
-      }
-    break;
-  case cJSON_NULL:
-  case cJSON_Number:
-  case cJSON_String:
-  case cJSON_Array:
-  default:
-    std::cerr << "Invalid toplevel JSON type (" << root->type << ").\n";
     return status;
-    break;
     }
-
-  cJSON* mtyp = cJSON_GetObjectItem(root, "type");
-  if (mtyp && mtyp->type == cJSON_String && mtyp->valuestring && !strcmp(mtyp->valuestring,"Manager"))
+  if (first)
     {
-    cJSON* body = cJSON_GetObjectItem(root, "topo");
-    status = ImportJSON::ofManager(body, manager);
+    std::cerr << "Empty JSON object.\n";
+    return status;
     }
 
-  cJSON_Delete(root);
+  if (isManager && haveTopo)
+    {
+    status = applyRecords(locations, manager);
+    }
   return status;
 }
 
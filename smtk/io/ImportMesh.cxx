@@ -13,6 +13,7 @@
 #include "smtk/mesh/moab/Readers.h"
 
 #include "smtk/mesh/json/Readers.h"
+#include "smtk/mesh/native/Readers.h"
 
 namespace smtk {
 namespace io {
@@ -59,6 +60,14 @@ smtk::mesh::CollectionPtr ImportMesh::entireJSON(cJSON* child,
   return collection;
 }
 
+//Load a native binary file as a new collection, mapping it into memory
+smtk::mesh::CollectionPtr ImportMesh::entireBinary(const std::string& filePath,
+                                                   const smtk::mesh::ManagerPtr& manager)
+{
+  smtk::mesh::CollectionPtr collection = smtk::mesh::native::read(filePath, manager);
+  collection->readLocation(filePath);
+  return collection;
+}
 
 //Merge the entire moab data file into an existing valid collection.
 bool ImportMesh::entireFileToCollection(const std::string& filePath,
@@ -63,6 +63,14 @@ public:
   static smtk::mesh::CollectionPtr entireJSON(cJSON* child,
                                               const smtk::mesh::ManagerPtr& manager);
 
+  //Load a native binary file written by WriteMesh::entireBinary as a new
+  //collection into the given manager. The file is memory mapped, so the
+  //collection opens without reading the points or connectivity.
+  //Returns an invalid collection that is NOT part of the manager if the
+  //file can't be loaded
+  static smtk::mesh::CollectionPtr entireBinary(const std::string& filePath,
+                                                const smtk::mesh::ManagerPtr& manager);
+
   //Merge the entire moab data file into an existing valid collection.
   static bool entireFileToCollection(const std::string& filePath,
                                      const smtk::mesh::CollectionPtr& collection);
@@ -10,9 +10,12 @@
 
 #include "smtk/io/ModelToMesh.h"
 
+#include "smtk/common/Parallel.h"
+
 #include "smtk/mesh/Manager.h"
 #include "smtk/mesh/Interface.h"
 #include "smtk/mesh/Collection.h"
+#include "smtk/mesh/WeldPoints.h"
 
 #include "smtk/model/EntityIterator.h"
 #include "smtk/model/Model.h"
@@ -67,237 +70,401 @@ void removeOnesWithoutTess(smtk::model::EntityRefs& ents)
 
 }
 
-template<typename MappingType>
-bool convert_vertices(const smtk::model::EntityRefs& ents,
-                      MappingType& mapping,
-                      const smtk::mesh::AllocatorPtr& ialloc)
+//----------------------------------------------------------------------------
+//the cell shapes that are converted, which all have a fixed number of
+//vertices so that cells of one shape can be allocated in a single block
+bool isConvertedShape(smtk::model::Tessellation::size_type cell_shape)
 {
-  typedef typename MappingType::value_type value_type;
+  return cell_shape == smtk::model::TESS_VERTEX   ||
+         cell_shape == smtk::model::TESS_TRIANGLE ||
+         cell_shape == smtk::model::TESS_QUAD;
+}
 
-  //count the number of points in the tessellation so that we can properly
-  //allocate a single pool large enough for all the points
-  std::size_t numPointsToAlloc = 0;
-  smtk::model::EntityIterator it;
-  it.traverse(ents.begin(), ents.end(), smtk::model::ITERATE_BARE);
-  for (it.begin(); !it.isAtEnd(); ++it)
+//----------------------------------------------------------------------------
+//what each entity contributes to the collection, and where its points and
+//cells go in the memory allocated for all entities of the same type
+struct EntityTessellation
+{
+  smtk::model::EntityRef entity;
+  const smtk::model::Tessellation* tess;
+  int dimension;
+
+  std::size_t numPoints;
+  std::size_t pointOffset;
+
+  std::size_t numCells[smtk::mesh::CellType_MAX];
+  std::size_t cellOffset[smtk::mesh::CellType_MAX];
+};
+
+//----------------------------------------------------------------------------
+//counts the points and cells of each entity
+class CountTessellation : public smtk::common::ParallelTask
+{
+public:
+  CountTessellation(std::vector<EntityTessellation>& ents) : m_ents(ents) {}
+
+  void execute(std::size_t piece)
+  {
+  typedef smtk::model::Tessellation Tess;
+  EntityTessellation& ent = this->m_ents[piece];
+  const Tess* tess = ent.tess;
+
+  //each model has an embedding dimension which dictates the number of
+  //coordinates per point. This allows us to convert 2d / 1d points
+  //safely into 3d space
+  ent.numPoints = tess->coords().size() / ent.dimension;
+
+  std::fill(ent.numCells, ent.numCells + smtk::mesh::CellType_MAX, 0);
+  for (Tess::size_type start_off = tess->begin();
+       start_off != tess->end();
+       start_off = tess->nextCellOffset(start_off))
     {
-    //we filtered out all ents without tess already, so this can't be null
-    const smtk::model::Tessellation* tess = it->hasTessellation();
-    std::vector<double> const& modelCoords = tess->coords();
-
-    //each model has an embedding dimension which dictates the number of
-    //coordinates per point. This allows us to convert 2d / 1d points
-    //safely into 3d space
-    const int dimension = it->embeddingDimension();
-    numPointsToAlloc += ( modelCoords.size() / dimension);
+    Tess::size_type cell_type;
+    tess->numberOfCellVertices(start_off, &cell_type);
+    Tess::size_type cell_shape = tess->cellShapeFromType(cell_type);
+    if(isConvertedShape(cell_shape))
+      {
+      ent.numCells[tessToSMTKCell(cell_shape)]++;
+      }
     }
+  }
 
-  std::vector<double *> meshCoords;
-  smtk::mesh::Handle firstVertHandle;
-  const bool pointsAllocated = ialloc->allocatePoints( numPointsToAlloc,
-                                                       firstVertHandle,
-                                                       meshCoords);
-  if(!pointsAllocated)
+private:
+  std::vector<EntityTessellation>& m_ents;
+};
+
+//----------------------------------------------------------------------------
+//copies the coordinates of an entity as 3d points, stride values apart
+void copyCoordinates(const EntityTessellation& ent,
+                     double* x, double* y, double* z,
+                     std::size_t stride)
+{
+  //while a little more complex, this way avoids branching or comparisons
+  //against dimension while filling the memory
+  std::vector<double> const& modelCoords = ent.tess->coords();
+  const std::size_t length = ent.numPoints * ent.dimension;
+  if(ent.dimension == 3)
+    {
+    for( std::size_t i=0; i < length; i+=3, x+=stride, y+=stride, z+=stride)
+      {
+      *x = modelCoords[i];
+      *y = modelCoords[i+1];
+      *z = modelCoords[i+2];
+      }
+    }
+  else if(ent.dimension == 2)
+    {
+    for( std::size_t i=0; i < length; i+=2, x+=stride, y+=stride, z+=stride)
+      {
+      *x = modelCoords[i];
+      *y = modelCoords[i+1];
+      *z = 0;
+      }
+    }
+  else if(ent.dimension == 1)
     {
-    return false;
+    for(std::size_t i=0; i < length; ++i, x+=stride, y+=stride, z+=stride)
+      {
+      *x = modelCoords[i];
+      *y = 0;
+      *z = 0;
+      }
     }
+}
 
-  //iterate over the tessellation populating the mesh coordinates
-  std::size_t pos = 0;
-  it.traverse(ents.begin(), ents.end(), smtk::model::ITERATE_BARE);
-  for (it.begin(); !it.isAtEnd(); ++it)
+//----------------------------------------------------------------------------
+//gathers the points of every entity as interleaved coordinates, so they
+//can be welded before anything is allocated
+class GatherPoints : public smtk::common::ParallelTask
+{
+public:
+  GatherPoints(const std::vector<EntityTessellation>& ents,
+               std::vector<double>& xyz) :
+    m_ents(ents),
+    m_xyz(xyz)
+  {
+  }
+
+  void execute(std::size_t piece)
+  {
+  const EntityTessellation& ent = this->m_ents[piece];
+  if(ent.numPoints > 0)
     {
-    //we filtered out all ents without tess already, so this can't be null
-    const smtk::model::Tessellation* tess = it->hasTessellation();
-    std::vector<double> const& modelCoords = tess->coords();
+    double* p = &this->m_xyz[3 * ent.pointOffset];
+    copyCoordinates(ent, p, p + 1, p + 2, 3);
+    }
+  }
 
-    const int dimension = it->embeddingDimension();
-    const std::size_t length = modelCoords.size();
+private:
+  const std::vector<EntityTessellation>& m_ents;
+  std::vector<double>& m_xyz;
+};
 
-    //mark for this entity where in the global pool of points we can
-    //find the start of its coordinates, this will allow us to properly
-    //create the new connectivity for the mesh referencing the global
-    //point coordinate array
-    mapping[*it]=firstVertHandle + pos;
+//----------------------------------------------------------------------------
+//copies the coordinates and connectivity of each entity into its own part
+//of the allocated memory, so entities can be filled concurrently. When the
+//points have been welded their coordinates are already filled, and
+//pointIds maps the points of every entity to the points that were kept
+class FillTessellation : public smtk::common::ParallelTask
+{
+public:
+  FillTessellation(const std::vector<EntityTessellation>& ents,
+                   smtk::mesh::Handle firstVertHandle,
+                   const std::vector<double*>& meshCoords,
+                   const std::vector<smtk::mesh::Handle*>& meshConn,
+                   const std::vector<std::size_t>* pointIds) :
+    m_ents(ents),
+    m_firstVertHandle(firstVertHandle),
+    m_meshCoords(meshCoords),
+    m_meshConn(meshConn),
+    m_pointIds(pointIds)
+  {
+  }
+
+  void execute(std::size_t piece)
+  {
+  typedef smtk::model::Tessellation Tess;
+  const EntityTessellation& ent = this->m_ents[piece];
+  const Tess* tess = ent.tess;
+
+  if(!this->m_pointIds)
+    {
+    copyCoordinates(ent,
+                    this->m_meshCoords[0] + ent.pointOffset,
+                    this->m_meshCoords[1] + ent.pointOffset,
+                    this->m_meshCoords[2] + ent.pointOffset,
+                    1);
+    }
 
-    //while a little more complex, this way avoids branching or comparisons
-    //against dimension while filling the memory
+  //the vertex ids of the tessellation are relative to the entity, so
+  //offset them by where its points start in the collection
+  const smtk::mesh::Handle global_coordinate_offset =
+    this->m_firstVertHandle + ent.pointOffset;
+  const std::size_t* pointIds = this->m_pointIds ?
+    &(*this->m_pointIds)[ent.pointOffset] : NULL;
+  std::vector<smtk::mesh::Handle*> currentConnLoc(smtk::mesh::CellType_MAX, NULL);
+  for(int ctype=0; ctype < smtk::mesh::CellType_MAX; ++ctype)
+    {
+    if(ent.numCells[ctype] > 0)
+      {
+      const smtk::mesh::CellType cellType = static_cast<smtk::mesh::CellType>(ctype);
+      currentConnLoc[ctype] = this->m_meshConn[ctype] +
+        ent.cellOffset[ctype] * smtk::mesh::verticesPerCell(cellType);
+      }
+    }
 
-    if(dimension == 3)
+  const std::vector<int>& tessConn = tess->conn();
+  for (Tess::size_type start_off = tess->begin();
+       start_off != tess->end();
+       start_off = tess->nextCellOffset(start_off))
+    {
+    //fetch the number of cell vertices, and the cell type in a single query
+    Tess::size_type cell_type;
+    Tess::size_type numVertsPerCell = tess->numberOfCellVertices(start_off, &cell_type);
+    Tess::size_type cell_shape = tess->cellShapeFromType(cell_type);
+    if(!isConvertedShape(cell_shape))
       {
-      for( std::size_t i=0; i < length; i+=3, pos++)
-        {
-        meshCoords[0][pos] = modelCoords[i];
-        meshCoords[1][pos] = modelCoords[i+1];
-        meshCoords[2][pos] = modelCoords[i+2];
-        }
+      continue;
       }
-    else if(dimension == 2)
+
+    //read the vertex ids in place instead of copying them out with
+    //vertexIdsOfCell, skipping the cell type and any vertex count
+    const int* cell_conn = &tessConn[start_off + 1 +
+      ((cell_type & smtk::model::TESS_VARYING_VERT_CELL) ? 1 : 0)];
+    smtk::mesh::Handle*& conn = currentConnLoc[tessToSMTKCell(cell_shape)];
+    if(pointIds)
       {
-      for( std::size_t i=0; i < length; i+=2, pos++)
+      for (int j=0; j < numVertsPerCell; ++j)
         {
-        meshCoords[0][pos] = modelCoords[i];
-        meshCoords[1][pos] = modelCoords[i+1];
+        conn[j] = this->m_firstVertHandle + pointIds[cell_conn[j]];
         }
-      std::fill( meshCoords[2], meshCoords[2] + numPointsToAlloc, double(0));
       }
-    else if(dimension == 1)
+    else
       {
-      for(std::size_t i=0; i < length; i++, pos++)
+      for (int j=0; j < numVertsPerCell; ++j)
         {
-        meshCoords[0][pos] = modelCoords[i];
+        conn[j] = global_coordinate_offset + cell_conn[j];
         }
-      std::fill( meshCoords[1], meshCoords[1] + numPointsToAlloc, double(0));
-      std::fill( meshCoords[2], meshCoords[2] + numPointsToAlloc, double(0));
       }
+    conn += numVertsPerCell;
     }
+  }
 
-  //return true if we have copied each coordinate from the tessellation
-  //into the mesh database.
-  return (pos == numPointsToAlloc);
+private:
+  const std::vector<EntityTessellation>& m_ents;
+  smtk::mesh::Handle m_firstVertHandle;
+  const std::vector<double*>& m_meshCoords;
+  const std::vector<smtk::mesh::Handle*>& m_meshConn;
+  const std::vector<std::size_t>* m_pointIds;
+};
 
+//----------------------------------------------------------------------------
+//the count handles of range that start at the given offset
+smtk::mesh::HandleRange subrange(const smtk::mesh::HandleRange& range,
+                                 std::size_t offset,
+                                 std::size_t count)
+{
+  smtk::mesh::HandleRange result;
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = range.const_pair_begin(); p != range.const_pair_end() && count > 0; ++p)
+    {
+    const std::size_t pairSize = static_cast<std::size_t>(p->second - p->first) + 1;
+    if(offset >= pairSize)
+      {
+      offset -= pairSize;
+      continue;
+      }
+    const std::size_t n = std::min(count, pairSize - offset);
+    result.insert(p->first + offset, p->first + offset + n - 1);
+    count -= n;
+    offset = 0;
+    }
+  return result;
 }
 
 //----------------------------------------------------------------------------
-template<typename MappingType>
+//Convert the tessellations of the entities in three stages: count the
+//points and cells of every entity in parallel and assign each entity its
+//offsets with a prefix sum, allocate the points and each cell type once for
+//all the entities, then fill that memory for every entity in parallel.
+//When weldTolerance isn't negative the points of all the entities are
+//welded before they are allocated, so only the kept points are allocated.
 std::map<smtk::model::EntityRef, smtk::mesh::HandleRange>
-convert_cells(const smtk::model::EntityRefs& ents,
-              MappingType& mapping,
-              const smtk::mesh::AllocatorPtr& ialloc)
+convert_entities(const smtk::model::EntityRefs& ents,
+                 const smtk::mesh::AllocatorPtr& ialloc,
+                 double weldTolerance)
 {
-  typedef smtk::model::Tessellation Tess;
-  typedef typename MappingType::value_type value_type;
-
   std::map<smtk::model::EntityRef, smtk::mesh::HandleRange> newlyCreatedCells;
 
+  std::vector<EntityTessellation> tessellations;
   smtk::model::EntityIterator it;
   it.traverse(ents.begin(), ents.end(), smtk::model::ITERATE_BARE);
   for (it.begin(); !it.isAtEnd(); ++it)
     {
-    smtk::mesh::HandleRange cellsForThisEntity;
-    const smtk::model::EntityRef& refForThisEntity = it.current();
-
     //we filtered out all ents without tess already, so this can't be null
-    const Tess* tess = it->hasTessellation();
-
-    // Convert the connectivity of this volume tesselation to a meshset.
-    // We make 2 passes through the tessellation: one to determine the
-    // allocation and another to create the cells. Note that each cell
-    // type must be put in a separate handle range.
-    //
-    // TODO: This does not handle triangle strips/fans or other cell types
-    //       with a varying number of vertices per cell.
-    Tess::size_type start_off;
-    std::vector<std::size_t> numCellsOfType(smtk::mesh::CellType_MAX, 0);
-    for (start_off = tess->begin();
-         start_off != tess->end();
-         start_off = tess->nextCellOffset(start_off))
-         //from end means that we properly handle runs of the same cell type
-      {
-      Tess::size_type cell_type;
-      tess->numberOfCellVertices(start_off, &cell_type);
-      Tess::size_type cell_shape = tess->cellShapeFromType(cell_type);
-      if(cell_shape == smtk::model::TESS_VERTEX   ||
-         cell_shape == smtk::model::TESS_TRIANGLE ||
-         cell_shape == smtk::model::TESS_QUAD)
-        numCellsOfType[tessToSMTKCell(cell_shape)]++;
-      }
+    EntityTessellation ent;
+    ent.entity = it.current();
+    ent.tess = it->hasTessellation();
+    ent.dimension = it->embeddingDimension();
+    tessellations.push_back(ent);
+    }
+  if(tessellations.empty())
+    {
+    return newlyCreatedCells;
+    }
 
-    // Allocate handles.
-    typedef std::pair<smtk::mesh::HandleRange, smtk::mesh::Handle*> HandleData;
-    HandleData blank;
-    blank.second = NULL;
-    std::vector<HandleData> cellMBConn(smtk::mesh::CellType_MAX, blank);
-    std::vector<HandleData>::iterator allocIt = cellMBConn.begin();
-    std::vector<std::size_t>::iterator cellsOfTypeIt = numCellsOfType.begin();
-    for (std::size_t ctype = 0; ctype != smtk::mesh::CellType_MAX; ++ctype, ++cellsOfTypeIt, ++allocIt)
+  CountTessellation count(tessellations);
+  smtk::common::Parallel::forEach(tessellations.size(), count);
+
+  std::size_t numPointsToAlloc = 0;
+  std::vector<std::size_t> numCellsToAlloc(smtk::mesh::CellType_MAX, 0);
+  typedef std::vector<EntityTessellation>::iterator e_it;
+  for(e_it e = tessellations.begin(); e != tessellations.end(); ++e)
+    {
+    e->pointOffset = numPointsToAlloc;
+    numPointsToAlloc += e->numPoints;
+    for(int ctype=0; ctype < smtk::mesh::CellType_MAX; ++ctype)
       {
-      if (*cellsOfTypeIt <= 0)
-        continue;
-
-      smtk::mesh::CellType cellType = static_cast<smtk::mesh::CellType>(ctype);
-      int numVertsPerCell = smtk::mesh::verticesPerCell(cellType);
-
-      if (
-        !ialloc->allocateCells(
-          cellType, *cellsOfTypeIt, numVertsPerCell,
-          allocIt->first, allocIt->second))
-        { // error
-        std::cerr << "Could not allocate cells\n";
-        }
+      e->cellOffset[ctype] = numCellsToAlloc[ctype];
+      numCellsToAlloc[ctype] += e->numCells[ctype];
       }
+    }
 
-    std::vector<int> cell_conn;
-    numCellsOfType = std::vector<std::size_t>(smtk::mesh::CellType_MAX, 0);
-    for (start_off = tess->begin();
-         start_off != tess->end();
-         start_off = tess->nextCellOffset(start_off))
+  //number the kept points in order, and move their coordinates to match
+  std::vector<double> xyz;
+  std::vector<std::size_t> pointIds;
+  if(weldTolerance >= 0 && numPointsToAlloc > 0)
+    {
+    xyz.resize(3 * numPointsToAlloc);
+    GatherPoints gather(tessellations, xyz);
+    smtk::common::Parallel::forEach(tessellations.size(), gather);
+
+    std::vector<std::size_t> remap;
+    smtk::mesh::weldPoints(&xyz[0], numPointsToAlloc, weldTolerance, remap);
+    pointIds.resize(numPointsToAlloc);
+    std::size_t numKept = 0;
+    for(std::size_t i=0; i < numPointsToAlloc; ++i)
       {
-      //fetch the number of cell vertices, and the cell type in a single query
-      Tess::size_type cell_type;
-      Tess::size_type numVertsPerCell = tess->numberOfCellVertices(start_off, &cell_type);
-      Tess::size_type cell_shape = tess->cellShapeFromType(cell_type);
-
-      //convert from tess type to smtk cell type
-      const smtk::mesh::CellType cellType = tessToSMTKCell( cell_shape );
-
-      //the most efficient way to allocate is to do batch allocation, so lets
-      //iterate all cells of the same shape. This can only be done for
-      //points, triangles and quads, as everything else has variable cell length
-      if(cell_shape != smtk::model::TESS_VERTEX   &&
-         cell_shape != smtk::model::TESS_TRIANGLE &&
-         cell_shape != smtk::model::TESS_QUAD)
+      if(remap[i] == i)
         {
-        continue;
+        std::copy(&xyz[3*i], &xyz[3*i] + 3, &xyz[3*numKept]);
+        pointIds[i] = numKept++;
         }
-
-      int idx = numCellsOfType[cellType]++;
-      std::size_t global_coordinate_offset = mapping[*it];
-
-      smtk::mesh::Handle* currentConnLoc = cellMBConn[cellType].second + numVertsPerCell * idx;
-      cell_conn.reserve(numVertsPerCell);
-      tess->vertexIdsOfCell(start_off, cell_conn);
-      for (int j=0; j < numVertsPerCell; ++j)
+      else
         {
-        //we need to fix the cell_conn to account for the fact that the
-        //values contained within are all relative to the tessellation and
-        //we need location based on the total sum of all tessellations.
-        //local position + ( total connectivity added before the tess ) should
-        //be correct.
-        currentConnLoc[j] = global_coordinate_offset + cell_conn[j];
+        pointIds[i] = pointIds[remap[i]];
         }
-
-      //this is horribly important. vertexIdsOfCell is implemented by using
-      //insert() and end() which means that it appends, and if we don't clear
-      //the vector we will append onto the end and have an vector that
-      //holds 2 triangles of connectivity ( than 3,4,5, etc).
-      //We also use clear, to reduce the number of memory allocation we require
-      cell_conn.clear();
       }
+    numPointsToAlloc = numKept;
+    }
 
-    allocIt = cellMBConn.begin();
-    cellsOfTypeIt = numCellsOfType.begin();
-    for (std::size_t ctype = 0; ctype != smtk::mesh::CellType_MAX; ++ctype, ++cellsOfTypeIt, ++allocIt)
+  std::vector<double *> meshCoords;
+  smtk::mesh::Handle firstVertHandle = 0;
+  if(numPointsToAlloc > 0 &&
+     !ialloc->allocatePoints(numPointsToAlloc, firstVertHandle, meshCoords))
+    {
+    std::cerr << "Could not allocate points\n";
+    return newlyCreatedCells;
+    }
+  if(!pointIds.empty())
+    {
+    for(std::size_t i=0; i < numPointsToAlloc; ++i)
       {
-      if (*cellsOfTypeIt <= 0)
-        continue;
+      meshCoords[0][i] = xyz[3*i];
+      meshCoords[1][i] = xyz[3*i+1];
+      meshCoords[2][i] = xyz[3*i+2];
+      }
+    }
 
-      smtk::mesh::CellType cellType = static_cast<smtk::mesh::CellType>(ctype);
-      int numVertsPerCell = smtk::mesh::verticesPerCell(cellType);
+  std::vector<smtk::mesh::HandleRange> createdCells(smtk::mesh::CellType_MAX);
+  std::vector<smtk::mesh::Handle*> meshConn(smtk::mesh::CellType_MAX, NULL);
+  for(int ctype=0; ctype < smtk::mesh::CellType_MAX; ++ctype)
+    {
+    if(numCellsToAlloc[ctype] == 0)
+      {
+      continue;
+      }
+    const smtk::mesh::CellType cellType = static_cast<smtk::mesh::CellType>(ctype);
+    if(!ialloc->allocateCells(cellType, numCellsToAlloc[ctype],
+                              smtk::mesh::verticesPerCell(cellType),
+                              createdCells[ctype], meshConn[ctype]))
+      {
+      std::cerr << "Could not allocate cells\n";
+      return newlyCreatedCells;
+      }
+    }
 
-      // notify database that we have written to connectivity, that way
-      // it can properly update adjacencies and other database info
-      ialloc->connectivityModified(allocIt->first,
-                                   numVertsPerCell,
-                                   allocIt->second);
+  FillTessellation fill(tessellations, firstVertHandle, meshCoords, meshConn,
+                        pointIds.empty() ? NULL : &pointIds);
+  smtk::common::Parallel::forEach(tessellations.size(), fill);
 
-      //we need to add these cells to the range that represents all
-      //cells for this volume
-      cellsForThisEntity.insert(allocIt->first.begin(), allocIt->first.end());
+  for(int ctype=0; ctype < smtk::mesh::CellType_MAX; ++ctype)
+    {
+    if(numCellsToAlloc[ctype] == 0)
+      {
+      continue;
       }
+    // notify database that we have written to connectivity, that way
+    // it can properly update adjacencies and other database info
+    const smtk::mesh::CellType cellType = static_cast<smtk::mesh::CellType>(ctype);
+    ialloc->connectivityModified(createdCells[ctype],
+                                 smtk::mesh::verticesPerCell(cellType),
+                                 meshConn[ctype]);
+    }
 
-    //save all the cells of this volume
-    newlyCreatedCells.insert( std::make_pair(refForThisEntity,cellsForThisEntity) );
+  //each entity owns a contiguous run of the cells of every type
+  for(e_it e = tessellations.begin(); e != tessellations.end(); ++e)
+    {
+    smtk::mesh::HandleRange cellsForThisEntity;
+    for(int ctype=0; ctype < smtk::mesh::CellType_MAX; ++ctype)
+      {
+      if(e->numCells[ctype] > 0)
+        {
+        cellsForThisEntity.merge(
+          subrange(createdCells[ctype], e->cellOffset[ctype], e->numCells[ctype]) );
+        }
+      }
+    newlyCreatedCells.insert( std::make_pair(e->entity, cellsForThisEntity) );
     }
   return newlyCreatedCells;
 }
@@ -305,13 +472,18 @@ convert_cells(const smtk::model::EntityRefs& ents,
 } //namespace detail
 
 
+//----------------------------------------------------------------------------
+ModelToMesh::ModelToMesh():
+  m_weldTolerance(-1)
+{
+}
+
 //----------------------------------------------------------------------------
 smtk::mesh::CollectionPtr ModelToMesh::operator()(const smtk::mesh::ManagerPtr& meshManager,
                                                   const smtk::model::ManagerPtr& modelManager) const
 {
   typedef smtk::model::EntityRefs EntityRefs;
   typedef smtk::model::EntityTypeBits EntityTypeBits;
-  typedef std::map< smtk::model::EntityRef, std::size_t > CoordinateOffsetMap;
 
   smtk::mesh::CollectionPtr nullCollectionPtr;
   if(!meshManager || !modelManager )
@@ -331,41 +503,33 @@ smtk::mesh::CollectionPtr ModelToMesh::operator()(const smtk::mesh::ManagerPtr&
   smtk::mesh::AllocatorPtr ialloc = iface->allocator();
   collection->setModelManager(modelManager);
 
-  //We create a new mesh each for the Edge(s), Face(s) and Volume(s).
-  //the MODEL_ENTITY will be associated with the meshset that contains all
-  // meshes.
-  CoordinateOffsetMap coordinateLocationMapping;
-
+  //We create a new mesh for each Vertex, Edge, Face and Volume that has
+  //a tessellation, and associate it with that entity. Welding needs to see
+  //the points of every entity at once, so then they are converted together.
+  const bool weld = this->m_weldTolerance >= 0;
   EntityTypeBits etypes[4] = { smtk::model::VERTEX, smtk::model::EDGE,
                                smtk::model::FACE, smtk::model::VOLUME };
-  for(int i=0; i != 4; ++i)
-    {
-    //extract all the coordinates from every tessellation and make a single
-    //big pool
-    EntityTypeBits entType = etypes[i];
-    EntityRefs currentEnts = modelManager->entitiesMatchingFlagsAs<EntityRefs>(entType);
-    detail::removeOnesWithoutTess(currentEnts);
-    detail::convert_vertices(currentEnts,
-                             coordinateLocationMapping,
-                             ialloc);
-    }
-
-
-  //We need to iterate over each model i think here
-  //next we convert all volumes, faces, edges, and vertices that have tessellation
+  EntityRefs weldedEnts;
   for(int i=0; i != 4; ++i)
   {
   EntityTypeBits entType = etypes[i];
   EntityRefs currentEnts = modelManager->entitiesMatchingFlagsAs<EntityRefs>(entType);
   detail::removeOnesWithoutTess( currentEnts );
+  if( weld )
+    {
+    weldedEnts.insert(currentEnts.begin(), currentEnts.end());
+    if( i != 3 )
+      {
+      continue;
+      }
+    currentEnts.swap(weldedEnts);
+    }
   if( !currentEnts.empty() )
     {
-    //for each volume entity we need to create a range of handles
-    //that represent the cell ids for that volume.
+    //for each entity we need to create a range of handles
+    //that represent the cell ids for that entity.
     std::map<smtk::model::EntityRef, smtk::mesh::HandleRange> per_ent_cells =
-        detail::convert_cells(currentEnts,
-                              coordinateLocationMapping,
-                              ialloc);
+        detail::convert_entities(currentEnts, ialloc, this->m_weldTolerance);
 
     typedef std::map<smtk::model::EntityRef, smtk::mesh::HandleRange>::const_iterator c_it;
     for(c_it i= per_ent_cells.begin(); i != per_ent_cells.end(); ++i)
@@ -375,11 +539,9 @@ smtk::mesh::CollectionPtr ModelToMesh::operator()(const smtk::mesh::ManagerPtr&
       smtk::mesh::MeshSet ms = collection->createMesh(cellsForMesh);
       collection->addAssociation(i->first, ms);
       }
-    // collection->addAssociation(ModelEntityRef, all_ms);
     }
   }
 
-
   return collection;
 
 }
@@ -18,9 +18,21 @@ namespace io {
 class SMTKCORE_EXPORT ModelToMesh
 {
 public:
+  ModelToMesh();
+
+  //Weld the points of the tessellations that are within tolerance of each
+  //other while converting, so that entities sharing a point share it in the
+  //collection too. A negative tolerance, the default, welds nothing, and
+  //zero welds only identical points.
+  void setWeldTolerance(double tolerance) { this->m_weldTolerance = tolerance; }
+  double weldTolerance() const { return this->m_weldTolerance; }
+
   //convert smtk::model to a collection
   smtk::mesh::CollectionPtr operator()(const smtk::mesh::ManagerPtr& meshManager,
                                        const smtk::model::ManagerPtr& modelManager) const;
+
+private:
+  double m_weldTolerance;
 };
 
 }
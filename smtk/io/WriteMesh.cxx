@@ -13,6 +13,7 @@
 #include "smtk/mesh/Collection.h"
 #include "smtk/mesh/Manager.h"
 #include "smtk/mesh/moab/Writers.h"
+#include "smtk/mesh/native/Writers.h"
 
 namespace smtk {
   namespace io {
@@ -77,6 +78,12 @@ bool WriteMesh::onlyDirichlet(const std::string& filePath,
   return smtk::mesh::moab::write_dirichlet(filePath, collection);
 }
 
+bool WriteMesh::entireBinary(const std::string& filePath,
+                             smtk::mesh::CollectionPtr collection)
+{
+  return smtk::mesh::native::write(filePath, collection);
+}
+
 
 }
 }
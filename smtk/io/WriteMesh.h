@@ -67,6 +67,12 @@ public:
   //Overwrites any existing content in the file
   static bool onlyDirichlet(const std::string& filePath,
                             smtk::mesh::CollectionPtr collection);
+
+  //Saves the entire collection to File in the native binary format, which
+  //ImportMesh::entireBinary can memory map. Overwrites any existing content
+  //in the file
+  static bool entireBinary(const std::string& filePath,
+                           smtk::mesh::CollectionPtr collection);
 };
 
   }
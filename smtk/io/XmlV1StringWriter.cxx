@@ -905,7 +905,7 @@ void XmlV1StringWriter::processAttribute(xml_node &attributes,
       //     even though it is much simpler, as that method
       //     will generate a descriptive name if none exists.
       smtk::model::UUIDWithStringProperties sprops = storage->stringPropertiesForEntity(*it);
-      smtk::model::PropertyNameWithStrings sprop;
+      smtk::model::StringProperties::iterator sprop;
       if (
         sprops != storage->stringProperties().end() &&
         ((sprop = sprops->second.find("name")) != sprops->second.end()) &&
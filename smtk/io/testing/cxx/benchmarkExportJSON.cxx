@@ -0,0 +1,99 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/io/ExportJSON.h"
+
+#include "smtk/common/Parallel.h"
+
+#include "smtk/model/Manager.h"
+#include "smtk/model/Tessellation.h"
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <stdlib.h>
+
+using namespace smtk::model;
+using namespace smtk::model::testing;
+using namespace smtk::io;
+
+/// Give each face of a discrete model a triangulated \a n x \a n grid.
+void tessellateFaces(ManagerPtr sm, const smtk::common::UUIDArray& cells, int n)
+{
+  for (std::size_t c = 0; c < cells.size(); ++c)
+    {
+    if (sm->findEntity(cells[c])->dimension() != 2)
+      continue;
+
+    Tessellation& tess(sm->tessellations()[cells[c]]);
+    for (int j = 0; j < n; ++j)
+      for (int i = 0; i < n; ++i)
+        tess.addCoords(i + 0.1 * c, j + 0.01 * c, 0.37 * ((i * j + c) % 11));
+    for (int j = 0; j + 1 < n; ++j)
+      {
+      for (int i = 0; i + 1 < n; ++i)
+        {
+        int p = j * n + i;
+        tess.addTriangle(p, p + 1, p + n + 1);
+        tess.addTriangle(p, p + n + 1, p + n);
+        }
+      }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+  int numTets = argc > 1 ? atoi(argv[1]) : 500;
+  int gridSize = argc > 2 ? atoi(argv[2]) : 40;
+
+  ManagerPtr sm = Manager::create();
+  smtk::common::UUIDArray cells = createTetCells(sm, numTets, true);
+  tessellateFaces(sm, cells, gridSize);
+
+  Timer t;
+  double serialTime = 0.;
+  std::string serialJSON;
+  std::size_t maxThreads = smtk::common::Parallel::numberOfThreads();
+  std::cout
+    << sm->topology().size() << " entities, " << sm->tessellations().size()
+    << " faces with " << gridSize * gridSize << " points each\n";
+  std::vector<std::size_t> threadCounts;
+  for (std::size_t threads = 1; threads < maxThreads; threads *= 2)
+    threadCounts.push_back(threads);
+  threadCounts.push_back(maxThreads);
+
+  for (std::size_t tc = 0; tc < threadCounts.size(); ++tc)
+    {
+    std::size_t threads = threadCounts[tc];
+    smtk::common::Parallel::setNumberOfThreads(threads);
+    std::ostringstream out;
+    t.mark();
+    ExportJSON::fromModelManagerToStream(out, sm);
+    double deltaT = t.elapsed();
+    if (threads == 1)
+      {
+      serialTime = deltaT;
+      serialJSON = out.str();
+      }
+    else if (out.str() != serialJSON)
+      {
+      std::cerr << "Output with " << threads << " threads differs from the serial output.\n";
+      return 1;
+      }
+    std::cout
+      << "  " << threads << " threads: " << deltaT << " seconds, "
+      << (out.str().size() / deltaT / 1048576.) << " MiB/sec, "
+      << (serialTime / deltaT) << "x speedup\n";
+    }
+  smtk::common::Parallel::setNumberOfThreads(maxThreads);
+
+  return 0;
+}
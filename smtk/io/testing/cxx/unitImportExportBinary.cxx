@@ -0,0 +1,246 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/io/ExportBinary.h"
+#include "smtk/io/ExportJSON.h"
+#include "smtk/io/ImportBinary.h"
+#include "smtk/io/ImportJSON.h"
+
+#include "smtk/model/DefaultSession.h"
+#include "smtk/model/Manager.h"
+#include "smtk/model/Session.h"
+#include "smtk/model/SessionIOBinary.h"
+#include "smtk/model/SessionRef.h"
+#include "smtk/model/Tessellation.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace smtk::io;
+using namespace smtk::model;
+using namespace smtk::common;
+
+// A delegate that stores a fixed string and remembers what it was given.
+class TestBinaryIO : public SessionIOBinary
+{
+public:
+  smtkTypeMacro(TestBinaryIO);
+  smtkCreateMacro(TestBinaryIO);
+
+  static std::string s_imported;
+
+  virtual int importBinary(ManagerPtr, const char* sessionData, std::size_t size)
+    {
+    s_imported.assign(sessionData, size);
+    return 1;
+    }
+
+  virtual int exportBinary(ManagerPtr, std::string& sessionData)
+    {
+    sessionData = std::string("native\0data", 11);
+    return 1;
+    }
+};
+std::string TestBinaryIO::s_imported;
+
+class TestBinarySession : public smtk::model::DefaultSession
+{
+public:
+  smtkTypeMacro(TestBinarySession);
+  smtkSuperclassMacro(smtk::model::DefaultSession);
+  smtkCreateMacro(TestBinarySession);
+  smtkSharedFromThisMacro(Session);
+  smtkDeclareModelingKernel();
+
+protected:
+  TestBinarySession()
+    {
+    this->initializeOperatorSystem(TestBinarySession::s_operators);
+    }
+
+  virtual SessionIOPtr createIODelegate(const std::string& format)
+    {
+    if (format == "binary")
+      return TestBinaryIO::create();
+    return this->Superclass::createIODelegate(format);
+    }
+};
+smtkImplementsModelingKernel(
+  /* no export symbol */,
+  binarytest,
+  "{\"kernel\":\"binarytest\", \"engines\":[]}",
+  SessionHasNoStaticSetup,
+  TestBinarySession,
+  true
+);
+
+std::string exportAll(ManagerPtr sm)
+{
+  return ExportJSON::fromModelManager(sm,
+    static_cast<JSONFlags>(
+      JSON_ENTITIES | JSON_TESSELLATIONS | JSON_ANALYSISMESH | JSON_PROPERTIES));
+}
+
+std::string exportBinary(ManagerPtr sm)
+{
+  std::ostringstream out;
+  test(ExportBinary::fromModelManager(out, sm) == 1, "Binary export failed.");
+  return out.str();
+}
+
+ManagerPtr createModel(UUIDArray& uids)
+{
+  ManagerPtr sm = Manager::create();
+  uids = smtk::model::testing::createTet(sm);
+  sm->setFloatProperty(uids[0], "area", 1.25);
+  sm->setFloatProperty(uids[1], "range", FloatList(3, 0.1));
+  sm->setFloatProperty(uids[1], "empty", FloatList());
+  sm->setStringProperty(uids[2], "name", std::string("nul\0 and caf\xc3\xa9", 13));
+  StringList labels;
+  labels.push_back("");
+  labels.push_back("label");
+  sm->setStringProperty(uids[2], "labels", labels);
+  sm->setStringProperty(uids[3], "name", "shared name");
+  sm->setIntegerProperty(uids[3], "ids", IntegerList(4, -7));
+  sm->setIntegerProperty(uids[4], "big", 1L << 40);
+  sm->analysisMesh()[uids[21]].addCoords(0., 1., 2.).addCoords(3., 4., 5.);
+  sm->tessellations()[uids[20]];
+
+  // An entity whose arrangement dictionary exists but is empty.
+  uids.push_back(sm->addEntityOfTypeAndDimension(GROUP_ENTITY, -1));
+  sm->arrangements()[uids.back()];
+  return sm;
+}
+
+void testRoundTrip()
+{
+  UUIDArray uids;
+  ManagerPtr sm = createModel(uids);
+  SessionRef native = sm->createSession("native");
+  SessionRef custom = sm->createSession("binarytest");
+  test(custom.isValid(), "Could not create test session.");
+
+  std::string archive = exportBinary(sm);
+  test(archive.size() % 8 == 0, "Archive should be padded to 8 bytes.");
+  test(archive.compare(0, 8, "SMTKARCH") == 0, "Bad archive header.");
+  test(exportBinary(sm) == archive, "Export should be repeatable.");
+
+  ManagerPtr sm2 = Manager::create();
+  TestBinaryIO::s_imported.clear();
+  test(ImportBinary::intoModelManager(archive.data(), archive.size(), sm2) == 1,
+    "Binary import failed.");
+  test(exportAll(sm2) == exportAll(sm), "Binary archive did not round trip.");
+  test(sm2->stringProperty(uids[2], "name")[0] == sm->stringProperty(uids[2], "name")[0],
+    "Strings with embedded nulls did not round trip.");
+  test(sm2->integerProperty(uids[4], "big")[0] == (1L << 40),
+    "Large integers did not round trip.");
+  test(sm2->arrangements().find(uids.back()) != sm2->arrangements().end(),
+    "Empty arrangement dictionary was not kept.");
+  test(sm2->tessellations().find(uids[20]) != sm2->tessellations().end(),
+    "Empty tessellation was not kept.");
+  test(SessionRef(sm2, native.entity()).session() &&
+    SessionRef(sm2, native.entity()).session()->name() == "native",
+    "Native session was not restored.");
+  test(SessionRef(sm2, custom.entity()).session() &&
+    SessionRef(sm2, custom.entity()).session()->name() == "binarytest",
+    "Test session was not restored.");
+  test(TestBinaryIO::s_imported == std::string("native\0data", 11),
+    "Session data did not round trip.");
+  test(exportBinary(sm2) == archive, "Re-exported archive differs.");
+
+  // Importing into a manager that holds the entities updates them the
+  // way JSON import does.
+  ManagerPtr tet = Manager::create();
+  UUIDArray tetUids = smtk::model::testing::createTet(tet);
+  tet->setIntegerProperty(tetUids[3], "ids", IntegerList(4, -7));
+  std::string tetArchive = exportBinary(tet);
+  std::string json = exportAll(tet);
+  ManagerPtr jsonMgr = Manager::create();
+  ManagerPtr binaryMgr = Manager::create();
+  for (int pass = 0; pass < 2; ++pass)
+    {
+    test(ImportJSON::intoModelManager(json.c_str(), jsonMgr) == 1, "JSON import failed.");
+    test(ImportBinary::intoModelManager(tetArchive.data(), tetArchive.size(), binaryMgr) == 1,
+      "Binary import failed.");
+    }
+  test(exportAll(binaryMgr) == exportAll(jsonMgr), "Binary re-import differs from JSON re-import.");
+
+  // Round trip through a file, which is memory-mapped where possible.
+  const char* filename = "unitImportExportBinary.smtkb";
+  test(ExportBinary::fromModelManagerToFile(sm, filename), "Could not write archive file.");
+  ManagerPtr sm3 = Manager::create();
+  test(ImportBinary::intoModelManagerFromFile(filename, sm3) == 1, "Could not read archive file.");
+  test(exportAll(sm3) == exportAll(sm), "Archive file did not round trip.");
+  std::remove(filename);
+  test(ImportBinary::intoModelManagerFromFile(filename, sm3) == 0,
+    "Reading a missing file should fail.");
+
+  // An empty manager round trips too.
+  ManagerPtr empty = Manager::create();
+  std::string emptyArchive = exportBinary(empty);
+  ManagerPtr sm4 = Manager::create();
+  test(ImportBinary::intoModelManager(emptyArchive.data(), emptyArchive.size(), sm4) == 1,
+    "Empty archive import failed.");
+  test(exportAll(sm4) == exportAll(empty), "Empty archive did not round trip.");
+}
+
+void testInvalidArchives()
+{
+  UUIDArray uids;
+  ManagerPtr sm = createModel(uids);
+  std::string archive = exportBinary(sm);
+
+  // Every truncation is rejected and leaves the manager untouched.
+  for (std::size_t size = 0; size < archive.size(); size += (size < 64 ? 1 : 29))
+    {
+    ManagerPtr dest = Manager::create();
+    test(ImportBinary::intoModelManager(archive.data(), size, dest) == 0,
+      "Truncated archive should be rejected.");
+    test(dest->topology().empty(), "A rejected archive modified the manager.");
+    }
+  test(ImportBinary::intoModelManager(NULL, 0, Manager::create()) == 0,
+    "Missing data should be rejected.");
+  test(ImportBinary::intoModelManager(archive.data(), archive.size(), ManagerPtr()) == 0,
+    "A missing manager should be rejected.");
+
+  // So are corrupt bytes in the header, trailer and section table.
+  std::size_t tableStart = archive.size() - 24 - 11 * 24;
+  std::size_t corrupt[] = {
+    0, 8, 12, archive.size() - 1, archive.size() - 16, archive.size() - 24,
+    tableStart, tableStart + 8, tableStart + 16 };
+  for (std::size_t i = 0; i < sizeof(corrupt) / sizeof(corrupt[0]); ++i)
+    {
+    std::string bad(archive);
+    bad[corrupt[i]] = static_cast<char>(bad[corrupt[i]] ^ 0x40);
+    ManagerPtr dest = Manager::create();
+    test(ImportBinary::intoModelManager(bad.data(), bad.size(), dest) == 0,
+      "Corrupt archive should be rejected.");
+    test(dest->topology().empty(), "A corrupt archive modified the manager.");
+    }
+
+  // Flipping bytes inside the sections must never read out of bounds.
+  for (std::size_t pos = 16; pos < tableStart; pos += 7)
+    {
+    std::string bad(archive);
+    bad[pos] = static_cast<char>(~bad[pos]);
+    ImportBinary::intoModelManager(bad.data(), bad.size(), Manager::create());
+    }
+}
+
+int main()
+{
+  testRoundTrip();
+  testInvalidArchives();
+  return 0;
+}
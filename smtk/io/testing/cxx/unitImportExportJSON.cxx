@@ -7,12 +7,28 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //=========================================================================
+#include "smtk/AutoInit.h"
+
 #include "smtk/io/ExportJSON.h"
 #include "smtk/io/ExportJSON.txx"
 #include "smtk/io/ImportJSON.h"
 #include "smtk/io/Logger.h"
+#include "smtk/io/ModelToMesh.h"
+
+#include "smtk/common/Parallel.h"
+
+#include "smtk/attribute/IntItem.h"
+#include "smtk/attribute/MeshItem.h"
+#include "smtk/attribute/StringItem.h"
 
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Handle.h"
+
+#include "smtk/model/CellEntity.h"
 #include "smtk/model/Manager.h"
+#include "smtk/model/Model.h"
+#include "smtk/model/Operator.h"
+#include "smtk/model/SessionRef.h"
 
 #include "smtk/common/testing/cxx/helpers.h"
 #include "smtk/model/testing/cxx/helpers.h"
@@ -21,8 +37,13 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
 using namespace smtk::io;
@@ -30,6 +51,8 @@ using namespace smtk::model;
 using namespace smtk::common;
 using smtk::shared_ptr;
 
+smtkComponentInitMacro(smtk_set_property_operator);
+
 void testLoggerSerialization1()
 {
   // round-trip an empty log
@@ -118,11 +141,276 @@ void testModelExport()
   std::cout << "json for vertex is \n" << json << "\n";
 }
 
+// Import JSON into a manager through a cJSON tree, as ImportJSON used to.
+int importWithTree(const std::string& json, ManagerPtr sm)
+{
+  cJSON* root = cJSON_Parse(json.c_str());
+  if (!root)
+    return 0;
+  int status = 0;
+  cJSON* mtyp = cJSON_GetObjectItem(root, "type");
+  if (mtyp && mtyp->type == cJSON_String && !strcmp(mtyp->valuestring, "Manager"))
+    status = ImportJSON::ofManager(cJSON_GetObjectItem(root, "topo"), sm);
+  cJSON_Delete(root);
+  return status;
+}
+
+std::string exportAll(ManagerPtr sm)
+{
+  return ExportJSON::fromModelManager(sm,
+    static_cast<JSONFlags>(
+      JSON_ENTITIES | JSON_TESSELLATIONS | JSON_ANALYSISMESH | JSON_PROPERTIES));
+}
+
+// The streaming import must produce the same manager as the tree.
+void testStreamingImportMatches(const std::string& json, int expectedStatus)
+{
+  ManagerPtr streamed = Manager::create();
+  ManagerPtr tree = Manager::create();
+  int status = ImportJSON::intoModelManager(json.c_str(), streamed);
+  test(status == expectedStatus, "Unexpected status from streaming import.");
+  test(importWithTree(json, tree) == expectedStatus, "Unexpected status from tree import.");
+  std::string exported = exportAll(streamed);
+  std::string expected = exportAll(tree);
+  if (exported != expected)
+    {
+    std::cout << "Streamed:\n" << exported << "\nExpected:\n" << expected << "\n";
+    }
+  test(exported == expected, "Streaming import differs from the cJSON tree.");
+}
+
+void testStreamingImport()
+{
+  ManagerPtr sm = Manager::create();
+  UUIDArray uids = smtk::model::testing::createTet(sm);
+  sm->setFloatProperty(uids[0], "area", 1.25);
+  sm->setFloatProperty(uids[1], "range", FloatList(3, 0.1));
+  sm->setFloatProperty(uids[1], "empty", FloatList());
+  sm->setStringProperty(uids[2], "name", "tab\tquote\"slash\\ caf\xc3\xa9");
+  sm->setIntegerProperty(uids[3], "ids", IntegerList(4, -7));
+  sm->analysisMesh()[uids[21]].addCoords(0., 1., 2.).addCoords(3., 4., 5.);
+
+  std::string json = ExportJSON::fromModelManager(sm,
+    static_cast<JSONFlags>(
+      JSON_ENTITIES | JSON_TESSELLATIONS | JSON_ANALYSISMESH | JSON_PROPERTIES));
+  testStreamingImportMatches(json, 1);
+
+  ManagerPtr sm2 = Manager::create();
+  test(ImportJSON::intoModelManager(json.c_str(), sm2) == 1, "Streaming import failed.");
+  test(exportAll(sm2) == exportAll(sm), "Streaming import did not round trip.");
+  test(sm2->stringProperty(uids[2], "name")[0] == sm->stringProperty(uids[2], "name")[0],
+    "Escaped strings did not round trip.");
+
+  // Hand-written records: the type follows the records, values are given
+  // as strings or single values, keys repeat, and strings use escapes.
+  testStreamingImportMatches(
+    "{ \"topo\": {\n"
+    "  \"0a5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\": {\n"
+    "    \"e\": \"256\", \"d\": 3, \"e\": 1,\n"
+    "    \"r\": [\"1b5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\", 5, \"2b5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\"],\n"
+    "    \"t\": { \"vertices\": [0, \"1.5\", -2.5e-3, 1e30, null], \"faces\": [0, 3, \"x\", 0, 1, 2] },\n"
+    "    \"f\": { \"single\": 0.1, \"\": [1], \"list\": [1, \"2\", true, 3.25] },\n"
+    "    \"s\": { \"num\": 1.5, \"esc\": [\"\\u00e9\\ud83d\\ude00\\/\\n\", \"\", \"x\"] },\n"
+    "    \"i\": { \"v\": [\"12\", 3, \"1x\"], \"w\": 9 }\n"
+    "  },\n"
+    "  \"1b5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\": {\n"
+    "    \"e\": 2, \"d\": 1, \"a\": { \"b\": [[0, 1], [], [\"2\"]], \"bogus\": [[1]] }\n"
+    "  },\n"
+    "  \"\": { \"e\": 1, \"d\": 0 }\n"
+    "}, \"type\": \"Manager\" }", 1);
+
+  // A record without an entity stops the import after that record.
+  testStreamingImportMatches(
+    "{ \"type\": \"Manager\", \"topo\": {"
+    "  \"0a5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\": { \"d\": 3, \"f\": { \"x\": 1 } },"
+    "  \"1b5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\": { \"e\": 2, \"d\": 1 } } }", 0);
+
+  // Nothing is imported from invalid documents.
+  const char* invalid[] = {
+    "{ \"type\": \"Other\", \"topo\": {} }",
+    "[1, 2]",
+    "{}",
+    "{ \"type\": \"Manager\", \"topo\": { \"0a5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\": { \"e\": 1, \"d\": 0 } }",
+    "{ \"type\": \"Manager\", \"topo\": { \"0a5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\": { \"e\": 1, \"d\": 0, } } }",
+    "{ \"type\": \"Manager\", \"topo\": { \"0a5d0fa0-3a21-4b6b-8b3a-2b8c4a8a1f11\": { \"e\": 1., \"d\": 0 } } }"
+  };
+  for (int i = 0; i < 6; ++i)
+    {
+    ManagerPtr empty = Manager::create();
+    test(ImportJSON::intoModelManager(invalid[i], empty) == 0, "Invalid JSON should not import.");
+    test(empty->topology().empty(), "Invalid JSON should not add records.");
+    }
+}
+
+std::string printTree(cJSON* json)
+{
+  char* printed = cJSON_Print(json);
+  std::string result(printed);
+  free(printed);
+  cJSON_Delete(json);
+  return result;
+}
+
+// The streaming export must print exactly what cJSON prints for the tree,
+// whether records are encoded serially or in parallel.
+void testStreamingExportMatches(ManagerPtr sm, JSONFlags sections)
+{
+  cJSON* json = cJSON_CreateObject();
+  ExportJSON::fromModelManager(json, sm, sections);
+  std::string expected = printTree(json);
+
+  // Nested as the value of a member, as the fetch-model reply does.
+  cJSON* reply = cJSON_CreateObject();
+  json = cJSON_CreateObject();
+  ExportJSON::fromModelManager(json, sm, sections);
+  cJSON_AddItemToObject(reply, "result", json);
+  std::string expectedNested = printTree(reply);
+
+  std::size_t numThreads = smtk::common::Parallel::numberOfThreads();
+  for (std::size_t threads = 1; threads <= 3; threads += 2)
+    {
+    smtk::common::Parallel::setNumberOfThreads(threads);
+    std::string streamed = ExportJSON::fromModelManager(sm, sections);
+    if (streamed != expected)
+      {
+      std::cout << "Streamed:\n" << streamed << "\nExpected:\n" << expected << "\n";
+      }
+    test(streamed == expected, "Streaming export differs from the cJSON tree.");
+
+    std::ostringstream nested;
+    nested << "{\n\t\"result\":\t";
+    ExportJSON::fromModelManagerToStream(nested, sm, sections, 1);
+    nested << "\n}";
+    test(nested.str() == expectedNested, "Nested streaming export differs from the cJSON tree.");
+    }
+  smtk::common::Parallel::setNumberOfThreads(numThreads);
+}
+
+void testStreamingExport()
+{
+  ManagerPtr sm = Manager::create();
+  UUIDArray uids = smtk::model::testing::createTet(sm);
+  SessionRef sess = sm->createSession("native");
+
+  // Numbers that take each of cJSON's formats, and the edges between them.
+  double special[] = {
+    0., -0., 1., -1., 0.1, -2.5, 123456.789, 1.0e-6, 9.99e-7, -1.0e-7,
+    1.0e9, 1.0e9 + 0.5, -3.0e9, 1.0e20, 1.0e70, 1.0000005, 0.0000015,
+    2.5e-7, 1.0e-20, INT_MAX, INT_MIN, 2147483648., -2147483649., 4503599627370497.,
+    DBL_MAX, DBL_MIN, DBL_EPSILON, 1. + DBL_EPSILON, 1.0 / 3.0, 0.0000005
+  };
+  sm->setFloatProperty(uids[0], "special",
+    FloatList(special, special + sizeof(special) / sizeof(special[0])));
+
+  // Values of every magnitude, most of which take the hand-written path.
+  FloatList values;
+  srand(12345);
+  for (int i = 0; i < 20000; ++i)
+    {
+    double mantissa = static_cast<double>(rand()) / RAND_MAX - 0.5;
+    values.push_back(mantissa * pow(10., (i % 24) - 10));
+    }
+  sm->setFloatProperty(uids[1], "random", values);
+  sm->setFloatProperty(uids[1], "empty", FloatList());
+  sm->setStringProperty(uids[2], "name", "tab\tquote\"slash\\ caf\xc3\xa9 \x01\x1f");
+  sm->setStringProperty(uids[2], "", "");
+  IntegerList ints;
+  ints.push_back(-7);
+  ints.push_back(LONG_MAX / 4096);
+  ints.push_back(INT_MIN);
+  sm->setIntegerProperty(uids[3], "ids", ints);
+  sm->analysisMesh()[uids[21]].addCoords(0., 1., 2.).addCoords(3.25, 4., -5.5);
+
+  Model model = sm->addModel(3, 3, "tet");
+  model.addCell(CellEntity(sm, uids[21]));
+  smtk::io::ModelToMesh convert;
+  test(!!convert(sm->meshes(), sm), "Could not convert the model to a mesh.");
+
+  testStreamingExportMatches(sm, JSON_DEFAULT);
+  testStreamingExportMatches(sm, JSON_CLIENT_DATA);
+  testStreamingExportMatches(sm, JSON_TESSELLATIONS);
+  testStreamingExportMatches(sm, JSON_NOTHING);
+  testStreamingExportMatches(sm, static_cast<JSONFlags>(JSON_MESHES | JSON_COMPACT_HANDLES));
+  testStreamingExportMatches(Manager::create(), JSON_DEFAULT);
+
+  // Enough records for several batches of parallel encoding.
+  ManagerPtr many = Manager::create();
+  UUIDArray cells = smtk::model::testing::createTetCells(many, 200, true);
+  for (std::size_t i = 0; i < cells.size(); i += 3)
+    {
+    many->setFloatProperty(cells[i], "weight", 0.5 * i);
+    many->setIntegerProperty(cells[i], "index", static_cast<long>(i));
+    }
+  SessionRef manySession = many->createSession("native");
+  testStreamingExportMatches(many, JSON_DEFAULT);
+  testStreamingExportMatches(many, JSON_ENTITIES);
+}
+
+/// Check that \a key of \a dictionary and \a compact hold the same handles in each form.
+void testHandleForms(cJSON* dictionary, cJSON* compact, const char* key)
+{
+  cJSON* dk = dictionary ? cJSON_GetObjectItem(dictionary, key) : NULL;
+  cJSON* ck = compact ? cJSON_GetObjectItem(compact, key) : NULL;
+  test(dk && dk->type != cJSON_String, "Expected handles in the dictionary form by default.");
+  test(ck && ck->type == cJSON_String, "Expected compact handles when asked for.");
+  test(smtk::mesh::from_json(dk) == smtk::mesh::from_json(ck), "Handle forms differ.");
+}
+
+/// Operator results can carry the collections they modify with compact handles.
+void testOperatorResultHandles()
+{
+  ManagerPtr sm = Manager::create();
+  UUIDArray uids = smtk::model::testing::createTet(sm);
+  SessionRef sess = sm->createSession("native");
+  Model model = sm->addModel(3, 3, "tet");
+  model.addCell(CellEntity(sm, uids[21]));
+  smtk::io::ModelToMesh convert;
+  smtk::mesh::CollectionPtr collection = convert(sm->meshes(), sm);
+  test(collection && !collection->meshes().is_empty(), "Could not convert the model to a mesh.");
+
+  OperatorPtr op = sess.op("set property");
+  test(!!op, "No \"set property\" operator.");
+  op->specification()->findString("name")->setValue("weight");
+  op->specification()->findInt("integer value")->appendValue(3);
+  op->specification()->findMesh("meshes")->appendValue(collection->meshes());
+  op->associateEntity(EntityRef(sm, uids[21]));
+  OperatorResult result = op->operate();
+  test(result->findInt("outcome")->value() == OPERATION_SUCCEEDED, "Operator failed.");
+
+  cJSON* dictionary = cJSON_CreateObject();
+  ExportJSON::forOperatorResult(result, dictionary);
+  cJSON* compact = cJSON_CreateObject();
+  ExportJSON::forOperatorResult(result, compact,
+    static_cast<JSONFlags>(JSON_DEFAULT | JSON_COMPACT_HANDLES));
+
+  std::string cid = collection->entity().toString();
+  cJSON* records[] = { dictionary, compact };
+  for (int i = 0; i < 2; ++i)
+    {
+    test((records[i] = cJSON_GetObjectItem(records[i], "mesh_records")) &&
+      (records[i] = cJSON_GetObjectItem(records[i], "mesh_collections")) &&
+      (records[i] = cJSON_GetObjectItem(records[i], cid.c_str())),
+      "Expected the modified collection in the operator result.");
+    }
+  testHandleForms(records[0], records[1], "meshIds");
+  cJSON* dmesh = cJSON_GetObjectItem(records[0], "meshes");
+  cJSON* cmesh = cJSON_GetObjectItem(records[1], "meshes");
+  test(dmesh && cmesh && dmesh->child && cmesh->child, "Expected mesh records.");
+  testHandleForms(dmesh->child, cmesh->child, "cells");
+  testHandleForms(dmesh->child, cmesh->child, "points");
+
+  cJSON_Delete(dictionary);
+  cJSON_Delete(compact);
+}
+
 int main(int argc, char* argv[])
 {
   testLoggerSerialization1();
   testLoggerSerialization2();
   testModelExport();
+  testStreamingImport();
+  testStreamingExport();
+  testOperatorResultHandles();
 
   int debug = argc > 2 ? 1 : 0;
   std::ifstream file(argc > 1 ? argv[1] : "testOut");
@@ -0,0 +1,875 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Adjacencies.h"
+#include "smtk/mesh/PointConnectivity.h"
+#include "smtk/mesh/PointSet.h"
+
+#include "smtk/common/Parallel.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace smtk {
+namespace mesh {
+
+namespace
+{
+
+const std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+//pieces smaller than this cost more to schedule than to build
+const std::size_t MinimumPieceSize = 4096;
+
+//----------------------------------------------------------------------------
+//The edges or faces of a cell in the canonical (moab) ordering, so that
+//the faces of a well oriented cell face outwards.
+struct SubEntityTable
+{
+  int numEntities;
+  int entitySize[12];
+  int entity[12][4];
+};
+
+const SubEntityTable triangleEdges = { 3, {2,2,2}, {{0,1},{1,2},{2,0}} };
+const SubEntityTable quadEdges = { 4, {2,2,2,2}, {{0,1},{1,2},{2,3},{3,0}} };
+const SubEntityTable tetEdges = { 6, {2,2,2,2,2,2},
+  {{0,1},{1,2},{2,0},{0,3},{1,3},{2,3}} };
+const SubEntityTable pyramidEdges = { 8, {2,2,2,2,2,2,2,2},
+  {{0,1},{1,2},{2,3},{3,0},{0,4},{1,4},{2,4},{3,4}} };
+const SubEntityTable wedgeEdges = { 9, {2,2,2,2,2,2,2,2,2},
+  {{0,1},{1,2},{2,0},{0,3},{1,4},{2,5},{3,4},{4,5},{5,3}} };
+const SubEntityTable hexEdges = { 12, {2,2,2,2,2,2,2,2,2,2,2,2},
+  {{0,1},{1,2},{2,3},{3,0},{0,4},{1,5},{2,6},{3,7},{4,5},{5,6},{6,7},{7,4}} };
+
+const SubEntityTable tetFaces = { 4, {3,3,3,3},
+  {{0,1,3},{1,2,3},{0,3,2},{0,2,1}} };
+const SubEntityTable pyramidFaces = { 5, {3,3,3,3,4},
+  {{0,1,4},{1,2,4},{2,3,4},{3,0,4},{0,3,2,1}} };
+const SubEntityTable wedgeFaces = { 5, {4,4,4,3,3},
+  {{0,1,4,3},{1,2,5,4},{0,3,5,2},{0,2,1},{3,4,5}} };
+const SubEntityTable hexFaces = { 6, {4,4,4,4,4,4},
+  {{0,1,5,4},{1,2,6,5},{2,3,7,6},{0,4,7,3},{0,3,2,1},{4,5,6,7}} };
+
+//----------------------------------------------------------------------------
+int cellDimension(smtk::mesh::CellType type)
+{
+  switch(type)
+    {
+    case smtk::mesh::Vertex: return 0;
+    case smtk::mesh::Line: return 1;
+    case smtk::mesh::Triangle:
+    case smtk::mesh::Quad:
+    case smtk::mesh::Polygon: return 2;
+    default: return 3;
+    }
+}
+
+//----------------------------------------------------------------------------
+const SubEntityTable* subEntityTable(smtk::mesh::CellType type, int dim)
+{
+  if(dim == 1)
+    {
+    switch(type)
+      {
+      case smtk::mesh::Triangle:    return &triangleEdges;
+      case smtk::mesh::Quad:        return &quadEdges;
+      case smtk::mesh::Tetrahedron: return &tetEdges;
+      case smtk::mesh::Pyramid:     return &pyramidEdges;
+      case smtk::mesh::Wedge:       return &wedgeEdges;
+      case smtk::mesh::Hexahedron:  return &hexEdges;
+      default: break;
+      }
+    }
+  else if(dim == 2)
+    {
+    switch(type)
+      {
+      case smtk::mesh::Tetrahedron: return &tetFaces;
+      case smtk::mesh::Pyramid:     return &pyramidFaces;
+      case smtk::mesh::Wedge:       return &wedgeFaces;
+      case smtk::mesh::Hexahedron:  return &hexFaces;
+      default: break;
+      }
+    }
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+//the number of edges (dim 1) or faces (dim 2) of a cell. A cell of that
+//dimension is its own sub-entity, as long as it is small enough to be the
+//edge or face of another cell
+int subEntityCount(smtk::mesh::CellType type, int numPts, int dim)
+{
+  const int cellDim = cellDimension(type);
+  if(cellDim == dim)
+    {
+    return (numPts <= 4) ? 1 : 0;
+    }
+  else if(cellDim < dim)
+    {
+    return 0;
+    }
+  else if(type == smtk::mesh::Polygon)
+    {
+    return numPts;
+    }
+  const SubEntityTable* table = subEntityTable(type, dim);
+  return table ? table->numEntities : 0;
+}
+
+//----------------------------------------------------------------------------
+//the points of the ith edge or face of a cell in the orientation of the
+//cell, returning how many there are
+int subEntityPoints(smtk::mesh::CellType type,
+                    const smtk::mesh::Handle* points,
+                    int numPts,
+                    int dim,
+                    int i,
+                    smtk::mesh::Handle result[4])
+{
+  if(cellDimension(type) == dim)
+    {
+    std::copy(points, points + numPts, result);
+    return numPts;
+    }
+  else if(type == smtk::mesh::Polygon)
+    {
+    result[0] = points[i];
+    result[1] = points[(i + 1) % numPts];
+    return 2;
+    }
+  const SubEntityTable* table = subEntityTable(type, dim);
+  for(int j=0; j < table->entitySize[i]; ++j)
+    {
+    result[j] = points[table->entity[i][j]];
+    }
+  return table->entitySize[i];
+}
+
+//----------------------------------------------------------------------------
+//an edge or face keyed on its sorted points, with unused slots left as 0,
+//which is never a valid handle
+struct Key
+{
+  smtk::mesh::Handle p[4];
+};
+
+bool operator==(const Key& a, const Key& b)
+{
+  return std::equal(a.p, a.p + 4, b.p);
+}
+
+bool operator<(const Key& a, const Key& b)
+{
+  return std::lexicographical_compare(a.p, a.p + 4, b.p, b.p + 4);
+}
+
+//----------------------------------------------------------------------------
+//the use of an edge or face by the ith slot of a cell
+struct Use
+{
+  Key key;
+  std::size_t cell;
+  std::size_t slot;
+};
+
+bool operator<(const Use& a, const Use& b)
+{
+  if(!(a.key == b.key))
+    {
+    return a.key < b.key;
+    }
+  return a.cell < b.cell || (a.cell == b.cell && a.slot < b.slot);
+}
+
+//----------------------------------------------------------------------------
+//an edge or face and its id, kept sorted by key so that cells added later
+//can find the sub-entities they share with the indexed cells
+struct KeyEntity
+{
+  Key key;
+  std::size_t id;
+};
+
+bool operator<(const KeyEntity& a, const KeyEntity& b)
+{
+  return a.key < b.key;
+}
+
+//----------------------------------------------------------------------------
+//split [0, size) into about as many pieces as threads can use
+std::vector<std::size_t> pieceBounds(std::size_t size)
+{
+  std::size_t numPieces = smtk::common::Parallel::numberOfThreads() * 4;
+  numPieces = std::min(numPieces, size / MinimumPieceSize);
+  numPieces = std::max(numPieces, static_cast<std::size_t>(1));
+
+  std::vector<std::size_t> bounds(numPieces + 1);
+  for(std::size_t i=0; i <= numPieces; ++i)
+    {
+    bounds[i] = (size * i) / numPieces;
+    }
+  return bounds;
+}
+
+//----------------------------------------------------------------------------
+//build a range from sorted handles
+smtk::mesh::HandleRange toRange(const std::vector<smtk::mesh::Handle>& handles)
+{
+  smtk::mesh::HandleRange result;
+  smtk::mesh::HandleRange::iterator hint = result.begin();
+  const std::size_t size = handles.size();
+  for(std::size_t i = 0; i < size;)
+    {
+    std::size_t j;
+    for(j = i + 1; j < size && handles[j] == 1 + handles[j-1]; j++);
+      //empty for loop
+    hint = result.insert( hint, handles[i], handles[i] + (j-i-1) );
+    i = j;
+    }
+  return result;
+}
+
+}
+
+//----------------------------------------------------------------------------
+class Adjacencies::Internals
+{
+public:
+  //the edges (dim 1) or faces (dim 2) of every cell as compressed rows
+  //both ways. Each cell has a slot per sub-entity, or a single slot for
+  //its own id when it is a sub-entity itself
+  struct Table
+  {
+    Table(): Built(false) {}
+
+    bool Built;
+    std::vector<std::size_t> CellOffsets;
+    std::vector<std::size_t> CellEntities;
+    std::vector<std::size_t> EntityOffsets;
+    std::vector<std::size_t> EntityCells; //only cells of higher dimension
+    std::vector<std::size_t> ExistingCell; //npos when there is no cell
+    std::vector<KeyEntity> Keys;
+  };
+
+  //cells are numbered in the order they were indexed, which is the order
+  //of their handles unless cells were added later
+  smtk::mesh::HandleRange Cells;
+  std::vector<smtk::mesh::Handle> CellHandles;
+  std::vector< std::pair<smtk::mesh::Handle, std::size_t> > CellLookup; //by handle
+  std::vector<smtk::mesh::CellType> CellTypes;
+  std::vector<std::size_t> CellOffsets;
+  std::vector<smtk::mesh::Handle> Connectivity;
+
+  std::vector<smtk::mesh::Handle> PointHandles;
+  std::vector<std::size_t> PointIds; //Connectivity as indices of PointHandles
+  std::vector<std::size_t> PointOffsets;
+  std::vector<std::size_t> PointCells;
+
+  mutable Table Tables[3];
+
+  //--------------------------------------------------------------------------
+  class MapPoints : public smtk::common::ParallelTask
+  {
+  public:
+    MapPoints(Internals* self, std::size_t start, const std::vector<std::size_t>& bounds):
+      m_self(self), m_start(start), m_bounds(bounds) {}
+
+    void execute(std::size_t piece)
+    {
+    const std::vector<smtk::mesh::Handle>& points = this->m_self->PointHandles;
+    const std::size_t last = this->m_start + this->m_bounds[piece+1];
+    for(std::size_t i=this->m_start + this->m_bounds[piece]; i < last; ++i)
+      {
+      this->m_self->PointIds[i] = static_cast<std::size_t>(
+        std::lower_bound(points.begin(), points.end(),
+                         this->m_self->Connectivity[i]) - points.begin());
+      }
+    }
+
+  private:
+    Internals* m_self;
+    std::size_t m_start;
+    const std::vector<std::size_t>& m_bounds;
+  };
+
+  //--------------------------------------------------------------------------
+  class FindUses : public smtk::common::ParallelTask
+  {
+  public:
+    //finds the uses of the cells from firstCell on
+    FindUses(const Internals* self, int dim, std::size_t firstCell,
+             std::vector<Use>& uses, const std::vector<std::size_t>& bounds):
+      m_self(self), m_dim(dim), m_firstCell(firstCell), m_uses(uses), m_bounds(bounds) {}
+
+    void execute(std::size_t piece)
+    {
+    const Table& table = this->m_self->Tables[this->m_dim];
+    const std::size_t base = table.CellOffsets[this->m_firstCell];
+    const std::size_t last = this->m_firstCell + this->m_bounds[piece+1];
+    smtk::mesh::Handle points[4];
+    for(std::size_t c=this->m_firstCell + this->m_bounds[piece]; c < last; ++c)
+      {
+      const std::size_t first = table.CellOffsets[c];
+      const std::size_t numSlots = table.CellOffsets[c+1] - first;
+      for(std::size_t s=0; s < numSlots; ++s)
+        {
+        Use& use = this->m_uses[first - base + s];
+        const int n = this->m_self->subEntity(c, this->m_dim, static_cast<int>(s), points);
+        std::fill(use.key.p, use.key.p + 4, 0);
+        std::copy(points, points + n, use.key.p);
+        std::sort(use.key.p, use.key.p + n);
+        use.cell = c;
+        use.slot = s;
+        }
+      }
+    }
+
+  private:
+    const Internals* m_self;
+    int m_dim;
+    std::size_t m_firstCell;
+    std::vector<Use>& m_uses;
+    const std::vector<std::size_t>& m_bounds;
+  };
+
+  //--------------------------------------------------------------------------
+  void indexCells(const smtk::mesh::CellSet& cs)
+  {
+  this->Cells = cs.range();
+  const smtk::mesh::HandleRange points = cs.points().range();
+  this->PointHandles.assign(points.begin(), points.end());
+  this->CellOffsets.push_back(0);
+  this->appendCells(cs);
+  this->indexPoints();
+  }
+
+  //--------------------------------------------------------------------------
+  //index cells that use only indexed points, numbering them after the
+  //cells already indexed. Edge and face tables that have been built are
+  //extended rather than rebuilt.
+  bool addCells(const smtk::mesh::CellSet& cs)
+  {
+  const smtk::mesh::HandleRange points = cs.points().range();
+  for(smtk::mesh::HandleRange::const_iterator p = points.begin(); p != points.end(); ++p)
+    {
+    if(!std::binary_search(this->PointHandles.begin(), this->PointHandles.end(), *p))
+      {
+      return false;
+      }
+    }
+
+  const std::size_t firstCell = this->CellHandles.size();
+  this->Cells.merge(cs.range());
+  this->appendCells(cs);
+  this->indexPoints();
+  for(int dim=1; dim < 3; ++dim)
+    {
+    if(this->Tables[dim].Built)
+      {
+      this->extendTable(dim, firstCell);
+      }
+    }
+  return true;
+  }
+
+  //--------------------------------------------------------------------------
+  //copy the types and connectivity of cells and map their points
+  void appendCells(const smtk::mesh::CellSet& cs)
+  {
+  const std::size_t firstCell = this->CellHandles.size();
+  const std::size_t firstConn = this->Connectivity.size();
+
+  //the connectivity blocks list the cells in the order of their range
+  const smtk::mesh::HandleRange cells = cs.range();
+  smtk::mesh::PointConnectivity pc = cs.pointConnectivity();
+  smtk::mesh::HandleRange::const_iterator cell = cells.begin();
+  for(std::size_t b=0; b < pc.numberOfBlocks(); ++b)
+    {
+    const smtk::mesh::ConnectivityBlock block = pc.block(b);
+    const smtk::mesh::Handle* conn = block.connectivity;
+    for(std::size_t c=0; c < block.numberOfCells; ++c, ++cell)
+      {
+      this->CellHandles.push_back(*cell);
+      this->CellTypes.push_back(block.cellType);
+      this->Connectivity.insert(this->Connectivity.end(), conn, conn + block.vertsPerCell);
+      conn += block.vertsPerCell;
+      this->CellOffsets.push_back(this->Connectivity.size());
+      }
+    }
+
+  this->PointIds.resize(this->Connectivity.size());
+  const std::vector<std::size_t> bounds = pieceBounds(this->Connectivity.size() - firstConn);
+  MapPoints mapper(this, firstConn, bounds);
+  smtk::common::Parallel::forEach(bounds.size() - 1, mapper);
+
+  //the new cells are in handle order, so merging keeps the lookup sorted
+  std::vector< std::pair<smtk::mesh::Handle, std::size_t> > added;
+  for(std::size_t c=firstCell; c < this->CellHandles.size(); ++c)
+    {
+    added.push_back(std::make_pair(this->CellHandles[c], c));
+    }
+  std::vector< std::pair<smtk::mesh::Handle, std::size_t> > lookup(
+    this->CellLookup.size() + added.size());
+  std::merge(this->CellLookup.begin(), this->CellLookup.end(),
+             added.begin(), added.end(), lookup.begin());
+  this->CellLookup.swap(lookup);
+  }
+
+  //--------------------------------------------------------------------------
+  void indexPoints()
+  {
+  //a counting sort of the cells by the points they use, skipping repeated
+  //points of a cell
+  const std::size_t numCells = this->CellHandles.size();
+  this->PointOffsets.assign(this->PointHandles.size() + 1, 0);
+  for(std::size_t c=0; c < numCells; ++c)
+    {
+    for(std::size_t i=this->CellOffsets[c]; i < this->CellOffsets[c+1]; ++i)
+      {
+      if(!this->repeatsPoint(c, i))
+        {
+        ++this->PointOffsets[this->PointIds[i] + 1];
+        }
+      }
+    }
+  for(std::size_t p=0; p < this->PointHandles.size(); ++p)
+    {
+    this->PointOffsets[p+1] += this->PointOffsets[p];
+    }
+
+  std::vector<std::size_t> next(this->PointOffsets.begin(), this->PointOffsets.end() - 1);
+  this->PointCells.resize(this->PointOffsets.back());
+  for(std::size_t c=0; c < numCells; ++c)
+    {
+    for(std::size_t i=this->CellOffsets[c]; i < this->CellOffsets[c+1]; ++i)
+      {
+      if(!this->repeatsPoint(c, i))
+        {
+        this->PointCells[next[this->PointIds[i]]++] = c;
+        }
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  bool repeatsPoint(std::size_t cell, std::size_t i) const
+  {
+  const std::size_t* begin = &this->PointIds[0] + this->CellOffsets[cell];
+  const std::size_t* end = &this->PointIds[0] + i;
+  return std::find(begin, end, this->PointIds[i]) != end;
+  }
+
+  //--------------------------------------------------------------------------
+  const Table& table(int dim) const
+  {
+  Table& table = this->Tables[dim];
+  if(table.Built)
+    {
+    return table;
+    }
+
+  const std::size_t numCells = this->CellHandles.size();
+  table.CellOffsets.resize(numCells + 1);
+  table.CellOffsets[0] = 0;
+  for(std::size_t c=0; c < numCells; ++c)
+    {
+    table.CellOffsets[c+1] = table.CellOffsets[c] +
+      subEntityCount(this->CellTypes[c], this->cellSize(c), dim);
+    }
+
+  //find every use of an edge or face, then sort them so uses of the same
+  //one are next to each other
+  std::vector<Use> uses(table.CellOffsets[numCells]);
+  const std::vector<std::size_t> bounds = pieceBounds(numCells);
+  FindUses finder(this, dim, 0, uses, bounds);
+  smtk::common::Parallel::forEach(bounds.size() - 1, finder);
+  smtk::common::Parallel::sort(uses);
+
+  table.CellEntities.resize(uses.size());
+  table.EntityOffsets.assign(1, 0);
+  table.EntityCells.reserve(uses.size());
+  for(std::size_t i=0; i < uses.size();)
+    {
+    //ids are given in key order, so Keys stays sorted
+    const std::size_t id = table.ExistingCell.size();
+    const KeyEntity entity = { uses[i].key, id };
+    table.Keys.push_back(entity);
+    std::size_t existing = npos;
+    std::size_t j = i;
+    for(; j < uses.size() && uses[j].key == uses[i].key; ++j)
+      {
+      const Use& use = uses[j];
+      table.CellEntities[table.CellOffsets[use.cell] + use.slot] = id;
+      if(this->dimension(use.cell) == dim)
+        {
+        existing = (existing == npos) ? use.cell : existing;
+        }
+      else
+        {
+        table.EntityCells.push_back(use.cell);
+        }
+      }
+    table.ExistingCell.push_back(existing);
+    table.EntityOffsets.push_back(table.EntityCells.size());
+    i = j;
+    }
+
+  table.Built = true;
+  return table;
+  }
+
+  //--------------------------------------------------------------------------
+  //add the uses of the cells from firstCell on to a built table
+  void extendTable(int dim, std::size_t firstCell) const
+  {
+  Table& table = this->Tables[dim];
+  const std::size_t numCells = this->CellHandles.size();
+  for(std::size_t c=firstCell; c < numCells; ++c)
+    {
+    table.CellOffsets.push_back(table.CellOffsets.back() +
+      subEntityCount(this->CellTypes[c], this->cellSize(c), dim));
+    }
+
+  const std::size_t base = table.CellOffsets[firstCell];
+  std::vector<Use> uses(table.CellOffsets[numCells] - base);
+  const std::vector<std::size_t> bounds = pieceBounds(numCells - firstCell);
+  FindUses finder(this, dim, firstCell, uses, bounds);
+  smtk::common::Parallel::forEach(bounds.size() - 1, finder);
+  smtk::common::Parallel::sort(uses);
+
+  //match the uses with the edges or faces already known, adding the rest
+  const std::size_t oldNumEntities = table.ExistingCell.size();
+  std::vector<KeyEntity> newKeys;
+  std::vector< std::pair<std::size_t, std::size_t> > newEntityCells;
+  table.CellEntities.resize(table.CellOffsets[numCells]);
+  for(std::size_t i=0; i < uses.size();)
+    {
+    const KeyEntity probe = { uses[i].key, 0 };
+    std::vector<KeyEntity>::const_iterator known =
+      std::lower_bound(table.Keys.begin(), table.Keys.end(), probe);
+    std::size_t id;
+    if(known != table.Keys.end() && known->key == probe.key)
+      {
+      id = known->id;
+      }
+    else
+      {
+      id = table.ExistingCell.size();
+      table.ExistingCell.push_back(npos);
+      const KeyEntity entity = { probe.key, id };
+      newKeys.push_back(entity);
+      }
+
+    std::size_t j = i;
+    for(; j < uses.size() && uses[j].key == uses[i].key; ++j)
+      {
+      const Use& use = uses[j];
+      table.CellEntities[table.CellOffsets[use.cell] + use.slot] = id;
+      if(this->dimension(use.cell) == dim)
+        {
+        if(table.ExistingCell[id] == npos)
+          {
+          table.ExistingCell[id] = use.cell;
+          }
+        }
+      else
+        {
+        newEntityCells.push_back(std::make_pair(id, use.cell));
+        }
+      }
+    i = j;
+    }
+
+  //the uses are sorted by key, so the new keys are too
+  std::vector<KeyEntity> keys(table.Keys.size() + newKeys.size());
+  std::merge(table.Keys.begin(), table.Keys.end(),
+             newKeys.begin(), newKeys.end(), keys.begin());
+  table.Keys.swap(keys);
+
+  //the new cells come after the old ones in each row of EntityCells
+  std::sort(newEntityCells.begin(), newEntityCells.end());
+  const std::size_t numEntities = table.ExistingCell.size();
+  std::vector<std::size_t> offsets(numEntities + 1, 0);
+  std::vector<std::size_t> entityCells;
+  entityCells.reserve(table.EntityCells.size() + newEntityCells.size());
+  std::vector< std::pair<std::size_t, std::size_t> >::const_iterator added =
+    newEntityCells.begin();
+  for(std::size_t id=0; id < numEntities; ++id)
+    {
+    if(id < oldNumEntities)
+      {
+      entityCells.insert(entityCells.end(),
+                         table.EntityCells.begin() + table.EntityOffsets[id],
+                         table.EntityCells.begin() + table.EntityOffsets[id+1]);
+      }
+    for(; added != newEntityCells.end() && added->first == id; ++added)
+      {
+      entityCells.push_back(added->second);
+      }
+    offsets[id+1] = entityCells.size();
+    }
+  table.EntityOffsets.swap(offsets);
+  table.EntityCells.swap(entityCells);
+  }
+
+  //--------------------------------------------------------------------------
+  std::size_t cellIndex(smtk::mesh::Handle cell) const
+  {
+  std::vector< std::pair<smtk::mesh::Handle, std::size_t> >::const_iterator i =
+    std::lower_bound(this->CellLookup.begin(), this->CellLookup.end(),
+                     std::make_pair(cell, static_cast<std::size_t>(0)));
+  if(i == this->CellLookup.end() || i->first != cell)
+    {
+    return npos;
+    }
+  return i->second;
+  }
+
+  int dimension(std::size_t cell) const
+    { return cellDimension(this->CellTypes[cell]); }
+
+  int cellSize(std::size_t cell) const
+    { return static_cast<int>(this->CellOffsets[cell+1] - this->CellOffsets[cell]); }
+
+  int subEntity(std::size_t cell, int dim, int i, smtk::mesh::Handle points[4]) const
+  {
+  return subEntityPoints(this->CellTypes[cell],
+                         &this->Connectivity[this->CellOffsets[cell]],
+                         this->cellSize(cell), dim, i, points);
+  }
+
+  //the first cell of dimension zero at a point, or npos
+  std::size_t vertexCell(std::size_t point) const
+  {
+  for(std::size_t i=this->PointOffsets[point]; i < this->PointOffsets[point+1]; ++i)
+    {
+    if(this->dimension(this->PointCells[i]) == 0)
+      {
+      return this->PointCells[i];
+      }
+    }
+  return npos;
+  }
+
+  //the cells of a dimension that use the points of a cell, other than itself
+  void cellsAtPoints(std::size_t cell, int dim, std::vector<std::size_t>& found) const
+  {
+  for(std::size_t i=this->CellOffsets[cell]; i < this->CellOffsets[cell+1]; ++i)
+    {
+    const std::size_t p = this->PointIds[i];
+    for(std::size_t j=this->PointOffsets[p]; j < this->PointOffsets[p+1]; ++j)
+      {
+      const std::size_t other = this->PointCells[j];
+      if(other != cell && this->dimension(other) == dim)
+        {
+        found.push_back(other);
+        }
+      }
+    }
+  }
+
+  //the cells of a dimension that use any of the edges or faces in the
+  //slots of a cell, other than itself
+  void cellsAtEntities(const Table& table, std::size_t cell, int dim,
+                       std::vector<std::size_t>& found) const
+  {
+  for(std::size_t s=table.CellOffsets[cell]; s < table.CellOffsets[cell+1]; ++s)
+    {
+    const std::size_t id = table.CellEntities[s];
+    for(std::size_t j=table.EntityOffsets[id]; j < table.EntityOffsets[id+1]; ++j)
+      {
+      const std::size_t other = table.EntityCells[j];
+      if(other != cell && this->dimension(other) == dim)
+        {
+        found.push_back(other);
+        }
+      }
+    }
+  }
+
+  smtk::mesh::HandleRange handles(std::vector<std::size_t>& cells) const
+  {
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+  std::vector<smtk::mesh::Handle> result(cells.size());
+  for(std::size_t i=0; i < cells.size(); ++i)
+    {
+    result[i] = this->CellHandles[cells[i]];
+    }
+  std::sort(result.begin(), result.end());
+  return toRange(result);
+  }
+};
+
+//----------------------------------------------------------------------------
+Adjacencies::Adjacencies(const smtk::mesh::CellSet& cells):
+  m_internals(new Internals)
+{
+  this->m_internals->indexCells(cells);
+}
+
+//----------------------------------------------------------------------------
+Adjacencies::~Adjacencies()
+{
+  delete this->m_internals;
+}
+
+//----------------------------------------------------------------------------
+const smtk::mesh::HandleRange& Adjacencies::cells() const
+{
+  return this->m_internals->Cells;
+}
+
+//----------------------------------------------------------------------------
+bool Adjacencies::addCells(const smtk::mesh::CellSet& cells)
+{
+  return this->m_internals->addCells(cells);
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Adjacencies::adjacent(const smtk::mesh::HandleRange& cells,
+                                              smtk::mesh::DimensionType fromDim,
+                                              smtk::mesh::DimensionType toDim) const
+{
+  const Internals& self = *this->m_internals;
+  const int from = static_cast<int>(fromDim);
+  const int to = static_cast<int>(toDim);
+  std::vector<std::size_t> found;
+  if(from == 0 && to == 0)
+    {
+    return smtk::mesh::HandleRange();
+    }
+
+  //points relate cells to vertices, and curves to each other
+  const bool byPoints = (from == 0 || to == 0 || (from == 1 && to == 1));
+  const Internals::Table* table = NULL;
+  if(!byPoints)
+    {
+    table = &self.table(std::min(from, to == from ? from - 1 : to));
+    }
+
+  for(smtk::mesh::HandleRange::const_iterator h = cells.begin(); h != cells.end(); ++h)
+    {
+    const std::size_t c = self.cellIndex(*h);
+    if(c == npos || self.dimension(c) != from)
+      {
+      continue;
+      }
+
+    if(byPoints)
+      {
+      self.cellsAtPoints(c, to, found);
+      }
+    else if(to < from)
+      {
+      for(std::size_t s=table->CellOffsets[c]; s < table->CellOffsets[c+1]; ++s)
+        {
+        const std::size_t existing = table->ExistingCell[table->CellEntities[s]];
+        if(existing != npos)
+          {
+          found.push_back(existing);
+          }
+        }
+      }
+    else
+      { //going up the cell is its own sub-entity, and with equal dimensions
+        //cells meet at their sides
+      self.cellsAtEntities(*table, c, to, found);
+      }
+    }
+  return self.handles(found);
+}
+
+//----------------------------------------------------------------------------
+void Adjacencies::subEntities(const smtk::mesh::HandleRange& cells,
+                              smtk::mesh::DimensionType fromDim,
+                              smtk::mesh::DimensionType toDim,
+                              bool boundaryOnly,
+                              smtk::mesh::HandleRange& existing,
+                              std::vector< std::vector< smtk::mesh::Handle > >& missing) const
+{
+  const Internals& self = *this->m_internals;
+  const int from = static_cast<int>(fromDim);
+  const int to = static_cast<int>(toDim);
+  if(to >= from)
+    {
+    return;
+    }
+
+  //count how many of the given cells use each point, edge or face, and
+  //remember the first use so missing ones can be oriented like it
+  const Internals::Table* table = (to == 0) ? NULL : &self.table(to);
+  const std::size_t numEntities = table ? table->ExistingCell.size() : self.PointHandles.size();
+  std::vector<unsigned int> counts(numEntities, 0);
+  std::vector<std::size_t> firstCell(numEntities, npos);
+  std::vector<std::size_t> firstSlot(numEntities, npos);
+  std::vector<std::size_t> seen;
+
+  for(smtk::mesh::HandleRange::const_iterator h = cells.begin(); h != cells.end(); ++h)
+    {
+    const std::size_t c = self.cellIndex(*h);
+    if(c == npos || self.dimension(c) != from)
+      {
+      continue;
+      }
+
+    const std::size_t first = table ? table->CellOffsets[c] : self.CellOffsets[c];
+    const std::size_t last = table ? table->CellOffsets[c+1] : self.CellOffsets[c+1];
+    for(std::size_t s=first; s < last; ++s)
+      {
+      if(!table && self.repeatsPoint(c, s))
+        {
+        continue;
+        }
+      const std::size_t id = table ? table->CellEntities[s] : self.PointIds[s];
+      if(counts[id]++ == 0)
+        {
+        firstCell[id] = c;
+        firstSlot[id] = s - first;
+        seen.push_back(id);
+        }
+      }
+    }
+  std::sort(seen.begin(), seen.end());
+
+  std::vector<smtk::mesh::Handle> found;
+  smtk::mesh::Handle points[4];
+  for(std::vector<std::size_t>::const_iterator id = seen.begin(); id != seen.end(); ++id)
+    {
+    if(boundaryOnly && counts[*id] != 1)
+      {
+      continue;
+      }
+
+    const std::size_t cell = table ? table->ExistingCell[*id] : self.vertexCell(*id);
+    if(cell != npos)
+      {
+      found.push_back(self.CellHandles[cell]);
+      }
+    else if(table)
+      {
+      const int n = self.subEntity(firstCell[*id], to, static_cast<int>(firstSlot[*id]), points);
+      missing.push_back(std::vector<smtk::mesh::Handle>(points, points + n));
+      }
+    else
+      {
+      missing.push_back(std::vector<smtk::mesh::Handle>(1, self.PointHandles[*id]));
+      }
+    }
+
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  existing.merge(toRange(found));
+}
+
+}
+}
@@ -0,0 +1,92 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef __smtk_mesh_Adjacencies_h
+#define __smtk_mesh_Adjacencies_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/PublicPointerDefs.h"
+
+#include "smtk/mesh/CellSet.h"
+#include "smtk/mesh/DimensionTypes.h"
+#include "smtk/mesh/Handle.h"
+
+#include <vector>
+
+namespace smtk {
+namespace mesh {
+
+//Adjacency tables between the cells of a CellSet of every dimension.
+//
+//Cells are related through the points, edges and faces they are made of:
+//the edges of a cell are its 1d sub-entities and the faces of a 3d cell its
+//2d sub-entities, in the canonical (moab) ordering so faces of a well
+//oriented cell point outwards. A sub-entity doesn't need a cell to exist,
+//but when a cell of that dimension has the same points it is the cell of
+//the sub-entity.
+//
+//The point to cell table is built on construction. The tables for edges
+//and faces are built in parallel the first time a query needs them, and
+//kept as compressed rows in both directions: from each cell to its
+//sub-entities, and from each sub-entity to the cells that use it. Like the
+//SpatialIndex the tables are a copy, and Collection::adjacencies() keeps
+//one that is extended when cells are added to the collection (such as by
+//MeshSet::extractShell) and rebuilt when other changes are made.
+//
+//Queries aren't thread safe, since they can build tables.
+class SMTKCORE_EXPORT Adjacencies
+{
+public:
+  Adjacencies(const smtk::mesh::CellSet& cells);
+
+  ~Adjacencies();
+
+  //the cells that were indexed
+  const smtk::mesh::HandleRange& cells() const;
+
+  //index more cells, extending the tables already built. The cells must
+  //not be indexed yet and may only use points of the indexed cells;
+  //returns false, leaving the tables unchanged, when they use other points
+  bool addCells(const smtk::mesh::CellSet& cells);
+
+  //find the existing cells of dimension toDim that are adjacent to the given
+  //cells of dimension fromDim; cells of other dimensions are ignored.
+  // - going down, the cells that are sub-entities of the given cells
+  // - going up, the cells that have a given cell as a sub-entity
+  // - with equal dimensions, the other cells sharing a side with a given
+  //   cell, which is a point for 1d cells
+  smtk::mesh::HandleRange adjacent(const smtk::mesh::HandleRange& cells,
+                                   smtk::mesh::DimensionType fromDim,
+                                   smtk::mesh::DimensionType toDim) const;
+
+  //find the sub-entities of dimension toDim of the given cells of dimension
+  //fromDim, which must be lower. Sub-entities that have a cell are added to
+  //existing, and the points of the others are appended to missing in the
+  //orientation of a cell that uses them. When boundaryOnly is set only the
+  //sub-entities used by exactly one of the given cells are found.
+  void subEntities(const smtk::mesh::HandleRange& cells,
+                   smtk::mesh::DimensionType fromDim,
+                   smtk::mesh::DimensionType toDim,
+                   bool boundaryOnly,
+                   smtk::mesh::HandleRange& existing,
+                   std::vector< std::vector< smtk::mesh::Handle > >& missing) const;
+
+private:
+  Adjacencies( const Adjacencies& other ); //blank since we are used by shared_ptr
+  Adjacencies& operator=( const Adjacencies& other ); //blank since we are used by shared_ptr
+
+  class Internals;
+  Internals* m_internals;
+};
+
+}
+}
+
+#endif
@@ -13,10 +13,44 @@
 
 #include "smtk/mesh/Interface.h"
 #include "smtk/mesh/ContainsFunctors.h"
+#include "smtk/mesh/PointConnectivity.h"
+
+#include "smtk/common/Parallel.h"
+
+#include <algorithm>
 
 namespace smtk {
 namespace mesh {
 
+namespace
+{
+//pieces smaller than this cost more to schedule than to visit
+const std::size_t MinCellsPerPiece = 16384;
+
+//----------------------------------------------------------------------------
+class VisitCellPieces : public smtk::common::ParallelTask
+{
+public:
+  VisitCellPieces(const smtk::mesh::InterfacePtr& iface,
+                  std::vector< smtk::mesh::PointConnectivity >& connectivity,
+                  std::vector< smtk::shared_ptr< CellForEach > >& filters):
+    m_iface(iface),
+    m_connectivity(connectivity),
+    m_filters(filters)
+  {
+  }
+
+  void execute(std::size_t piece)
+  {
+  this->m_iface->cellForEach(this->m_connectivity[piece], *this->m_filters[piece]);
+  }
+
+private:
+  const smtk::mesh::InterfacePtr& m_iface;
+  std::vector< smtk::mesh::PointConnectivity >& m_connectivity;
+  std::vector< smtk::shared_ptr< CellForEach > >& m_filters;
+};
+}
 
 //----------------------------------------------------------------------------
 CellSet::CellSet(const smtk::mesh::CollectionPtr& parent,
@@ -239,5 +273,61 @@ SMTKCORE_EXPORT void for_each(const CellSet& a, CellForEach &filter)
   iface->cellForEach(pc, filter);
 }
 
+//----------------------------------------------------------------------------
+SMTKCORE_EXPORT void for_each(const CellSet& a, CellBlockForEach &filter)
+{
+  smtk::mesh::PointConnectivity pc(a.m_parent, a.m_range);
+
+  filter.m_collection = a.m_parent;
+  const std::size_t numBlocks = pc.numberOfBlocks();
+  for(std::size_t i=0; i < numBlocks; ++i)
+    {
+    filter.forBlock( pc.block(i) );
+    }
+}
+
+//----------------------------------------------------------------------------
+SMTKCORE_EXPORT void parallel_for_each(const CellSet& a, CellForEach &filter)
+{
+  std::size_t numPieces = smtk::common::Parallel::numberOfThreads() * 4;
+  numPieces = std::min(numPieces, a.m_range.size() / MinCellsPerPiece);
+
+  smtk::shared_ptr< CellForEach > first;
+  if(numPieces > 1)
+    {
+    first.reset( filter.clone() );
+    }
+  if(!first)
+    {
+    for_each(a, filter);
+    return;
+    }
+
+  //the connectivity of every piece is gathered up front on this thread, so
+  //the workers only read cell memory. Backends serialize any coordinate
+  //queries that are not safe to make concurrently (moab's get_coords)
+  std::vector< smtk::mesh::HandleRange > ranges =
+    smtk::mesh::split_range(a.m_range, numPieces);
+  std::vector< smtk::mesh::PointConnectivity > connectivity;
+  std::vector< smtk::shared_ptr< CellForEach > > filters;
+  connectivity.reserve(ranges.size());
+  filters.reserve(ranges.size());
+  for(std::size_t i=0; i < ranges.size(); ++i)
+    {
+    connectivity.push_back( smtk::mesh::PointConnectivity(a.m_parent, ranges[i]) );
+    filters.push_back( i == 0 ? first : smtk::shared_ptr< CellForEach >(filter.clone()) );
+    filters.back()->collection(a.m_parent);
+    }
+
+  VisitCellPieces task(a.m_parent->interface(), connectivity, filters);
+  smtk::common::Parallel::forEach(ranges.size(), task);
+
+  filter.collection(a.m_parent);
+  for(std::size_t i=0; i < filters.size(); ++i)
+    {
+    filter.reduce(*filters[i]);
+    }
+}
+
 }
 }
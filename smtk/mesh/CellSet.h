@@ -24,6 +24,8 @@
 namespace smtk {
 namespace mesh {
 
+class StreamingTessellation;
+
 //Represents a collection of cells that have been constructed by a Collection
 //We represent the collection of cells by range of cell id entities. CellSets
 //are a fairly lightweight representation, that are meant to be subdivided
@@ -41,6 +43,10 @@ class SMTKCORE_EXPORT CellSet
   friend CellSet point_intersect( const CellSet& a, const CellSet& b, ContainmentType t);
   friend CellSet point_difference( const CellSet& a, const CellSet& b, ContainmentType t);
   friend void for_each( const CellSet& a, CellForEach& filter);
+  friend void for_each( const CellSet& a, CellBlockForEach& filter);
+  friend void parallel_for_each( const CellSet& a, CellForEach& filter);
+  friend void extractTessellation( const CellSet& a, const PointSet& ps,
+                                   StreamingTessellation& tess);
   friend class Collection; //required for creation of new meshes, deletion of cells
 public:
 
@@ -130,6 +136,16 @@ SMTKCORE_EXPORT CellSet point_difference( const CellSet& a, const CellSet& b,
 //apply a for_each cell operator on all cells of a given set.
 SMTKCORE_EXPORT void for_each( const CellSet& a, CellForEach& filter);
 
+//apply a for_each block operator on all cells of a given set, one
+//homogeneous block of cells at a time.
+SMTKCORE_EXPORT void for_each( const CellSet& a, CellBlockForEach& filter);
+
+//apply a for_each cell operator on all cells of a given set, splitting the
+//cells into pieces that are visited concurrently by clones of the filter.
+//Once all pieces are done the clones are passed to filter.reduce() in order.
+//Falls back to for_each when the filter doesn't implement clone().
+SMTKCORE_EXPORT void parallel_for_each( const CellSet& a, CellForEach& filter);
+
 }
 }
 
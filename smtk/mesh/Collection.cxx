@@ -9,7 +9,9 @@
 //=========================================================================
 
 #include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Adjacencies.h"
 #include "smtk/mesh/Manager.h"
+#include "smtk/mesh/SpatialIndex.h"
 
 #include "smtk/mesh/moab/Interface.h"
 
@@ -21,12 +23,16 @@ class Collection::InternalImpl
 {
 public:
   InternalImpl():
+    IndexModificationCount(0),
+    AdjacencyModificationCount(0),
     WeakManager(),
     Interface( smtk::mesh::moab::make_interface()  )
   {
   }
 
   InternalImpl( smtk::mesh::ManagerPtr mngr ):
+    IndexModificationCount(0),
+    AdjacencyModificationCount(0),
     WeakManager(mngr),
     Interface( smtk::mesh::moab::make_interface() )
   {
@@ -34,6 +40,8 @@ public:
 
   InternalImpl( smtk::mesh::ManagerPtr mngr,
                 smtk::mesh::InterfacePtr interface ):
+    IndexModificationCount(0),
+    AdjacencyModificationCount(0),
     WeakManager(mngr),
     Interface( interface )
   {
@@ -61,6 +69,15 @@ public:
   smtk::mesh::Handle mesh_root_handle() const
     { return this->Interface->getRoot(); }
 
+  //built on demand by Collection::spatialIndex, along with the
+  //allocator's modification count at that time
+  smtk::shared_ptr<smtk::mesh::SpatialIndex> Index;
+  std::size_t IndexModificationCount;
+
+  //built on demand by Collection::adjacencies, along with the
+  //allocator's modification count when they were last built or extended
+  smtk::shared_ptr<smtk::mesh::Adjacencies> Adjacency;
+  std::size_t AdjacencyModificationCount;
 
 
 private:
@@ -471,11 +488,74 @@ bool Collection::removeMeshes(smtk::mesh::MeshSet& meshesToDelete )
     //delete our mesh and cells that aren't used by any one else
     bool deletedMeshes = iface->deleteHandles(meshesToDelete.m_range);
     bool deletedCells = iface->deleteHandles(cellsUsedByDeletedMeshes.m_range);
+    this->invalidateSpatialIndex();
+    this->invalidateAdjacencies();
     return deletedMeshes && deletedCells;
     }
   return false;
 }
 
+//----------------------------------------------------------------------------
+const smtk::mesh::SpatialIndex& Collection::spatialIndex()
+{
+  smtk::mesh::CellSet all = this->cells();
+  smtk::mesh::AllocatorPtr alloc = this->m_internals->mesh_iface()->allocator();
+  const std::size_t modificationCount = alloc ? alloc->modificationCount() : 0;
+  smtk::shared_ptr<smtk::mesh::SpatialIndex>& index = this->m_internals->Index;
+  if(!index || index->cells() != all.range() ||
+     this->m_internals->IndexModificationCount != modificationCount)
+    {
+    index.reset( new smtk::mesh::SpatialIndex(all) );
+    this->m_internals->IndexModificationCount = modificationCount;
+    }
+  return *index;
+}
+
+//----------------------------------------------------------------------------
+void Collection::invalidateSpatialIndex()
+{
+  this->m_internals->Index.reset();
+}
+
+//----------------------------------------------------------------------------
+const smtk::mesh::Adjacencies& Collection::adjacencies()
+{
+  smtk::mesh::CellSet all = this->cells();
+  smtk::mesh::AllocatorPtr alloc = this->m_internals->mesh_iface()->allocator();
+  const std::size_t modificationCount = alloc ? alloc->modificationCount() : 0;
+  smtk::shared_ptr<smtk::mesh::Adjacencies>& adj = this->m_internals->Adjacency;
+  if(adj && adj->cells() != all.range())
+    {
+    //cells that were only added, such as by extractShell, are indexed
+    //without rebuilding the tables of the existing cells
+    smtk::mesh::CellSet indexed(this->shared_from_this(), adj->cells());
+    smtk::mesh::CellSet added = smtk::mesh::set_difference(all, indexed);
+    if(indexed.size() + added.size() != all.size() || !adj->addCells(added))
+      {
+      adj.reset();
+      }
+    }
+  else if(adj &&
+          this->m_internals->AdjacencyModificationCount != modificationCount)
+    {
+    //the same cells, but their connectivity was rewritten through the
+    //allocator
+    adj.reset();
+    }
+  if(!adj)
+    {
+    adj.reset( new smtk::mesh::Adjacencies(all) );
+    }
+  this->m_internals->AdjacencyModificationCount = modificationCount;
+  return *adj;
+}
+
+//----------------------------------------------------------------------------
+void Collection::invalidateAdjacencies()
+{
+  this->m_internals->Adjacency.reset();
+}
+
 //----------------------------------------------------------------------------
 std::vector< smtk::mesh::Domain > Collection::domains()
 {
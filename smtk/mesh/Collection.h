@@ -36,6 +36,9 @@ namespace smtk {
   namespace io { class ImportMesh; }
   namespace mesh {
 
+class Adjacencies;
+class SpatialIndex;
+
 //Flyweight interface around a moab database of meshes. When constructed
 //becomes registered with a manager with a weak relationship.
 class SMTKCORE_EXPORT Collection : public smtk::enable_shared_from_this<Collection>
@@ -85,6 +88,7 @@ public:
   // valid types are:
   // "moab"
   // "json"
+  // "native"
   //Note: all names will be all lower-case
   std::string interfaceName() const;
 
@@ -105,10 +109,6 @@ public:
   smtk::mesh::CellSet   cells( ); //all cells
   smtk::mesh::PointSet  points( ); //all points
 
-  //todo:
-  //find all cells of a given dimension that are attached to ?
-  //smtk::mesh::CellSet   connectivity( smtk::mesh::DimensionType dim );
-
   smtk::mesh::PointConnectivity pointConnectivity( ); //all point connectivity info for all cells
 
   //For any mesh set that has a name we return that name. It is possible
@@ -156,6 +156,33 @@ public:
   //we will return an empty MeshSet.
   smtk::mesh::MeshSet createMesh( const smtk::mesh::CellSet& cells );
 
+  //----------------------------------------------------------------------------
+  // Spatial Queries
+  //----------------------------------------------------------------------------
+  //get a spatial index over all the cells of the collection. The index is
+  //built the first time it is requested, and rebuilt when the cells of the
+  //collection have changed, points have been allocated or connectivity
+  //modified through the allocator, or it has been invalidated since. The
+  //returned reference is valid until the next call that rebuilds the index.
+  const smtk::mesh::SpatialIndex& spatialIndex();
+
+  //discard the spatial index. Removing meshes and merging points do this
+  //for you; call it after writing to the coordinates of existing points
+  //through memory the allocator handed out earlier
+  void invalidateSpatialIndex();
+
+  //get the adjacency tables between the cells of the collection, which
+  //MeshSet::connectivity and MeshSet::extractShell query. They are kept
+  //like the spatial index; cells added since are indexed in place when
+  //they only use existing points, and any other change to the cells or
+  //to their connectivity through the allocator rebuilds them. Rewriting
+  //existing cells while also adding cells needs invalidateAdjacencies. The reference is valid until the next call that
+  //rebuilds them.
+  const smtk::mesh::Adjacencies& adjacencies();
+
+  //discard the adjacency tables, see invalidateSpatialIndex
+  void invalidateAdjacencies();
+
   //----------------------------------------------------------------------------
   // Deletion of Items
   //----------------------------------------------------------------------------
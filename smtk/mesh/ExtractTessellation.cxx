@@ -9,9 +9,13 @@
 //=========================================================================
 
 #include "smtk/mesh/ExtractTessellation.h"
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Interface.h"
 #include "smtk/mesh/PointConnectivity.h"
 #include "smtk/mesh/PointSet.h"
 
+#include <algorithm>
+
 namespace smtk {
 namespace mesh {
 
@@ -413,5 +417,218 @@ void extractTessellation( const smtk::mesh::CellSet& cs,
 }
 
 
+
+//----------------------------------------------------------------------------
+StreamingTessellation::StreamingTessellation(std::size_t maxConnectivityLength):
+  m_maxConnectivityLength(maxConnectivityLength),
+  m_useVTKConnectivity(true),
+  m_useVTKCellTypes(true),
+  m_useLocalPoints(false)
+{
+
+}
+
+//----------------------------------------------------------------------------
+StreamingTessellation::~StreamingTessellation()
+{
+
+}
+
+//----------------------------------------------------------------------------
+void extractTessellation( const smtk::mesh::MeshSet& ms,
+                          StreamingTessellation& tess)
+{
+  smtk::mesh::CellSet cs = ms.cells();
+  extractTessellation(cs,cs.points(),tess);
+}
+
+//----------------------------------------------------------------------------
+void extractTessellation( const smtk::mesh::CellSet& cs,
+                          StreamingTessellation& tess)
+{
+  extractTessellation(cs,cs.points(),tess);
+}
+
+namespace detail
+{
+
+//----------------------------------------------------------------------------
+//the buffers of a chunk, reused for every chunk of a set
+class ChunkBuffers
+{
+public:
+  ChunkBuffers(const smtk::mesh::InterfacePtr& iface,
+               const smtk::mesh::PointSet& ps,
+               StreamingTessellation& tess):
+    m_iface(iface),
+    m_ps(ps),
+    m_tess(tess),
+    m_firstCell(0),
+    m_connectivityOffset(0)
+  {
+  }
+
+  void add(smtk::mesh::CellType ctype, int numPts, const smtk::mesh::Handle* pointIds)
+  {
+  const std::size_t cellLength = numPts + (this->m_tess.useVTKConnectivity() ? 1 : 0);
+  if(!this->m_cellTypes.empty() &&
+     this->m_connectivity.size() + cellLength > this->m_tess.maxConnectivityLength())
+    {
+    this->flush();
+    }
+
+  this->m_cellLocations.push_back(this->m_connectivity.size());
+  this->m_cellTypes.push_back(this->m_tess.useVTKCellTypes() ?
+                              smtkToVTKCell(ctype) : smtkToSMTKCell(ctype));
+  if(this->m_tess.useVTKConnectivity())
+    {
+    this->m_connectivity.push_back(numPts);
+    }
+  if(this->m_tess.useLocalPoints())
+    {
+    //keep the handles for now, flush turns them into local indices
+    this->m_connectivity.insert(this->m_connectivity.end(), pointIds, pointIds + numPts);
+    }
+  else
+    {
+    for(int i=0; i < numPts; ++i)
+      {
+      this->m_connectivity.push_back( this->m_ps.find( pointIds[i] ) );
+      }
+    }
+  }
+
+  void flush()
+  {
+  if(this->m_cellTypes.empty())
+    {
+    return;
+    }
+
+  TessellationChunk chunk;
+  chunk.firstCell = this->m_firstCell;
+  chunk.connectivityOffset = this->m_connectivityOffset;
+  chunk.numberOfCells = this->m_cellTypes.size();
+  chunk.connectivityLength = this->m_connectivity.size();
+  chunk.numberOfPoints = 0;
+  chunk.points = NULL;
+  chunk.pointIds = NULL;
+
+  if(this->m_tess.useLocalPoints())
+    {
+    this->renumberPoints();
+    if(!this->m_handles.empty())
+      {
+      chunk.numberOfPoints = this->m_handles.size();
+      chunk.points = &this->m_points[0];
+      chunk.pointIds = &this->m_pointIds[0];
+      }
+    }
+
+  chunk.connectivity = &this->m_connectivity[0];
+  chunk.cellLocations = &this->m_cellLocations[0];
+  chunk.cellTypes = &this->m_cellTypes[0];
+  this->m_tess.forChunk(chunk);
+
+  this->m_firstCell += chunk.numberOfCells;
+  this->m_connectivityOffset += chunk.connectivityLength;
+  this->m_connectivity.clear();
+  this->m_cellLocations.clear();
+  this->m_cellTypes.clear();
+  }
+
+private:
+  //replace the point handles of the connectivity with their index in the
+  //sorted handles of the chunk, and fetch those points
+  void renumberPoints()
+  {
+  const bool vtkConn = this->m_tess.useVTKConnectivity();
+  this->m_handles.clear();
+  for(std::size_t c=0; c < this->m_cellLocations.size(); ++c)
+    {
+    const std::size_t start = this->m_cellLocations[c] + (vtkConn ? 1 : 0);
+    const std::size_t end = (c + 1 < this->m_cellLocations.size()) ?
+      this->m_cellLocations[c + 1] : this->m_connectivity.size();
+    for(std::size_t i=start; i < end; ++i)
+      {
+      this->m_handles.push_back(
+        static_cast<smtk::mesh::Handle>(this->m_connectivity[i]) );
+      }
+    }
+  std::sort(this->m_handles.begin(), this->m_handles.end());
+  this->m_handles.erase( std::unique(this->m_handles.begin(), this->m_handles.end()),
+                         this->m_handles.end() );
+
+  for(std::size_t c=0; c < this->m_cellLocations.size(); ++c)
+    {
+    const std::size_t start = this->m_cellLocations[c] + (vtkConn ? 1 : 0);
+    const std::size_t end = (c + 1 < this->m_cellLocations.size()) ?
+      this->m_cellLocations[c + 1] : this->m_connectivity.size();
+    for(std::size_t i=start; i < end; ++i)
+      {
+      const smtk::mesh::Handle handle =
+        static_cast<smtk::mesh::Handle>(this->m_connectivity[i]);
+      this->m_connectivity[i] =
+        std::lower_bound(this->m_handles.begin(), this->m_handles.end(), handle) -
+        this->m_handles.begin();
+      }
+    }
+
+  if(this->m_handles.empty())
+    {
+    return;
+    }
+  this->m_points.resize(3 * this->m_handles.size());
+  this->m_iface->getCoordinates(&this->m_handles[0], this->m_handles.size(),
+                                &this->m_points[0]);
+  this->m_pointIds.resize(this->m_handles.size());
+  for(std::size_t i=0; i < this->m_handles.size(); ++i)
+    {
+    this->m_pointIds[i] = this->m_ps.find( this->m_handles[i] );
+    }
+  }
+
+  smtk::mesh::InterfacePtr m_iface;
+  const smtk::mesh::PointSet& m_ps;
+  StreamingTessellation& m_tess;
+
+  std::size_t m_firstCell;
+  std::size_t m_connectivityOffset;
+
+  std::vector<boost::int64_t> m_connectivity;
+  std::vector<boost::int64_t> m_cellLocations;
+  std::vector<unsigned char> m_cellTypes;
+
+  std::vector<smtk::mesh::Handle> m_handles;
+  std::vector<double> m_points;
+  std::vector<boost::int64_t> m_pointIds;
+};
+
+} //namespace detail
+
+//----------------------------------------------------------------------------
+void extractTessellation( const smtk::mesh::CellSet& cs,
+                          const smtk::mesh::PointSet& ps,
+                          StreamingTessellation& tess)
+{
+  if(cs.is_empty() || !cs.m_parent)
+    {
+    return;
+    }
+
+  //the connectivity of the set refers to the interface's own storage, so
+  //walking it costs no memory beyond the chunk buffers
+  detail::ChunkBuffers buffers(cs.m_parent->interface(), ps, tess);
+  smtk::mesh::PointConnectivity pc = cs.pointConnectivity();
+  smtk::mesh::CellType ctype;
+  int numPts = 0;
+  const smtk::mesh::Handle* pointIds;
+  for(pc.initCellTraversal(); pc.fetchNextCell(ctype, numPts, pointIds);)
+    {
+    buffers.add(ctype, numPts, pointIds);
+    }
+  buffers.flush();
+}
+
 }
 }
@@ -139,6 +139,67 @@ private:
   bool m_useVTKCellTypes;
 };
 
+//A bounded piece of the tessellation of a CellSet, handed to
+//StreamingTessellation::forChunk. The arrays are only valid for the
+//duration of the call.
+struct TessellationChunk
+{
+  //the index of the first cell of the chunk in the CellSet, and where the
+  //connectivity of the chunk starts in the connectivity of the whole set
+  std::size_t firstCell;
+  std::size_t connectivityOffset;
+
+  std::size_t numberOfCells;
+  std::size_t connectivityLength;
+
+  //the cell locations are relative to the start of this chunk's
+  //connectivity
+  const boost::int64_t* connectivity;
+  const boost::int64_t* cellLocations;
+  const unsigned char* cellTypes;
+
+  //only set when local points are enabled: the connectivity then indexes
+  //the numberOfPoints points of the chunk, whose coordinates are in points
+  //(3 * numberOfPoints values) and whose index in the PointSet is given by
+  //pointIds
+  std::size_t numberOfPoints;
+  const double* points;
+  const boost::int64_t* pointIds;
+};
+
+//Extracts the tessellation of a CellSet in chunks whose connectivity holds
+//at most maxConnectivityLength values, so that large collections can be
+//converted or written with a fixed amount of memory. A single cell longer
+//than the limit is given a chunk of its own.
+class SMTKCORE_EXPORT StreamingTessellation
+{
+public:
+  StreamingTessellation(std::size_t maxConnectivityLength);
+
+  virtual ~StreamingTessellation();
+
+  virtual void forChunk(const smtk::mesh::TessellationChunk& chunk) = 0;
+
+  //see PreAllocatedTessellation
+  void disableVTKStyleConnectivity(bool disable) { m_useVTKConnectivity  = !disable; }
+  void disableVTKCellTypes(bool disable) { m_useVTKCellTypes  = !disable; }
+
+  //renumber the points of each chunk from zero and hand their coordinates
+  //to the chunk, instead of using the indices of the whole PointSet
+  void enableLocalPoints(bool enable) { m_useLocalPoints = enable; }
+
+  std::size_t maxConnectivityLength() const { return this->m_maxConnectivityLength; }
+  bool useVTKConnectivity() const { return this->m_useVTKConnectivity; }
+  bool useVTKCellTypes() const { return this->m_useVTKCellTypes; }
+  bool useLocalPoints() const { return this->m_useLocalPoints; }
+
+private:
+  std::size_t m_maxConnectivityLength;
+  bool m_useVTKConnectivity;
+  bool m_useVTKCellTypes;
+  bool m_useLocalPoints;
+};
+
 //Don't wrap these for python, instead python should use the Tessellation class
 //and the extract method
 #ifndef SHIBOKEN_SKIP
@@ -152,6 +213,13 @@ SMTKCORE_EXPORT void extractTessellation( const smtk::mesh::CellSet&, PreAllocat
 SMTKCORE_EXPORT void extractTessellation( const smtk::mesh::MeshSet&, const smtk::mesh::PointSet&, PreAllocatedTessellation& );
 SMTKCORE_EXPORT void extractTessellation( const smtk::mesh::CellSet&, const smtk::mesh::PointSet& , PreAllocatedTessellation& );
 
+//Extract the Tessellation in chunks of bounded size instead of into arrays
+//sized for the whole set. Without local points the connectivity indexes
+//the given PointSet, whose coordinates the caller fetches separately.
+SMTKCORE_EXPORT void extractTessellation( const smtk::mesh::MeshSet&, StreamingTessellation& );
+SMTKCORE_EXPORT void extractTessellation( const smtk::mesh::CellSet&, StreamingTessellation& );
+SMTKCORE_EXPORT void extractTessellation( const smtk::mesh::CellSet&, const smtk::mesh::PointSet&, StreamingTessellation& );
+
 #endif //SHIBOKEN_SKIP
 
 }
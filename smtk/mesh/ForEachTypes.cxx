@@ -9,6 +9,9 @@
 //=========================================================================
 #include "smtk/mesh/ForEachTypes.h"
 
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Interface.h"
+
 namespace smtk {
   namespace mesh {
 
@@ -35,6 +38,27 @@ CellForEach::~CellForEach()
 
 }
 
+//----------------------------------------------------------------------------
+CellBlockForEach::~CellBlockForEach()
+{
+
+}
+
+//----------------------------------------------------------------------------
+bool CellBlockForEach::coordinates(const smtk::mesh::ConnectivityBlock& block,
+                                   std::vector<double>& xyz) const
+{
+  const std::size_t numPoints = block.numberOfCells * block.vertsPerCell;
+  xyz.resize(3 * numPoints);
+  if(numPoints == 0 || !this->m_collection)
+    {
+    return numPoints == 0;
+    }
+  return this->m_collection->interface()->getCoordinates(block.connectivity,
+                                                         numPoints,
+                                                         &xyz[0]);
+}
+
 //----------------------------------------------------------------------------
 PointForEach::~PointForEach()
 {
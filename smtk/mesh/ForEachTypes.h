@@ -17,6 +17,8 @@
 #include "smtk/mesh/CellTypes.h"
 #include "smtk/mesh/Handle.h"
 
+#include <vector>
+
 namespace smtk {
 namespace mesh {
 
@@ -45,6 +47,15 @@ public:
 
   virtual void forCell(smtk::mesh::CellType cellType, int numPointIds) = 0;
 
+  //Return a new copy of this visitor for parallel_for_each to run on one
+  //piece of a CellSet, or NULL to have parallel_for_each visit serially.
+  //The caller takes ownership of the copy.
+  virtual CellForEach* clone() const { return NULL; }
+
+  //Combine the results of a copy returned by clone() into this visitor.
+  //parallel_for_each calls this once per piece, in the order of the pieces.
+  virtual void reduce(const CellForEach& piece) { (void)piece; }
+
   //returns true if the CellForEach visitor wants its coordinates member
   //variable filled
   bool wantsCoordinates() const
@@ -84,6 +95,38 @@ private:
   bool m_wantsCoordinates;
 };
 
+//----------------------------------------------------------------------------
+//A run of cells that share a cell type and number of points, and whose
+//point ids are stored back to back: the points of cell i are
+//connectivity[i*vertsPerCell] through connectivity[(i+1)*vertsPerCell - 1].
+//The connectivity points directly into the interface's storage and must be
+//treated as read only.
+struct ConnectivityBlock
+{
+  smtk::mesh::CellType cellType;
+  int vertsPerCell;
+  std::size_t numberOfCells;
+  const smtk::mesh::Handle* connectivity;
+};
+
+//----------------------------------------------------------------------------
+//Visits a CellSet one ConnectivityBlock at a time, so kernels can loop over
+//the cells of a block without a virtual call per cell.
+class SMTKCORE_EXPORT CellBlockForEach
+{
+public:
+  virtual ~CellBlockForEach();
+
+  virtual void forBlock(const smtk::mesh::ConnectivityBlock& block) = 0;
+
+  //Fetch the coordinates of every point id of the block in a single query,
+  //cell by cell, into xyz (3*numberOfCells*vertsPerCell values).
+  bool coordinates(const smtk::mesh::ConnectivityBlock& block,
+                   std::vector<double>& xyz) const;
+
+  smtk::mesh::CollectionPtr m_collection;
+};
+
 //----------------------------------------------------------------------------
 class SMTKCORE_EXPORT PointForEach
 {
@@ -92,6 +135,15 @@ public:
 
   virtual void forPoint(const smtk::mesh::Handle& pointId, double x, double y, double z)=0;
 
+  //Return a new copy of this visitor for parallel_for_each to run on one
+  //piece of a PointSet, or NULL to have parallel_for_each visit serially.
+  //The caller takes ownership of the copy.
+  virtual PointForEach* clone() const { return NULL; }
+
+  //Combine the results of a copy returned by clone() into this visitor.
+  //parallel_for_each calls this once per piece, in the order of the pieces.
+  virtual void reduce(const PointForEach& piece) { (void)piece; }
+
   smtk::mesh::CollectionPtr m_collection;
 };
 
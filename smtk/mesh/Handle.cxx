@@ -12,6 +12,8 @@
 #include "cJSON.h"
 
 #include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
@@ -90,6 +92,127 @@ namespace detail
 
   return result;
   }
+
+  //the compact encoding is prefixed by its version, so that it can change
+  //without breaking readers of older files
+  const char compactPrefix[] = "c1:";
+  const std::size_t compactPrefixLength = 3;
+
+  const char base64Chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  void append_varint(std::vector<unsigned char>& bytes, boost::uint64_t value)
+  {
+  while(value >= 0x80)
+    {
+    bytes.push_back(static_cast<unsigned char>(value | 0x80));
+    value >>= 7;
+    }
+  bytes.push_back(static_cast<unsigned char>(value));
+  }
+
+  bool read_varint(const std::vector<unsigned char>& bytes,
+                   std::size_t& pos,
+                   boost::uint64_t& value)
+  {
+  value = 0;
+  for(int shift=0; pos < bytes.size() && shift < 64; shift+=7)
+    {
+    const unsigned char byte = bytes[pos++];
+    value |= static_cast<boost::uint64_t>(byte & 0x7f) << shift;
+    if(!(byte & 0x80))
+      {
+      return true;
+      }
+    }
+  return false;
+  }
+
+  std::string base64_encode(const std::vector<unsigned char>& bytes)
+  {
+  std::string result;
+  result.reserve(4 * ((bytes.size() + 2) / 3));
+  for(std::size_t i=0; i < bytes.size(); i+=3)
+    {
+    const std::size_t remaining = bytes.size() - i;
+    boost::uint32_t triple = static_cast<boost::uint32_t>(bytes[i]) << 16;
+    if(remaining > 1) { triple |= static_cast<boost::uint32_t>(bytes[i+1]) << 8; }
+    if(remaining > 2) { triple |= static_cast<boost::uint32_t>(bytes[i+2]); }
+
+    result += base64Chars[(triple >> 18) & 0x3f];
+    result += base64Chars[(triple >> 12) & 0x3f];
+    result += remaining > 1 ? base64Chars[(triple >> 6) & 0x3f] : '=';
+    result += remaining > 2 ? base64Chars[triple & 0x3f] : '=';
+    }
+  return result;
+  }
+
+  bool base64_decode(const char* text, std::size_t length,
+                     std::vector<unsigned char>& bytes)
+  {
+  if(length % 4 != 0)
+    {
+    return false;
+    }
+  bytes.reserve(3 * (length / 4));
+  for(std::size_t i=0; i < length; i+=4)
+    {
+    boost::uint32_t quad = 0;
+    int padding = 0;
+    for(int j=0; j < 4; ++j)
+      {
+      const char c = text[i+j];
+      boost::uint32_t value = 0;
+      if(c >= 'A' && c <= 'Z') { value = c - 'A'; }
+      else if(c >= 'a' && c <= 'z') { value = c - 'a' + 26; }
+      else if(c >= '0' && c <= '9') { value = c - '0' + 52; }
+      else if(c == '+') { value = 62; }
+      else if(c == '/') { value = 63; }
+      else if(c == '=' && i + 4 == length && j >= 2) { ++padding; }
+      else { return false; }
+      if(padding > 0 && c != '=')
+        { //nothing may follow padding
+        return false;
+        }
+      quad = (quad << 6) | value;
+      }
+    bytes.push_back(static_cast<unsigned char>(quad >> 16));
+    if(padding < 2) { bytes.push_back(static_cast<unsigned char>(quad >> 8)); }
+    if(padding < 1) { bytes.push_back(static_cast<unsigned char>(quad)); }
+    }
+  return true;
+  }
+
+  smtk::mesh::HandleRange compact_from_json(const char* text)
+  {
+  smtk::mesh::HandleRange result;
+  const std::size_t length = std::strlen(text);
+  std::vector<unsigned char> bytes;
+  if(length < compactPrefixLength ||
+     std::strncmp(text, compactPrefix, compactPrefixLength) != 0 ||
+     !base64_decode(text + compactPrefixLength,
+                    length - compactPrefixLength, bytes))
+    {
+    return result;
+    }
+
+  //the runs are in order, so each can be appended to the end of the range
+  smtk::mesh::Handle previousEnd = 0;
+  smtk::mesh::HandleRange::iterator hint = result.begin();
+  std::size_t pos = 0;
+  while(pos < bytes.size())
+    {
+    boost::uint64_t gap, runLength;
+    if(!read_varint(bytes, pos, gap) || !read_varint(bytes, pos, runLength))
+      {
+      return smtk::mesh::HandleRange();
+      }
+    const smtk::mesh::Handle start = previousEnd + static_cast<smtk::mesh::Handle>(gap);
+    previousEnd = start + static_cast<smtk::mesh::Handle>(runLength);
+    hint = result.insert(hint, start, previousEnd);
+    }
+  return result;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -123,6 +246,28 @@ cJSON* to_json(const smtk::mesh::HandleRange& range)
   return json_dict;
 }
 
+//----------------------------------------------------------------------------
+//convert a handle range to a compact json string
+cJSON* to_compact_json(const smtk::mesh::HandleRange& range)
+{
+  std::vector<unsigned char> bytes;
+  bytes.reserve(4 * range.psize());
+
+  typedef smtk::mesh::HandleRange::const_pair_iterator const_pair_iterator;
+  smtk::mesh::Handle previousEnd = 0;
+  for(const_pair_iterator i=range.const_pair_begin();
+      i != range.const_pair_end();
+      ++i)
+    {
+    detail::append_varint(bytes, i->first - previousEnd);
+    detail::append_varint(bytes, i->second - i->first);
+    previousEnd = i->second;
+    }
+
+  const std::string text = detail::compactPrefix + detail::base64_encode(bytes);
+  return cJSON_CreateString(text.c_str());
+}
+
 //----------------------------------------------------------------------------
 //convert json formatted string to a handle range
 smtk::mesh::HandleRange from_json(cJSON* json)
@@ -132,6 +277,10 @@ smtk::mesh::HandleRange from_json(cJSON* json)
   {
     return result;
   }
+  if(json->type == cJSON_String)
+  {
+    return json->valuestring ? detail::compact_from_json(json->valuestring) : result;
+  }
 
   std::stringstream buffer;
   //iterate the children
@@ -153,5 +302,47 @@ smtk::mesh::HandleRange from_json(cJSON* json)
   return result;
 }
 
+//----------------------------------------------------------------------------
+std::vector< smtk::mesh::HandleRange >
+split_range(const smtk::mesh::HandleRange& range, std::size_t numberOfPieces)
+{
+  std::vector< smtk::mesh::HandleRange > pieces;
+  const std::size_t size = range.size();
+  if(size == 0 || numberOfPieces == 0)
+    {
+    return pieces;
+    }
+  const std::size_t pieceSize = (size + numberOfPieces - 1) / numberOfPieces;
+
+  //walk the contiguous runs of handles, cutting them whenever the current
+  //piece is full
+  smtk::mesh::HandleRange current;
+  std::size_t currentSize = 0;
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = range.const_pair_begin(); p != range.const_pair_end(); ++p)
+    {
+    smtk::mesh::Handle start = p->first;
+    while(start <= p->second)
+      {
+      const std::size_t remaining = static_cast<std::size_t>(p->second - start) + 1;
+      const std::size_t take = std::min(remaining, pieceSize - currentSize);
+      current.insert(start, start + take - 1);
+      currentSize += take;
+      start += take;
+      if(currentSize == pieceSize)
+        {
+        pieces.push_back(current);
+        current.clear();
+        currentSize = 0;
+        }
+      }
+    }
+  if(currentSize > 0)
+    {
+    pieces.push_back(current);
+    }
+  return pieces;
+}
+
 }
 }
@@ -14,6 +14,8 @@
 #include "smtk/CoreExports.h"
 #include "smtk/mesh/moab/HandleRange.h"
 
+#include <vector>
+
 #ifndef SHIBOKEN_SKIP
 #  include "cJSON.h"
 #endif // SHIBOKEN_SKIP
@@ -25,8 +27,22 @@ namespace mesh {
 
   SMTKCORE_EXPORT cJSON* to_json(const smtk::mesh::HandleRange& range);
 
+  //convert a range to a single json string, which is a fraction of the size
+  //of to_json for fragmented ranges and much faster to parse. Each run of
+  //consecutive handles is stored as the gap from the end of the previous
+  //run and its length, packed as variable length integers and then base64
+  //encoded, after a version prefix.
+  SMTKCORE_EXPORT cJSON* to_compact_json(const smtk::mesh::HandleRange& range);
+
+  //convert json made by either to_json or to_compact_json to a range. An
+  //invalid compact string converts to an empty range.
   SMTKCORE_EXPORT smtk::mesh::HandleRange from_json(cJSON* json);
 
+  //split a range into at most numberOfPieces consecutive ranges of nearly
+  //equal size. Used to hand out independent pieces of work to threads.
+  SMTKCORE_EXPORT std::vector< smtk::mesh::HandleRange >
+    split_range(const smtk::mesh::HandleRange& range, std::size_t numberOfPieces);
+
 }
 }
 
@@ -18,9 +18,11 @@
 #include "smtk/mesh/CellTraits.h"
 #include "smtk/mesh/CellTypes.h"
 #include "smtk/mesh/DimensionTypes.h"
+#include "smtk/mesh/ForEachTypes.h"
 #include "smtk/mesh/Handle.h"
 #include "smtk/mesh/TypeSet.h"
 
+#include <utility>
 #include <vector>
 
 namespace smtk {
@@ -34,8 +36,14 @@ class PointConnectivity;
 class SMTKCORE_EXPORT Allocator
 {
 public:
+  Allocator(): m_modificationCount(0) {}
+
   virtual ~Allocator() {}
 
+  //incremented each time points are allocated or cell connectivity is
+  //modified, so caches built from the geometry can tell they are stale
+  std::size_t modificationCount() const { return this->m_modificationCount; }
+
   virtual bool allocatePoints( std::size_t numPointsToAlloc,
                                smtk::mesh::Handle& firstVertexHandle,
                                std::vector<double* >& coordinateMemory) = 0;
@@ -65,6 +73,11 @@ public:
                                      int numVertsPerCell,
                                      const smtk::mesh::Handle* connectivityArray) = 0;
 
+protected:
+  void modified() { ++this->m_modificationCount; }
+
+private:
+  std::size_t m_modificationCount;
 };
 
 //----------------------------------------------------------------------------
@@ -96,6 +109,11 @@ public:
   virtual std::size_t cellSize() const = 0;
 
   virtual std::size_t vertSize() const = 0;
+
+  //the number of homogeneous runs of cells the storage is made of
+  virtual std::size_t numberOfBlocks() const = 0;
+
+  virtual smtk::mesh::ConnectivityBlock block(std::size_t index) const = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -204,6 +222,14 @@ public:
   virtual bool getCoordinates(const smtk::mesh::HandleRange& points,
                               float* xyz) const = 0;
 
+  //----------------------------------------------------------------------------
+  //get the coordinates of an array of point ids, such as the connectivity
+  //of a ConnectivityBlock. Point ids may repeat and need not be sorted.
+  //xyz needs to be allocated to 3*numPoints
+  virtual bool getCoordinates(const smtk::mesh::Handle* points,
+                              std::size_t numPoints,
+                              double* xyz) const = 0;
+
   //----------------------------------------------------------------------------
   virtual std::vector< std::string > computeNames(const smtk::mesh::HandleRange& meshsets) const = 0;
 
@@ -231,6 +257,14 @@ public:
   virtual bool mergeCoincidentContactPoints(const smtk::mesh::HandleRange& meshes,
                                            double tolerance) const = 0;
 
+  //----------------------------------------------------------------------------
+  //replace the first point of each pair with the second, rewriting the
+  //connectivity of every cell in place and any mesh that holds the point,
+  //then delete the first points. The pairs must be sorted by their first
+  //point, and a second point can't be the first of another pair
+  virtual bool mergePoints(const std::vector< std::pair< smtk::mesh::Handle,
+                                                         smtk::mesh::Handle > >& mapping) const = 0;
+
   //----------------------------------------------------------------------------
   virtual bool setDomain(const smtk::mesh::HandleRange& meshsets,
                          const smtk::mesh::Domain& domain) const = 0;
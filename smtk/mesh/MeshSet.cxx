@@ -9,13 +9,65 @@
 //=========================================================================
 
 #include "smtk/mesh/MeshSet.h"
+#include "smtk/mesh/Adjacencies.h"
 #include "smtk/mesh/Collection.h"
+#include "smtk/mesh/WeldPoints.h"
 
 #include "smtk/mesh/Interface.h"
 
+#include <algorithm>
+#include <map>
+
 namespace smtk {
 namespace mesh {
 
+namespace
+{
+//----------------------------------------------------------------------------
+//create cells of a dimension from lists of points, grouped by the number
+//of points so each group is a single allocation
+bool createCells(const smtk::mesh::InterfacePtr& iface,
+                 int dimension,
+                 const std::vector< std::vector< smtk::mesh::Handle > >& cells,
+                 smtk::mesh::HandleRange& created)
+{
+  typedef std::map< std::size_t, std::vector< std::size_t > > GroupMap;
+  GroupMap groups;
+  for(std::size_t i=0; i < cells.size(); ++i)
+    {
+    groups[cells[i].size()].push_back(i);
+    }
+
+  smtk::mesh::AllocatorPtr alloc = iface->allocator();
+  for(GroupMap::const_iterator g = groups.begin(); g != groups.end(); ++g)
+    {
+    smtk::mesh::CellType cellType = smtk::mesh::Polygon;
+    if(dimension == 1)        { cellType = smtk::mesh::Line; }
+    else if(g->first == 3)    { cellType = smtk::mesh::Triangle; }
+    else if(g->first == 4)    { cellType = smtk::mesh::Quad; }
+
+    const int vertsPerCell = static_cast<int>(g->first);
+    smtk::mesh::HandleRange ids;
+    smtk::mesh::Handle* conn = NULL;
+    if(!alloc->allocateCells(cellType, g->second.size(), vertsPerCell, ids, conn))
+      {
+      return false;
+      }
+    for(std::size_t i=0; i < g->second.size(); ++i)
+      {
+      const std::vector< smtk::mesh::Handle >& points = cells[g->second[i]];
+      std::copy(points.begin(), points.end(), conn + i * vertsPerCell);
+      }
+    if(!alloc->connectivityModified(ids, vertsPerCell, conn))
+      {
+      return false;
+      }
+    created.merge(ids);
+    }
+  return true;
+}
+}
+
 //----------------------------------------------------------------------------
 MeshSet::MeshSet():
   m_parent(),
@@ -364,14 +416,87 @@ smtk::mesh::MeshSet MeshSet::subset( std::size_t ith ) const
   return singleMesh;
 }
 
+//----------------------------------------------------------------------------
+smtk::mesh::CellSet MeshSet::connectivity( smtk::mesh::DimensionType fromDim,
+                                           smtk::mesh::DimensionType toDim ) const
+{
+  smtk::mesh::CellSet from = this->cells(fromDim);
+  const smtk::mesh::Adjacencies& adj = this->m_parent->adjacencies();
+  return smtk::mesh::CellSet( this->m_parent,
+                              adj.adjacent(from.range(), fromDim, toDim) );
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::MeshSet MeshSet::createConnectivity( smtk::mesh::DimensionType fromDim,
+                                                 smtk::mesh::DimensionType toDim ) const
+{
+  const smtk::mesh::InterfacePtr& iface = this->m_parent->interface();
+
+  smtk::mesh::HandleRange entities;
+  smtk::mesh::HandleRange cells;
+  bool connected = true;
+  if(toDim >= fromDim || toDim == smtk::mesh::Dims0)
+    {
+    cells = this->connectivity(fromDim, toDim).range();
+    }
+  else
+    {
+    smtk::mesh::CellSet from = this->cells(fromDim);
+    std::vector< std::vector< smtk::mesh::Handle > > missing;
+    this->m_parent->adjacencies().subEntities(from.range(), fromDim, toDim,
+                                              false, cells, missing);
+    connected = createCells(iface, toDim, missing, cells);
+    }
+
+  if(connected && !cells.empty())
+    {
+    smtk::mesh::Handle meshSetHandle;
+    //create a mesh for these cells since they don't have a meshset currently
+    const bool meshCreated = iface->createMesh(cells, meshSetHandle);
+    if(meshCreated)
+      {
+      entities.insert(meshSetHandle);
+      }
+    }
+  return smtk::mesh::MeshSet( this->m_parent,
+                              this->m_handle,
+                              entities );
+}
+
 //----------------------------------------------------------------------------
 smtk::mesh::MeshSet MeshSet::extractShell() const
 {
   const smtk::mesh::InterfacePtr& iface = this->m_parent->interface();
 
+  //the shell is made of the sides of the highest dimension cells that only
+  //one of those cells uses
+  int dimension = 3;
+  smtk::mesh::CellSet highest = this->cells( smtk::mesh::Dims3 );
+  while(highest.is_empty() && dimension > 1)
+    {
+    --dimension;
+    highest = this->cells( static_cast<smtk::mesh::DimensionType>(dimension) );
+    }
+
   smtk::mesh::HandleRange entities;
   smtk::mesh::HandleRange cells;
-  const bool shellExtracted = iface->computeShell( this->m_range, cells );
+  bool shellExtracted = false;
+  if(dimension == 1)
+    { //the shell of curves is points, which the adjacencies don't make
+      //cells for
+    shellExtracted = iface->computeShell( this->m_range, cells );
+    }
+  else
+    {
+    std::vector< std::vector< smtk::mesh::Handle > > missing;
+    this->m_parent->adjacencies().subEntities(
+      highest.range(),
+      static_cast<smtk::mesh::DimensionType>(dimension),
+      static_cast<smtk::mesh::DimensionType>(dimension - 1),
+      true, cells, missing);
+    shellExtracted = createCells(iface, dimension - 1, missing, cells) &&
+                     !cells.empty();
+    }
   if(shellExtracted)
     {
     smtk::mesh::Handle meshSetHandle;
@@ -391,7 +516,25 @@ smtk::mesh::MeshSet MeshSet::extractShell() const
 bool MeshSet::mergeCoincidentContactPoints( double tolerance ) const
 {
   const smtk::mesh::InterfacePtr& iface = this->m_parent->interface();
-  return iface->mergeCoincidentContactPoints(this->m_range, tolerance);
+  const bool merged = iface->mergeCoincidentContactPoints(this->m_range, tolerance);
+  this->m_parent->invalidateSpatialIndex();
+  this->m_parent->invalidateAdjacencies();
+  return merged;
+}
+
+//----------------------------------------------------------------------------
+bool MeshSet::mergeCoincidentContactPoints(
+  double tolerance,
+  std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > >& merged) const
+{
+  const smtk::mesh::InterfacePtr& iface = this->m_parent->interface();
+  smtk::mesh::HandleRange points = this->points().range();
+  merged.clear();
+  const bool welded = smtk::mesh::weldPoints(*iface, points, tolerance, merged) &&
+                      iface->mergePoints(merged);
+  this->m_parent->invalidateSpatialIndex();
+  this->m_parent->invalidateAdjacencies();
+  return welded;
 }
 
 //----------------------------------------------------------------------------
@@ -119,6 +119,21 @@ public:
   //subset this MeshSet given an index into moab entity sets (m_range)
   smtk::mesh::MeshSet   subset( std::size_t ith ) const;
 
+  //find the cells of dimension toDim adjacent to the cells of dimension
+  //fromDim in these meshes, using the adjacency tables of the collection.
+  //Going down in dimension these are the edges, faces, or vertex cells of
+  //the cells that exist; going up the cells that contain them; and with
+  //equal dimensions the cells sharing a side with them.
+  smtk::mesh::CellSet connectivity( smtk::mesh::DimensionType fromDim,
+                                    smtk::mesh::DimensionType toDim ) const;
+
+  //like connectivity, but going down in dimension first creates a cell for
+  //each edge or face that doesn't have one; vertex cells are never created.
+  //Like extractShell the cells are added to a new mesh, so that they are
+  //saved and found by later queries, and that mesh is returned.
+  smtk::mesh::MeshSet createConnectivity( smtk::mesh::DimensionType fromDim,
+                                          smtk::mesh::DimensionType toDim ) const;
+
   //Extract the shell ( exterior face elements ) of this set of meshes
   //This operation might create new cells if no shell already exists
   //for the given meshset. The resulting meshset will be added to the
@@ -132,6 +147,13 @@ public:
   //invalid, and using them will cause any undefined behavior
   bool mergeCoincidentContactPoints(double tolerance=1.0e-6) const;
 
+  //Merge all duplicate points contained within this meshset as above, and
+  //return the pairs of each point that was removed and the point that
+  //replaced it, sorted by the removed point
+  bool mergeCoincidentContactPoints(
+    double tolerance,
+    std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > >& merged) const;
+
   //get the underlying HandleRange that this MeshSet represents
   const smtk::mesh::HandleRange& range() const { return this->m_range; }
 
@@ -80,6 +80,18 @@ bool PointConnectivity::is_empty( ) const
   return this->m_connectivity->cellSize() == 0;
 }
 
+//----------------------------------------------------------------------------
+std::size_t PointConnectivity::numberOfBlocks( ) const
+{
+  return this->m_connectivity->numberOfBlocks();
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::ConnectivityBlock PointConnectivity::block( std::size_t index ) const
+{
+  return this->m_connectivity->block(index);
+}
+
 //----------------------------------------------------------------------------
 void PointConnectivity::initCellTraversal()
 {
@@ -76,6 +76,14 @@ public:
                       int& numPts,
                       const smtk::mesh::Handle* &points);
 
+  //Get the number of homogeneous blocks of cells in the connectivity.
+  std::size_t numberOfBlocks() const;
+
+  //Get a block of cells that share a cell type and number of points and
+  //whose point ids are stored back to back. This gives direct access to the
+  //same memory fetchNextCell walks, without a call per cell.
+  smtk::mesh::ConnectivityBlock block(std::size_t index) const;
+
 private:
 
   smtk::mesh::CollectionPtr m_parent;
@@ -13,9 +13,43 @@
 #include "smtk/mesh/Collection.h"
 #include "smtk/mesh/Interface.h"
 
+#include "smtk/common/Parallel.h"
+
+#include <algorithm>
+
 namespace smtk {
 namespace mesh {
 
+namespace
+{
+//pieces smaller than this cost more to schedule than to visit
+const std::size_t MinPointsPerPiece = 65536;
+
+//----------------------------------------------------------------------------
+class VisitPointPieces : public smtk::common::ParallelTask
+{
+public:
+  VisitPointPieces(const smtk::mesh::InterfacePtr& iface,
+                   std::vector< smtk::mesh::HandleRange >& ranges,
+                   std::vector< smtk::shared_ptr< PointForEach > >& filters):
+    m_iface(iface),
+    m_ranges(ranges),
+    m_filters(filters)
+  {
+  }
+
+  void execute(std::size_t piece)
+  {
+  this->m_iface->pointForEach(this->m_ranges[piece], *this->m_filters[piece]);
+  }
+
+private:
+  const smtk::mesh::InterfacePtr& m_iface;
+  std::vector< smtk::mesh::HandleRange >& m_ranges;
+  std::vector< smtk::shared_ptr< PointForEach > >& m_filters;
+};
+}
+
 //----------------------------------------------------------------------------
 PointSet::PointSet(const smtk::mesh::CollectionPtr& parent,
                  const smtk::mesh::HandleRange& points):
@@ -180,5 +214,42 @@ void for_each( const PointSet& a, PointForEach& filter )
   iface->pointForEach(a.m_points, filter);
 }
 
+//----------------------------------------------------------------------------
+void parallel_for_each( const PointSet& a, PointForEach& filter )
+{
+  std::size_t numPieces = smtk::common::Parallel::numberOfThreads() * 4;
+  numPieces = std::min(numPieces, a.m_points.size() / MinPointsPerPiece);
+
+  smtk::shared_ptr< PointForEach > first;
+  if(numPieces > 1)
+    {
+    first.reset( filter.clone() );
+    }
+  if(!first)
+    {
+    for_each(a, filter);
+    return;
+    }
+
+  std::vector< smtk::mesh::HandleRange > ranges =
+    smtk::mesh::split_range(a.m_points, numPieces);
+  std::vector< smtk::shared_ptr< PointForEach > > filters;
+  filters.reserve(ranges.size());
+  for(std::size_t i=0; i < ranges.size(); ++i)
+    {
+    filters.push_back( i == 0 ? first : smtk::shared_ptr< PointForEach >(filter.clone()) );
+    filters.back()->m_collection = a.m_parent;
+    }
+
+  VisitPointPieces task(a.m_parent->interface(), ranges, filters);
+  smtk::common::Parallel::forEach(ranges.size(), task);
+
+  filter.m_collection = a.m_parent;
+  for(std::size_t i=0; i < filters.size(); ++i)
+    {
+    filter.reduce(*filters[i]);
+    }
+}
+
 }
 }
@@ -26,6 +26,7 @@ class SMTKCORE_EXPORT PointSet
   friend PointSet set_difference( const PointSet& a, const PointSet& b);
   friend PointSet set_union( const PointSet& a, const PointSet& b );
   friend void for_each( const PointSet& a, PointForEach& filter);
+  friend void parallel_for_each( const PointSet& a, PointForEach& filter);
 public:
   PointSet(const smtk::mesh::CollectionPtr& parent,
            const smtk::mesh::HandleRange& points);
@@ -114,6 +115,12 @@ SMTKCORE_EXPORT PointSet set_union( const PointSet& a, const PointSet& b );
 //apply a for_each point operator on each point in a container.
 SMTKCORE_EXPORT void for_each( const PointSet& a, PointForEach& filter);
 
+//apply a for_each point operator on each point in a container, splitting the
+//points into pieces that are visited concurrently by clones of the filter.
+//Once all pieces are done the clones are passed to filter.reduce() in order.
+//Falls back to for_each when the filter doesn't implement clone().
+SMTKCORE_EXPORT void parallel_for_each( const PointSet& a, PointForEach& filter);
+
 }
 }
 
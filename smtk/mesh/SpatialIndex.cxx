@@ -0,0 +1,957 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/SpatialIndex.h"
+#include "smtk/mesh/PointConnectivity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace smtk {
+namespace mesh {
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+//the tetrahedra each 3d cell type is split into, as indices of its points
+const int TetrahedronTets[1][4] = { {0,1,2,3} };
+const int PyramidTets[2][4] = { {0,1,2,4}, {0,2,3,4} };
+const int WedgeTets[3][4] = { {0,1,2,5}, {0,1,5,4}, {0,4,5,3} };
+const int HexahedronTets[6][4] = { {0,1,2,6}, {0,2,3,6}, {0,3,7,6},
+                                   {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+
+//----------------------------------------------------------------------------
+int cellDimension(smtk::mesh::CellType type)
+{
+  switch(type)
+    {
+    case smtk::mesh::Vertex: return 0;
+    case smtk::mesh::Line: return 1;
+    case smtk::mesh::Triangle:
+    case smtk::mesh::Quad:
+    case smtk::mesh::Polygon: return 2;
+    default: return 3;
+    }
+}
+
+//----------------------------------------------------------------------------
+int tetsOfCell(smtk::mesh::CellType type, const int (*&tets)[4])
+{
+  switch(type)
+    {
+    case smtk::mesh::Tetrahedron: tets = TetrahedronTets; return 1;
+    case smtk::mesh::Pyramid: tets = PyramidTets; return 2;
+    case smtk::mesh::Wedge: tets = WedgeTets; return 3;
+    case smtk::mesh::Hexahedron: tets = HexahedronTets; return 6;
+    default: tets = NULL; return 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+inline void sub(const double a[3], const double b[3], double r[3])
+{
+  r[0] = a[0] - b[0]; r[1] = a[1] - b[1]; r[2] = a[2] - b[2];
+}
+
+inline double dot(const double a[3], const double b[3])
+{
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline void cross(const double a[3], const double b[3], double r[3])
+{
+  r[0] = a[1] * b[2] - a[2] * b[1];
+  r[1] = a[2] * b[0] - a[0] * b[2];
+  r[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+inline double distance2(const double a[3], const double b[3])
+{
+  double d[3];
+  sub(a, b, d);
+  return dot(d, d);
+}
+
+//----------------------------------------------------------------------------
+double segmentDistance2(const double p[3], const double a[3], const double b[3])
+{
+  double ab[3], ap[3];
+  sub(b, a, ab);
+  sub(p, a, ap);
+  const double len2 = dot(ab, ab);
+  double t = len2 > 0 ? dot(ap, ab) / len2 : 0;
+  t = std::max(0., std::min(1., t));
+  const double closest[3] = { a[0] + t * ab[0], a[1] + t * ab[1], a[2] + t * ab[2] };
+  return distance2(p, closest);
+}
+
+//----------------------------------------------------------------------------
+//the closest point on a triangle, from Ericson's Real-Time Collision Detection
+double triangleDistance2(const double p[3],
+                         const double a[3], const double b[3], const double c[3])
+{
+  double ab[3], ac[3], ap[3], bp[3], cp[3], closest[3];
+  sub(b, a, ab);
+  sub(c, a, ac);
+  sub(p, a, ap);
+  const double d1 = dot(ab, ap);
+  const double d2 = dot(ac, ap);
+  if(d1 <= 0 && d2 <= 0)
+    {
+    return distance2(p, a);
+    }
+
+  sub(p, b, bp);
+  const double d3 = dot(ab, bp);
+  const double d4 = dot(ac, bp);
+  if(d3 >= 0 && d4 <= d3)
+    {
+    return distance2(p, b);
+    }
+
+  const double vc = d1 * d4 - d3 * d2;
+  if(vc <= 0 && d1 >= 0 && d3 <= 0)
+    {
+    const double v = d1 / (d1 - d3);
+    for(int i=0; i < 3; ++i) { closest[i] = a[i] + v * ab[i]; }
+    return distance2(p, closest);
+    }
+
+  sub(p, c, cp);
+  const double d5 = dot(ab, cp);
+  const double d6 = dot(ac, cp);
+  if(d6 >= 0 && d5 <= d6)
+    {
+    return distance2(p, c);
+    }
+
+  const double vb = d5 * d2 - d1 * d6;
+  if(vb <= 0 && d2 >= 0 && d6 <= 0)
+    {
+    const double w = d2 / (d2 - d6);
+    for(int i=0; i < 3; ++i) { closest[i] = a[i] + w * ac[i]; }
+    return distance2(p, closest);
+    }
+
+  const double va = d3 * d6 - d5 * d4;
+  if(va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+    {
+    const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    for(int i=0; i < 3; ++i) { closest[i] = b[i] + w * (c[i] - b[i]); }
+    return distance2(p, closest);
+    }
+
+  const double denom = 1. / (va + vb + vc);
+  const double v = vb * denom;
+  const double w = vc * denom;
+  for(int i=0; i < 3; ++i) { closest[i] = a[i] + ab[i] * v + ac[i] * w; }
+  return distance2(p, closest);
+}
+
+//----------------------------------------------------------------------------
+double tetVolume6(const double a[3], const double b[3], const double c[3], const double d[3])
+{
+  double ab[3], ac[3], ad[3], n[3];
+  sub(b, a, ab);
+  sub(c, a, ac);
+  sub(d, a, ad);
+  cross(ab, ac, n);
+  return dot(n, ad);
+}
+
+//----------------------------------------------------------------------------
+double tetDistance2(const double p[3], const double* v[4])
+{
+  const double volume = tetVolume6(v[0], v[1], v[2], v[3]);
+  if(volume != 0)
+    {
+    //the point is inside when it is on the same side of every face as
+    //the opposite vertex
+    const double l0 = tetVolume6(p, v[1], v[2], v[3]) / volume;
+    const double l1 = tetVolume6(v[0], p, v[2], v[3]) / volume;
+    const double l2 = tetVolume6(v[0], v[1], p, v[3]) / volume;
+    const double l3 = tetVolume6(v[0], v[1], v[2], p) / volume;
+    if(l0 >= 0 && l1 >= 0 && l2 >= 0 && l3 >= 0)
+      {
+      return 0;
+      }
+    }
+  return std::min( std::min( triangleDistance2(p, v[0], v[1], v[2]),
+                             triangleDistance2(p, v[0], v[1], v[3]) ),
+                   std::min( triangleDistance2(p, v[0], v[2], v[3]),
+                             triangleDistance2(p, v[1], v[2], v[3]) ) );
+}
+
+//----------------------------------------------------------------------------
+//Moller-Trumbore, returns the parameter of the hit along dir or -1
+double rayTriangle(const double o[3], const double dir[3],
+                   const double a[3], const double b[3], const double c[3])
+{
+  double e1[3], e2[3], pv[3], tv[3], qv[3];
+  sub(b, a, e1);
+  sub(c, a, e2);
+  cross(dir, e2, pv);
+  const double det = dot(e1, pv);
+  if(det == 0)
+    {
+    return -1;
+    }
+  const double inv = 1. / det;
+  sub(o, a, tv);
+  const double u = dot(tv, pv) * inv;
+  if(u < 0 || u > 1)
+    {
+    return -1;
+    }
+  cross(tv, e1, qv);
+  const double v = dot(dir, qv) * inv;
+  if(v < 0 || u + v > 1)
+    {
+    return -1;
+    }
+  return dot(e2, qv) * inv;
+}
+
+//----------------------------------------------------------------------------
+//clip the ray to the tetrahedron, returns where the ray enters it within
+//[0, tmax] or -1
+double rayTet(const double o[3], const double dir[3], double tmax, const double* v[4])
+{
+  const double volume = tetVolume6(v[0], v[1], v[2], v[3]);
+  if(volume == 0)
+    {
+    return -1;
+    }
+  static const int faces[4][4] = { {1,2,3,0}, {0,2,3,1}, {0,1,3,2}, {0,1,2,3} };
+  double t0 = 0, t1 = tmax;
+  for(int f=0; f < 4; ++f)
+    {
+    const double* a = v[faces[f][0]];
+    double ab[3], ac[3], n[3], ad[3], ao[3];
+    sub(v[faces[f][1]], a, ab);
+    sub(v[faces[f][2]], a, ac);
+    cross(ab, ac, n);
+    //point the normal away from the opposite vertex
+    sub(v[faces[f][3]], a, ad);
+    if(dot(n, ad) > 0)
+      {
+      n[0] = -n[0]; n[1] = -n[1]; n[2] = -n[2];
+      }
+    //inside when n.(o + t dir - a) <= 0
+    sub(o, a, ao);
+    const double num = dot(n, ao);
+    const double den = dot(n, dir);
+    if(den == 0)
+      {
+      if(num > 0)
+        {
+        return -1;
+        }
+      }
+    else if(den > 0)
+      {
+      t1 = std::min(t1, -num / den);
+      }
+    else
+      {
+      t0 = std::max(t0, -num / den);
+      }
+    if(t0 > t1)
+      {
+      return -1;
+      }
+    }
+  return t0;
+}
+
+//----------------------------------------------------------------------------
+struct BoxNode
+{
+  double box[6];
+  std::size_t start;
+  std::size_t count;
+  std::size_t left;
+  std::size_t right;
+};
+
+//----------------------------------------------------------------------------
+double boxDistance2(const double box[6], const double p[3])
+{
+  double d2 = 0;
+  for(int i=0; i < 3; ++i)
+    {
+    const double d = std::max(0., std::max(box[2*i] - p[i], p[i] - box[2*i+1]));
+    d2 += d * d;
+    }
+  return d2;
+}
+
+//----------------------------------------------------------------------------
+bool rayBox(const double box[6], const double o[3], const double dir[3], double tmax)
+{
+  double t0 = 0, t1 = tmax;
+  for(int i=0; i < 3; ++i)
+    {
+    if(dir[i] == 0)
+      {
+      if(o[i] < box[2*i] || o[i] > box[2*i+1])
+        {
+        return false;
+        }
+      continue;
+      }
+    double ta = (box[2*i] - o[i]) / dir[i];
+    double tb = (box[2*i+1] - o[i]) / dir[i];
+    if(ta > tb)
+      {
+      std::swap(ta, tb);
+      }
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+    if(t0 > t1)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+//A bounding volume hierarchy over items with axis aligned boxes, split at
+//the median of the longest axis of the item centers
+class BoxTree
+{
+public:
+  enum { LeafSize = 4 };
+
+  void build(const std::vector<double>& boxes)
+  {
+  const std::size_t n = boxes.size() / 6;
+  this->m_items.resize(n);
+  this->m_centers.resize(3 * n);
+  for(std::size_t i=0; i < n; ++i)
+    {
+    this->m_items[i] = i;
+    for(int a=0; a < 3; ++a)
+      {
+      this->m_centers[3*i+a] = 0.5 * (boxes[6*i+2*a] + boxes[6*i+2*a+1]);
+      }
+    }
+  this->m_nodes.clear();
+  if(n > 0)
+    {
+    this->buildNode(boxes, 0, n);
+    }
+  std::vector<double>().swap(this->m_centers);
+  }
+
+  const std::vector<BoxNode>& nodes() const { return this->m_nodes; }
+  std::size_t item(std::size_t i) const { return this->m_items[i]; }
+
+private:
+  struct CenterLess
+  {
+    CenterLess(const std::vector<double>& centers, int axis) :
+      m_centers(centers), m_axis(axis) {}
+    bool operator()(std::size_t a, std::size_t b) const
+      { return this->m_centers[3*a+this->m_axis] < this->m_centers[3*b+this->m_axis]; }
+    const std::vector<double>& m_centers;
+    int m_axis;
+  };
+
+  std::size_t buildNode(const std::vector<double>& boxes,
+                        std::size_t start, std::size_t end)
+  {
+  const std::size_t index = this->m_nodes.size();
+  this->m_nodes.push_back(BoxNode());
+
+  BoxNode node;
+  double centerBox[6];
+  for(int a=0; a < 3; ++a)
+    {
+    node.box[2*a] = centerBox[2*a] = std::numeric_limits<double>::max();
+    node.box[2*a+1] = centerBox[2*a+1] = -std::numeric_limits<double>::max();
+    }
+  for(std::size_t i=start; i < end; ++i)
+    {
+    const std::size_t item = this->m_items[i];
+    for(int a=0; a < 3; ++a)
+      {
+      node.box[2*a] = std::min(node.box[2*a], boxes[6*item+2*a]);
+      node.box[2*a+1] = std::max(node.box[2*a+1], boxes[6*item+2*a+1]);
+      centerBox[2*a] = std::min(centerBox[2*a], this->m_centers[3*item+a]);
+      centerBox[2*a+1] = std::max(centerBox[2*a+1], this->m_centers[3*item+a]);
+      }
+    }
+
+  node.start = start;
+  node.count = end - start;
+  node.left = node.right = 0;
+  if(node.count > LeafSize)
+    {
+    int axis = 0;
+    for(int a=1; a < 3; ++a)
+      {
+      if(centerBox[2*a+1] - centerBox[2*a] > centerBox[2*axis+1] - centerBox[2*axis])
+        {
+        axis = a;
+        }
+      }
+    const std::size_t mid = start + node.count / 2;
+    std::nth_element(this->m_items.begin() + start,
+                     this->m_items.begin() + mid,
+                     this->m_items.begin() + end,
+                     CenterLess(this->m_centers, axis));
+    node.count = 0;
+    node.left = this->buildNode(boxes, start, mid);
+    node.right = this->buildNode(boxes, mid, end);
+    }
+  this->m_nodes[index] = node;
+  return index;
+  }
+
+  std::vector<BoxNode> m_nodes;
+  std::vector<std::size_t> m_items;
+  std::vector<double> m_centers;
+};
+
+}
+
+//----------------------------------------------------------------------------
+class SpatialIndex::Internals
+{
+public:
+  smtk::mesh::HandleRange Cells;
+  smtk::mesh::HandleRange Points;
+
+  //coordinates of the points, in the order of the Points range
+  std::vector<double> Coordinates;
+  std::vector<smtk::mesh::Handle> PointHandles;
+
+  //per cell its handle, type and where its point indices start in
+  //Connectivity, in the order of the Cells range
+  std::vector<smtk::mesh::Handle> CellHandles;
+  std::vector<smtk::mesh::CellType> CellTypes;
+  std::vector<std::size_t> CellOffsets;
+  std::vector<std::size_t> Connectivity;
+
+  BoxTree PointTree;
+  BoxTree CellTree;
+
+  void indexPoints(const smtk::mesh::PointSet& ps)
+  {
+  this->Points = ps.range();
+  ps.get(this->Coordinates);
+  this->PointHandles.assign(this->Points.begin(), this->Points.end());
+
+  std::vector<double> boxes(2 * this->Coordinates.size());
+  for(std::size_t i=0; i < this->PointHandles.size(); ++i)
+    {
+    for(int a=0; a < 3; ++a)
+      {
+      boxes[6*i+2*a] = boxes[6*i+2*a+1] = this->Coordinates[3*i+a];
+      }
+    }
+  this->PointTree.build(boxes);
+  }
+
+  void indexCells(const smtk::mesh::CellSet& cs)
+  {
+  this->Cells = cs.range();
+  const smtk::mesh::PointSet ps = cs.points();
+  this->indexPoints(ps);
+
+  //the connectivity blocks list the cells in the order of their range.
+  //Cells whose connectivity holds handles that aren't points of the set,
+  //such as polyhedra listing their faces, are left out of the index
+  smtk::mesh::PointConnectivity pc = cs.pointConnectivity();
+  smtk::mesh::HandleRange::const_iterator cell = this->Cells.begin();
+  const std::size_t numPoints = this->PointHandles.size();
+  this->CellOffsets.push_back(0);
+  for(std::size_t b=0; b < pc.numberOfBlocks(); ++b)
+    {
+    const smtk::mesh::ConnectivityBlock block = pc.block(b);
+    const smtk::mesh::Handle* conn = block.connectivity;
+    for(std::size_t c=0; c < block.numberOfCells; ++c, ++cell)
+      {
+      const std::size_t start = this->Connectivity.size();
+      bool known = true;
+      for(int i=0; i < block.vertsPerCell; ++i, ++conn)
+        {
+        const std::size_t index = ps.find(*conn);
+        known = known && index < numPoints;
+        this->Connectivity.push_back( index );
+        }
+      if(!known)
+        {
+        this->Connectivity.resize(start);
+        continue;
+        }
+      this->CellHandles.push_back(*cell);
+      this->CellTypes.push_back(block.cellType);
+      this->CellOffsets.push_back(this->Connectivity.size());
+      }
+    }
+
+  const std::size_t numCells = this->CellHandles.size();
+  std::vector<double> boxes(6 * numCells);
+  for(std::size_t c=0; c < numCells; ++c)
+    {
+    double* box = &boxes[6*c];
+    for(int a=0; a < 3; ++a)
+      {
+      box[2*a] = std::numeric_limits<double>::max();
+      box[2*a+1] = -std::numeric_limits<double>::max();
+      }
+    for(std::size_t i=this->CellOffsets[c]; i < this->CellOffsets[c+1]; ++i)
+      {
+      const double* p = this->point(this->Connectivity[i]);
+      for(int a=0; a < 3; ++a)
+        {
+        box[2*a] = std::min(box[2*a], p[a]);
+        box[2*a+1] = std::max(box[2*a+1], p[a]);
+        }
+      }
+    }
+  this->CellTree.build(boxes);
+  }
+
+  const double* point(std::size_t index) const
+    { return &this->Coordinates[3*index]; }
+
+  const double* cellPoint(std::size_t cell, int i) const
+    { return this->point(this->Connectivity[this->CellOffsets[cell] + i]); }
+
+  int cellSize(std::size_t cell) const
+    { return static_cast<int>(this->CellOffsets[cell+1] - this->CellOffsets[cell]); }
+
+  //the squared distance from the point to the cell, zero when inside
+  double cellDistance2(std::size_t cell, const double p[3]) const
+  {
+  const smtk::mesh::CellType type = this->CellTypes[cell];
+  const int n = this->cellSize(cell);
+  switch(cellDimension(type))
+    {
+    case 0:
+      return distance2(p, this->cellPoint(cell, 0));
+    case 1:
+      return segmentDistance2(p, this->cellPoint(cell, 0), this->cellPoint(cell, n - 1));
+    case 2:
+      {
+      double d2 = std::numeric_limits<double>::max();
+      for(int i=1; i + 1 < n; ++i)
+        {
+        d2 = std::min(d2, triangleDistance2(p, this->cellPoint(cell, 0),
+                                               this->cellPoint(cell, i),
+                                               this->cellPoint(cell, i + 1)));
+        }
+      return d2;
+      }
+    default:
+      {
+      const int (*tets)[4];
+      const int numTets = tetsOfCell(type, tets);
+      double d2 = std::numeric_limits<double>::max();
+      for(int t=0; t < numTets && d2 > 0; ++t)
+        {
+        const double* v[4];
+        for(int i=0; i < 4; ++i)
+          {
+          v[i] = this->cellPoint(cell, tets[t][i]);
+          }
+        d2 = std::min(d2, tetDistance2(p, v));
+        }
+      return d2;
+      }
+    }
+  }
+
+  //where the ray first meets the cell within [0, tmax], or -1
+  double cellRay(std::size_t cell, const double o[3], const double dir[3], double tmax) const
+  {
+  const smtk::mesh::CellType type = this->CellTypes[cell];
+  const int n = this->cellSize(cell);
+  double best = -1;
+  if(cellDimension(type) == 2)
+    {
+    for(int i=1; i + 1 < n; ++i)
+      {
+      const double t = rayTriangle(o, dir, this->cellPoint(cell, 0),
+                                   this->cellPoint(cell, i),
+                                   this->cellPoint(cell, i + 1));
+      if(t >= 0 && t <= tmax && (best < 0 || t < best))
+        {
+        best = t;
+        }
+      }
+    }
+  else if(cellDimension(type) == 3)
+    {
+    const int (*tets)[4];
+    const int numTets = tetsOfCell(type, tets);
+    for(int t=0; t < numTets; ++t)
+      {
+      const double* v[4];
+      for(int i=0; i < 4; ++i)
+        {
+        v[i] = this->cellPoint(cell, tets[t][i]);
+        }
+      const double hit = rayTet(o, dir, tmax, v);
+      if(hit >= 0 && (best < 0 || hit < best))
+        {
+        best = hit;
+        }
+      }
+    }
+  return best;
+  }
+
+  //visit every item of the tree whose box is within radius2 of the point
+  template<typename Visitor>
+  void visitNear(const BoxTree& tree, const double p[3], double radius2, Visitor& visitor) const
+  {
+  const std::vector<BoxNode>& nodes = tree.nodes();
+  if(nodes.empty())
+    {
+    return;
+    }
+  std::vector<std::size_t> stack(1, 0);
+  while(!stack.empty())
+    {
+    const BoxNode& node = nodes[stack.back()];
+    stack.pop_back();
+    if(boxDistance2(node.box, p) > radius2)
+      {
+      continue;
+      }
+    if(node.count > 0)
+      {
+      for(std::size_t i=node.start; i < node.start + node.count; ++i)
+        {
+        visitor(tree.item(i));
+        }
+      }
+    else
+      {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+      }
+    }
+  }
+
+  //visit every cell whose box the ray crosses within [0, tmax]
+  template<typename Visitor>
+  void visitRay(const double o[3], const double dir[3], double tmax, Visitor& visitor) const
+  {
+  const std::vector<BoxNode>& nodes = this->CellTree.nodes();
+  if(nodes.empty())
+    {
+    return;
+    }
+  std::vector<std::size_t> stack(1, 0);
+  while(!stack.empty())
+    {
+    const BoxNode& node = nodes[stack.back()];
+    stack.pop_back();
+    if(!rayBox(node.box, o, dir, tmax))
+      {
+      continue;
+      }
+    if(node.count > 0)
+      {
+      for(std::size_t i=node.start; i < node.start + node.count; ++i)
+        {
+        visitor(this->CellTree.item(i));
+        }
+      }
+    else
+      {
+      stack.push_back(node.left);
+      stack.push_back(node.right);
+      }
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  struct BestCell
+  {
+    BestCell(const Internals* internals, const double* p, double tolerance2) :
+      m_internals(internals), m_p(p), m_tolerance2(tolerance2),
+      found(false), cell(0), dimension(-1), distance2(0) {}
+
+    void operator()(std::size_t c)
+    {
+    const double d2 = this->m_internals->cellDistance2(c, this->m_p);
+    if(d2 > this->m_tolerance2)
+      {
+      return;
+      }
+    const int dim = cellDimension(this->m_internals->CellTypes[c]);
+    if(!this->found || dim > this->dimension ||
+       (dim == this->dimension && d2 < this->distance2))
+      {
+      this->found = true;
+      this->cell = c;
+      this->dimension = dim;
+      this->distance2 = d2;
+      }
+    }
+
+    const Internals* m_internals;
+    const double* m_p;
+    double m_tolerance2;
+
+    bool found;
+    std::size_t cell;
+    int dimension;
+    double distance2;
+  };
+
+  //--------------------------------------------------------------------------
+  struct PointsNear
+  {
+    PointsNear(const Internals* internals, const double* p, double radius2) :
+      m_internals(internals), m_p(p), m_radius2(radius2) {}
+
+    void operator()(std::size_t i)
+    {
+    if(distance2(this->m_internals->point(i), this->m_p) <= this->m_radius2)
+      {
+      this->result.insert(this->m_internals->PointHandles[i]);
+      }
+    }
+
+    const Internals* m_internals;
+    const double* m_p;
+    double m_radius2;
+    smtk::mesh::HandleRange result;
+  };
+
+  //--------------------------------------------------------------------------
+  struct CellsNear
+  {
+    CellsNear(const Internals* internals, const double* p, double radius2) :
+      m_internals(internals), m_p(p), m_radius2(radius2) {}
+
+    void operator()(std::size_t c)
+    {
+    if(this->m_internals->cellDistance2(c, this->m_p) <= this->m_radius2)
+      {
+      this->result.insert(this->m_internals->CellHandles[c]);
+      }
+    }
+
+    const Internals* m_internals;
+    const double* m_p;
+    double m_radius2;
+    smtk::mesh::HandleRange result;
+  };
+
+  //--------------------------------------------------------------------------
+  struct RayHits
+  {
+    RayHits(const Internals* internals,
+            const double* o, const double* dir, double tmax) :
+      m_internals(internals), m_o(o), m_dir(dir), m_tmax(tmax) {}
+
+    void operator()(std::size_t c)
+    {
+    const double t = this->m_internals->cellRay(c, this->m_o, this->m_dir, this->m_tmax);
+    if(t >= 0)
+      {
+      this->hits.push_back( std::make_pair(t, this->m_internals->CellHandles[c]) );
+      }
+    }
+
+    const Internals* m_internals;
+    const double* m_o;
+    const double* m_dir;
+    double m_tmax;
+    std::vector< std::pair<double, smtk::mesh::Handle> > hits;
+  };
+};
+
+//----------------------------------------------------------------------------
+SpatialIndex::SpatialIndex(const smtk::mesh::CellSet& cells):
+  m_internals(new Internals)
+{
+  this->m_internals->indexCells(cells);
+}
+
+//----------------------------------------------------------------------------
+SpatialIndex::SpatialIndex(const smtk::mesh::PointSet& points):
+  m_internals(new Internals)
+{
+  this->m_internals->indexPoints(points);
+}
+
+//----------------------------------------------------------------------------
+SpatialIndex::~SpatialIndex()
+{
+  delete this->m_internals;
+}
+
+//----------------------------------------------------------------------------
+const smtk::mesh::HandleRange& SpatialIndex::cells() const
+{
+  return this->m_internals->Cells;
+}
+
+//----------------------------------------------------------------------------
+const smtk::mesh::HandleRange& SpatialIndex::points() const
+{
+  return this->m_internals->Points;
+}
+
+//----------------------------------------------------------------------------
+bool SpatialIndex::bounds(double b[6]) const
+{
+  const std::vector<BoxNode>& nodes = this->m_internals->PointTree.nodes();
+  if(nodes.empty())
+    {
+    return false;
+    }
+  std::copy(nodes[0].box, nodes[0].box + 6, b);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool SpatialIndex::findCell(const double point[3],
+                            smtk::mesh::Handle& cell,
+                            double tolerance) const
+{
+  Internals::BestCell best(this->m_internals, point, tolerance * tolerance);
+  this->m_internals->visitNear(this->m_internals->CellTree, point,
+                               tolerance * tolerance, best);
+  if(best.found)
+    {
+    cell = this->m_internals->CellHandles[best.cell];
+    }
+  return best.found;
+}
+
+//----------------------------------------------------------------------------
+std::vector< smtk::mesh::Handle > SpatialIndex::nearestPoints(const double point[3],
+                                                              std::size_t k) const
+{
+  typedef std::pair<double, std::size_t> Entry;
+  const BoxTree& tree = this->m_internals->PointTree;
+  const std::vector<BoxNode>& nodes = tree.nodes();
+
+  //best first search: nodes ordered by their distance, closest first, and
+  //the k closest points found so far, farthest first
+  std::priority_queue< Entry, std::vector<Entry>, std::greater<Entry> > toVisit;
+  std::priority_queue< Entry > closest;
+  if(!nodes.empty() && k > 0)
+    {
+    toVisit.push( Entry(boxDistance2(nodes[0].box, point), 0) );
+    }
+  while(!toVisit.empty())
+    {
+    const Entry next = toVisit.top();
+    toVisit.pop();
+    if(closest.size() == k && next.first > closest.top().first)
+      {
+      break;
+      }
+    const BoxNode& node = nodes[next.second];
+    if(node.count > 0)
+      {
+      for(std::size_t i=node.start; i < node.start + node.count; ++i)
+        {
+        const std::size_t p = tree.item(i);
+        const double d2 = distance2(this->m_internals->point(p), point);
+        if(closest.size() < k)
+          {
+          closest.push( Entry(d2, p) );
+          }
+        else if(d2 < closest.top().first)
+          {
+          closest.pop();
+          closest.push( Entry(d2, p) );
+          }
+        }
+      }
+    else
+      {
+      toVisit.push( Entry(boxDistance2(nodes[node.left].box, point), node.left) );
+      toVisit.push( Entry(boxDistance2(nodes[node.right].box, point), node.right) );
+      }
+    }
+
+  std::vector< smtk::mesh::Handle > result(closest.size());
+  for(std::size_t i=result.size(); i > 0; --i)
+    {
+    result[i-1] = this->m_internals->PointHandles[closest.top().second];
+    closest.pop();
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange SpatialIndex::pointsWithinRadius(const double point[3],
+                                                         double radius) const
+{
+  Internals::PointsNear near(this->m_internals, point, radius * radius);
+  this->m_internals->visitNear(this->m_internals->PointTree, point,
+                               radius * radius, near);
+  return near.result;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange SpatialIndex::cellsWithinRadius(const double point[3],
+                                                        double radius) const
+{
+  Internals::CellsNear near(this->m_internals, point, radius * radius);
+  this->m_internals->visitNear(this->m_internals->CellTree, point,
+                               radius * radius, near);
+  return near.result;
+}
+
+//----------------------------------------------------------------------------
+void SpatialIndex::intersectSegment(const double p0[3],
+                                    const double p1[3],
+                                    std::vector< std::pair<double, smtk::mesh::Handle> >& hits) const
+{
+  double dir[3];
+  sub(p1, p0, dir);
+  Internals::RayHits ray(this->m_internals, p0, dir, 1.);
+  this->m_internals->visitRay(p0, dir, 1., ray);
+  std::sort(ray.hits.begin(), ray.hits.end());
+  hits.swap(ray.hits);
+}
+
+//----------------------------------------------------------------------------
+bool SpatialIndex::intersectRay(const double origin[3],
+                                const double direction[3],
+                                smtk::mesh::Handle& cell,
+                                double& t) const
+{
+  Internals::RayHits ray(this->m_internals, origin, direction,
+              std::numeric_limits<double>::max());
+  this->m_internals->visitRay(origin, direction,
+                              std::numeric_limits<double>::max(), ray);
+  if(ray.hits.empty())
+    {
+    return false;
+    }
+  const std::pair<double, smtk::mesh::Handle> first =
+    *std::min_element(ray.hits.begin(), ray.hits.end());
+  t = first.first;
+  cell = first.second;
+  return true;
+}
+
+}
+}
@@ -0,0 +1,97 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef __smtk_mesh_SpatialIndex_h
+#define __smtk_mesh_SpatialIndex_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/PublicPointerDefs.h"
+
+#include "smtk/mesh/CellSet.h"
+#include "smtk/mesh/Handle.h"
+#include "smtk/mesh/PointSet.h"
+
+#include <utility>
+#include <vector>
+
+namespace smtk {
+namespace mesh {
+
+//A bounding volume hierarchy over the cells of a CellSet, and over the
+//points those cells use, that answers geometric queries. The index copies
+//the coordinates and connectivity it needs when constructed, so it doesn't
+//see later changes to the collection; Collection::spatialIndex() keeps an
+//index that is rebuilt when the cells or points of the collection change.
+//
+//3d cells are treated as the union of the tetrahedra they split into, and
+//2d cells as the fan of triangles around their first point, which is exact
+//for planar cells.
+class SMTKCORE_EXPORT SpatialIndex
+{
+public:
+  //index the cells and the points that they use
+  SpatialIndex(const smtk::mesh::CellSet& cells);
+
+  //index only points; cell queries will find nothing
+  SpatialIndex(const smtk::mesh::PointSet& points);
+
+  ~SpatialIndex();
+
+  //the cells and points that were indexed
+  const smtk::mesh::HandleRange& cells() const;
+  const smtk::mesh::HandleRange& points() const;
+
+  //the bounds of every indexed point as xmin, xmax, ymin, ymax, zmin, zmax.
+  //Returns false when nothing is indexed
+  bool bounds(double b[6]) const;
+
+  //find the cell that contains the point, or is within tolerance of it.
+  //When several cells qualify the one of highest dimension is chosen, then
+  //the closest one
+  bool findCell(const double point[3],
+                smtk::mesh::Handle& cell,
+                double tolerance = 1e-8) const;
+
+  //the k points closest to the given point, closest first
+  std::vector< smtk::mesh::Handle > nearestPoints(const double point[3],
+                                                  std::size_t k) const;
+
+  //all points and all cells that come within radius of the given point
+  smtk::mesh::HandleRange pointsWithinRadius(const double point[3],
+                                             double radius) const;
+  smtk::mesh::HandleRange cellsWithinRadius(const double point[3],
+                                            double radius) const;
+
+  //every 2d and 3d cell crossed by the segment from p0 to p1, as pairs of
+  //where the segment first meets the cell (0 at p0, 1 at p1) and the cell,
+  //sorted by that parameter
+  void intersectSegment(const double p0[3],
+                        const double p1[3],
+                        std::vector< std::pair<double, smtk::mesh::Handle> >& hits) const;
+
+  //the first 2d or 3d cell hit by the ray, and the parameter of the hit
+  //in units of direction
+  bool intersectRay(const double origin[3],
+                    const double direction[3],
+                    smtk::mesh::Handle& cell,
+                    double& t) const;
+
+private:
+  SpatialIndex( const SpatialIndex& other ); //blank since we are used by shared_ptr
+  SpatialIndex& operator=( const SpatialIndex& other ); //blank since we are used by shared_ptr
+
+  class Internals;
+  Internals* m_internals;
+};
+
+}
+}
+
+#endif
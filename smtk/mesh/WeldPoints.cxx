@@ -0,0 +1,301 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/WeldPoints.h"
+#include "smtk/mesh/Interface.h"
+
+#include "smtk/common/Parallel.h"
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace smtk {
+namespace mesh {
+
+namespace
+{
+
+//pieces smaller than this cost more to schedule than to weld
+const std::size_t MinimumPieceSize = 4096;
+
+//----------------------------------------------------------------------------
+//a point and the grid bin it falls in, ordered by bin and then by index
+struct BinnedPoint
+{
+  boost::int64_t bin[3];
+  std::size_t index;
+};
+
+bool sameBin(const boost::int64_t a[3], const boost::int64_t b[3])
+{
+  return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+}
+
+bool binLess(const boost::int64_t a[3], const boost::int64_t b[3])
+{
+  return std::lexicographical_compare(a, a + 3, b, b + 3);
+}
+
+bool operator<(const BinnedPoint& a, const BinnedPoint& b)
+{
+  if(!sameBin(a.bin, b.bin))
+    {
+    return binLess(a.bin, b.bin);
+    }
+  return a.index < b.index;
+}
+
+struct CompareBin
+{
+  bool operator()(const BinnedPoint& a, const boost::int64_t* bin) const
+    { return binLess(a.bin, bin); }
+  bool operator()(const boost::int64_t* bin, const BinnedPoint& a) const
+    { return binLess(bin, a.bin); }
+};
+
+//----------------------------------------------------------------------------
+std::size_t findRoot(std::vector<std::size_t>& parent, std::size_t i)
+{
+  while(parent[i] != i)
+    {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+    }
+  return i;
+}
+
+//----------------------------------------------------------------------------
+std::vector<std::size_t> pieceBounds(std::size_t size)
+{
+  std::size_t numPieces = smtk::common::Parallel::numberOfThreads() * 4;
+  numPieces = std::min(numPieces, size / MinimumPieceSize);
+  numPieces = std::max(numPieces, static_cast<std::size_t>(1));
+
+  std::vector<std::size_t> bounds(numPieces + 1);
+  for(std::size_t i=0; i <= numPieces; ++i)
+    {
+    bounds[i] = (size * i) / numPieces;
+    }
+  return bounds;
+}
+
+//----------------------------------------------------------------------------
+class BinPoints : public smtk::common::ParallelTask
+{
+public:
+  BinPoints(const double* xyz, const double origin[3], double binSize,
+            std::vector<BinnedPoint>& binned,
+            const std::vector<std::size_t>& bounds):
+    m_xyz(xyz), m_origin(origin), m_binSize(binSize),
+    m_binned(binned), m_bounds(bounds) {}
+
+  void execute(std::size_t piece)
+  {
+  for(std::size_t i=this->m_bounds[piece]; i < this->m_bounds[piece+1]; ++i)
+    {
+    BinnedPoint& bp = this->m_binned[i];
+    for(int a=0; a < 3; ++a)
+      {
+      bp.bin[a] = static_cast<boost::int64_t>(
+        std::floor((this->m_xyz[3*i+a] - this->m_origin[a]) / this->m_binSize));
+      }
+    bp.index = i;
+    }
+  }
+
+private:
+  const double* m_xyz;
+  const double* m_origin;
+  double m_binSize;
+  std::vector<BinnedPoint>& m_binned;
+  const std::vector<std::size_t>& m_bounds;
+};
+
+//----------------------------------------------------------------------------
+//finds the pairs of points within tolerance. Each point is compared with
+//the points after it in its own bin, and with the 13 neighboring bins that
+//sort after its own, so every pair is found once.
+class FindPairs : public smtk::common::ParallelTask
+{
+public:
+  typedef std::vector< std::pair<std::size_t, std::size_t> > PairVector;
+
+  FindPairs(const double* xyz, double tolerance,
+            const std::vector<BinnedPoint>& binned,
+            const std::vector<std::size_t>& bounds,
+            std::vector<PairVector>& pairs):
+    m_xyz(xyz), m_tolSquared(tolerance * tolerance),
+    m_binned(binned), m_bounds(bounds), m_pairs(pairs) {}
+
+  void execute(std::size_t piece)
+  {
+  typedef std::vector<BinnedPoint>::const_iterator iterator;
+  PairVector& pairs = this->m_pairs[piece];
+  for(std::size_t i=this->m_bounds[piece]; i < this->m_bounds[piece+1]; ++i)
+    {
+    const BinnedPoint& bp = this->m_binned[i];
+
+    //the rest of its own bin
+    for(std::size_t j=i+1; j < this->m_binned.size() &&
+                           sameBin(this->m_binned[j].bin, bp.bin); ++j)
+      {
+      this->compare(bp.index, this->m_binned[j].index, pairs);
+      }
+
+    for(int dx=0; dx <= 1; ++dx)
+      {
+      for(int dy=(dx > 0 ? -1 : 0); dy <= 1; ++dy)
+        {
+        for(int dz=(dx > 0 || dy > 0 ? -1 : 1); dz <= 1; ++dz)
+          {
+          const boost::int64_t bin[3] = { bp.bin[0] + dx, bp.bin[1] + dy, bp.bin[2] + dz };
+          std::pair<iterator, iterator> range =
+            std::equal_range(this->m_binned.begin(), this->m_binned.end(),
+                             static_cast<const boost::int64_t*>(bin), CompareBin());
+          for(iterator j = range.first; j != range.second; ++j)
+            {
+            this->compare(bp.index, j->index, pairs);
+            }
+          }
+        }
+      }
+    }
+  }
+
+private:
+  void compare(std::size_t a, std::size_t b, PairVector& pairs) const
+  {
+  const double* pa = this->m_xyz + 3 * a;
+  const double* pb = this->m_xyz + 3 * b;
+  const double dx = pa[0] - pb[0], dy = pa[1] - pb[1], dz = pa[2] - pb[2];
+  if(dx * dx + dy * dy + dz * dz <= this->m_tolSquared)
+    {
+    pairs.push_back(std::make_pair(a, b));
+    }
+  }
+
+  const double* m_xyz;
+  double m_tolSquared;
+  const std::vector<BinnedPoint>& m_binned;
+  const std::vector<std::size_t>& m_bounds;
+  std::vector<PairVector>& m_pairs;
+};
+
+}
+
+//----------------------------------------------------------------------------
+std::size_t weldPoints(const double* xyz,
+                       std::size_t numPoints,
+                       double tolerance,
+                       std::vector< std::size_t >& remap)
+{
+  remap.resize(numPoints);
+  for(std::size_t i=0; i < numPoints; ++i)
+    {
+    remap[i] = i;
+    }
+  if(numPoints < 2 || tolerance < 0)
+    {
+    return numPoints;
+    }
+
+  double lo[3] = { xyz[0], xyz[1], xyz[2] };
+  double hi[3] = { xyz[0], xyz[1], xyz[2] };
+  for(std::size_t i=1; i < numPoints; ++i)
+    {
+    for(int a=0; a < 3; ++a)
+      {
+      lo[a] = std::min(lo[a], xyz[3*i+a]);
+      hi[a] = std::max(hi[a], xyz[3*i+a]);
+      }
+    }
+
+  //bins narrower than the tolerance would miss pairs, but wider ones only
+  //cost comparisons, so widen them when the tolerance is so small that the
+  //bin numbers wouldn't fit
+  const double extent = std::max(hi[0] - lo[0], std::max(hi[1] - lo[1], hi[2] - lo[2]));
+  double binSize = std::max(tolerance, extent * 1e-12);
+  if(binSize <= 0)
+    { //every point is identical
+    binSize = 1;
+    }
+
+  std::vector<BinnedPoint> binned(numPoints);
+  const std::vector<std::size_t> bounds = pieceBounds(numPoints);
+  BinPoints binner(xyz, lo, binSize, binned, bounds);
+  smtk::common::Parallel::forEach(bounds.size() - 1, binner);
+  smtk::common::Parallel::sort(binned);
+
+  std::vector<FindPairs::PairVector> pairs(bounds.size() - 1);
+  FindPairs finder(xyz, tolerance, binned, bounds, pairs);
+  smtk::common::Parallel::forEach(bounds.size() - 1, finder);
+
+  //join the pairs, keeping the lowest index of each group as its root
+  std::vector<std::size_t>& parent = remap;
+  for(std::size_t p=0; p < pairs.size(); ++p)
+    {
+    typedef FindPairs::PairVector::const_iterator cit;
+    for(cit i = pairs[p].begin(); i != pairs[p].end(); ++i)
+      {
+      const std::size_t ra = findRoot(parent, i->first);
+      const std::size_t rb = findRoot(parent, i->second);
+      if(ra != rb)
+        {
+        parent[std::max(ra, rb)] = std::min(ra, rb);
+        }
+      }
+    }
+
+  std::size_t numKept = 0;
+  for(std::size_t i=0; i < numPoints; ++i)
+    {
+    remap[i] = findRoot(parent, i);
+    numKept += (remap[i] == i) ? 1 : 0;
+    }
+  return numKept;
+}
+
+//----------------------------------------------------------------------------
+bool weldPoints(const smtk::mesh::Interface& iface,
+                const smtk::mesh::HandleRange& points,
+                double tolerance,
+                std::vector< std::pair< smtk::mesh::Handle,
+                                        smtk::mesh::Handle > >& merged)
+{
+  if(points.empty())
+    {
+    return true;
+    }
+
+  std::vector< double > xyz(3 * points.size());
+  if(!iface.getCoordinates(points, &xyz[0]))
+    {
+    return false;
+    }
+
+  std::vector< std::size_t > remap;
+  weldPoints(&xyz[0], points.size(), tolerance, remap);
+
+  //points are visited in handle order, so the pairs come out sorted
+  std::vector< smtk::mesh::Handle > handles(points.begin(), points.end());
+  for(std::size_t i=0; i < handles.size(); ++i)
+    {
+    if(remap[i] != i)
+      {
+      merged.push_back(std::make_pair(handles[i], handles[remap[i]]));
+      }
+    }
+  return true;
+}
+
+}
+}
@@ -0,0 +1,57 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef __smtk_mesh_WeldPoints_h
+#define __smtk_mesh_WeldPoints_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/PublicPointerDefs.h"
+
+#include "smtk/mesh/Handle.h"
+
+#include <utility>
+#include <vector>
+
+namespace smtk {
+namespace mesh {
+
+class Interface;
+
+//Find the points that are within tolerance of each other, given as
+//interleaved xyz coordinates. remap is set to the index of the point each
+//point welds to, which is the lowest index of its group, so that remap[i]
+//is i for the points that are kept. Points further apart than the
+//tolerance still weld when a chain of close points joins them. A negative
+//tolerance welds nothing, and zero welds only identical points.
+//
+//The points are binned on a grid with bins as wide as the tolerance, so
+//each point is only compared with the points of neighboring bins. Binning
+//and comparing run in parallel.
+//
+//Returns the number of points that are kept.
+SMTKCORE_EXPORT std::size_t weldPoints(const double* xyz,
+                                       std::size_t numPoints,
+                                       double tolerance,
+                                       std::vector< std::size_t >& remap);
+
+//Find the points of an interface that are within tolerance of each other.
+//For each point that welds to another, appends the pair of it and the point
+//it welds to, sorted by the first, which is what Interface::mergePoints
+//takes.
+SMTKCORE_EXPORT bool weldPoints(const smtk::mesh::Interface& iface,
+                                const smtk::mesh::HandleRange& points,
+                                double tolerance,
+                                std::vector< std::pair< smtk::mesh::Handle,
+                                                        smtk::mesh::Handle > >& merged);
+
+}
+}
+
+#endif
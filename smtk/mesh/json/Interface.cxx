@@ -318,6 +318,15 @@ bool Interface::getCoordinates(const smtk::mesh::HandleRange& points,
 }
 
 
+//----------------------------------------------------------------------------
+bool Interface::getCoordinates(const smtk::mesh::Handle*,
+                               std::size_t,
+                               double*) const
+{
+  return false;
+}
+
+
 //----------------------------------------------------------------------------
 std::vector< std::string > Interface::computeNames(const smtk::mesh::HandleRange& meshsets) const
 {
@@ -450,6 +459,13 @@ bool Interface::mergeCoincidentContactPoints(const smtk::mesh::HandleRange& mesh
   return false;
 }
 
+//----------------------------------------------------------------------------
+bool Interface::mergePoints(const std::vector< std::pair< smtk::mesh::Handle,
+                                                          smtk::mesh::Handle > >&) const
+{
+  return false;
+}
+
 //----------------------------------------------------------------------------
 bool Interface::setDomain(const smtk::mesh::HandleRange& meshsets,
                             const smtk::mesh::Domain& domain) const
@@ -148,6 +148,13 @@ public:
   bool getCoordinates(const smtk::mesh::HandleRange& points,
                       float* xyz) const;
 
+  //----------------------------------------------------------------------------
+  //get the coordinates of an array of point ids
+  //xyz needs to be allocated to 3*numPoints
+  bool getCoordinates(const smtk::mesh::Handle* points,
+                      std::size_t numPoints,
+                      double* xyz) const;
+
   //----------------------------------------------------------------------------
   std::vector< std::string > computeNames(const smtk::mesh::HandleRange& meshsets) const;
 
@@ -175,6 +182,10 @@ public:
   bool mergeCoincidentContactPoints(const smtk::mesh::HandleRange& meshes,
                                    double tolerance) const;
 
+  //----------------------------------------------------------------------------
+  bool mergePoints(const std::vector< std::pair< smtk::mesh::Handle,
+                                                 smtk::mesh::Handle > >& mapping) const;
+
   //----------------------------------------------------------------------------
   bool setDomain(const smtk::mesh::HandleRange& meshsets,
                    const smtk::mesh::Domain& domain) const;
@@ -43,6 +43,7 @@ bool Allocator::allocatePoints( std::size_t numPointsToAlloc,
                                 std::vector<double* >& coordinateMemory)
 {
   if(this->m_rface == NULL) { return false; }
+  this->modified();
   ::moab::ErrorCode err;
   err = this->m_rface->get_node_coords(3, //x,y,z
                                        numPointsToAlloc,
@@ -84,6 +85,7 @@ bool Allocator::connectivityModified( const smtk::mesh::HandleRange& cellsToUpda
                                       const smtk::mesh::Handle* connectivityArray)
 {
   if(this->m_rface == NULL) { return false; }
+  this->modified();
 
   const smtk::mesh::Handle& startHandle = cellsToUpdate.front();
   ::moab::ErrorCode err;
@@ -68,6 +68,7 @@ ConnectivityStorage::ConnectivityStorage(
     this->ConnectivityStartPositions.push_back(connectivity);
     this->ConnectivityArraysLengths.push_back(numCellsInSubRange);
     this->ConnectivityVertsPerCell.push_back(numVertsPerCell);
+    this->ConnectivityTypePerCell.push_back(smtk::mesh::Vertex);
 
     //increment our iterator
     cells_current += static_cast<std::size_t>(numCellsInSubRange);
@@ -181,6 +182,17 @@ bool ConnectivityStorage::fetchNextCell(
   return true;
 }
 
+//----------------------------------------------------------------------------
+smtk::mesh::ConnectivityBlock ConnectivityStorage::block(std::size_t index) const
+{
+  smtk::mesh::ConnectivityBlock result;
+  result.cellType = this->ConnectivityTypePerCell[index];
+  result.vertsPerCell = this->ConnectivityVertsPerCell[index];
+  result.numberOfCells = static_cast<std::size_t>(this->ConnectivityArraysLengths[index]);
+  result.connectivity = this->ConnectivityStartPositions[index];
+  return result;
+}
+
 //----------------------------------------------------------------------------
 bool ConnectivityStorage::equal( smtk::mesh::ConnectivityStorage* base_other ) const
 {
@@ -42,6 +42,10 @@ public:
 
   std::size_t vertSize() const { return NumberOfVerts; }
 
+  std::size_t numberOfBlocks() const { return ConnectivityStartPositions.size(); }
+
+  smtk::mesh::ConnectivityBlock block(std::size_t index) const;
+
 private:
   //blank since we are used by shared_ptr
   ConnectivityStorage( const ConnectivityStorage& other );
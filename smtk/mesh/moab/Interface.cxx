@@ -15,11 +15,11 @@
 #include "smtk/mesh/MeshSet.h"
 #include "smtk/mesh/QueryTypes.h"
 #include "smtk/mesh/ContainsFunctors.h"
+#include "smtk/mesh/WeldPoints.h"
 
 #include "smtk/mesh/moab/CellTypeToType.h"
 #include "smtk/mesh/moab/Allocator.h"
 #include "smtk/mesh/moab/ConnectivityStorage.h"
-#include "smtk/mesh/moab/MergeMeshVertices.h"
 
 #include "moab/Core.hpp"
 #include "moab/FileOptions.hpp"
@@ -33,16 +33,49 @@
 #include "smtk/mesh/moab/Tags.h"
 #undef BEING_USED_BY_INTERFACE_CXX
 
+#include "smtk/Options.h"
+
 #include <algorithm>
 #include <cstring>
 #include <set>
 
+#ifdef SMTK_HAVE_STD_THREAD
+#  include <mutex>
+#endif
+
 namespace smtk {
 namespace mesh {
 namespace moab {
 
 namespace detail
 {
+#ifdef SMTK_HAVE_STD_THREAD
+//moab::Core::get_coords remembers the last sequence it looked up in a
+//mutable member, so coordinate queries made by the pieces of a
+//parallel_for_each must not overlap.
+std::mutex coordsMutex;
+#endif
+
+//----------------------------------------------------------------------------
+template<typename H>
+void getCoords(::moab::Interface* iface, const H& points, double* coords)
+{
+#ifdef SMTK_HAVE_STD_THREAD
+  std::lock_guard<std::mutex> lock(coordsMutex);
+#endif
+  iface->get_coords(points, coords);
+}
+
+//----------------------------------------------------------------------------
+void getCoords(::moab::Interface* iface, const smtk::mesh::Handle* points,
+               int numPoints, double* coords)
+{
+#ifdef SMTK_HAVE_STD_THREAD
+  std::lock_guard<std::mutex> lock(coordsMutex);
+#endif
+  iface->get_coords(points, numPoints, coords);
+}
+
 //----------------------------------------------------------------------------
 smtk::mesh::HandleRange vectorToRange(std::vector< ::moab::EntityHandle >& vresult)
 {
@@ -622,6 +655,21 @@ bool Interface::getCoordinates(const smtk::mesh::HandleRange& points,
 }
 
 
+//----------------------------------------------------------------------------
+bool Interface::getCoordinates(const smtk::mesh::Handle* points,
+                               std::size_t numPoints,
+                               double* xyz) const
+{
+  if(numPoints == 0)
+    {
+    return false;
+    }
+  ::moab::ErrorCode rval = m_iface->get_coords(points,
+                                               static_cast<int>(numPoints),
+                                               xyz);
+  return rval == ::moab::MB_SUCCESS;
+}
+
 //----------------------------------------------------------------------------
 std::vector< std::string > Interface::computeNames(const smtk::mesh::HandleRange& meshsets) const
 {
@@ -789,9 +837,36 @@ bool Interface::mergeCoincidentContactPoints(const smtk::mesh::HandleRange& mesh
 {
   //we want to merge the contact points for all dimensions
   //of the meshes, not just the highest dimension i expect
-  smtk::mesh::moab::MergeMeshVertices meshmerger(this->moabInterface());
-  ::moab::ErrorCode rval = meshmerger.merge_entities(meshes, tolerance);
-  return (rval == ::moab::MB_SUCCESS);
+  smtk::mesh::HandleRange points = this->getPoints(this->getCells(meshes));
+  std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > > mapping;
+  return smtk::mesh::weldPoints(*this, points, tolerance, mapping) &&
+         this->mergePoints(mapping);
+}
+
+//----------------------------------------------------------------------------
+bool Interface::mergePoints(const std::vector< std::pair< smtk::mesh::Handle,
+                                                          smtk::mesh::Handle > >& mapping) const
+{
+  if(mapping.empty())
+    {
+    return true;
+    }
+
+  //moab rewrites the connectivity of the cells using each removed point,
+  //and replaces it in the meshsets that hold it
+  ::moab::Interface* iface = this->moabInterface();
+  smtk::mesh::HandleRange removed;
+  typedef std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > >::const_iterator cit;
+  for(cit i = mapping.begin(); i != mapping.end(); ++i)
+    {
+    ::moab::ErrorCode rval = iface->merge_entities(i->second, i->first, false, false);
+    if(rval != ::moab::MB_SUCCESS)
+      {
+      return false;
+      }
+    removed.insert(i->first);
+    }
+  return iface->delete_entities(removed) == ::moab::MB_SUCCESS;
 }
 
 //----------------------------------------------------------------------------
@@ -1074,7 +1149,7 @@ void Interface::pointForEach(const HandleRange &points,
       subset.insert(start,end);
 
       //fetch all the coordinates for the start, end range
-      m_iface->get_coords( subset,  &coords[0] );
+      detail::getCoords(m_iface.get(), subset, &coords[0]);
 
       //call the filter for each point
       for(std::size_t offset = 0; start != end; offset+=3, ++start)
@@ -1093,7 +1168,7 @@ void Interface::pointForEach(const HandleRange &points,
     subset.insert(start,end);
 
     //fetch all the coordinates for the start, end range
-    m_iface->get_coords( subset,  &coords[0] );
+    detail::getCoords(m_iface.get(), subset, &coords[0]);
 
     //call the filter for each point
     for(std::size_t offset = 0; start != end; offset+=3, ++start)
@@ -1122,21 +1197,49 @@ void Interface::cellForEach(smtk::mesh::PointConnectivity& pc,
 
     if(filter.wantsCoordinates())
       {
+      //cells of one type that are stored back to back share a single
+      //connectivity array, so fetch the coordinates of a whole batch of
+      //them at once instead of querying moab per cell
+      const std::size_t maxVertsPerBatch = 16384;
+      std::vector<double> batchCoords;
       std::vector<double> coords;
-      for(pc.initCellTraversal();
-          pc.fetchNextCell(cellType, size, points) == true;
-          )
+      pc.initCellTraversal();
+      bool haveCell = pc.fetchNextCell(cellType, size, points);
+      while(haveCell)
         {
-        coords.resize(size*3);
-
-        //query to grab the coordinates for these points
-        m_iface->get_coords(points,
-                            size,
-                            &coords[0]);
-        //call the custom filter
-        filter.pointIds(points);
-        filter.coordinates(&coords);
-        filter.forCell(cellType,size);
+        const smtk::mesh::CellType batchType = cellType;
+        const int batchSize = size;
+        const smtk::mesh::Handle* batchPoints = points;
+        std::size_t numCells = 1;
+        while( (haveCell = pc.fetchNextCell(cellType, size, points)) == true &&
+               cellType == batchType && size == batchSize &&
+               points == batchPoints + numCells * batchSize &&
+               (numCells + 1) * batchSize <= maxVertsPerBatch )
+          {
+          ++numCells;
+          }
+
+        //query to grab the coordinates for the batch
+        const std::size_t numVerts = numCells * batchSize;
+        batchCoords.resize(numVerts*3);
+        if(numVerts > 0)
+          {
+          detail::getCoords(m_iface.get(), batchPoints,
+                            static_cast<int>(numVerts),
+                            &batchCoords[0]);
+          }
+
+        for(std::size_t i=0; i < numCells; ++i)
+          {
+          std::vector<double>::const_iterator cellCoords =
+            batchCoords.begin() + i * batchSize * 3;
+          coords.assign(cellCoords, cellCoords + batchSize * 3);
+
+          //call the custom filter
+          filter.pointIds(batchPoints + i * batchSize);
+          filter.coordinates(&coords);
+          filter.forCell(batchType,batchSize);
+          }
         }
       }
     else
@@ -0,0 +1,86 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#include "smtk/mesh/native/Allocator.h"
+#include "smtk/mesh/native/Storage.h"
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+//----------------------------------------------------------------------------
+Allocator::Allocator( smtk::mesh::native::Storage* storage ):
+  m_storage(storage)
+{
+}
+
+//----------------------------------------------------------------------------
+Allocator::~Allocator( )
+{
+  //don't de-allocate the storage, the Interface that created us owns it
+  this->m_storage = NULL;
+}
+
+//----------------------------------------------------------------------------
+bool Allocator::allocatePoints( std::size_t numPointsToAlloc,
+                                smtk::mesh::Handle& firstVertexHandle,
+                                std::vector<double* >& coordinateMemory)
+{
+  if(this->m_storage == NULL) { return false; }
+  this->modified();
+  firstVertexHandle = this->m_storage->allocatePoints(numPointsToAlloc,
+                                                      coordinateMemory);
+  return firstVertexHandle != 0;
+}
+
+//----------------------------------------------------------------------------
+bool Allocator::allocateCells(smtk::mesh::CellType cellType,
+                              std::size_t numCellsToAlloc,
+                              int numVertsPerCell,
+                              smtk::mesh::HandleRange& createdCellIds,
+                              smtk::mesh::Handle*& connectivityArray)
+{
+  if(this->m_storage == NULL) { return false; }
+  connectivityArray = NULL;
+  smtk::mesh::Handle startHandle =
+    this->m_storage->allocateCells(cellType,
+                                   numCellsToAlloc,
+                                   numVertsPerCell,
+                                   connectivityArray);
+  if(startHandle == 0)
+    {
+    createdCellIds.clear();
+    return false;
+    }
+
+  createdCellIds = smtk::mesh::HandleRange(startHandle,
+                                           startHandle+numCellsToAlloc-1);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool Allocator::connectivityModified( const smtk::mesh::HandleRange& cellsToUpdate,
+                                      int numVertsPerCell,
+                                      const smtk::mesh::Handle* connectivityArray)
+{
+  //connectivity is written in place and we don't keep adjacencies, so
+  //there is nothing to update. Just verify the cells are ours.
+  (void)numVertsPerCell;
+  (void)connectivityArray;
+  if(this->m_storage == NULL || cellsToUpdate.empty()) { return false; }
+  this->modified();
+  std::size_t index;
+  return this->m_storage->findCell(cellsToUpdate.front(), index) != NULL;
+}
+
+}
+}
+}
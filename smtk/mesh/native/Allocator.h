@@ -0,0 +1,62 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#ifndef __smtk_mesh_native_Allocator_h
+#define __smtk_mesh_native_Allocator_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/PublicPointerDefs.h"
+
+#include "smtk/mesh/Interface.h"
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+class Storage;
+
+//----------------------------------------------------------------------------
+class SMTKCORE_EXPORT Allocator : public smtk::mesh::Allocator
+{
+public:
+  Allocator( smtk::mesh::native::Storage* storage );
+
+  virtual ~Allocator();
+
+  //the coordinate memory is returned as 3 arrays: all x, all y, all z
+  bool allocatePoints( std::size_t numPointsToAlloc,
+                       smtk::mesh::Handle& firstVertexHandle,
+                       std::vector<double* >& coordinateMemory);
+
+  //vertices are their own cells, so allocating smtk::mesh::Vertex cells
+  //will fail. Use allocatePoints instead.
+  bool allocateCells( smtk::mesh::CellType cellType,
+                      std::size_t numCellsToAlloc,
+                      int numVertsPerCell,
+                      smtk::mesh::HandleRange& createdCellIds,
+                      smtk::mesh::Handle*& connectivityArray);
+
+  bool connectivityModified( const smtk::mesh::HandleRange& cellsToUpdate,
+                             int numVertsPerCell,
+                             const smtk::mesh::Handle* connectivityArray);
+private:
+  Allocator( const Allocator& other ); //blank since we are used by shared_ptr
+  Allocator& operator=( const Allocator& other ); //blank since we are used by shared_ptr
+
+  //holds a reference to the storage of the interface that owns us
+  smtk::mesh::native::Storage* m_storage;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,106 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#ifndef __smtk_mesh_native_BinaryFormat_h
+#define __smtk_mesh_native_BinaryFormat_h
+
+#include <boost/cstdint.hpp>
+
+namespace smtk {
+namespace mesh {
+namespace native {
+namespace binary {
+
+//these aren't exported as they are private helpers that only
+//smtk::mesh::native readers and writers should use
+
+//The layout of a native binary mesh collection file:
+//
+//  FileHeader
+//  SectionHeader[numberOfSections]
+//  section data, each section starting on a SectionAlignment boundary
+//
+//Every value is stored in the byte order and handle width of the machine
+//that wrote the file; readers reject files that don't match theirs. Point
+//and cell ids are stored as native interface handles, so a reader can hand
+//the mapped sections straight to a native interface without translating
+//them.
+
+const char Magic[8] = { 'S', 'M', 'T', 'K', 'M', 'S', 'H', '\0' };
+const boost::uint32_t Version = 1;
+const boost::uint32_t ByteOrderMark = 0x01020304;
+const boost::uint64_t SectionAlignment = 64;
+
+//the mesh index used in the association table for the collection itself
+const boost::uint64_t CollectionIndex = ~static_cast<boost::uint64_t>(0);
+
+enum SectionKind
+{
+  //count points; x[count], then y[count], then z[count] as doubles
+  Points = 1,
+  //count cells of cellType; count * vertsPerCell point handles
+  Connectivity = 2,
+  //count meshes; per mesh a MeshRecord into the MeshCells section
+  Meshes = 3,
+  //count handle pairs; the inclusive [first, last] runs of every mesh
+  MeshCells = 4,
+  //count TagRecords each
+  Domains = 5,
+  Dirichlets = 6,
+  Neumanns = 7,
+  //count AssociationRecords
+  Associations = 8
+};
+
+struct FileHeader
+{
+  char magic[8];
+  boost::uint32_t version;
+  boost::uint32_t byteOrder;
+  boost::uint32_t handleSize;
+  boost::uint32_t numberOfSections;
+  boost::uint64_t reserved;
+};
+
+struct SectionHeader
+{
+  boost::uint32_t kind;
+  boost::int32_t cellType;
+  boost::int32_t vertsPerCell;
+  boost::uint32_t reserved;
+  boost::uint64_t offset;
+  boost::uint64_t count;
+};
+
+struct MeshRecord
+{
+  boost::uint64_t firstPair;
+  boost::uint64_t numberOfPairs;
+};
+
+struct TagRecord
+{
+  boost::uint64_t mesh;
+  boost::int64_t value;
+};
+
+struct AssociationRecord
+{
+  boost::uint64_t mesh;
+  unsigned char uuid[16];
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,191 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/native/ConnectivityStorage.h"
+#include "smtk/mesh/native/Storage.h"
+
+#include "moab/EntityType.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+//----------------------------------------------------------------------------
+ConnectivityStorage::ConnectivityStorage(
+                         const smtk::mesh::native::Storage* storage,
+                         const smtk::mesh::HandleRange& cells):
+  ConnectivityStartPositions(),
+  ConnectivityArraysLengths(),
+  ConnectivityVertsPerCell(),
+  ConnectivityTypePerCell(),
+  NumberOfCells(0),
+  NumberOfVerts(0),
+  VertConnectivityStorage()
+{
+  std::size_t cellCount = 0;
+  std::size_t vertCount = 0;
+
+  //We allocate VertConnectivityStorage once before we insert any vertices
+  //this guarantees that all of the ConnectivityStartPositions pointers
+  //into our storage are valid.
+  this->VertConnectivityStorage.reserve( cells.num_of_type( ::moab::MBVERTEX ) );
+
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = cells.const_pair_begin(); p != cells.const_pair_end(); ++p)
+    {
+    smtk::mesh::Handle current = p->first;
+    const smtk::mesh::Handle last = p->second;
+    while(current <= last)
+      {
+      std::size_t index = 0;
+      if(handleType(current) == ::moab::MBVERTEX)
+        {
+        //vertices are their own connectivity
+        const std::size_t numInRun = static_cast<std::size_t>(last - current + 1);
+        const std::size_t start = this->VertConnectivityStorage.size();
+        for(smtk::mesh::Handle h = current; h <= last; ++h)
+          {
+          this->VertConnectivityStorage.push_back(h);
+          }
+        this->ConnectivityStartPositions.push_back(&this->VertConnectivityStorage[start]);
+        this->ConnectivityArraysLengths.push_back(static_cast<int>(numInRun));
+        this->ConnectivityVertsPerCell.push_back(1);
+        this->ConnectivityTypePerCell.push_back(smtk::mesh::Vertex);
+        cellCount += numInRun;
+        vertCount += numInRun;
+        current = last + 1;
+        continue;
+        }
+
+      const CellBlock* block = storage->findCell(current, index);
+      if(!block)
+        {
+#ifndef NDEBUG
+        std::cerr << "Passed range that contained non cell id " << current << std::endl;
+#endif
+        ++current;
+        continue;
+        }
+
+      //a run of handles may span several blocks of the same type
+      const smtk::mesh::Handle blockLast = block->first + block->size - 1;
+      const smtk::mesh::Handle runLast = std::min(last, blockLast);
+      const std::size_t numInRun = static_cast<std::size_t>(runLast - current + 1);
+
+      this->ConnectivityStartPositions.push_back(&block->conn[index * block->vertsPerCell]);
+      this->ConnectivityArraysLengths.push_back(static_cast<int>(numInRun));
+      this->ConnectivityVertsPerCell.push_back(block->vertsPerCell);
+      this->ConnectivityTypePerCell.push_back(block->cellType);
+      cellCount += numInRun;
+      vertCount += numInRun * block->vertsPerCell;
+      current = runLast + 1;
+      }
+    }
+
+  this->NumberOfCells = cellCount;
+  this->NumberOfVerts = vertCount;
+}
+
+//----------------------------------------------------------------------------
+ConnectivityStorage::~ConnectivityStorage( )
+{
+}
+
+//----------------------------------------------------------------------------
+void ConnectivityStorage::initTraversal(
+                       smtk::mesh::ConnectivityStorage::IterationState& state )
+{
+  state.whichConnectivityVector = 0;
+  state.ptrOffsetInVector = 0;
+}
+
+//----------------------------------------------------------------------------
+bool ConnectivityStorage::fetchNextCell(
+                       smtk::mesh::ConnectivityStorage::IterationState& state,
+                       smtk::mesh::CellType& cellType,
+                       int& numPts,
+                       const smtk::mesh::Handle* &points)
+{
+  if(state.whichConnectivityVector >= this->ConnectivityVertsPerCell.size())
+    { //we have iterated passed the end of connectivity pointers
+    return false;
+    }
+
+  const std::size_t index = state.whichConnectivityVector;
+  const std::size_t ptr = state.ptrOffsetInVector;
+
+  cellType = this->ConnectivityTypePerCell[ index ];
+  numPts = this->ConnectivityVertsPerCell[ index ];
+  points = &this->ConnectivityStartPositions[ index ][ptr];
+
+  const std::size_t currentArrayLength = this->ConnectivityArraysLengths[index] *
+                                         this->ConnectivityVertsPerCell[index];
+  if( ptr + numPts >= currentArrayLength)
+    {
+    //move to the next run
+    ++state.whichConnectivityVector;
+    state.ptrOffsetInVector = 0;
+    }
+  else
+    {
+    state.ptrOffsetInVector += numPts;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::ConnectivityBlock ConnectivityStorage::block(std::size_t index) const
+{
+  smtk::mesh::ConnectivityBlock result;
+  result.cellType = this->ConnectivityTypePerCell[index];
+  result.vertsPerCell = this->ConnectivityVertsPerCell[index];
+  result.numberOfCells = static_cast<std::size_t>(this->ConnectivityArraysLengths[index]);
+  result.connectivity = this->ConnectivityStartPositions[index];
+  return result;
+}
+
+//----------------------------------------------------------------------------
+bool ConnectivityStorage::equal( smtk::mesh::ConnectivityStorage* base_other ) const
+{
+  if( this == base_other ) { return true;}
+  if( !base_other ) { return false; }
+
+  smtk::mesh::native::ConnectivityStorage* other =
+       dynamic_cast< smtk::mesh::native::ConnectivityStorage* >(base_other);
+  if( !other ) { return false; }
+
+  if( this->NumberOfCells != other->NumberOfCells ||
+      this->ConnectivityStartPositions.size() !=
+      other->ConnectivityStartPositions.size() )
+    { return false; }
+
+  //vertex runs point into each object's own copy, so compare those by value
+  for(std::size_t i=0; i < this->ConnectivityStartPositions.size(); ++i)
+    {
+    if( this->ConnectivityArraysLengths[i] != other->ConnectivityArraysLengths[i] ||
+        this->ConnectivityTypePerCell[i] != other->ConnectivityTypePerCell[i] )
+      { return false; }
+    if( this->ConnectivityTypePerCell[i] == smtk::mesh::Vertex )
+      {
+      if( *this->ConnectivityStartPositions[i] != *other->ConnectivityStartPositions[i] )
+        { return false; }
+      }
+    else if( this->ConnectivityStartPositions[i] != other->ConnectivityStartPositions[i] )
+      { return false; }
+    }
+  return true;
+}
+
+}
+}
+}
@@ -0,0 +1,73 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef __smtk_mesh_native_ConnectivityStorage_h
+#define __smtk_mesh_native_ConnectivityStorage_h
+
+#include "smtk/PublicPointerDefs.h"
+#include "smtk/mesh/Handle.h"
+#include "smtk/mesh/Interface.h"
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+class Storage;
+
+//Points directly into the connectivity blocks of a native Storage, so
+//constructing one only records where each run of cells starts.
+class SMTKCORE_EXPORT ConnectivityStorage : public smtk::mesh::ConnectivityStorage
+{
+public:
+
+  ConnectivityStorage(const smtk::mesh::native::Storage* storage,
+                      const smtk::mesh::HandleRange& cells);
+
+  virtual ~ConnectivityStorage();
+
+  void initTraversal( smtk::mesh::ConnectivityStorage::IterationState& state );
+
+  bool fetchNextCell( smtk::mesh::ConnectivityStorage::IterationState& state,
+                      smtk::mesh::CellType& cellType,
+                      int& numPts,
+                      const smtk::mesh::Handle* &points);
+
+  bool equal( smtk::mesh::ConnectivityStorage* other ) const;
+
+  std::size_t cellSize() const { return NumberOfCells; }
+
+  std::size_t vertSize() const { return NumberOfVerts; }
+
+  std::size_t numberOfBlocks() const { return ConnectivityStartPositions.size(); }
+
+  smtk::mesh::ConnectivityBlock block(std::size_t index) const;
+
+private:
+  //blank since we are used by shared_ptr
+  ConnectivityStorage( const ConnectivityStorage& other );
+  //blank since we are used by shared_ptr
+  ConnectivityStorage& operator=( const ConnectivityStorage& other );
+
+  std::vector< const smtk::mesh::Handle* > ConnectivityStartPositions;
+  std::vector<int> ConnectivityArraysLengths;
+  std::vector<int> ConnectivityVertsPerCell;
+  std::vector< smtk::mesh::CellType > ConnectivityTypePerCell;
+  std::size_t NumberOfCells;
+  std::size_t NumberOfVerts;
+
+  //points don't have connectivity so we create our own
+  std::vector< smtk::mesh::Handle > VertConnectivityStorage;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,1178 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/MeshSet.h"
+#include "smtk/mesh/QueryTypes.h"
+#include "smtk/mesh/ContainsFunctors.h"
+#include "smtk/mesh/PointConnectivity.h"
+#include "smtk/mesh/WeldPoints.h"
+
+#include "smtk/mesh/moab/CellTypeToType.h"
+
+#include "smtk/mesh/native/Allocator.h"
+#include "smtk/mesh/native/ConnectivityStorage.h"
+#include "smtk/mesh/native/Storage.h"
+
+#include "moab/EntityType.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+namespace detail
+{
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange vectorToRange(std::vector< smtk::mesh::Handle >& vresult)
+{
+  smtk::mesh::HandleRange resulting_range;
+  smtk::mesh::HandleRange::iterator hint = resulting_range.begin();
+  const std::size_t size = vresult.size();
+  for(std::size_t i = 0; i < size;)
+    {
+    std::size_t j;
+    for(j = i + 1; j < size && vresult[j] == 1 + vresult[j-1]; j++);
+      //empty for loop
+    hint = resulting_range.insert( hint, vresult[i], vresult[i] + (j-i-1) );
+    i = j;
+    }
+  return resulting_range;
+}
+
+//----------------------------------------------------------------------------
+//The sides of a cell in the canonical (moab) ordering, so that the sides
+//of a well oriented cell face outwards.
+struct SideTable
+{
+  int numSides;
+  int sideSize[6];
+  int side[6][4];
+};
+
+const SideTable triangleSides = { 3, {2,2,2}, {{0,1},{1,2},{2,0}} };
+const SideTable quadSides = { 4, {2,2,2,2}, {{0,1},{1,2},{2,3},{3,0}} };
+const SideTable tetSides = { 4, {3,3,3,3},
+  {{0,1,3},{1,2,3},{0,3,2},{0,2,1}} };
+const SideTable pyramidSides = { 5, {3,3,3,3,4},
+  {{0,1,4},{1,2,4},{2,3,4},{3,0,4},{0,3,2,1}} };
+const SideTable wedgeSides = { 5, {4,4,4,3,3},
+  {{0,1,4,3},{1,2,5,4},{0,3,5,2},{0,2,1},{3,4,5}} };
+const SideTable hexSides = { 6, {4,4,4,4,4,4},
+  {{0,1,5,4},{1,2,6,5},{2,3,7,6},{0,4,7,3},{0,3,2,1},{4,5,6,7}} };
+
+//----------------------------------------------------------------------------
+//append the sides of a cell to sides, each as the point handles of the side
+void cellSides(smtk::mesh::CellType cellType,
+               const smtk::mesh::Handle* points,
+               int numPts,
+               std::vector< std::vector< smtk::mesh::Handle > >& sides)
+{
+  const SideTable* table = NULL;
+  switch(cellType)
+    {
+    case smtk::mesh::Line:
+      sides.push_back(std::vector< smtk::mesh::Handle >(1, points[0]));
+      sides.push_back(std::vector< smtk::mesh::Handle >(1, points[numPts - 1]));
+      return;
+    case smtk::mesh::Polygon:
+      for(int i=0; i < numPts; ++i)
+        {
+        std::vector< smtk::mesh::Handle > edge(2);
+        edge[0] = points[i];
+        edge[1] = points[(i + 1) % numPts];
+        sides.push_back(edge);
+        }
+      return;
+    case smtk::mesh::Triangle:    table = &triangleSides; break;
+    case smtk::mesh::Quad:        table = &quadSides; break;
+    case smtk::mesh::Tetrahedron: table = &tetSides; break;
+    case smtk::mesh::Pyramid:     table = &pyramidSides; break;
+    case smtk::mesh::Wedge:       table = &wedgeSides; break;
+    case smtk::mesh::Hexahedron:  table = &hexSides; break;
+    default:
+      return;
+    }
+
+  for(int s=0; s < table->numSides; ++s)
+    {
+    std::vector< smtk::mesh::Handle > side(table->sideSize[s]);
+    for(int i=0; i < table->sideSize[s]; ++i)
+      {
+      side[i] = points[table->side[s][i]];
+      }
+    sides.push_back(side);
+    }
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::CellType sideCellType(std::size_t numPts)
+{
+  switch(numPts)
+    {
+    case 2: return smtk::mesh::Line;
+    case 3: return smtk::mesh::Triangle;
+    case 4: return smtk::mesh::Quad;
+    default: break;
+    }
+  return smtk::mesh::Polygon;
+}
+
+} //detail
+
+
+//construct an empty interface instance
+smtk::mesh::native::InterfacePtr make_interface()
+{
+  return smtk::mesh::native::InterfacePtr( new smtk::mesh::native::Interface() );
+}
+
+//----------------------------------------------------------------------------
+Interface::MeshInfo::MeshInfo():
+  cells(),
+  hasDomain(false),
+  hasDirichlet(false),
+  hasNeumann(false),
+  domain(0),
+  dirichlet(0),
+  neumann(0),
+  model()
+{
+}
+
+//----------------------------------------------------------------------------
+Interface::Interface():
+  m_storage( new smtk::mesh::native::Storage() ),
+  m_alloc( new smtk::mesh::native::Allocator( this->m_storage.get() ) ),
+  m_meshes(),
+  m_nextMeshId(1)
+{
+}
+
+//----------------------------------------------------------------------------
+Interface::~Interface()
+{
+}
+
+//----------------------------------------------------------------------------
+std::size_t Interface::memoryUsed() const
+{
+  return this->m_storage->memoryUsed();
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::AllocatorPtr Interface::allocator()
+{
+  return this->m_alloc;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::ConnectivityStoragePtr Interface::connectivityStorage(
+                                      const smtk::mesh::HandleRange& cells)
+{
+  smtk::mesh::ConnectivityStoragePtr cs(
+                    new smtk::mesh::native::ConnectivityStorage(this->m_storage.get(),
+                                                                cells) );
+  return cs;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::Handle Interface::getRoot() const
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+bool Interface::createMesh(const smtk::mesh::HandleRange& cells,
+                           smtk::mesh::Handle& meshHandle)
+{
+  if(cells.empty())
+    {
+    return false;
+    }
+
+  //make sure the cells are actually cells instead of meshsets, and that
+  //every one of them exists
+  if(cells.num_of_type(::moab::MBENTITYSET) != 0)
+    {
+    return false;
+    }
+  smtk::mesh::HandleRange unknown = ::moab::subtract(cells, this->m_storage->cells());
+  unknown = ::moab::subtract(unknown, this->m_storage->points());
+  if(!unknown.empty())
+    {
+    return false;
+    }
+
+  meshHandle = makeHandle(::moab::MBENTITYSET, this->m_nextMeshId++);
+  this->m_meshes[meshHandle].cells = cells;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::size_t Interface::numMeshes(smtk::mesh::Handle handle) const
+{
+  //meshsets are only ever children of the root
+  return handle == this->getRoot() ? this->m_meshes.size() : 0;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::getMeshsets(smtk::mesh::Handle handle) const
+{
+  smtk::mesh::HandleRange range;
+  if(handle != this->getRoot())
+    {
+    return range;
+    }
+
+  //the map is sorted so we can always insert at the end
+  smtk::mesh::HandleRange::iterator hint = range.begin();
+  for(MeshInfoMapType::const_iterator i = this->m_meshes.begin();
+      i != this->m_meshes.end(); ++i)
+    {
+    hint = range.insert(hint, i->first);
+    }
+  return range;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::getMeshsets(smtk::mesh::Handle handle,
+                                                int dimension) const
+{
+  std::vector< smtk::mesh::Handle > matching_ents;
+  if(handle == this->getRoot())
+    {
+    for(MeshInfoMapType::const_iterator i = this->m_meshes.begin();
+        i != this->m_meshes.end(); ++i)
+      {
+      if(i->second.cells.num_of_dimension(dimension) != 0)
+        {
+        matching_ents.push_back(i->first);
+        }
+      }
+    }
+  return detail::vectorToRange(matching_ents);
+}
+
+//----------------------------------------------------------------------------
+//names are not stored by this interface so nothing matches
+smtk::mesh::HandleRange Interface::getMeshsets(smtk::mesh::Handle,
+                                                const std::string&) const
+{
+  return smtk::mesh::HandleRange();
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::getMeshsets(smtk::mesh::Handle handle,
+                                               const smtk::mesh::Domain &domain) const
+{
+  std::vector< smtk::mesh::Handle > matching_ents;
+  if(handle == this->getRoot())
+    {
+    for(MeshInfoMapType::const_iterator i = this->m_meshes.begin();
+        i != this->m_meshes.end(); ++i)
+      {
+      if(i->second.hasDomain && i->second.domain == domain.value())
+        {
+        matching_ents.push_back(i->first);
+        }
+      }
+    }
+  return detail::vectorToRange(matching_ents);
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::getMeshsets(smtk::mesh::Handle handle,
+                                               const smtk::mesh::Dirichlet &dirichlet) const
+{
+  std::vector< smtk::mesh::Handle > matching_ents;
+  if(handle == this->getRoot())
+    {
+    for(MeshInfoMapType::const_iterator i = this->m_meshes.begin();
+        i != this->m_meshes.end(); ++i)
+      {
+      if(i->second.hasDirichlet && i->second.dirichlet == dirichlet.value())
+        {
+        matching_ents.push_back(i->first);
+        }
+      }
+    }
+  return detail::vectorToRange(matching_ents);
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::getMeshsets(smtk::mesh::Handle handle,
+                                               const smtk::mesh::Neumann &neumann) const
+{
+  std::vector< smtk::mesh::Handle > matching_ents;
+  if(handle == this->getRoot())
+    {
+    for(MeshInfoMapType::const_iterator i = this->m_meshes.begin();
+        i != this->m_meshes.end(); ++i)
+      {
+      if(i->second.hasNeumann && i->second.neumann == neumann.value())
+        {
+        matching_ents.push_back(i->first);
+        }
+      }
+    }
+  return detail::vectorToRange(matching_ents);
+}
+
+//----------------------------------------------------------------------------
+//get all cells held by this range
+smtk::mesh::HandleRange Interface::getCells(const HandleRange &meshsets) const
+{
+  typedef smtk::mesh::HandleRange::const_iterator iterator;
+  smtk::mesh::HandleRange entitiesCells;
+  for(iterator i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    if(*i == this->getRoot())
+      { //the root holds everything
+      entitiesCells.merge(this->m_storage->points());
+      entitiesCells.merge(this->m_storage->cells());
+      continue;
+      }
+    const MeshInfo* info = this->find(*i);
+    if(info)
+      {
+      entitiesCells.merge(info->cells);
+      }
+    }
+  return entitiesCells;
+}
+
+//----------------------------------------------------------------------------
+//get all cells held by this range handle of a given cell type
+smtk::mesh::HandleRange Interface::getCells(const HandleRange &meshsets,
+                                            smtk::mesh::CellType cellType) const
+{
+  int moabCellType = smtk::mesh::moab::smtkToMOABCell(cellType);
+  return this->getCells(meshsets).subset_by_type(
+    static_cast< ::moab::EntityType >(moabCellType));
+}
+
+//----------------------------------------------------------------------------
+//get all cells held by this range handle of a given cell type(s)
+smtk::mesh::HandleRange Interface::getCells(const smtk::mesh::HandleRange& meshsets,
+                                            const smtk::mesh::CellTypes& cellTypes) const
+{
+  const std::size_t cellTypesToFind = cellTypes.count();
+  if( cellTypesToFind == cellTypes.size())
+    {
+    return this->getCells( meshsets );
+    }
+  else if(cellTypesToFind == 0)
+    {
+    return smtk::mesh::HandleRange();
+    }
+
+  //fetch the cells once and split them by type
+  smtk::mesh::HandleRange allCells = this->getCells( meshsets );
+  smtk::mesh::HandleRange entitiesCells;
+  for(int i = (cellTypes.size() -1); i >= 0; --i )
+    {
+    if( !cellTypes[i] )
+      { continue; }
+
+    int moabCellType =
+      smtk::mesh::moab::smtkToMOABCell(static_cast<smtk::mesh::CellType>(i));
+    entitiesCells.merge(
+      allCells.subset_by_type(static_cast< ::moab::EntityType >(moabCellType)));
+    }
+  return entitiesCells;
+}
+
+//----------------------------------------------------------------------------
+//get all cells held by this range handle of a given dimension
+smtk::mesh::HandleRange Interface::getCells(const smtk::mesh::HandleRange& meshsets,
+                                            smtk::mesh::DimensionType dim) const
+{
+  return this->getCells(meshsets).subset_by_dimension(static_cast<int>(dim));
+}
+
+//----------------------------------------------------------------------------
+//get all points used by the cells
+smtk::mesh::HandleRange Interface::getPoints(const smtk::mesh::HandleRange& cells) const
+{
+  //points are their own connectivity
+  smtk::mesh::HandleRange pointIds = cells.subset_by_type( ::moab::MBVERTEX );
+
+  std::vector< smtk::mesh::Handle > used;
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = cells.const_pair_begin(); p != cells.const_pair_end(); ++p)
+    {
+    smtk::mesh::Handle current = p->first;
+    while(current <= p->second)
+      {
+      if(handleType(current) == ::moab::MBVERTEX)
+        { //already added to pointIds, skip past the whole run of points
+        current = std::min(p->second, makeHandle(::moab::MBEDGE, 0) - 1) + 1;
+        continue;
+        }
+      std::size_t index = 0;
+      const CellBlock* block = this->m_storage->findCell(current, index);
+      if(!block)
+        {
+        ++current;
+        continue;
+        }
+      const smtk::mesh::Handle last =
+        std::min(p->second, block->first + block->size - 1);
+      const std::size_t numCells = static_cast<std::size_t>(last - current + 1);
+      const smtk::mesh::Handle* conn = &block->conn[index * block->vertsPerCell];
+      used.insert(used.end(), conn, conn + numCells * block->vertsPerCell);
+      current = last + 1;
+      }
+    }
+
+  std::sort(used.begin(), used.end());
+  used.erase(std::unique(used.begin(), used.end()), used.end());
+  pointIds.merge(detail::vectorToRange(used));
+  return pointIds;
+}
+
+//----------------------------------------------------------------------------
+bool Interface::getCoordinates(const smtk::mesh::HandleRange& points,
+                               double* xyz) const
+{
+  if(points.empty())
+    {
+    return false;
+    }
+
+  std::size_t xyz_index = 0;
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = points.const_pair_begin(); p != points.const_pair_end(); ++p)
+    {
+    smtk::mesh::Handle current = p->first;
+    while(current <= p->second)
+      {
+      std::size_t index = 0;
+      const PointBlock* block = this->m_storage->findPoint(current, index);
+      if(!block)
+        {
+        return false;
+        }
+      const smtk::mesh::Handle last =
+        std::min(p->second, block->first + block->size - 1);
+      const std::size_t end = index + static_cast<std::size_t>(last - current + 1);
+      for(; index < end; ++index)
+        {
+        xyz[xyz_index++] = block->x[index];
+        xyz[xyz_index++] = block->y[index];
+        xyz[xyz_index++] = block->z[index];
+        }
+      current = last + 1;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool Interface::getCoordinates(const smtk::mesh::HandleRange& points,
+                               float* xyz) const
+{
+  if(points.empty())
+    {
+    return false;
+    }
+
+  //the coordinates are already split per block, so convert them directly
+  //instead of going through a temporary array of doubles
+  std::size_t xyz_index = 0;
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = points.const_pair_begin(); p != points.const_pair_end(); ++p)
+    {
+    smtk::mesh::Handle current = p->first;
+    while(current <= p->second)
+      {
+      std::size_t index = 0;
+      const PointBlock* block = this->m_storage->findPoint(current, index);
+      if(!block)
+        {
+        return false;
+        }
+      const smtk::mesh::Handle last =
+        std::min(p->second, block->first + block->size - 1);
+      const std::size_t end = index + static_cast<std::size_t>(last - current + 1);
+      for(; index < end; ++index)
+        {
+        xyz[xyz_index++] = static_cast<float>(block->x[index]);
+        xyz[xyz_index++] = static_cast<float>(block->y[index]);
+        xyz[xyz_index++] = static_cast<float>(block->z[index]);
+        }
+      current = last + 1;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool Interface::getCoordinates(const smtk::mesh::Handle* points,
+                               std::size_t numPoints,
+                               double* xyz) const
+{
+  if(numPoints == 0)
+    {
+    return false;
+    }
+  return this->m_storage->coordinates(points, numPoints, xyz);
+}
+
+//----------------------------------------------------------------------------
+//names are not stored by this interface
+std::vector< std::string > Interface::computeNames(const smtk::mesh::HandleRange&) const
+{
+  return std::vector< std::string >();
+}
+
+//----------------------------------------------------------------------------
+std::vector< smtk::mesh::Domain > Interface::computeDomainValues(const smtk::mesh::HandleRange& meshsets) const
+{
+  std::set< int > values;
+  typedef smtk::mesh::HandleRange::const_iterator it;
+  for(it i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    const MeshInfo* info = this->find(*i);
+    if(info && info->hasDomain)
+      {
+      values.insert(info->domain);
+      }
+    }
+  return std::vector< smtk::mesh::Domain >(values.begin(), values.end());
+}
+
+//----------------------------------------------------------------------------
+std::vector< smtk::mesh::Dirichlet > Interface::computeDirichletValues(const smtk::mesh::HandleRange& meshsets) const
+{
+  std::set< int > values;
+  typedef smtk::mesh::HandleRange::const_iterator it;
+  for(it i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    const MeshInfo* info = this->find(*i);
+    if(info && info->hasDirichlet)
+      {
+      values.insert(info->dirichlet);
+      }
+    }
+  return std::vector< smtk::mesh::Dirichlet >(values.begin(), values.end());
+}
+
+//----------------------------------------------------------------------------
+std::vector< smtk::mesh::Neumann > Interface::computeNeumannValues(const smtk::mesh::HandleRange& meshsets) const
+{
+  std::set< int > values;
+  typedef smtk::mesh::HandleRange::const_iterator it;
+  for(it i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    const MeshInfo* info = this->find(*i);
+    if(info && info->hasNeumann)
+      {
+      values.insert(info->neumann);
+      }
+    }
+  return std::vector< smtk::mesh::Neumann >(values.begin(), values.end());
+}
+
+/**\brief Return the model entity of each meshset that has one.
+  *
+  */
+smtk::common::UUIDArray Interface::computeModelEntities(const smtk::mesh::HandleRange& meshsets) const
+{
+  smtk::common::UUIDArray result;
+  typedef smtk::mesh::HandleRange::const_iterator it;
+  for(it i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    const MeshInfo* info = this->find(*i);
+    if(info && info->model)
+      {
+      result.push_back(info->model);
+      }
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::TypeSet Interface::computeTypes(const smtk::mesh::HandleRange& range) const
+{
+  typedef ::smtk::mesh::CellType CellEnum;
+
+  smtk::mesh::HandleRange meshes = range.subset_by_type( ::moab::MBENTITYSET );
+  smtk::mesh::HandleRange cells = ::moab::subtract(range,meshes);
+  cells.merge(this->getCells(meshes));
+
+  smtk::mesh::CellTypes ctypes;
+  if(!cells.empty())
+    {
+    for (std::size_t i = 0; i < ctypes.size(); ++i )
+      {
+      const CellEnum ce = static_cast<CellEnum>(i);
+      const ::moab::EntityType moabEType =
+        static_cast< ::moab::EntityType >(smtk::mesh::moab::smtkToMOABCell(ce));
+      if( cells.num_of_type( moabEType ) > 0) { ctypes[ce] = true; }
+      }
+    }
+
+  const bool hasM = !(meshes.empty());
+  const bool hasC = ctypes.any();
+  return smtk::mesh::TypeSet( ctypes, hasM, hasC );
+}
+
+//----------------------------------------------------------------------------
+int Interface::highestDimension(const smtk::mesh::HandleRange& meshsets,
+                                smtk::mesh::HandleRange& cells) const
+{
+  smtk::mesh::HandleRange allCells = this->getCells(meshsets);
+  for(int dimension = 3; dimension >= 0; --dimension)
+    {
+    cells = allCells.subset_by_dimension(dimension);
+    if(!cells.empty())
+      {
+      return dimension;
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+bool Interface::computeShell(const smtk::mesh::HandleRange& meshes,
+                             smtk::mesh::HandleRange& shell) const
+{
+  typedef std::vector< smtk::mesh::Handle > Side;
+  typedef std::map< Side, std::pair< int, Side > > SideCountMap;
+
+  //step 1 get all the highest dimension cells for the meshes
+  smtk::mesh::HandleRange cells;
+  const int dimension = this->highestDimension(meshes, cells);
+  if(dimension <= 0)
+    {
+    return false;
+    }
+
+  //step 2 count how many cells use each side. Sides are keyed on their
+  //sorted points, and keep the orientation of the first cell that uses them
+  SideCountMap sideCounts;
+  std::vector< Side > sides;
+  smtk::mesh::native::ConnectivityStorage cs(this->m_storage.get(), cells);
+  smtk::mesh::ConnectivityStorage::IterationState state;
+  smtk::mesh::CellType cellType;
+  int numPts = 0;
+  const smtk::mesh::Handle* points;
+  for(cs.initTraversal(state); cs.fetchNextCell(state, cellType, numPts, points);)
+    {
+    sides.clear();
+    detail::cellSides(cellType, points, numPts, sides);
+    for(std::vector< Side >::const_iterator s = sides.begin(); s != sides.end(); ++s)
+      {
+      Side key(*s);
+      std::sort(key.begin(), key.end());
+      SideCountMap::iterator entry = sideCounts.find(key);
+      if(entry == sideCounts.end())
+        {
+        sideCounts.insert(std::make_pair(key, std::make_pair(1, *s)));
+        }
+      else
+        {
+        ++entry->second.first;
+        }
+      }
+    }
+
+  //step 3 the shell of a 1d mesh is the points at the ends of its curves
+  smtk::mesh::HandleRange result;
+  if(dimension == 1)
+    {
+    for(SideCountMap::const_iterator s = sideCounts.begin(); s != sideCounts.end(); ++s)
+      {
+      if(s->second.first == 1)
+        {
+        result.insert(s->first[0]);
+        }
+      }
+    shell = result;
+    return !shell.empty();
+    }
+
+  //step 4 reuse existing cells of the shell dimension when they match a
+  //side, so computing a shell twice doesn't create duplicate cells
+  std::map< Side, smtk::mesh::Handle > existing;
+  {
+  smtk::mesh::HandleRange candidates =
+    this->m_storage->cells().subset_by_dimension(dimension - 1);
+  smtk::mesh::native::ConnectivityStorage ecs(this->m_storage.get(), candidates);
+  smtk::mesh::HandleRange::const_iterator handle = candidates.begin();
+  for(ecs.initTraversal(state);
+      ecs.fetchNextCell(state, cellType, numPts, points); ++handle)
+    {
+    Side key(points, points + numPts);
+    std::sort(key.begin(), key.end());
+    existing[key] = *handle;
+    }
+  }
+
+  //step 5 create cells for the remaining boundary sides, grouped by the
+  //number of points so each group is a single allocation
+  std::map< std::size_t, std::vector< const Side* > > toCreate;
+  for(SideCountMap::const_iterator s = sideCounts.begin(); s != sideCounts.end(); ++s)
+    {
+    if(s->second.first != 1)
+      {
+      continue;
+      }
+    std::map< Side, smtk::mesh::Handle >::const_iterator match = existing.find(s->first);
+    if(match != existing.end())
+      {
+      result.insert(match->second);
+      }
+    else
+      {
+      toCreate[s->second.second.size()].push_back(&s->second.second);
+      }
+    }
+
+  typedef std::map< std::size_t, std::vector< const Side* > >::const_iterator group_it;
+  for(group_it g = toCreate.begin(); g != toCreate.end(); ++g)
+    {
+    smtk::mesh::Handle* conn = NULL;
+    const int vertsPerCell = static_cast<int>(g->first);
+    smtk::mesh::Handle first =
+      this->m_storage->allocateCells(detail::sideCellType(g->first),
+                                     g->second.size(), vertsPerCell, conn);
+    if(first == 0)
+      {
+      return false;
+      }
+    for(std::size_t i=0; i < g->second.size(); ++i)
+      {
+      std::copy(g->second[i]->begin(), g->second[i]->end(), conn + i * vertsPerCell);
+      }
+    result.insert(first, first + g->second.size() - 1);
+    }
+
+  shell = result;
+  return !shell.empty();
+}
+
+//----------------------------------------------------------------------------
+bool Interface::mergeCoincidentContactPoints(const smtk::mesh::HandleRange& meshes,
+                                            double tolerance) const
+{
+  //we want to merge the contact points for all dimensions
+  //of the meshes, not just the highest dimension
+  smtk::mesh::HandleRange points = this->getPoints(this->getCells(meshes));
+  if(points.empty())
+    {
+    return true;
+    }
+
+  std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > > mapping;
+  return smtk::mesh::weldPoints(*this, points, tolerance, mapping) &&
+         this->mergePoints(mapping);
+}
+
+//----------------------------------------------------------------------------
+bool Interface::mergePoints(const std::vector< std::pair< smtk::mesh::Handle,
+                                                          smtk::mesh::Handle > >& mapping) const
+{
+  if(mapping.empty())
+    {
+    return true;
+    }
+
+  std::vector< smtk::mesh::Handle > merged(mapping.size());
+  for(std::size_t i=0; i < mapping.size(); ++i)
+    {
+    merged[i] = mapping[i].first;
+    }
+
+  //rewrite the connectivity of every cell, remove the merged points, and
+  //replace them in any meshset that holds them as vertex cells
+  this->m_storage->replacePoints(mapping);
+  smtk::mesh::HandleRange mergedRange = detail::vectorToRange(merged);
+  this->m_storage->erase(mergedRange);
+  for(MeshInfoMapType::iterator m = this->m_meshes.begin(); m != this->m_meshes.end(); ++m)
+    {
+    smtk::mesh::HandleRange removed = ::moab::intersect(m->second.cells, mergedRange);
+    if(removed.empty())
+      {
+      continue;
+      }
+    m->second.cells = ::moab::subtract(m->second.cells, removed);
+    typedef smtk::mesh::HandleRange::const_iterator cit;
+    for(cit r = removed.begin(); r != removed.end(); ++r)
+      {
+      std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > >::const_iterator match =
+        std::lower_bound(mapping.begin(), mapping.end(), std::make_pair(*r, smtk::mesh::Handle(0)));
+      m->second.cells.insert(match->second);
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool Interface::setDomain(const smtk::mesh::HandleRange& meshsets,
+                          const smtk::mesh::Domain& domain) const
+{
+  bool tagged = true;
+  typedef smtk::mesh::HandleRange::const_iterator cit;
+  for(cit i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    MeshInfo* info = this->find(*i);
+    if(!info)
+      {
+      tagged = false;
+      continue;
+      }
+    info->hasDomain = true;
+    info->domain = domain.value();
+    }
+  return tagged;
+}
+
+//----------------------------------------------------------------------------
+bool Interface::setDirichlet(const smtk::mesh::HandleRange& meshsets,
+                             const smtk::mesh::Dirichlet& dirichlet) const
+{
+  bool tagged = true;
+  typedef smtk::mesh::HandleRange::const_iterator cit;
+  for(cit i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    MeshInfo* info = this->find(*i);
+    if(!info)
+      {
+      tagged = false;
+      continue;
+      }
+    info->hasDirichlet = true;
+    info->dirichlet = dirichlet.value();
+    }
+  return tagged;
+}
+
+//----------------------------------------------------------------------------
+bool Interface::setNeumann(const smtk::mesh::HandleRange& meshsets,
+                           const smtk::mesh::Neumann& neumann) const
+{
+  bool tagged = true;
+  typedef smtk::mesh::HandleRange::const_iterator cit;
+  for(cit i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    MeshInfo* info = this->find(*i);
+    if(!info)
+      {
+      tagged = false;
+      continue;
+      }
+    info->hasNeumann = true;
+    info->neumann = neumann.value();
+    }
+  return tagged;
+}
+
+/**\brief Set the model entity assigned to each meshset member to \a ent.
+  */
+bool Interface::setModelEntity(
+  const smtk::mesh::HandleRange& meshsets,
+  const smtk::common::UUID& uuid) const
+{
+  bool tagged = true;
+  typedef smtk::mesh::HandleRange::const_iterator cit;
+  for(cit i = meshsets.begin(); i != meshsets.end(); ++i)
+    {
+    MeshInfo* info = this->find(*i);
+    if(!info)
+      {
+      tagged = false;
+      continue;
+      }
+    info->model = uuid;
+    }
+  return tagged;
+}
+
+/**\brief Find mesh entities associated with the given model entity.
+  *
+  */
+smtk::mesh::HandleRange Interface::findAssociations(
+  const smtk::mesh::Handle& root,
+  const smtk::common::UUID& modelUUID)
+{
+  std::vector< smtk::mesh::Handle > matching_ents;
+  if (modelUUID && root == this->getRoot())
+    {
+    for(MeshInfoMapType::const_iterator i = this->m_meshes.begin();
+        i != this->m_meshes.end(); ++i)
+      {
+      if(i->second.model == modelUUID)
+        {
+        matching_ents.push_back(i->first);
+        }
+      }
+    }
+  return detail::vectorToRange(matching_ents);
+}
+
+//----------------------------------------------------------------------------
+bool Interface::addAssociation(const smtk::common::UUID& modelUUID,
+                               const smtk::mesh::HandleRange& range)
+{
+  if(range.empty() || !modelUUID)
+    { //if empty range or invalid uuid
+    return false;
+    }
+  return this->setModelEntity(range, modelUUID);
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::rangeIntersect(const smtk::mesh::HandleRange& a,
+                                                  const smtk::mesh::HandleRange& b) const
+{
+  return ::moab::intersect(a,b);
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::rangeDifference(const smtk::mesh::HandleRange& a,
+                                                   const smtk::mesh::HandleRange& b) const
+{
+  return ::moab::subtract(a,b);
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::rangeUnion(const smtk::mesh::HandleRange& a,
+                                              const smtk::mesh::HandleRange& b) const
+{
+  return ::moab::unite(a,b);
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::pointIntersect(const smtk::mesh::HandleRange& a,
+                                                  const smtk::mesh::HandleRange& b,
+                                                  smtk::mesh::PointConnectivity& bpc,
+                                                  const smtk::mesh::ContainsFunctor& containsFunctor) const
+{
+  if(a.empty() || b.empty())
+    { //the intersection with nothing is nothing
+    return smtk::mesh::HandleRange();
+    }
+
+  smtk::mesh::HandleRange a_points = this->getPoints(a);
+  if(a_points.empty())
+    {
+    return  smtk::mesh::HandleRange();
+    }
+
+  typedef smtk::mesh::HandleRange::const_iterator cit;
+  std::vector< smtk::mesh::Handle > vresult;
+  if(!bpc.is_empty())
+    {
+    int size=0;
+    const smtk::mesh::Handle* connectivity;
+    bpc.initCellTraversal();
+    for(cit i = b.begin(); i!= b.end(); ++i)
+      {
+      const bool validCell = bpc.fetchNextCell(size, connectivity);
+      if(validCell && containsFunctor(a_points, connectivity, size))
+        {
+        vresult.push_back( *i );
+        }
+      }
+    }
+  return detail::vectorToRange(vresult);
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::HandleRange Interface::pointDifference(const smtk::mesh::HandleRange& a,
+                                                   const smtk::mesh::HandleRange& b,
+                                                   smtk::mesh::PointConnectivity& bpc,
+                                                   const smtk::mesh::ContainsFunctor& containsFunctor) const
+{
+  if(a.empty() || b.empty())
+    { //the intersection with nothing is nothing
+    return smtk::mesh::HandleRange();
+    }
+
+  smtk::mesh::HandleRange a_points = this->getPoints(a);
+  if(a_points.empty())
+    {
+    return  smtk::mesh::HandleRange();
+    }
+
+  typedef smtk::mesh::HandleRange::const_iterator cit;
+  std::vector< smtk::mesh::Handle > vresult;
+  if(!bpc.is_empty())
+    {
+    int size=0;
+    const smtk::mesh::Handle* connectivity;
+    bpc.initCellTraversal();
+    for(cit i = b.begin(); i!= b.end(); ++i)
+      {
+      const bool validCell = bpc.fetchNextCell(size, connectivity);
+      if(validCell && !containsFunctor(a_points, connectivity, size))
+        {
+        vresult.push_back( *i );
+        }
+      }
+    }
+  return detail::vectorToRange(vresult);
+}
+
+//----------------------------------------------------------------------------
+void Interface::pointForEach(const HandleRange &points,
+                             smtk::mesh::PointForEach& filter) const
+{
+  //walk the coordinate arrays directly, a block at a time
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = points.const_pair_begin(); p != points.const_pair_end(); ++p)
+    {
+    smtk::mesh::Handle current = p->first;
+    while(current <= p->second)
+      {
+      std::size_t index = 0;
+      const PointBlock* block = this->m_storage->findPoint(current, index);
+      if(!block)
+        {
+        ++current;
+        continue;
+        }
+      const smtk::mesh::Handle last =
+        std::min(p->second, block->first + block->size - 1);
+      for(; current <= last; ++current, ++index)
+        {
+        filter.forPoint( current,
+                         block->x[index],
+                         block->y[index],
+                         block->z[index] );
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void Interface::cellForEach(smtk::mesh::PointConnectivity& pc,
+                            smtk::mesh::CellForEach& filter) const
+{
+  if(!pc.is_empty())
+    {
+    smtk::mesh::CellType cellType;
+    int size=0;
+    const smtk::mesh::Handle* points;
+
+    if(filter.wantsCoordinates())
+      {
+      std::vector<double> coords;
+      for(pc.initCellTraversal();
+          pc.fetchNextCell(cellType, size, points) == true;
+          )
+        {
+        coords.resize(size*3);
+        this->m_storage->coordinates(points, size, &coords[0]);
+
+        //call the custom filter
+        filter.pointIds(points);
+        filter.coordinates(&coords);
+        filter.forCell(cellType,size);
+        }
+      }
+    else
+      { //don't extract the coords
+      for(pc.initCellTraversal();
+          pc.fetchNextCell(cellType, size, points) == true;
+          )
+        {
+        filter.pointIds(points);
+        filter.forCell(cellType,size);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void Interface::meshForEach(const smtk::mesh::HandleRange &meshes,
+                            smtk::mesh::MeshForEach& filter) const
+{
+  typedef smtk::mesh::HandleRange::const_iterator cit;
+  for(cit i = meshes.begin(); i!= meshes.end(); ++i)
+    {
+    smtk::mesh::HandleRange singlHandle(*i,*i);
+    smtk::mesh::MeshSet singleMesh(filter.m_collection,*i,singlHandle);
+
+    //call the custom filter
+    filter.forMesh(singleMesh);
+    }
+}
+
+//----------------------------------------------------------------------------
+bool Interface::deleteHandles(const smtk::mesh::HandleRange& toDel)
+{
+  if(toDel.empty())
+    {
+    return true;
+    }
+
+  //Ranges are always sorted, and the root is always id 0
+  if(toDel.front() == this->getRoot())
+    {
+    return false;
+    }
+
+  typedef smtk::mesh::HandleRange::const_iterator cit;
+  if(toDel.all_of_type(::moab::MBENTITYSET))
+    {
+    //verify every meshset exists before removing any of them
+    for(cit i = toDel.begin(); i != toDel.end(); ++i)
+      {
+      if(!this->find(*i))
+        {
+        return false;
+        }
+      }
+    for(cit i = toDel.begin(); i != toDel.end(); ++i)
+      {
+      this->m_meshes.erase(*i);
+      }
+    return true;
+    }
+  else if(toDel.num_of_type(::moab::MBENTITYSET) == 0)
+    {
+    smtk::mesh::HandleRange live =
+      ::moab::unite(this->m_storage->points(), this->m_storage->cells());
+    if(!::moab::subtract(toDel, live).empty())
+      {
+      return false;
+      }
+    this->m_storage->erase(toDel);
+    for(MeshInfoMapType::iterator m = this->m_meshes.begin(); m != this->m_meshes.end(); ++m)
+      {
+      m->second.cells = ::moab::subtract(m->second.cells, toDel);
+      }
+    return true;
+    }
+
+  //we are mixed cells and entity sets and must fail
+  return false;
+}
+
+//----------------------------------------------------------------------------
+Interface::MeshInfo* Interface::find(smtk::mesh::Handle handle) const
+{
+  MeshInfoMapType::iterator i = this->m_meshes.find(handle);
+  return i == this->m_meshes.end() ? NULL : &i->second;
+}
+
+}
+}
+}
@@ -0,0 +1,377 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#include "smtk/mesh/native/Readers.h"
+#include "smtk/mesh/native/BinaryFormat.h"
+#include "smtk/mesh/native/Interface.h"
+#include "smtk/mesh/native/Storage.h"
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+
+#include <cstring>
+#include <fstream>
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+namespace
+{
+using namespace smtk::mesh::native::binary;
+
+//----------------------------------------------------------------------------
+//The contents of a file, mapped copy-on-write where the platform supports
+//it so that changes made through the interface never reach the file, and
+//read into memory otherwise.
+class MappedFile
+{
+public:
+  static smtk::shared_ptr< MappedFile > open(const std::string& path)
+  {
+  smtk::shared_ptr< MappedFile > file(new MappedFile);
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0)
+    {
+    return smtk::shared_ptr< MappedFile >();
+    }
+  struct stat info;
+  if(::fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+    void* data = ::mmap(NULL, static_cast<std::size_t>(info.st_size),
+                        PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if(data != MAP_FAILED)
+      {
+      file->m_data = static_cast<char*>(data);
+      file->m_size = static_cast<std::size_t>(info.st_size);
+      }
+    }
+  ::close(fd);
+  if(file->m_data)
+    {
+    return file;
+    }
+#endif
+
+  //fall back to reading the whole file, into 8 byte aligned memory
+  std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+  if(!in)
+    {
+    return smtk::shared_ptr< MappedFile >();
+    }
+  in.seekg(0, std::ios::end);
+  const std::streamoff size = in.tellg();
+  in.seekg(0, std::ios::beg);
+  if(size <= 0)
+    {
+    return smtk::shared_ptr< MappedFile >();
+    }
+  file->m_memory.resize((static_cast<std::size_t>(size) + 7) / 8);
+  file->m_data = reinterpret_cast<char*>(&file->m_memory[0]);
+  file->m_size = static_cast<std::size_t>(size);
+  if(!in.read(file->m_data, size))
+    {
+    return smtk::shared_ptr< MappedFile >();
+    }
+  return file;
+  }
+
+  ~MappedFile()
+  {
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  if(this->m_data && this->m_memory.empty())
+    {
+    ::munmap(this->m_data, this->m_size);
+    }
+#endif
+  }
+
+  char* data() const { return this->m_data; }
+  std::size_t size() const { return this->m_size; }
+
+private:
+  MappedFile() : m_data(NULL), m_size(0) {}
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+
+  char* m_data;
+  std::size_t m_size;
+  std::vector< boost::uint64_t > m_memory;
+};
+
+//----------------------------------------------------------------------------
+//the data of a section, or NULL if it doesn't fit inside the file
+template<typename T>
+T* sectionData(const MappedFile& file,
+               const SectionHeader& header,
+               boost::uint64_t valuesPerEntry = 1)
+{
+  const boost::uint64_t size = file.size();
+  if(header.offset % sizeof(boost::uint64_t) != 0 || header.offset > size)
+    {
+    return NULL;
+    }
+  const boost::uint64_t available = (size - header.offset) / sizeof(T);
+  if(valuesPerEntry == 0 || header.count > available / valuesPerEntry)
+    {
+    return NULL;
+    }
+  return reinterpret_cast<T*>(file.data() + header.offset);
+}
+
+//----------------------------------------------------------------------------
+const SectionHeader* findSection(const SectionHeader* headers,
+                                 boost::uint32_t numberOfSections,
+                                 SectionKind kind)
+{
+  for(boost::uint32_t i=0; i < numberOfSections; ++i)
+    {
+    if(headers[i].kind == static_cast<boost::uint32_t>(kind))
+      {
+      return headers + i;
+      }
+    }
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+//the records of an optional tag or association section, or false if the
+//section doesn't fit inside the file or names a mesh that doesn't exist
+template<typename Record>
+bool records(const MappedFile& file,
+             const SectionHeader* header,
+             std::size_t numberOfMeshes,
+             const Record*& result,
+             boost::uint64_t& count)
+{
+  result = NULL;
+  count = 0;
+  if(!header || header->count == 0)
+    {
+    return true;
+    }
+  result = sectionData<const Record>(file, *header);
+  if(!result)
+    {
+    return false;
+    }
+  count = header->count;
+  for(boost::uint64_t i=0; i < count; ++i)
+    {
+    if(result[i].mesh >= numberOfMeshes && result[i].mesh != CollectionIndex)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+template<typename TagType>
+bool setTags(const smtk::mesh::native::InterfacePtr& iface,
+             const MappedFile& file,
+             const SectionHeader* header,
+             const std::vector< smtk::mesh::Handle >& meshes,
+             bool (smtk::mesh::native::Interface::*setTag)(
+               const smtk::mesh::HandleRange&, const TagType&) const)
+{
+  const TagRecord* tags;
+  boost::uint64_t count;
+  if(!records(file, header, meshes.size(), tags, count))
+    {
+    return false;
+    }
+  for(boost::uint64_t i=0; i < count; ++i)
+    {
+    if(tags[i].mesh == CollectionIndex)
+      {
+      return false;
+      }
+    const smtk::mesh::Handle mesh = meshes[tags[i].mesh];
+    ((*iface).*setTag)(smtk::mesh::HandleRange(mesh, mesh),
+                       TagType(static_cast<int>(tags[i].value)));
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool load(const smtk::shared_ptr< MappedFile >& file,
+          const smtk::mesh::native::InterfacePtr& iface,
+          smtk::common::UUID& associatedModel)
+{
+  if(file->size() < sizeof(FileHeader))
+    {
+    return false;
+    }
+  const FileHeader* fileHeader = reinterpret_cast<const FileHeader*>(file->data());
+  if(std::memcmp(fileHeader->magic, Magic, sizeof(Magic)) != 0 ||
+     fileHeader->version != Version ||
+     fileHeader->byteOrder != ByteOrderMark ||
+     fileHeader->handleSize != sizeof(smtk::mesh::Handle))
+    {
+    return false;
+    }
+  const boost::uint32_t numSections = fileHeader->numberOfSections;
+  if(numSections > (file->size() - sizeof(FileHeader)) / sizeof(SectionHeader))
+    {
+    return false;
+    }
+  const SectionHeader* headers =
+    reinterpret_cast<const SectionHeader*>(file->data() + sizeof(FileHeader));
+
+  //the mapped file is kept alive by every block that uses its memory
+  const smtk::shared_ptr<void> external = file;
+  smtk::mesh::native::Storage& storage = iface->storage();
+
+  //points and connectivity are used in place. Their handles were assigned
+  //by the writer in the same order a fresh interface assigns them
+  for(boost::uint32_t i=0; i < numSections; ++i)
+    {
+    const SectionHeader& header = headers[i];
+    if(header.kind == Points && header.count > 0)
+      {
+      double* xyz = sectionData<double>(*file, header, 3);
+      const std::size_t n = static_cast<std::size_t>(header.count);
+      if(!xyz || storage.adoptPoints(n, xyz, xyz + n, xyz + 2 * n, external) == 0)
+        {
+        return false;
+        }
+      }
+    else if(header.kind == Connectivity && header.count > 0)
+      {
+      if(header.cellType <= smtk::mesh::Vertex ||
+         header.cellType >= smtk::mesh::CellType_MAX ||
+         header.vertsPerCell <= 0)
+        {
+        return false;
+        }
+      smtk::mesh::Handle* conn = sectionData<smtk::mesh::Handle>(
+        *file, header, static_cast<boost::uint64_t>(header.vertsPerCell));
+      if(!conn ||
+         storage.adoptCells(static_cast<smtk::mesh::CellType>(header.cellType),
+                            static_cast<std::size_t>(header.count),
+                            header.vertsPerCell, conn, external) == 0)
+        {
+        return false;
+        }
+      }
+    }
+
+  //meshes, which are numbered by their position in the file
+  std::vector< smtk::mesh::Handle > meshes;
+  const SectionHeader* meshHeader = findSection(headers, numSections, Meshes);
+  const SectionHeader* pairHeader = findSection(headers, numSections, MeshCells);
+  if(meshHeader && meshHeader->count > 0)
+    {
+    const MeshRecord* meshRecords = sectionData<const MeshRecord>(*file, *meshHeader);
+    const smtk::mesh::Handle* pairs = pairHeader ?
+      sectionData<const smtk::mesh::Handle>(*file, *pairHeader, 2) : NULL;
+    if(!meshRecords || !pairs)
+      {
+      return false;
+      }
+    meshes.resize(static_cast<std::size_t>(meshHeader->count));
+    for(std::size_t m=0; m < meshes.size(); ++m)
+      {
+      const MeshRecord& record = meshRecords[m];
+      if(record.firstPair > pairHeader->count ||
+         record.numberOfPairs > pairHeader->count - record.firstPair)
+        {
+        return false;
+        }
+      smtk::mesh::HandleRange cells;
+      const smtk::mesh::Handle* pair = pairs + 2 * record.firstPair;
+      for(boost::uint64_t p=0; p < record.numberOfPairs; ++p, pair += 2)
+        {
+        if(pair[0] > pair[1])
+          {
+          return false;
+          }
+        cells.insert(pair[0], pair[1]);
+        }
+      if(!iface->createMesh(cells, meshes[m]))
+        {
+        return false;
+        }
+      }
+    }
+
+  if(!setTags<smtk::mesh::Domain>(iface, *file,
+        findSection(headers, numSections, Domains), meshes,
+        &smtk::mesh::native::Interface::setDomain) ||
+     !setTags<smtk::mesh::Dirichlet>(iface, *file,
+        findSection(headers, numSections, Dirichlets), meshes,
+        &smtk::mesh::native::Interface::setDirichlet) ||
+     !setTags<smtk::mesh::Neumann>(iface, *file,
+        findSection(headers, numSections, Neumanns), meshes,
+        &smtk::mesh::native::Interface::setNeumann))
+    {
+    return false;
+    }
+
+  const AssociationRecord* associations;
+  boost::uint64_t numAssociations;
+  if(!records(*file, findSection(headers, numSections, Associations),
+              meshes.size(), associations, numAssociations))
+    {
+    return false;
+    }
+  for(boost::uint64_t i=0; i < numAssociations; ++i)
+    {
+    const AssociationRecord& record = associations[i];
+    const smtk::common::UUID uuid(record.uuid, record.uuid + smtk::common::UUID::SIZE);
+    if(record.mesh == CollectionIndex)
+      {
+      associatedModel = uuid;
+      }
+    else
+      {
+      const smtk::mesh::Handle mesh = meshes[record.mesh];
+      iface->setModelEntity(smtk::mesh::HandleRange(mesh, mesh), uuid);
+      }
+    }
+  return true;
+}
+
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::CollectionPtr read(const std::string& path,
+                               const smtk::mesh::ManagerPtr& manager)
+{
+  smtk::shared_ptr< MappedFile > file = MappedFile::open(path);
+  smtk::mesh::native::InterfacePtr iface = smtk::mesh::native::make_interface();
+  smtk::common::UUID associatedModel;
+  if(!file || !manager || !load(file, iface, associatedModel))
+    {
+    //create an invalid collection which isn't part of a manager
+    return smtk::mesh::Collection::create();
+    }
+
+  smtk::mesh::CollectionPtr collection = manager->makeCollection(iface);
+  if(!associatedModel.isNull())
+    {
+    collection->associateModel(associatedModel);
+    }
+  return collection;
+}
+
+}
+}
+}
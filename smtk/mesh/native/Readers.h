@@ -0,0 +1,40 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+
+
+#ifndef __smtk_mesh_native_Readers_h
+#define __smtk_mesh_native_Readers_h
+
+#include "smtk/PublicPointerDefs.h"
+
+#include <string>
+
+namespace smtk {
+namespace mesh {
+namespace native
+{
+
+//Load a native binary file as a new collection into the given manager.
+//The file is mapped into memory instead of being read, and the points and
+//connectivity are used in place, so opening the file only costs the size
+//of its mesh tables. Changes made to the collection are never written back
+//to the file.
+//Returns an invalid collection that is NOT part of the manager if the
+//file can't be loaded
+smtk::mesh::CollectionPtr read(const std::string& path,
+                               const smtk::mesh::ManagerPtr& manager);
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,348 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#include "smtk/mesh/native/Storage.h"
+
+#include "smtk/mesh/moab/CellTypeToType.h"
+
+#include "moab/EntityType.hpp"
+
+#include <algorithm>
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+namespace
+{
+//----------------------------------------------------------------------------
+template<typename BlockType>
+struct BlockEndsBefore
+{
+  bool operator()(const smtk::shared_ptr< BlockType >& block,
+                  smtk::mesh::Handle handle) const
+  {
+  return block->first + block->size <= handle;
+  }
+};
+
+//----------------------------------------------------------------------------
+template<typename BlockType>
+const BlockType* findBlock(const std::vector< smtk::shared_ptr< BlockType > >& blocks,
+                           smtk::mesh::Handle handle,
+                           std::size_t& index)
+{
+  //blocks are sorted and never overlap, so the first block that doesn't
+  //end before the handle is the only one that can hold it
+  typename std::vector< smtk::shared_ptr< BlockType > >::const_iterator it =
+    std::lower_bound(blocks.begin(), blocks.end(), handle, BlockEndsBefore<BlockType>());
+  if(it == blocks.end() || (*it)->first > handle)
+    {
+    return NULL;
+    }
+  index = static_cast<std::size_t>(handle - (*it)->first);
+  return it->get();
+}
+
+//----------------------------------------------------------------------------
+//drop the blocks that no longer hold a live handle, releasing their memory.
+//blocks and the pairs of live are both sorted, so one pass over each is
+//enough; pair is left at the first pair that may overlap a later block.
+template<typename BlockType>
+void releaseUnusedBlocks(std::vector< smtk::shared_ptr< BlockType > >& blocks,
+                         const smtk::mesh::HandleRange& live,
+                         smtk::mesh::HandleRange::const_pair_iterator& pair)
+{
+  typedef typename std::vector< smtk::shared_ptr< BlockType > >::iterator bit;
+  bit kept = blocks.begin();
+  for(bit b = blocks.begin(); b != blocks.end(); ++b)
+    {
+    const smtk::mesh::Handle last = (*b)->first + (*b)->size - 1;
+    while(pair != live.const_pair_end() && pair->second < (*b)->first)
+      {
+      ++pair;
+      }
+    if(pair != live.const_pair_end() && pair->first <= last)
+      {
+      *kept++ = *b;
+      }
+    }
+  blocks.erase(kept, blocks.end());
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+std::size_t bytesOf(const std::vector<T>& v)
+{
+  return v.capacity() * sizeof(T);
+}
+
+}
+
+//----------------------------------------------------------------------------
+Storage::Storage():
+  m_pointBlocks(),
+  m_points(),
+  m_cells()
+{
+  //ids start at 1 so that no handle collides with the root (0)
+  std::fill(this->m_nextId, this->m_nextId + NumberOfHandleTypes, 1);
+}
+
+//----------------------------------------------------------------------------
+smtk::shared_ptr< PointBlock > Storage::addPointBlock(std::size_t numPoints)
+{
+  smtk::shared_ptr< PointBlock > block;
+  if(numPoints == 0)
+    {
+    return block;
+    }
+
+  block.reset(new PointBlock);
+  block->first = makeHandle(::moab::MBVERTEX, this->m_nextId[::moab::MBVERTEX]);
+  block->size = numPoints;
+  block->x = block->y = block->z = NULL;
+  this->m_nextId[::moab::MBVERTEX] += numPoints;
+  this->m_pointBlocks.push_back(block);
+  this->m_points.insert(block->first, block->first + numPoints - 1);
+  return block;
+}
+
+//----------------------------------------------------------------------------
+smtk::shared_ptr< CellBlock > Storage::addCellBlock(smtk::mesh::CellType cellType,
+                                                   std::size_t numCells,
+                                                   int numVertsPerCell)
+{
+  //vertices are their own cells, so they are created with allocatePoints
+  smtk::shared_ptr< CellBlock > block;
+  const int entityType = smtk::mesh::moab::smtkToMOABCell(cellType);
+  if(numCells == 0 || numVertsPerCell <= 0 ||
+     entityType <= ::moab::MBVERTEX || entityType >= ::moab::MBENTITYSET)
+    {
+    return block;
+    }
+
+  block.reset(new CellBlock);
+  block->first = makeHandle(entityType, this->m_nextId[entityType]);
+  block->size = numCells;
+  block->vertsPerCell = numVertsPerCell;
+  block->cellType = cellType;
+  block->conn = NULL;
+  this->m_nextId[entityType] += numCells;
+  this->m_cellBlocks[entityType].push_back(block);
+  this->m_cells.insert(block->first, block->first + numCells - 1);
+  return block;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::Handle Storage::allocatePoints(std::size_t numPoints,
+                                           std::vector<double* >& coordinateMemory)
+{
+  smtk::shared_ptr< PointBlock > block = this->addPointBlock(numPoints);
+  if(!block)
+    {
+    return 0;
+    }
+
+  block->memory.resize(3 * numPoints, 0.);
+  block->x = &block->memory[0];
+  block->y = block->x + numPoints;
+  block->z = block->y + numPoints;
+
+  coordinateMemory.resize(3);
+  coordinateMemory[0] = block->x;
+  coordinateMemory[1] = block->y;
+  coordinateMemory[2] = block->z;
+  return block->first;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::Handle Storage::allocateCells(smtk::mesh::CellType cellType,
+                                          std::size_t numCells,
+                                          int numVertsPerCell,
+                                          smtk::mesh::Handle*& connectivity)
+{
+  smtk::shared_ptr< CellBlock > block =
+    this->addCellBlock(cellType, numCells, numVertsPerCell);
+  if(!block)
+    {
+    return 0;
+    }
+
+  block->memory.resize(numCells * numVertsPerCell, 0);
+  block->conn = &block->memory[0];
+
+  connectivity = block->conn;
+  return block->first;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::Handle Storage::adoptPoints(std::size_t numPoints,
+                                        double* x, double* y, double* z,
+                                        const smtk::shared_ptr<void>& external)
+{
+  if(!x || !y || !z)
+    {
+    return 0;
+    }
+  smtk::shared_ptr< PointBlock > block = this->addPointBlock(numPoints);
+  if(!block)
+    {
+    return 0;
+    }
+
+  block->x = x;
+  block->y = y;
+  block->z = z;
+  block->external = external;
+  return block->first;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::Handle Storage::adoptCells(smtk::mesh::CellType cellType,
+                                       std::size_t numCells,
+                                       int numVertsPerCell,
+                                       smtk::mesh::Handle* connectivity,
+                                       const smtk::shared_ptr<void>& external)
+{
+  if(!connectivity)
+    {
+    return 0;
+    }
+  smtk::shared_ptr< CellBlock > block =
+    this->addCellBlock(cellType, numCells, numVertsPerCell);
+  if(!block)
+    {
+    return 0;
+    }
+
+  block->conn = connectivity;
+  block->external = external;
+  return block->first;
+}
+
+//----------------------------------------------------------------------------
+const PointBlock* Storage::findPoint(smtk::mesh::Handle point,
+                                     std::size_t& index) const
+{
+  if(handleType(point) != ::moab::MBVERTEX)
+    {
+    return NULL;
+    }
+  return findBlock(this->m_pointBlocks, point, index);
+}
+
+//----------------------------------------------------------------------------
+const CellBlock* Storage::findCell(smtk::mesh::Handle cell,
+                                   std::size_t& index) const
+{
+  const int entityType = handleType(cell);
+  if(entityType <= ::moab::MBVERTEX || entityType >= ::moab::MBENTITYSET)
+    {
+    return NULL;
+    }
+  return findBlock(this->m_cellBlocks[entityType], cell, index);
+}
+
+//----------------------------------------------------------------------------
+bool Storage::coordinates(const smtk::mesh::Handle* points,
+                          std::size_t numPoints,
+                          double* xyz) const
+{
+  for(std::size_t i=0; i < numPoints; ++i)
+    {
+    std::size_t index;
+    const PointBlock* block = this->findPoint(points[i], index);
+    if(!block)
+      {
+      return false;
+      }
+    xyz[3*i]   = block->x[index];
+    xyz[3*i+1] = block->y[index];
+    xyz[3*i+2] = block->z[index];
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void Storage::erase(const smtk::mesh::HandleRange& entities)
+{
+  this->m_points = ::moab::subtract(this->m_points, entities);
+  this->m_cells = ::moab::subtract(this->m_cells, entities);
+
+  //handles are never reused, so once every entity of a block is erased
+  //nothing can refer to it and its memory can be released
+  smtk::mesh::HandleRange::const_pair_iterator pair =
+    this->m_points.const_pair_begin();
+  releaseUnusedBlocks(this->m_pointBlocks, this->m_points, pair);
+
+  //cell handles are sorted by type first, so a single pass covers every type
+  pair = this->m_cells.const_pair_begin();
+  for(int t = ::moab::MBEDGE; t < ::moab::MBENTITYSET; ++t)
+    {
+    releaseUnusedBlocks(this->m_cellBlocks[t], this->m_cells, pair);
+    }
+}
+
+//----------------------------------------------------------------------------
+void Storage::replacePoints(
+  const std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > >& mapping)
+{
+  typedef std::pair< smtk::mesh::Handle, smtk::mesh::Handle > PointPair;
+  typedef std::vector< PointPair >::const_iterator cit;
+  if(mapping.empty())
+    {
+    return;
+    }
+
+  for(int t = ::moab::MBEDGE; t < ::moab::MBENTITYSET; ++t)
+    {
+    typedef std::vector< smtk::shared_ptr< CellBlock > >::const_iterator bit;
+    for(bit b = this->m_cellBlocks[t].begin(); b != this->m_cellBlocks[t].end(); ++b)
+      {
+      smtk::mesh::Handle* conn = (*b)->conn;
+      const std::size_t length = (*b)->size * (*b)->vertsPerCell;
+      for(std::size_t i=0; i < length; ++i)
+        {
+        cit match = std::lower_bound(mapping.begin(), mapping.end(),
+                                     PointPair(conn[i], 0));
+        if(match != mapping.end() && match->first == conn[i])
+          {
+          conn[i] = match->second;
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+std::size_t Storage::memoryUsed() const
+{
+  std::size_t total = 0;
+  typedef std::vector< smtk::shared_ptr< PointBlock > >::const_iterator pit;
+  for(pit p = this->m_pointBlocks.begin(); p != this->m_pointBlocks.end(); ++p)
+    {
+    total += bytesOf((*p)->memory);
+    }
+  for(int t = 0; t < NumberOfHandleTypes; ++t)
+    {
+    typedef std::vector< smtk::shared_ptr< CellBlock > >::const_iterator cit;
+    for(cit c = this->m_cellBlocks[t].begin(); c != this->m_cellBlocks[t].end(); ++c)
+      {
+      total += bytesOf((*c)->memory);
+      }
+    }
+  return total;
+}
+
+}
+}
+}
@@ -0,0 +1,159 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#ifndef __smtk_mesh_native_Storage_h
+#define __smtk_mesh_native_Storage_h
+
+#include "smtk/SharedPtr.h"
+
+#include "smtk/mesh/CellTypes.h"
+#include "smtk/mesh/Handle.h"
+
+#include <vector>
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+//these aren't exported as they are private helpers that only
+//smtk::mesh::native should call
+
+//Handles use the same layout as moab: the entity type in the top 4 bits
+//and a per-type id in the remaining bits. This keeps HandleRange queries
+//such as num_of_type and subset_by_dimension, and the handle JSON
+//encoding, working unchanged.
+const int HandleIdWidth = 8 * sizeof(smtk::mesh::Handle) - 4;
+
+inline smtk::mesh::Handle makeHandle(int entityType, smtk::mesh::Handle id)
+{
+  return (static_cast<smtk::mesh::Handle>(entityType) << HandleIdWidth) | id;
+}
+
+inline int handleType(smtk::mesh::Handle handle)
+{
+  return static_cast<int>(handle >> HandleIdWidth);
+}
+
+//----------------------------------------------------------------------------
+//A run of points created by a single allocation. Coordinates are stored
+//as one array per axis so that filling and scanning them is contiguous.
+//The arrays either live in memory owned by the block, or in external
+//memory (such as a mapped file) kept alive by external.
+struct PointBlock
+{
+  smtk::mesh::Handle first;
+  std::size_t size;
+  double* x;
+  double* y;
+  double* z;
+  std::vector<double> memory;
+  smtk::shared_ptr<void> external;
+};
+
+//----------------------------------------------------------------------------
+//A run of cells of one type created by a single allocation. The point
+//handles of every cell are stored back to back in conn, which is owned
+//the same way as the PointBlock coordinates.
+struct CellBlock
+{
+  smtk::mesh::Handle first;
+  std::size_t size;
+  int vertsPerCell;
+  smtk::mesh::CellType cellType;
+  smtk::mesh::Handle* conn;
+  std::vector< smtk::mesh::Handle > memory;
+  smtk::shared_ptr<void> external;
+};
+
+//----------------------------------------------------------------------------
+//Owns the points and cells of a native interface. Blocks are never
+//reallocated once created, so pointers handed out by allocatePoints and
+//allocateCells stay valid until every entity of the block is erased.
+//Deleted entities are removed from the live ranges; a block's memory is
+//released once none of its entities are live. Handles are never reused.
+class Storage
+{
+public:
+  Storage();
+
+  //returns the handle of the first point, or 0 on failure
+  smtk::mesh::Handle allocatePoints(std::size_t numPoints,
+                                    std::vector<double* >& coordinateMemory);
+
+  //returns the handle of the first cell, or 0 on failure
+  smtk::mesh::Handle allocateCells(smtk::mesh::CellType cellType,
+                                   std::size_t numCells,
+                                   int numVertsPerCell,
+                                   smtk::mesh::Handle*& connectivity);
+
+  //add points or cells whose memory is owned by external instead of the
+  //storage, without copying. The memory must stay valid and writable for
+  //as long as external is alive. Returns the first handle, or 0 on failure.
+  smtk::mesh::Handle adoptPoints(std::size_t numPoints,
+                                 double* x, double* y, double* z,
+                                 const smtk::shared_ptr<void>& external);
+  smtk::mesh::Handle adoptCells(smtk::mesh::CellType cellType,
+                                std::size_t numCells,
+                                int numVertsPerCell,
+                                smtk::mesh::Handle* connectivity,
+                                const smtk::shared_ptr<void>& external);
+
+  //find the block holding the given handle, and the index into it
+  const PointBlock* findPoint(smtk::mesh::Handle point, std::size_t& index) const;
+  const CellBlock* findCell(smtk::mesh::Handle cell, std::size_t& index) const;
+
+  //copy the coordinates of numPoints points into xyz (3*numPoints values)
+  bool coordinates(const smtk::mesh::Handle* points,
+                   std::size_t numPoints,
+                   double* xyz) const;
+
+  //all point and cell blocks, sorted by their first handle
+  const std::vector< smtk::shared_ptr< PointBlock > >& pointBlocks() const
+    { return this->m_pointBlocks; }
+  const std::vector< smtk::shared_ptr< CellBlock > >& cellBlocks(int entityType) const
+    { return this->m_cellBlocks[entityType]; }
+
+  //the points and cells that have been allocated and not deleted
+  const smtk::mesh::HandleRange& points() const { return this->m_points; }
+  const smtk::mesh::HandleRange& cells() const { return this->m_cells; }
+
+  //remove entities from the live ranges, releasing blocks left empty
+  void erase(const smtk::mesh::HandleRange& entities);
+
+  //replace every use of a point as listed in the sorted (from, to) pairs
+  void replacePoints(
+    const std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > >& mapping);
+
+  //bytes of memory owned by the storage, excluding external memory
+  std::size_t memoryUsed() const;
+
+private:
+  smtk::shared_ptr< PointBlock > addPointBlock(std::size_t numPoints);
+  smtk::shared_ptr< CellBlock > addCellBlock(smtk::mesh::CellType cellType,
+                                             std::size_t numCells,
+                                             int numVertsPerCell);
+
+  //moab::MBMAXTYPE, the number of distinct handle types
+  enum { NumberOfHandleTypes = 12 };
+
+  std::vector< smtk::shared_ptr< PointBlock > > m_pointBlocks;
+  std::vector< smtk::shared_ptr< CellBlock > > m_cellBlocks[NumberOfHandleTypes];
+  smtk::mesh::Handle m_nextId[NumberOfHandleTypes];
+
+  smtk::mesh::HandleRange m_points;
+  smtk::mesh::HandleRange m_cells;
+};
+
+}
+}
+}
+
+#endif
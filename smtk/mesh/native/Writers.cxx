@@ -0,0 +1,410 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+#include "smtk/mesh/native/Writers.h"
+#include "smtk/mesh/native/BinaryFormat.h"
+#include "smtk/mesh/native/Storage.h"
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Interface.h"
+#include "smtk/mesh/PointConnectivity.h"
+
+#include "moab/EntityType.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace smtk {
+namespace mesh {
+namespace native {
+
+namespace
+{
+using namespace smtk::mesh::native::binary;
+
+//the number of values fetched and converted at a time while writing
+const std::size_t ChunkSize = 65536;
+
+//----------------------------------------------------------------------------
+//maps each handle of a range to its position in the range
+class RangeIndex
+{
+public:
+  RangeIndex(const smtk::mesh::HandleRange& range)
+  {
+  std::size_t offset = 0;
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = range.const_pair_begin(); p != range.const_pair_end(); ++p)
+    {
+    this->m_starts.push_back(p->first);
+    this->m_offsets.push_back(offset);
+    offset += static_cast<std::size_t>(p->second - p->first) + 1;
+    }
+  }
+
+  //the handle must be in the range
+  std::size_t operator()(smtk::mesh::Handle handle) const
+  {
+  const std::size_t pair =
+    std::upper_bound(this->m_starts.begin(), this->m_starts.end(), handle) -
+    this->m_starts.begin() - 1;
+  return this->m_offsets[pair] + static_cast<std::size_t>(handle - this->m_starts[pair]);
+  }
+
+private:
+  std::vector< smtk::mesh::Handle > m_starts;
+  std::vector< std::size_t > m_offsets;
+};
+
+//----------------------------------------------------------------------------
+//the handles the cells and points of a collection get in the written file,
+//which are the handles a fresh native interface gives them when reading
+class HandleMap
+{
+public:
+  HandleMap(const smtk::mesh::HandleRange& points,
+            const smtk::mesh::HandleRange& cells)
+  {
+  this->m_ranges[::moab::MBVERTEX] = points;
+  for(int t = ::moab::MBEDGE; t < ::moab::MBPOLYHEDRON; ++t)
+    {
+    this->m_ranges[t] = cells.subset_by_type( static_cast< ::moab::EntityType >(t) );
+    }
+  for(int t = ::moab::MBVERTEX; t < ::moab::MBPOLYHEDRON; ++t)
+    {
+    this->m_indices.push_back( RangeIndex(this->m_ranges[t]) );
+    this->m_all.merge( this->m_ranges[t] );
+    }
+  }
+
+  const smtk::mesh::HandleRange& all() const { return this->m_all; }
+
+  //the handle must be in all()
+  smtk::mesh::Handle operator()(smtk::mesh::Handle handle) const
+  {
+  const int t = handleType(handle);
+  return makeHandle(t, 1 + this->m_indices[t](handle));
+  }
+
+  smtk::mesh::HandleRange operator()(const smtk::mesh::HandleRange& handles) const
+  {
+  //handles that are consecutive in the collection are consecutive in the
+  //file, so only the ends of each run need to be mapped
+  smtk::mesh::HandleRange known = ::moab::intersect(handles, this->m_all);
+  smtk::mesh::HandleRange result;
+  typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+  for(pit p = known.const_pair_begin(); p != known.const_pair_end(); ++p)
+    {
+    result.insert( (*this)(p->first), (*this)(p->second) );
+    }
+  return result;
+  }
+
+private:
+  smtk::mesh::HandleRange m_ranges[::moab::MBPOLYHEDRON];
+  std::vector< RangeIndex > m_indices;
+  smtk::mesh::HandleRange m_all;
+};
+
+//----------------------------------------------------------------------------
+//consecutive connectivity blocks that share a cell type and size are
+//written as one section
+struct ConnectivitySection
+{
+  smtk::mesh::CellType cellType;
+  int vertsPerCell;
+  std::size_t numberOfCells;
+  std::vector< smtk::mesh::ConnectivityBlock > blocks;
+};
+
+//----------------------------------------------------------------------------
+boost::uint64_t align(boost::uint64_t offset)
+{
+  return (offset + SectionAlignment - 1) / SectionAlignment * SectionAlignment;
+}
+
+//----------------------------------------------------------------------------
+void pad(std::ofstream& file, boost::uint64_t offset)
+{
+  static const char zeros[SectionAlignment] = { 0 };
+  const boost::uint64_t current = static_cast<boost::uint64_t>(file.tellp());
+  if(offset > current)
+    {
+    file.write(zeros, static_cast<std::streamsize>(offset - current));
+    }
+}
+
+//----------------------------------------------------------------------------
+template<typename T>
+void writeArray(std::ofstream& file, const std::vector<T>& values)
+{
+  if(!values.empty())
+    {
+    file.write(reinterpret_cast<const char*>(&values[0]),
+               static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+}
+
+//----------------------------------------------------------------------------
+template<typename TagType>
+void collectTags(const std::vector<TagType>& values,
+                 std::size_t mesh,
+                 std::vector<TagRecord>& records)
+{
+  //a single mesh has at most one value of each tag
+  if(!values.empty())
+    {
+    TagRecord record;
+    record.mesh = mesh;
+    record.value = values[0].value();
+    records.push_back(record);
+    }
+}
+
+//----------------------------------------------------------------------------
+void addAssociation(boost::uint64_t mesh,
+                    const smtk::common::UUID& uuid,
+                    std::vector<AssociationRecord>& records)
+{
+  AssociationRecord record;
+  record.mesh = mesh;
+  std::copy(uuid.begin(), uuid.end(), record.uuid);
+  records.push_back(record);
+}
+
+//----------------------------------------------------------------------------
+void addSection(std::vector<SectionHeader>& headers,
+                boost::uint32_t kind,
+                boost::uint64_t count,
+                boost::uint64_t bytes,
+                boost::uint64_t& offset,
+                int cellType = 0,
+                int vertsPerCell = 0)
+{
+  SectionHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.kind = kind;
+  header.cellType = cellType;
+  header.vertsPerCell = vertsPerCell;
+  header.offset = offset;
+  header.count = count;
+  headers.push_back(header);
+  offset = align(offset + bytes);
+}
+
+}
+
+//----------------------------------------------------------------------------
+bool write(const std::string& path, const smtk::mesh::CollectionPtr& c)
+{
+  if(!c || !c->isValid() || path.empty())
+    {
+    return false;
+    }
+  const smtk::mesh::InterfacePtr& iface = c->interface();
+
+  //gather the points and cells, leaving out polyhedra whose connectivity
+  //is made of faces instead of points
+  smtk::mesh::HandleRange cells = c->cells().range();
+  smtk::mesh::HandleRange points = c->points().range();
+  points.merge( cells.subset_by_type( ::moab::MBVERTEX ) );
+  cells = ::moab::subtract(cells, cells.subset_by_type( ::moab::MBVERTEX ));
+  cells = ::moab::subtract(cells, cells.subset_by_type( ::moab::MBPOLYHEDRON ));
+  const HandleMap handleMap(points, cells);
+
+  std::vector< ConnectivitySection > connectivity;
+  if(!cells.empty())
+    {
+    smtk::mesh::PointConnectivity pc(c, cells);
+    for(std::size_t i=0; i < pc.numberOfBlocks(); ++i)
+      {
+      smtk::mesh::ConnectivityBlock block = pc.block(i);
+      if(connectivity.empty() ||
+         connectivity.back().cellType != block.cellType ||
+         connectivity.back().vertsPerCell != block.vertsPerCell)
+        {
+        ConnectivitySection section;
+        section.cellType = block.cellType;
+        section.vertsPerCell = block.vertsPerCell;
+        section.numberOfCells = 0;
+        connectivity.push_back(section);
+        }
+      connectivity.back().numberOfCells += block.numberOfCells;
+      connectivity.back().blocks.push_back(block);
+      }
+    }
+
+  //the meshes, as runs of file handles, and their tags
+  smtk::mesh::HandleRange meshes = c->meshes().range();
+  std::vector< MeshRecord > meshRecords;
+  std::vector< smtk::mesh::Handle > meshPairs;
+  std::vector< TagRecord > domains, dirichlets, neumanns;
+  std::vector< AssociationRecord > associations;
+  std::size_t meshIndex = 0;
+  for(smtk::mesh::HandleRange::const_iterator m = meshes.begin();
+      m != meshes.end(); ++m)
+    {
+    //meshes made only of polyhedra have nothing left to write
+    const smtk::mesh::HandleRange single(*m, *m);
+    const smtk::mesh::HandleRange meshCells = handleMap( iface->getCells(single) );
+    if(meshCells.empty())
+      {
+      continue;
+      }
+
+    MeshRecord record;
+    record.firstPair = meshPairs.size() / 2;
+    record.numberOfPairs = meshCells.psize();
+    meshRecords.push_back(record);
+    typedef smtk::mesh::HandleRange::const_pair_iterator pit;
+    for(pit p = meshCells.const_pair_begin(); p != meshCells.const_pair_end(); ++p)
+      {
+      meshPairs.push_back(p->first);
+      meshPairs.push_back(p->second);
+      }
+
+    collectTags(iface->computeDomainValues(single), meshIndex, domains);
+    collectTags(iface->computeDirichletValues(single), meshIndex, dirichlets);
+    collectTags(iface->computeNeumannValues(single), meshIndex, neumanns);
+
+    smtk::common::UUIDArray models = iface->computeModelEntities(single);
+    for(std::size_t i=0; i < models.size(); ++i)
+      {
+      addAssociation(meshIndex, models[i], associations);
+      }
+    ++meshIndex;
+    }
+  if(!c->associatedModel().isNull())
+    {
+    addAssociation(CollectionIndex, c->associatedModel(), associations);
+    }
+
+  //lay out the sections
+  const std::size_t numPoints = points.size();
+  std::size_t numSections = 7 + connectivity.size();
+  boost::uint64_t offset =
+    align(sizeof(FileHeader) + numSections * sizeof(SectionHeader));
+  std::vector< SectionHeader > headers;
+  addSection(headers, Points, numPoints, 3 * numPoints * sizeof(double), offset);
+  for(std::size_t i=0; i < connectivity.size(); ++i)
+    {
+    const ConnectivitySection& section = connectivity[i];
+    addSection(headers, Connectivity, section.numberOfCells,
+               section.numberOfCells * section.vertsPerCell * sizeof(smtk::mesh::Handle),
+               offset, section.cellType, section.vertsPerCell);
+    }
+  addSection(headers, Meshes, meshRecords.size(),
+             meshRecords.size() * sizeof(MeshRecord), offset);
+  addSection(headers, MeshCells, meshPairs.size() / 2,
+             meshPairs.size() * sizeof(smtk::mesh::Handle), offset);
+  addSection(headers, Domains, domains.size(),
+             domains.size() * sizeof(TagRecord), offset);
+  addSection(headers, Dirichlets, dirichlets.size(),
+             dirichlets.size() * sizeof(TagRecord), offset);
+  addSection(headers, Neumanns, neumanns.size(),
+             neumanns.size() * sizeof(TagRecord), offset);
+  addSection(headers, Associations, associations.size(),
+             associations.size() * sizeof(AssociationRecord), offset);
+
+  std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!file)
+    {
+    return false;
+    }
+
+  FileHeader fileHeader;
+  std::memset(&fileHeader, 0, sizeof(fileHeader));
+  std::memcpy(fileHeader.magic, Magic, sizeof(Magic));
+  fileHeader.version = Version;
+  fileHeader.byteOrder = ByteOrderMark;
+  fileHeader.handleSize = sizeof(smtk::mesh::Handle);
+  fileHeader.numberOfSections = static_cast<boost::uint32_t>(headers.size());
+  file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+  writeArray(file, headers);
+
+  //points: fetch a chunk of interleaved coordinates at a time and scatter
+  //them into the x, y and z arrays of the section
+  std::size_t section = 0;
+  if(numPoints > 0)
+    {
+    const boost::uint64_t start = headers[section].offset;
+    std::vector< smtk::mesh::HandleRange > chunks =
+      smtk::mesh::split_range(points, (numPoints + ChunkSize - 1) / ChunkSize);
+    std::vector<double> xyz, axis;
+    std::size_t written = 0;
+    for(std::size_t i=0; i < chunks.size(); ++i)
+      {
+      const std::size_t n = chunks[i].size();
+      xyz.resize(3 * n);
+      axis.resize(n);
+      if(!iface->getCoordinates(chunks[i], &xyz[0]))
+        {
+        return false;
+        }
+      for(int a=0; a < 3; ++a)
+        {
+        for(std::size_t p=0; p < n; ++p)
+          {
+          axis[p] = xyz[3*p+a];
+          }
+        file.seekp(static_cast<std::streamoff>(
+          start + (a * numPoints + written) * sizeof(double)));
+        writeArray(file, axis);
+        }
+      written += n;
+      }
+    file.seekp(static_cast<std::streamoff>(start + 3 * numPoints * sizeof(double)));
+    }
+  ++section;
+
+  //connectivity, translated to file handles
+  std::vector< smtk::mesh::Handle > conn;
+  for(std::size_t i=0; i < connectivity.size(); ++i, ++section)
+    {
+    pad(file, headers[section].offset);
+    const std::vector< smtk::mesh::ConnectivityBlock >& blocks = connectivity[i].blocks;
+    for(std::size_t b=0; b < blocks.size(); ++b)
+      {
+      const std::size_t length = blocks[b].numberOfCells * blocks[b].vertsPerCell;
+      for(std::size_t first=0; first < length; first += ChunkSize)
+        {
+        const std::size_t n = std::min(ChunkSize, length - first);
+        conn.resize(n);
+        for(std::size_t p=0; p < n; ++p)
+          {
+          conn[p] = handleMap(blocks[b].connectivity[first + p]);
+          }
+        writeArray(file, conn);
+        }
+      }
+    }
+
+  pad(file, headers[section++].offset);
+  writeArray(file, meshRecords);
+  pad(file, headers[section++].offset);
+  writeArray(file, meshPairs);
+  pad(file, headers[section++].offset);
+  writeArray(file, domains);
+  pad(file, headers[section++].offset);
+  writeArray(file, dirichlets);
+  pad(file, headers[section++].offset);
+  writeArray(file, neumanns);
+  pad(file, headers[section++].offset);
+  writeArray(file, associations);
+
+  file.close();
+  return !file.fail();
+}
+
+}
+}
+}
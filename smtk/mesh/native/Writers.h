@@ -0,0 +1,36 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+
+
+#ifndef __smtk_mesh_native_Writers_h
+#define __smtk_mesh_native_Writers_h
+
+#include "smtk/PublicPointerDefs.h"
+
+#include <string>
+
+namespace smtk {
+namespace mesh {
+namespace native
+{
+
+//Write a collection of any interface type to a native binary file: the
+//points, the connectivity of every cell type, every mesh with its domain,
+//dirichlet and neumann values, and the model associations of the meshes
+//and the collection. Polyhedra are not written.
+bool write(const std::string& path, const smtk::mesh::CollectionPtr& c);
+
+}
+}
+}
+
+#endif
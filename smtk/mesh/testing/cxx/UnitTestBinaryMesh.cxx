@@ -0,0 +1,218 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/io/ImportMesh.h"
+#include "smtk/io/WriteMesh.h"
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/moab/Interface.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/mesh/testing/cxx/helpers.h"
+
+//force to use filesystem version 3
+#define BOOST_FILESYSTEM_VERSION 3
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+//gathers the type and corner coordinates of every cell, in visit order
+class GatherCells : public smtk::mesh::CellForEach
+{
+public:
+  GatherCells(): smtk::mesh::CellForEach(true) {}
+  void forCell(smtk::mesh::CellType cellType, int numPts)
+  {
+  this->types.push_back(cellType);
+  this->xyz.insert(this->xyz.end(),
+                   this->coordinates().begin(),
+                   this->coordinates().begin() + 3 * numPts);
+  }
+  std::vector<int> types;
+  std::vector<double> xyz;
+};
+
+//----------------------------------------------------------------------------
+std::string temp_file_path()
+{
+  return ( ::boost::filesystem::temp_directory_path() /
+           ::boost::filesystem::unique_path("smtk-%%%%-%%%%.smtkmesh") ).string();
+}
+
+//----------------------------------------------------------------------------
+void cleanup( const std::string& file_path )
+{
+  ::boost::filesystem::path path( file_path );
+  if( ::boost::filesystem::is_regular_file( path ) )
+    {
+    ::boost::filesystem::remove( path );
+    }
+}
+
+//----------------------------------------------------------------------------
+//fill the collection with a strip of n unit hexahedra along x, and n pairs
+//of triangles covering the bottom of the strip, in tagged meshes
+smtk::mesh::CollectionPtr create_strip(smtk::mesh::ManagerPtr mgr,
+                                       smtk::mesh::InterfacePtr iface,
+                                       std::size_t n)
+{
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(4 * (n + 1), firstPoint, coords) );
+  for(std::size_t i=0; i <= n; ++i)
+    {
+    for(int j=0; j < 4; ++j)
+      {
+      coords[0][4*i+j] = static_cast<double>(i) + 0.25 * j;
+      coords[1][4*i+j] = (j == 1 || j == 2) ? 1. : 0.;
+      coords[2][4*i+j] = (j >= 2) ? 1. : 0.;
+      }
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(n, hexes, conn) );
+  for(std::size_t i=0; i < n; ++i)
+    {
+    const smtk::mesh::Handle a = firstPoint + 4*i;
+    const smtk::mesh::Handle b = firstPoint + 4*(i+1);
+    smtk::mesh::Handle* hex = conn + 8*i;
+    hex[0] = a;   hex[1] = b;   hex[2] = b+1; hex[3] = a+1;
+    hex[4] = a+3; hex[5] = b+3; hex[6] = b+2; hex[7] = a+2;
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+
+  smtk::mesh::HandleRange tris;
+  test( alloc->allocateCells<smtk::mesh::Triangle>(2*n, tris, conn) );
+  for(std::size_t i=0; i < n; ++i)
+    {
+    const smtk::mesh::Handle a = firstPoint + 4*i;
+    const smtk::mesh::Handle b = firstPoint + 4*(i+1);
+    smtk::mesh::Handle* tri = conn + 6*i;
+    tri[0] = a; tri[1] = b;   tri[2] = b+1;
+    tri[3] = a; tri[4] = b+1; tri[5] = a+1;
+    }
+  test( alloc->connectivityModified(tris, 3, conn) );
+
+  smtk::mesh::MeshSet volume = c->createMesh( smtk::mesh::CellSet(c, hexes) );
+  smtk::mesh::MeshSet surface = c->createMesh( smtk::mesh::CellSet(c, tris) );
+  test( volume.setDomain( smtk::mesh::Domain(7) ) );
+  test( surface.setDirichlet( smtk::mesh::Dirichlet(3) ) );
+  test( surface.setNeumann( smtk::mesh::Neumann(4) ) );
+
+  c->interface()->setModelEntity( volume.range(),
+                                  smtk::common::UUID::random() );
+  c->associateModel( smtk::common::UUID::random() );
+  return c;
+}
+
+//----------------------------------------------------------------------------
+void verify_round_trip(smtk::mesh::InterfacePtr iface)
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_strip(mgr, iface, 50);
+
+  const std::string path = temp_file_path();
+  test( smtk::io::WriteMesh::entireBinary(path, c), "failed to write binary file");
+
+  smtk::mesh::CollectionPtr r = smtk::io::ImportMesh::entireBinary(path, mgr);
+  test( r->isValid(), "failed to read binary file");
+  test( r->interfaceName() == "native" );
+  test( r->readLocation() == path );
+
+  test( r->points().size() == c->points().size() );
+  test( r->cells().size() == c->cells().size() );
+  test( r->numberOfMeshes() == c->numberOfMeshes() );
+  test( r->cells( smtk::mesh::Dims3 ).size() == 50 );
+  test( r->cells( smtk::mesh::Dims2 ).size() == 100 );
+
+  //points and cells keep their order, so their coordinates match exactly
+  std::vector<double> expected(3 * c->points().size());
+  std::vector<double> actual(3 * r->points().size());
+  test( c->interface()->getCoordinates(c->points().range(), &expected[0]) );
+  test( r->interface()->getCoordinates(r->points().range(), &actual[0]) );
+  test( expected == actual, "point coordinates don't match");
+
+  GatherCells before, after;
+  smtk::mesh::for_each(c->cells(), before);
+  smtk::mesh::for_each(r->cells(), after);
+  test( before.types == after.types, "cell types don't match");
+  test( before.xyz == after.xyz, "cell coordinates don't match");
+
+  //tags and associations
+  test( r->meshes( smtk::mesh::Domain(7) ).cells().size() == 50 );
+  test( r->meshes( smtk::mesh::Dirichlet(3) ).cells().size() == 100 );
+  test( r->neumanns().size() == 1 && r->neumanns()[0].value() == 4 );
+  test( r->associatedModel() == c->associatedModel() );
+  test( r->meshes( smtk::mesh::Domain(7) ).modelEntityIds() ==
+        c->meshes( smtk::mesh::Domain(7) ).modelEntityIds() );
+
+  //the points and connectivity live in the mapped file, not the interface
+  smtk::mesh::native::InterfacePtr native =
+    smtk::dynamic_pointer_cast< smtk::mesh::native::Interface >(r->interface());
+  test( !!native );
+  test( native->memoryUsed() == 0, "binary read shouldn't copy the mesh");
+
+  //the collection stays usable after the file is gone
+  mgr->removeCollection(c);
+  cleanup(path);
+  test( r->meshes( smtk::mesh::Dims3 ).points().size() == 204 );
+}
+
+//----------------------------------------------------------------------------
+void verify_bad_files()
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+
+  const std::string path = temp_file_path();
+  test( !smtk::io::ImportMesh::entireBinary(path, mgr)->isValid(),
+        "a missing file shouldn't load");
+
+  {
+  std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+  out << "this isn't a mesh file, just some text that is long enough";
+  }
+  test( !smtk::io::ImportMesh::entireBinary(path, mgr)->isValid(),
+        "a file of the wrong type shouldn't load");
+
+  //a truncated file
+  smtk::mesh::CollectionPtr c =
+    create_strip(mgr, smtk::mesh::native::make_interface(), 10);
+  test( smtk::io::WriteMesh::entireBinary(path, c) );
+  const std::size_t size =
+    static_cast<std::size_t>(::boost::filesystem::file_size(path));
+  ::boost::filesystem::resize_file(path, size / 2);
+  test( !smtk::io::ImportMesh::entireBinary(path, mgr)->isValid(),
+        "a truncated file shouldn't load");
+
+  test( mgr->numberOfCollections() == 1,
+        "failed loads shouldn't add collections to the manager");
+  cleanup(path);
+}
+
+}
+
+//----------------------------------------------------------------------------
+int UnitTestBinaryMesh(int, char**)
+{
+  verify_round_trip( smtk::mesh::native::make_interface() );
+  verify_round_trip( smtk::mesh::moab::make_interface() );
+  verify_bad_files();
+
+  return 0;
+}
@@ -0,0 +1,179 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/moab/Interface.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/mesh/testing/cxx/helpers.h"
+
+#include <cmath>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+//sums the volume of axis aligned hexahedra and the area of triangles in
+//the z=0 plane, a block at a time
+class MeasureCells : public smtk::mesh::CellBlockForEach
+{
+public:
+  MeasureCells(): numBlocks(0), numCells(0), volume(0.), area(0.) {}
+
+  void forBlock(const smtk::mesh::ConnectivityBlock& block)
+  {
+  ++this->numBlocks;
+  this->numCells += block.numberOfCells;
+
+  std::vector<double> xyz;
+  test( this->coordinates(block, xyz), "failed to fetch block coordinates");
+
+  const int n = block.vertsPerCell;
+  if(block.cellType == smtk::mesh::Hexahedron)
+    {
+    for(std::size_t c=0; c < block.numberOfCells; ++c)
+      {
+      //opposite corners 0 and 6
+      const double* p0 = &xyz[3*n*c];
+      const double* p6 = p0 + 3*6;
+      this->volume += (p6[0] - p0[0]) * (p6[1] - p0[1]) * (p6[2] - p0[2]);
+      }
+    }
+  else if(block.cellType == smtk::mesh::Triangle)
+    {
+    for(std::size_t c=0; c < block.numberOfCells; ++c)
+      {
+      const double* p = &xyz[3*n*c];
+      this->area += 0.5 * std::fabs( (p[3] - p[0]) * (p[7] - p[1]) -
+                                     (p[6] - p[0]) * (p[4] - p[1]) );
+      }
+    }
+  }
+
+  std::size_t numBlocks;
+  std::size_t numCells;
+  double volume;
+  double area;
+};
+
+//----------------------------------------------------------------------------
+//fill the collection with a strip of n unit hexahedra along x, and n pairs
+//of triangles covering the bottom of the strip
+smtk::mesh::CollectionPtr create_strip(smtk::mesh::ManagerPtr mgr,
+                                       smtk::mesh::InterfacePtr iface,
+                                       std::size_t n)
+{
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(4 * (n + 1), firstPoint, coords) );
+  for(std::size_t i=0; i <= n; ++i)
+    {
+    for(int j=0; j < 4; ++j)
+      {
+      coords[0][4*i+j] = static_cast<double>(i);
+      coords[1][4*i+j] = (j == 1 || j == 2) ? 1. : 0.;
+      coords[2][4*i+j] = (j >= 2) ? 1. : 0.;
+      }
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(n, hexes, conn) );
+  for(std::size_t i=0; i < n; ++i)
+    {
+    //bottom face is points 0 and 1 of both ends, top face is 3 and 2
+    const smtk::mesh::Handle a = firstPoint + 4*i;
+    const smtk::mesh::Handle b = firstPoint + 4*(i+1);
+    smtk::mesh::Handle* hex = conn + 8*i;
+    hex[0] = a;   hex[1] = b;   hex[2] = b+1; hex[3] = a+1;
+    hex[4] = a+3; hex[5] = b+3; hex[6] = b+2; hex[7] = a+2;
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+
+  smtk::mesh::HandleRange tris;
+  test( alloc->allocateCells<smtk::mesh::Triangle>(2*n, tris, conn) );
+  for(std::size_t i=0; i < n; ++i)
+    {
+    const smtk::mesh::Handle a = firstPoint + 4*i;
+    const smtk::mesh::Handle b = firstPoint + 4*(i+1);
+    smtk::mesh::Handle* tri = conn + 6*i;
+    tri[0] = a; tri[1] = b;   tri[2] = b+1;
+    tri[3] = a; tri[4] = b+1; tri[5] = a+1;
+    }
+  test( alloc->connectivityModified(tris, 3, conn) );
+
+  c->createMesh( smtk::mesh::CellSet(c, hexes) );
+  c->createMesh( smtk::mesh::CellSet(c, tris) );
+  return c;
+}
+
+//----------------------------------------------------------------------------
+void verify_blocks_match_cells(const smtk::mesh::CellSet& cells)
+{
+  smtk::mesh::PointConnectivity pc = cells.pointConnectivity();
+  test( pc.numberOfBlocks() > 0 );
+
+  //walking the blocks must give the same cells as fetchNextCell
+  pc.initCellTraversal();
+  std::size_t total = 0;
+  for(std::size_t b=0; b < pc.numberOfBlocks(); ++b)
+    {
+    smtk::mesh::ConnectivityBlock block = pc.block(b);
+    for(std::size_t i=0; i < block.numberOfCells; ++i, ++total)
+      {
+      smtk::mesh::CellType cellType;
+      int numPts;
+      const smtk::mesh::Handle* points;
+      test( pc.fetchNextCell(cellType, numPts, points) );
+      test( cellType == block.cellType, "block and cell types should match");
+      test( numPts == block.vertsPerCell );
+      test( points == block.connectivity + i * block.vertsPerCell,
+            "blocks should point at the same memory as the cells");
+      }
+    }
+  test( total == pc.numberOfCells() );
+}
+
+//----------------------------------------------------------------------------
+void verify_block_visitor(smtk::mesh::InterfacePtr iface)
+{
+  const std::size_t n = 1000;
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_strip(mgr, iface, n);
+
+  MeasureCells measure;
+  smtk::mesh::for_each( c->cells(), measure );
+  test( measure.numBlocks >= 2, "hexahedra and triangles need separate blocks");
+  test( measure.numCells == 3 * n );
+  test( measure.volume == static_cast<double>(n) );
+  test( measure.area == static_cast<double>(n) );
+
+  verify_blocks_match_cells(c->cells());
+
+  //points are blocks of vertex cells
+  smtk::mesh::CellSet points(c, c->points().range());
+  verify_blocks_match_cells(points);
+  smtk::mesh::ConnectivityBlock block = points.pointConnectivity().block(0);
+  test( block.cellType == smtk::mesh::Vertex && block.vertsPerCell == 1 );
+}
+
+}
+
+//----------------------------------------------------------------------------
+int UnitTestCellBlockForEach(int, char**)
+{
+  verify_block_visitor( smtk::mesh::moab::make_interface() );
+  verify_block_visitor( smtk::mesh::native::make_interface() );
+  return 0;
+}
@@ -0,0 +1,269 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Adjacencies.h"
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/moab/Interface.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/mesh/testing/cxx/helpers.h"
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+//two unit hexahedra sharing the face at x=1, each in its own mesh
+smtk::mesh::CollectionPtr create_two_hexes(smtk::mesh::ManagerPtr mgr,
+                                           smtk::mesh::InterfacePtr iface)
+{
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(12, firstPoint, coords) );
+  for(int k=0; k < 2; ++k)
+    {
+    for(int j=0; j < 2; ++j)
+      {
+      for(int i=0; i < 3; ++i)
+        {
+        const int p = i + 3 * (j + 2 * k);
+        coords[0][p] = i;
+        coords[1][p] = j;
+        coords[2][p] = k;
+        }
+      }
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(2, hexes, conn) );
+  for(int h=0; h < 2; ++h)
+    {
+    const smtk::mesh::Handle p = firstPoint + h;
+    smtk::mesh::Handle* hex = conn + 8 * h;
+    hex[0] = p;     hex[1] = p+1;     hex[2] = p+4;     hex[3] = p+3;
+    hex[4] = p+6;   hex[5] = p+7;     hex[6] = p+10;    hex[7] = p+9;
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+
+  c->createMesh( smtk::mesh::CellSet(c, smtk::mesh::HandleRange(hexes.front(), hexes.front())) );
+  c->createMesh( smtk::mesh::CellSet(c, smtk::mesh::HandleRange(hexes.back(), hexes.back())) );
+  return c;
+}
+
+//----------------------------------------------------------------------------
+void verify_connectivity(smtk::mesh::InterfacePtr iface)
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_two_hexes(mgr, iface);
+  smtk::mesh::MeshSet all = c->meshes();
+  smtk::mesh::MeshSet first = all.subset(0);
+
+  //nothing of a lower dimension exists yet
+  test( all.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims2).is_empty() );
+  test( all.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims0).is_empty() );
+
+  //the hexahedra are neighbors across the shared face
+  smtk::mesh::CellSet hexes = c->cells(smtk::mesh::Dims3);
+  test( all.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims3) == hexes );
+  smtk::mesh::CellSet neighbor = first.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims3);
+  test( neighbor.size() == 1 && neighbor == all.subset(1).cells() );
+
+  //creating the faces makes one for the shared face, and a mesh of them
+  smtk::mesh::MeshSet faceMesh = all.createConnectivity(smtk::mesh::Dims3, smtk::mesh::Dims2);
+  test( faceMesh.size() == 1 );
+  smtk::mesh::CellSet faces = faceMesh.cells();
+  test( faces.size() == 11, "expected a face per distinct side");
+  test( c->cells(smtk::mesh::Quad) == faces );
+  test( all.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims2) == faces );
+  test( first.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims2).size() == 6 );
+
+  //creating them again reuses the faces
+  smtk::mesh::MeshSet again = all.createConnectivity(smtk::mesh::Dims3, smtk::mesh::Dims2);
+  test( again.cells() == faces );
+  test( c->cells(smtk::mesh::Dims2).size() == 11 );
+  test( c->removeMeshes(again) );
+  test( c->cells(smtk::mesh::Dims2) == faces, "faces of another mesh should remain");
+
+  //edges, which the faces share
+  smtk::mesh::MeshSet edgeMesh = all.createConnectivity(smtk::mesh::Dims3, smtk::mesh::Dims1);
+  smtk::mesh::CellSet edges = edgeMesh.cells();
+  test( edges.size() == 20 );
+  test( faceMesh.connectivity(smtk::mesh::Dims2, smtk::mesh::Dims1) == edges );
+  test( faceMesh.connectivity(smtk::mesh::Dims1, smtk::mesh::Dims2).is_empty(),
+        "the face mesh has no edges to go up from");
+
+  //going up finds the cells that use them
+  test( faceMesh.connectivity(smtk::mesh::Dims2, smtk::mesh::Dims3) == hexes );
+  test( edgeMesh.connectivity(smtk::mesh::Dims1, smtk::mesh::Dims3) == hexes );
+  test( edgeMesh.connectivity(smtk::mesh::Dims1, smtk::mesh::Dims2) == faces );
+
+  //quads share edges with the four around them, lines share points
+  test( faceMesh.connectivity(smtk::mesh::Dims2, smtk::mesh::Dims2) == faces );
+  test( edgeMesh.connectivity(smtk::mesh::Dims1, smtk::mesh::Dims1) == edges );
+
+  //there are no vertex cells, and none are made
+  test( all.createConnectivity(smtk::mesh::Dims3, smtk::mesh::Dims0).is_empty() );
+
+  //the shell reuses the faces that were created
+  smtk::mesh::MeshSet shell = c->meshes(smtk::mesh::Dims3).extractShell();
+  test( shell.cells(smtk::mesh::Quad).size() == 10 );
+  test( c->cells(smtk::mesh::Quad).size() == 11 );
+}
+
+
+//----------------------------------------------------------------------------
+//compare every query of tables that were extended with tables built from
+//scratch for the same cells
+void compare_adjacencies(const smtk::mesh::Adjacencies& extended,
+                         const smtk::mesh::Adjacencies& fresh)
+{
+  test( extended.cells() == fresh.cells() );
+  const smtk::mesh::HandleRange& cells = fresh.cells();
+  for(int from=0; from < 4; ++from)
+    {
+    for(int to=0; to < 4; ++to)
+      {
+      const smtk::mesh::DimensionType f = static_cast<smtk::mesh::DimensionType>(from);
+      const smtk::mesh::DimensionType t = static_cast<smtk::mesh::DimensionType>(to);
+      test( extended.adjacent(cells, f, t) == fresh.adjacent(cells, f, t),
+            "extended adjacencies differ from rebuilt ones");
+      for(int boundary=0; boundary < 2; ++boundary)
+        {
+        smtk::mesh::HandleRange e1, e2;
+        std::vector< std::vector< smtk::mesh::Handle > > m1, m2;
+        extended.subEntities(cells, f, t, boundary != 0, e1, m1);
+        fresh.subEntities(cells, f, t, boundary != 0, e2, m2);
+        test( e1 == e2 && m1 == m2, "extended sub-entities differ from rebuilt ones");
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void verify_added_cells(smtk::mesh::InterfacePtr iface)
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_two_hexes(mgr, iface);
+  smtk::mesh::MeshSet all = c->meshes();
+
+  //build the face tables, then add the quads of the shell, which are
+  //indexed in place and reused when the shell is extracted again
+  test( all.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims3).size() == 2 );
+  smtk::mesh::MeshSet shell = all.extractShell();
+  test( shell.cells(smtk::mesh::Quad).size() == 10 );
+  {
+  smtk::mesh::Adjacencies fresh(c->cells());
+  compare_adjacencies(c->adjacencies(), fresh);
+  }
+  smtk::mesh::MeshSet again = c->meshes(smtk::mesh::Dims3).extractShell();
+  test( again.cells() == shell.cells() );
+  test( c->cells(smtk::mesh::Quad).size() == 10 );
+
+  //edges are added to both the edge and face tables
+  smtk::mesh::MeshSet edgeMesh =
+    c->meshes(smtk::mesh::Dims3).createConnectivity(smtk::mesh::Dims3, smtk::mesh::Dims1);
+  test( edgeMesh.cells().size() == 20 );
+  {
+  smtk::mesh::Adjacencies fresh(c->cells());
+  compare_adjacencies(c->adjacencies(), fresh);
+  }
+
+  //cells that use new points rebuild the tables
+  test( c->cells(smtk::mesh::Triangle).is_empty() );
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+  std::vector<double*> coords;
+  smtk::mesh::Handle point;
+  test( alloc->allocatePoints(1, point, coords) );
+  coords[0][0] = 3.; coords[1][0] = 0.; coords[2][0] = 0.;
+  smtk::mesh::HandleRange triangles;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Triangle>(1, triangles, conn) );
+  conn[0] = c->points().range().front() + 2;
+  conn[1] = point;
+  conn[2] = c->points().range().front() + 5;
+  test( alloc->connectivityModified(triangles, 3, conn) );
+  c->createMesh( smtk::mesh::CellSet(c, triangles) );
+  {
+  smtk::mesh::Adjacencies fresh(c->cells());
+  compare_adjacencies(c->adjacencies(), fresh);
+  }
+  test( c->adjacencies().cells() == c->cells().range() );
+}
+
+
+//----------------------------------------------------------------------------
+void verify_rewritten_connectivity(smtk::mesh::InterfacePtr iface)
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  //the points of the two hexahedra, and four more at x=1.5 to move the
+  //second one onto
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(16, firstPoint, coords) );
+  for(int p=0; p < 12; ++p)
+    {
+    coords[0][p] = p % 3;
+    coords[1][p] = (p / 3) % 2;
+    coords[2][p] = p / 6;
+    }
+  for(int p=12; p < 16; ++p)
+    {
+    coords[0][p] = 1.5;
+    coords[1][p] = (p - 12) % 2;
+    coords[2][p] = (p - 12) / 2;
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(2, hexes, conn) );
+  for(int h=0; h < 2; ++h)
+    {
+    const smtk::mesh::Handle p = firstPoint + h;
+    smtk::mesh::Handle* hex = conn + 8 * h;
+    hex[0] = p;     hex[1] = p+1;     hex[2] = p+4;     hex[3] = p+3;
+    hex[4] = p+6;   hex[5] = p+7;     hex[6] = p+10;    hex[7] = p+9;
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+  smtk::mesh::MeshSet all = c->createMesh( smtk::mesh::CellSet(c, hexes) );
+  test( all.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims3).size() == 2 );
+
+  //detach the second hexahedron from the shared face in place; the
+  //cells are unchanged, so only the allocator knows the tables are stale
+  smtk::mesh::Handle* second = conn + 8;
+  second[0] = firstPoint + 12;   second[3] = firstPoint + 13;
+  second[4] = firstPoint + 14;   second[7] = firstPoint + 15;
+  test( alloc->connectivityModified(hexes, 8, conn) );
+  test( all.connectivity(smtk::mesh::Dims3, smtk::mesh::Dims3).is_empty(),
+        "adjacencies were not rebuilt after the connectivity was rewritten" );
+  smtk::mesh::Adjacencies fresh(c->cells());
+  compare_adjacencies(c->adjacencies(), fresh);
+}
+
+}
+
+//----------------------------------------------------------------------------
+int UnitTestConnectivity(int, char**)
+{
+  verify_connectivity( smtk::mesh::native::make_interface() );
+  verify_connectivity( smtk::mesh::moab::make_interface() );
+  verify_added_cells( smtk::mesh::native::make_interface() );
+  verify_added_cells( smtk::mesh::moab::make_interface() );
+  verify_rewritten_connectivity( smtk::mesh::native::make_interface() );
+  verify_rewritten_connectivity( smtk::mesh::moab::make_interface() );
+
+  return 0;
+}
@@ -294,6 +294,31 @@ void verify_vertex_conversion()
   test( points.size() == 7, "After merging of identical points we should have 7");
 }
 
+//----------------------------------------------------------------------------
+void verify_welded_conversion()
+{
+  smtk::mesh::ManagerPtr meshManager = smtk::mesh::Manager::create();
+  smtk::model::ManagerPtr modelManager = smtk::model::Manager::create();
+
+  create_simple_model(modelManager);
+
+  smtk::io::ModelToMesh convert;
+  test( convert.weldTolerance() < 0, "welding should be off by default");
+  convert.setWeldTolerance(0);
+  smtk::mesh::CollectionPtr c = convert(meshManager,modelManager);
+  test( c->isValid(), "collection should be valid");
+  test( c->numberOfMeshes() == numTetsInModel, "collection should have a mesh per tet");
+
+  //identical points are welded while converting
+  test( c->points().size() == 7, "Welding identical points should leave 7");
+  test( c->cells(smtk::mesh::Dims2).size() == numTetsInModel * 10 );
+  test( c->meshes().points().size() == 7 );
+
+  //and there is nothing left to merge
+  c->meshes().mergeCoincidentContactPoints();
+  test( c->points().size() == 7 );
+}
+
 //----------------------------------------------------------------------------
 void verify_cell_have_points()
 {
@@ -330,6 +355,7 @@ int UnitTestModelToMesh(int, char**)
   verify_empty_model();
   verify_cell_conversion();
   verify_vertex_conversion();
+  verify_welded_conversion();
   verify_cell_have_points();
 
   return 0;
@@ -0,0 +1,283 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/mesh/testing/cxx/helpers.h"
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+class SumPoints : public smtk::mesh::PointForEach
+{
+public:
+  SumPoints(): count(0), sum(0.) {}
+  void forPoint(const smtk::mesh::Handle&, double x, double y, double z)
+  {
+  ++this->count;
+  this->sum += x + y + z;
+  }
+  std::size_t count;
+  double sum;
+};
+
+//----------------------------------------------------------------------------
+class CountCells : public smtk::mesh::CellForEach
+{
+public:
+  CountCells(): smtk::mesh::CellForEach(true), numCells(0), sumZ(0.) {}
+  void forCell(smtk::mesh::CellType cellType, int numPts)
+  {
+  test( cellType == smtk::mesh::Hexahedron, "only expected hexahedra");
+  ++this->numCells;
+  for(int i=0; i < numPts; ++i)
+    {
+    this->pointsSeen.insert( this->pointId(i) );
+    this->sumZ += this->coordinates()[3*i+2];
+    }
+  }
+  std::size_t numCells;
+  double sumZ;
+  smtk::mesh::HandleRange pointsSeen;
+};
+
+//----------------------------------------------------------------------------
+//create two unit hexahedra side by side along x, each with its own 8
+//points, so the 4 points on the shared face are duplicated
+smtk::mesh::CollectionPtr create_two_hexes(smtk::mesh::ManagerPtr mgr)
+{
+  smtk::mesh::CollectionPtr c =
+    mgr->makeCollection(smtk::mesh::native::make_interface());
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(16, firstPoint, coords), "failed to allocate points");
+  test( coords.size() == 3, "expected separate x, y and z arrays");
+
+  const double corner[8][3] = { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0},
+                                {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1} };
+  for(int h=0; h < 2; ++h)
+    {
+    for(int i=0; i < 8; ++i)
+      {
+      coords[0][8*h+i] = corner[i][0] + h;
+      coords[1][8*h+i] = corner[i][1];
+      coords[2][8*h+i] = corner[i][2];
+      }
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(2, hexes, conn),
+        "failed to allocate hexahedra");
+  test( hexes.size() == 2 );
+  for(int i=0; i < 16; ++i)
+    {
+    conn[i] = firstPoint + i;
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+
+  smtk::mesh::MeshSet ms = c->createMesh( smtk::mesh::CellSet(c, hexes) );
+  test( !ms.is_empty(), "failed to create a mesh");
+  return c;
+}
+
+//----------------------------------------------------------------------------
+void verify_allocation()
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_two_hexes(mgr);
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  test( c->interfaceName() == "native" );
+  test( c->numberOfMeshes() == 1 );
+  test( c->cells().size() == 2 );
+  test( c->cells( smtk::mesh::Dims3 ).size() == 2 );
+  test( c->cells( smtk::mesh::Dims2 ).size() == 0 );
+  test( c->points().size() == 16 );
+  test( c->meshes( smtk::mesh::Dims3 ).size() == 1 );
+  test( c->meshes( smtk::mesh::Dims2 ).size() == 0 );
+
+  smtk::mesh::CellTypes types = c->types().cellTypes();
+  test( types.count() == 1 && types[smtk::mesh::Hexahedron],
+        "expected only hexahedra");
+
+  //vertices are their own cells
+  smtk::mesh::HandleRange verts;
+  smtk::mesh::Handle* conn;
+  test( !alloc->allocateCells(smtk::mesh::Vertex, 1, 1, verts, conn),
+        "vertex cells should be created as points");
+
+  //a mesh can't be made of cells that don't exist
+  smtk::mesh::Handle meshHandle;
+  smtk::mesh::HandleRange bogus;
+  bogus.insert( c->cells().range().back() + 10 );
+  test( !c->interface()->createMesh(bogus, meshHandle) );
+}
+
+//----------------------------------------------------------------------------
+void verify_coordinates_and_iteration()
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_two_hexes(mgr);
+  smtk::mesh::InterfacePtr iface = c->interface();
+
+  smtk::mesh::HandleRange points = c->points().range();
+  std::vector<double> xyz(3 * points.size());
+  std::vector<float> fxyz(3 * points.size());
+  test( iface->getCoordinates(points, &xyz[0]) );
+  test( iface->getCoordinates(points, &fxyz[0]) );
+  test( xyz[3*9] == 2. && xyz[3*9+1] == 0. && xyz[3*9+2] == 0.,
+        "second point of the second hexahedron should be at (2,0,0)");
+  for(std::size_t i=0; i < xyz.size(); ++i)
+    {
+    test( static_cast<float>(xyz[i]) == fxyz[i] );
+    }
+
+  SumPoints sum;
+  smtk::mesh::for_each( c->points(), sum );
+  test( sum.count == 16 );
+  test( sum.sum == 32., "unexpected sum of point coordinates");
+
+  CountCells counter;
+  smtk::mesh::for_each( c->cells(), counter );
+  test( counter.numCells == 2 );
+  test( counter.pointsSeen == points );
+  test( counter.sumZ == 8. );
+}
+
+//----------------------------------------------------------------------------
+void verify_merge_and_shell()
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_two_hexes(mgr);
+
+  //unmerged, each hexahedron is its own shell
+  smtk::mesh::MeshSet shell = c->meshes().extractShell();
+  test( shell.size() == 1 );
+  test( shell.cells( smtk::mesh::Quad ).size() == 12 );
+  test( c->removeMeshes(shell) );
+  test( c->numberOfMeshes() == 1 );
+
+  c->meshes().mergeCoincidentContactPoints();
+  test( c->points().size() == 12, "expected the shared face to be merged");
+
+  CountCells counter;
+  smtk::mesh::for_each( c->cells( smtk::mesh::Dims3 ), counter );
+  test( counter.pointsSeen.size() == 12,
+        "cells should refer only to the remaining points");
+
+  //the shared face is interior once the points are merged
+  smtk::mesh::MeshSet mergedShell = c->meshes( smtk::mesh::Dims3 ).extractShell();
+  test( mergedShell.cells( smtk::mesh::Quad ).size() == 10 );
+  test( mergedShell.points().size() == 12 );
+
+  //extracting the shell again reuses the quads that already exist
+  smtk::mesh::MeshSet secondShell = c->meshes( smtk::mesh::Dims3 ).extractShell();
+  test( secondShell.cells() == mergedShell.cells() );
+  test( c->cells( smtk::mesh::Quad ).size() == 10 );
+}
+
+//----------------------------------------------------------------------------
+void verify_tags_and_associations()
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_two_hexes(mgr);
+  smtk::mesh::MeshSet all = c->meshes();
+
+  test( all.setDomain( smtk::mesh::Domain(7) ) );
+  test( all.setDirichlet( smtk::mesh::Dirichlet(3) ) );
+  test( c->domains().size() == 1 && c->domains()[0] == smtk::mesh::Domain(7) );
+  test( c->meshes( smtk::mesh::Domain(7) ).size() == 1 );
+  test( c->meshes( smtk::mesh::Domain(8) ).size() == 0 );
+  test( c->meshes( smtk::mesh::Dirichlet(3) ).size() == 1 );
+  test( c->meshes( smtk::mesh::Neumann(3) ).size() == 0 );
+
+  smtk::common::UUID uid = smtk::common::UUID::random();
+  smtk::mesh::InterfacePtr iface = c->interface();
+  test( iface->addAssociation(uid, all.range()) );
+  test( iface->findAssociations(iface->getRoot(), uid) == all.range() );
+  test( iface->findAssociations(iface->getRoot(), smtk::common::UUID::random()).empty() );
+  test( all.modelEntityIds().size() == 1 && all.modelEntityIds()[0] == uid );
+
+  //mixed deletes fail, cell deletes remove cells from their meshes
+  smtk::mesh::HandleRange mixed = all.range();
+  mixed.insert( c->cells().range().front() );
+  test( !iface->deleteHandles(mixed) );
+
+  smtk::mesh::HandleRange first;
+  first.insert( c->cells().range().front() );
+  test( iface->deleteHandles(first) );
+  test( c->cells().size() == 1 );
+  test( all.cells().size() == 1 );
+}
+
+
+//----------------------------------------------------------------------------
+void verify_erase_and_reallocate()
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = create_two_hexes(mgr);
+  smtk::mesh::native::InterfacePtr native =
+    smtk::dynamic_pointer_cast< smtk::mesh::native::Interface >(c->interface());
+  test( !!native );
+  const std::size_t used = native->memoryUsed();
+  test( used > 0 );
+
+  //a block keeps its memory while any of its entities are live
+  smtk::mesh::HandleRange cells = c->cells().range();
+  smtk::mesh::HandleRange points = c->points().range();
+  smtk::mesh::HandleRange first;
+  first.insert( cells.front() );
+  test( native->deleteHandles(first) );
+  test( native->memoryUsed() == used );
+
+  //once all of them are erased the memory is released
+  test( native->deleteHandles( c->cells().range() ) );
+  test( native->deleteHandles(points) );
+  test( native->memoryUsed() == 0, "erased blocks should release their memory");
+  std::vector<double> xyz(3 * points.size());
+  test( !native->getCoordinates(points, &xyz[0]),
+        "erased points should no longer have coordinates");
+
+  //reallocating gives new handles and reuses no stale memory
+  smtk::mesh::AllocatorPtr alloc = native->allocator();
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(16, firstPoint, coords) );
+  test( points.find(firstPoint) == points.end(), "handles should never be reused");
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(2, hexes, conn) );
+  test( ::moab::intersect(hexes, cells).empty(), "handles should never be reused");
+  test( native->memoryUsed() == used );
+  coords[2][15] = 5.;
+  smtk::mesh::HandleRange newPoints;
+  newPoints.insert(firstPoint, firstPoint + 15);
+  test( native->getCoordinates(newPoints, &xyz[0]) );
+  test( xyz[3*15+2] == 5., "reallocated points should be readable");
+}
+
+}
+
+//----------------------------------------------------------------------------
+int UnitTestNativeInterface(int, char**)
+{
+  verify_allocation();
+  verify_coordinates_and_iteration();
+  verify_merge_and_shell();
+  verify_tags_and_associations();
+  verify_erase_and_reallocate();
+  return 0;
+}
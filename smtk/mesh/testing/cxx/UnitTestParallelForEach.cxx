@@ -0,0 +1,256 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/moab/Interface.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/common/Parallel.h"
+
+#include "smtk/mesh/testing/cxx/helpers.h"
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+class CellStatistics : public smtk::mesh::CellForEach
+{
+public:
+  CellStatistics(): smtk::mesh::CellForEach(true),
+    numCells(0), numPieces(1), sumX(0.), maxPointId(0) {}
+
+  void forCell(smtk::mesh::CellType, int numPts)
+  {
+  ++this->numCells;
+  for(int i=0; i < numPts; ++i)
+    {
+    this->sumX += this->coordinates()[3*i];
+    this->maxPointId = std::max(this->maxPointId, this->pointId(i));
+    }
+  }
+
+  CellForEach* clone() const { return new CellStatistics; }
+
+  void reduce(const smtk::mesh::CellForEach& piece)
+  {
+  const CellStatistics& other = static_cast<const CellStatistics&>(piece);
+  this->numCells += other.numCells;
+  this->sumX += other.sumX;
+  this->maxPointId = std::max(this->maxPointId, other.maxPointId);
+  ++this->numPieces;
+  }
+
+  std::size_t numCells;
+  std::size_t numPieces;
+  double sumX;
+  smtk::mesh::Handle maxPointId;
+};
+
+//----------------------------------------------------------------------------
+class PointStatistics : public smtk::mesh::PointForEach
+{
+public:
+  PointStatistics(): numPoints(0), sumZ(0.) {}
+
+  void forPoint(const smtk::mesh::Handle& pointId, double, double, double z)
+  {
+  test( this->visited.empty() || this->visited.back() < pointId,
+        "points within a piece should be visited in order");
+  this->visited.insert(pointId);
+  ++this->numPoints;
+  this->sumZ += z;
+  }
+
+  PointForEach* clone() const { return new PointStatistics; }
+
+  void reduce(const smtk::mesh::PointForEach& piece)
+  {
+  const PointStatistics& other = static_cast<const PointStatistics&>(piece);
+  test( this->visited.empty() || other.visited.empty() ||
+        this->visited.back() < other.visited.front(),
+        "pieces should be reduced in order");
+  this->visited.merge(other.visited);
+  this->numPoints += other.numPoints;
+  this->sumZ += other.sumZ;
+  }
+
+  std::size_t numPoints;
+  double sumZ;
+  smtk::mesh::HandleRange visited;
+};
+
+//----------------------------------------------------------------------------
+//records the order its pieces run in, which is only safe when they run serially
+class RecordPieces : public smtk::common::ParallelTask
+{
+public:
+  void execute(std::size_t piece)
+  {
+  this->order.push_back(piece);
+  }
+
+  std::vector<std::size_t> order;
+};
+
+//----------------------------------------------------------------------------
+//each piece runs a nested forEach and sort of its own
+class NestedPieces : public smtk::common::ParallelTask
+{
+public:
+  NestedPieces(std::size_t numPieces):
+    inner(numPieces), sorted(numPieces, true), threads(numPieces, 0) {}
+
+  void execute(std::size_t piece)
+  {
+  this->threads[piece] = smtk::common::Parallel::numberOfThreads();
+  smtk::common::Parallel::forEach(1000, this->inner[piece]);
+
+  std::vector<int> values(10000);
+  for(std::size_t i=0; i < values.size(); ++i)
+    {
+    values[i] = static_cast<int>((i * 7919) % values.size());
+    }
+  smtk::common::Parallel::sort(values);
+  for(std::size_t i=0; i < values.size(); ++i)
+    {
+    this->sorted[piece] = this->sorted[piece] && values[i] == static_cast<int>(i);
+    }
+  }
+
+  std::vector<RecordPieces> inner;
+  std::vector<bool> sorted;
+  std::vector<std::size_t> threads;
+};
+
+//----------------------------------------------------------------------------
+void verify_nested_calls()
+{
+  const std::size_t numPieces = 8;
+  NestedPieces nested(numPieces);
+  smtk::common::Parallel::forEach(numPieces, nested);
+  for(std::size_t piece=0; piece < numPieces; ++piece)
+    {
+    test( nested.threads[piece] == 1, "nested calls should use one thread");
+    const std::vector<std::size_t>& order = nested.inner[piece].order;
+    test( order.size() == 1000, "every nested piece should run");
+    for(std::size_t i=0; i < order.size(); ++i)
+      {
+      test( order[i] == i, "nested pieces should run serially in order");
+      }
+    test( nested.sorted[piece], "nested sort failed");
+    }
+  test( smtk::common::Parallel::numberOfThreads() == 4,
+        "the caller should still use every thread");
+}
+
+//----------------------------------------------------------------------------
+//fill the collection with a strip of n unit hexahedra along x
+void create_hex_strip(smtk::mesh::CollectionPtr c, std::size_t n)
+{
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(4 * (n + 1), firstPoint, coords) );
+  for(std::size_t i=0; i <= n; ++i)
+    {
+    for(int j=0; j < 4; ++j)
+      {
+      coords[0][4*i+j] = static_cast<double>(i);
+      coords[1][4*i+j] = (j == 1 || j == 2) ? 1. : 0.;
+      coords[2][4*i+j] = (j >= 2) ? 1. : 0.;
+      }
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(n, hexes, conn) );
+  for(std::size_t i=0; i < n; ++i)
+    {
+    for(int j=0; j < 4; ++j)
+      {
+      conn[8*i+j] = firstPoint + 4*i + j;
+      conn[8*i+4+j] = firstPoint + 4*(i+1) + j;
+      }
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+  c->createMesh( smtk::mesh::CellSet(c, hexes) );
+}
+
+//----------------------------------------------------------------------------
+void verify_split_range()
+{
+  smtk::mesh::HandleRange range;
+  range.insert(10, 19);
+  range.insert(30, 34);
+
+  std::vector< smtk::mesh::HandleRange > pieces = smtk::mesh::split_range(range, 4);
+  test( pieces.size() == 4, "15 handles should split into 4 pieces");
+  smtk::mesh::HandleRange joined;
+  for(std::size_t i=0; i < pieces.size(); ++i)
+    {
+    test( pieces[i].size() == (i < 3 ? 4 : 3) );
+    test( joined.empty() || joined.back() < pieces[i].front() );
+    joined.merge(pieces[i]);
+    }
+  test( joined == range );
+
+  test( smtk::mesh::split_range(range, 100).size() == range.size() );
+  test( smtk::mesh::split_range(smtk::mesh::HandleRange(), 4).empty() );
+}
+
+//----------------------------------------------------------------------------
+void verify_traversal(smtk::mesh::InterfacePtr iface)
+{
+  const std::size_t numHexes = 100000;
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  create_hex_strip(c, numHexes);
+
+  //each hex has 8 points, 4 at x=i and 4 at x=i+1
+  const double expectedSumX = 4. * static_cast<double>(numHexes) * numHexes;
+
+  CellStatistics serialCells;
+  smtk::mesh::for_each( c->cells(), serialCells );
+  test( serialCells.numCells == numHexes );
+  test( serialCells.sumX == expectedSumX );
+
+  CellStatistics parallelCells;
+  smtk::mesh::parallel_for_each( c->cells(), parallelCells );
+  test( parallelCells.numPieces > 1, "expected the cells to be split");
+  test( parallelCells.numCells == numHexes );
+  test( parallelCells.sumX == expectedSumX );
+  test( parallelCells.maxPointId == serialCells.maxPointId );
+
+  PointStatistics parallelPoints;
+  smtk::mesh::parallel_for_each( c->points(), parallelPoints );
+  test( parallelPoints.numPoints == 4 * (numHexes + 1) );
+  test( parallelPoints.visited == c->points().range() );
+  test( parallelPoints.sumZ == 2. * (numHexes + 1) );
+}
+
+}
+
+//----------------------------------------------------------------------------
+int UnitTestParallelForEach(int, char**)
+{
+  verify_split_range();
+
+  //use several threads even on a single core machine
+  smtk::common::Parallel::setNumberOfThreads(4);
+  verify_nested_calls();
+  verify_traversal( smtk::mesh::moab::make_interface() );
+  verify_traversal( smtk::mesh::native::make_interface() );
+
+  smtk::common::Parallel::setNumberOfThreads(1);
+  verify_traversal( smtk::mesh::moab::make_interface() );
+  return 0;
+}
@@ -14,6 +14,9 @@
 
 #include "smtk/mesh/testing/cxx/helpers.h"
 
+#include <cstdlib>
+#include <cstring>
+
 //force to use filesystem version 3
 #define BOOST_FILESYSTEM_VERSION 3
 #include <boost/filesystem.hpp>
@@ -155,6 +158,54 @@ void verify_large_number_of_values_handle()
   test( result == range, "mixed cell set handle didn't serialize properly");
 }
 
+//----------------------------------------------------------------------------
+void verify_compact_handle()
+{
+  //empty ranges
+  smtk::mesh::HandleRange empty;
+  cJSON* json = smtk::mesh::to_compact_json(empty);
+  test( json->type == cJSON_String, "compact json form should be a string" );
+  test( smtk::mesh::from_json(json).empty(), "empty handle didn't serialize properly");
+  cJSON_Delete(json);
+
+  //a fragmented range of several types, with runs of every length and
+  //handles at the limits of their type
+  smtk::mesh::HandleRange range;
+  range.insert(to_handle(::moab::MBVERTEX, 0), to_handle(::moab::MBVERTEX, 0));
+  for(int i=0; i < 5000; ++i)
+    {
+    const ::moab::EntityID start = 3 * i + (i % 7) * 20000;
+    range.insert(to_handle(::moab::MBTRI, start),
+                 to_handle(::moab::MBTRI, start + (i % 3)));
+    }
+  range.insert(to_handle(::moab::MBHEX, 1), to_handle(::moab::MBHEX, 8388607));
+  range.insert(to_handle(::moab::MBENTITYSET, 0xFFFFFFFFFFFFFFF),
+               to_handle(::moab::MBENTITYSET, 0xFFFFFFFFFFFFFFF));
+
+  json = smtk::mesh::to_compact_json(range);
+  smtk::mesh::HandleRange result = smtk::mesh::from_json(json);
+  test( result == range, "compact handle didn't serialize properly");
+
+  //the compact form should be much smaller than the dictionary form
+  cJSON* dict = smtk::mesh::to_json(range);
+  char* compactText = cJSON_PrintUnformatted(json);
+  char* dictText = cJSON_PrintUnformatted(dict);
+  test( strlen(compactText) * 3 < strlen(dictText),
+        "compact handles should be smaller than the dictionary form");
+  free(compactText);
+  free(dictText);
+  cJSON_Delete(dict);
+  cJSON_Delete(json);
+
+  //strings that aren't compact ranges give an empty range
+  const char* invalid[] = { "", "c1", "c2:AAAA", "c1:AAA", "c1:A*AA", "c1:gA==", "c1:=AAA" };
+  for(int i=0; i < 7; ++i)
+    {
+    json = cJSON_CreateString(invalid[i]);
+    test( smtk::mesh::from_json(json).empty(), "invalid compact string should give no handles");
+    cJSON_Delete(json);
+    }
+}
 
 }
 
@@ -168,5 +219,7 @@ int UnitTestReadWriteHandles(int, char**)
   verify_mixed_handle();
 
   verify_large_number_of_values_handle();
+
+  verify_compact_handle();
   return 0;
 }
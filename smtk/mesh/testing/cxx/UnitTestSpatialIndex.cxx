@@ -0,0 +1,254 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/SpatialIndex.h"
+#include "smtk/mesh/moab/Interface.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/mesh/testing/cxx/helpers.h"
+
+#include <cmath>
+
+namespace
+{
+
+const std::size_t n = 4;
+
+//----------------------------------------------------------------------------
+//fill the collection with an n by n by n grid of unit hexahedra, one mesh
+//per layer along z, returning the hexahedra in i, j, k order and their
+//connectivity through the optional argument
+std::vector<smtk::mesh::Handle> create_grid(smtk::mesh::CollectionPtr c,
+                                            smtk::mesh::Handle** connectivity = NULL)
+{
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  const std::size_t np = n + 1;
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(np * np * np, firstPoint, coords) );
+  for(std::size_t k=0; k < np; ++k)
+    {
+    for(std::size_t j=0; j < np; ++j)
+      {
+      for(std::size_t i=0; i < np; ++i)
+        {
+        const std::size_t p = i + np * (j + np * k);
+        coords[0][p] = static_cast<double>(i);
+        coords[1][p] = static_cast<double>(j);
+        coords[2][p] = static_cast<double>(k);
+        }
+      }
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(n * n * n, hexes, conn) );
+  smtk::mesh::Handle* hex = conn;
+  for(std::size_t k=0; k < n; ++k)
+    {
+    for(std::size_t j=0; j < n; ++j)
+      {
+      for(std::size_t i=0; i < n; ++i, hex += 8)
+        {
+        const smtk::mesh::Handle p = firstPoint + i + np * (j + np * k);
+        const smtk::mesh::Handle dj = np, dk = np * np;
+        hex[0] = p;         hex[1] = p+1;         hex[2] = p+1+dj;         hex[3] = p+dj;
+        hex[4] = p+dk;      hex[5] = p+1+dk;      hex[6] = p+1+dj+dk;      hex[7] = p+dj+dk;
+        }
+      }
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+  if(connectivity)
+    {
+    *connectivity = conn;
+    }
+
+  std::vector<smtk::mesh::Handle> ordered(hexes.begin(), hexes.end());
+  for(std::size_t k=0; k < n; ++k)
+    {
+    smtk::mesh::HandleRange layer;
+    layer.insert(ordered[n*n*k], ordered[n*n*(k+1) - 1]);
+    c->createMesh( smtk::mesh::CellSet(c, layer) );
+    }
+  return ordered;
+}
+
+//----------------------------------------------------------------------------
+smtk::mesh::Handle hex_at(const std::vector<smtk::mesh::Handle>& hexes,
+                          std::size_t i, std::size_t j, std::size_t k)
+{
+  return hexes[i + n * (j + n * k)];
+}
+
+//----------------------------------------------------------------------------
+void verify_queries(smtk::mesh::InterfacePtr iface)
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  smtk::mesh::Handle* conn = NULL;
+  std::vector<smtk::mesh::Handle> hexes = create_grid(c, &conn);
+
+  const smtk::mesh::SpatialIndex& index = c->spatialIndex();
+  test( index.cells().size() == n * n * n );
+  test( index.points().size() == (n+1) * (n+1) * (n+1) );
+
+  double b[6];
+  test( index.bounds(b) );
+  test( b[0] == 0 && b[1] == n && b[2] == 0 && b[3] == n && b[4] == 0 && b[5] == n );
+
+  //point location
+  smtk::mesh::Handle cell = 0;
+  const double inside[3] = { 1.5, 2.5, 0.25 };
+  test( index.findCell(inside, cell), "failed to locate a point inside the grid");
+  test( cell == hex_at(hexes, 1, 2, 0), "located the wrong cell");
+
+  const double outside[3] = { -0.5, 1., 1. };
+  test( !index.findCell(outside, cell), "located a point outside the grid");
+  test( index.findCell(outside, cell, 0.6), "tolerance should find the nearby cell");
+
+  //nearest points, closest first
+  const double nearCorner[3] = { 0.1, 0.2, 0.3 };
+  std::vector<smtk::mesh::Handle> nearest = index.nearestPoints(nearCorner, 4);
+  test( nearest.size() == 4 );
+  test( nearest[0] == c->points().range().front(), "the corner is the closest point");
+  std::vector<double> xyz(12);
+  test( iface->getCoordinates(&nearest[0], nearest.size(), &xyz[0]) );
+  for(std::size_t i=1; i < 4; ++i)
+    {
+    const double* prev = &xyz[3*(i-1)];
+    const double* cur = &xyz[3*i];
+    double dPrev = 0, dCur = 0;
+    for(int a=0; a < 3; ++a)
+      {
+      dPrev += (prev[a] - nearCorner[a]) * (prev[a] - nearCorner[a]);
+      dCur += (cur[a] - nearCorner[a]) * (cur[a] - nearCorner[a]);
+      }
+    test( dPrev <= dCur, "nearest points should be sorted by distance");
+    }
+
+  //radius queries
+  const double origin[3] = { 0., 0., 0. };
+  test( index.pointsWithinRadius(origin, 1.01).size() == 4 );
+  const double center[3] = { 2., 2., 2. };
+  test( index.cellsWithinRadius(center, 0.01).size() == 8,
+        "an interior grid point is shared by 8 cells");
+  test( index.cellsWithinRadius(center, 1.01).size() == 32 );
+
+  //a segment through a row of cells
+  const double p0[3] = { -1., 0.5, 0.5 };
+  const double p1[3] = { n + 1., 0.5, 0.5 };
+  std::vector< std::pair<double, smtk::mesh::Handle> > hits;
+  index.intersectSegment(p0, p1, hits);
+  test( hits.size() == n, "the segment crosses a row of cells");
+  for(std::size_t i=0; i < n; ++i)
+    {
+    test( hits[i].second == hex_at(hexes, i, 0, 0), "hits out of order");
+    test( std::fabs(hits[i].first - (i + 1.) / (n + 2.)) < 1e-12, "wrong entry parameter");
+    }
+
+  //a ray from above
+  const double from[3] = { 0.5, 3.5, 10. };
+  const double down[3] = { 0., 0., -1. };
+  double t = 0;
+  test( index.intersectRay(from, down, cell, t) );
+  test( cell == hex_at(hexes, 0, 3, n-1) && std::fabs(t - (10. - n)) < 1e-12 );
+  const double up[3] = { 0., 0., 1. };
+  test( !index.intersectRay(from, up, cell, t), "the ray points away from the grid");
+
+  //the index is kept until the cells change
+  test( &c->spatialIndex() == &index, "the index should be reused");
+
+  //and until connectivity is modified through the allocator, even when the
+  //cells stay the same. Move the first cell onto the far corner of the grid
+  const smtk::mesh::Handle shift = (n - 1) * (1 + (n + 1) + (n + 1) * (n + 1));
+  for(int i=0; i < 8; ++i)
+    {
+    conn[i] += shift;
+    }
+  smtk::mesh::HandleRange first(hexes[0], hexes[0]);
+  test( c->interface()->allocator()->connectivityModified(first, 8, conn) );
+  const double farCorner[3] = { n - 0.5, n - 0.5, n - 0.5 };
+  smtk::mesh::HandleRange moved = c->spatialIndex().cellsWithinRadius(farCorner, 0.01);
+  test( moved.size() == 2 && moved.find(hexes[0]) != moved.end(),
+        "the index should see modified connectivity");
+  const double nearCorner2[3] = { 0.5, 0.5, 0.5 };
+  test( c->spatialIndex().cellsWithinRadius(nearCorner2, 0.01).empty(),
+        "the index should not see the old connectivity");
+
+  smtk::mesh::MeshSet top = c->meshes().subset(n - 1);
+  test( c->removeMeshes(top) );
+  const smtk::mesh::SpatialIndex& rebuilt = c->spatialIndex();
+  test( rebuilt.cells().size() == n * n * (n - 1), "the index should be rebuilt");
+  test( rebuilt.intersectRay(from, down, cell, t) );
+  test( cell == hex_at(hexes, 0, 3, n-2) && std::fabs(t - (11. - n)) < 1e-12 );
+}
+
+//----------------------------------------------------------------------------
+void verify_triangles_and_points()
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(smtk::mesh::native::make_interface());
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  //two triangles making the unit square in the z=1 plane
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(4, firstPoint, coords) );
+  const double square[4][2] = { {0,0}, {1,0}, {1,1}, {0,1} };
+  for(int i=0; i < 4; ++i)
+    {
+    coords[0][i] = square[i][0];
+    coords[1][i] = square[i][1];
+    coords[2][i] = 1.;
+    }
+  smtk::mesh::HandleRange tris;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Triangle>(2, tris, conn) );
+  conn[0] = firstPoint; conn[1] = firstPoint+1; conn[2] = firstPoint+2;
+  conn[3] = firstPoint; conn[4] = firstPoint+2; conn[5] = firstPoint+3;
+  test( alloc->connectivityModified(tris, 3, conn) );
+  c->createMesh( smtk::mesh::CellSet(c, tris) );
+
+  smtk::mesh::SpatialIndex index(c->cells());
+  smtk::mesh::Handle cell;
+  const double onSurface[3] = { 0.75, 0.25, 1. };
+  test( index.findCell(onSurface, cell) && cell == tris.front() );
+  const double above[3] = { 0.25, 0.75, 1.5 };
+  test( !index.findCell(above, cell) );
+  test( index.findCell(above, cell, 0.5) && cell == tris.back() );
+
+  const double from[3] = { 0.25, 0.75, 5. };
+  const double down[3] = { 0., 0., -2. };
+  double t;
+  test( index.intersectRay(from, down, cell, t) );
+  test( cell == tris.back() && std::fabs(t - 2.) < 1e-12 );
+
+  //an index of just points
+  smtk::mesh::SpatialIndex points(c->points());
+  test( points.cells().empty() && points.points().size() == 4 );
+  test( !points.findCell(onSurface, cell, 1.) );
+  std::vector<smtk::mesh::Handle> nearest = points.nearestPoints(onSurface, 10);
+  test( nearest.size() == 4 && nearest[0] == firstPoint + 1 );
+}
+
+}
+
+//----------------------------------------------------------------------------
+int UnitTestSpatialIndex(int, char**)
+{
+  verify_queries( smtk::mesh::native::make_interface() );
+  verify_queries( smtk::mesh::moab::make_interface() );
+  verify_triangles_and_points();
+
+  return 0;
+}
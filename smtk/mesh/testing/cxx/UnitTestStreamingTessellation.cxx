@@ -0,0 +1,197 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/ExtractTessellation.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/moab/Interface.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/mesh/testing/cxx/helpers.h"
+
+#include <algorithm>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+//fill the collection with an n by n by n grid of unit hexahedra
+smtk::mesh::CollectionPtr create_grid(smtk::mesh::ManagerPtr mgr,
+                                      smtk::mesh::InterfacePtr iface,
+                                      std::size_t n)
+{
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  const std::size_t np = n + 1;
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(np * np * np, firstPoint, coords) );
+  for(std::size_t k=0; k < np; ++k)
+    {
+    for(std::size_t j=0; j < np; ++j)
+      {
+      for(std::size_t i=0; i < np; ++i)
+        {
+        const std::size_t p = i + np * (j + np * k);
+        coords[0][p] = static_cast<double>(i);
+        coords[1][p] = static_cast<double>(j);
+        coords[2][p] = static_cast<double>(k);
+        }
+      }
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(n * n * n, hexes, conn) );
+  smtk::mesh::Handle* hex = conn;
+  for(std::size_t k=0; k < n; ++k)
+    {
+    for(std::size_t j=0; j < n; ++j)
+      {
+      for(std::size_t i=0; i < n; ++i, hex += 8)
+        {
+        const smtk::mesh::Handle p = firstPoint + i + np * (j + np * k);
+        const smtk::mesh::Handle dj = np, dk = np * np;
+        hex[0] = p;         hex[1] = p+1;         hex[2] = p+1+dj;         hex[3] = p+dj;
+        hex[4] = p+dk;      hex[5] = p+1+dk;      hex[6] = p+1+dj+dk;      hex[7] = p+dj+dk;
+        }
+      }
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+
+  c->createMesh( smtk::mesh::CellSet(c, hexes) );
+  return c;
+}
+
+//----------------------------------------------------------------------------
+//reassembles the chunks into arrays for the whole set, checking each chunk
+//against the limit as it goes
+class Reassemble : public smtk::mesh::StreamingTessellation
+{
+public:
+  Reassemble(std::size_t maxConnectivityLength):
+    smtk::mesh::StreamingTessellation(maxConnectivityLength),
+    numChunks(0)
+  {
+  }
+
+  void forChunk(const smtk::mesh::TessellationChunk& chunk)
+  {
+  ++this->numChunks;
+  test( chunk.numberOfCells > 0 );
+  test( chunk.numberOfCells == 1 ||
+        chunk.connectivityLength <= this->maxConnectivityLength(),
+        "chunk is larger than the limit");
+  test( chunk.firstCell == this->cellTypes.size(), "chunks out of order");
+  test( chunk.connectivityOffset == this->connectivity.size(), "chunks out of order");
+
+  for(std::size_t c=0; c < chunk.numberOfCells; ++c)
+    {
+    this->cellLocations.push_back( chunk.cellLocations[c] + chunk.connectivityOffset );
+    this->cellTypes.push_back( chunk.cellTypes[c] );
+    }
+
+  if(!this->useLocalPoints())
+    {
+    test( chunk.points == NULL && chunk.numberOfPoints == 0 );
+    this->connectivity.insert(this->connectivity.end(),
+                              chunk.connectivity,
+                              chunk.connectivity + chunk.connectivityLength);
+    return;
+    }
+
+  //map the local points back to the PointSet, checking their coordinates
+  test( chunk.numberOfPoints > 0 && chunk.numberOfPoints <= chunk.connectivityLength );
+  for(std::size_t i=0; i < chunk.connectivityLength; ++i)
+    {
+    const bool isLength = this->useVTKConnectivity() &&
+      std::find(chunk.cellLocations, chunk.cellLocations + chunk.numberOfCells,
+                static_cast<boost::int64_t>(i)) != chunk.cellLocations + chunk.numberOfCells;
+    if(isLength)
+      {
+      this->connectivity.push_back(chunk.connectivity[i]);
+      continue;
+      }
+    const boost::int64_t local = chunk.connectivity[i];
+    test( local >= 0 && static_cast<std::size_t>(local) < chunk.numberOfPoints );
+    const boost::int64_t id = chunk.pointIds[local];
+    this->connectivity.push_back(id);
+    for(int a=0; a < 3; ++a)
+      {
+      test( chunk.points[3*local+a] == (*this->allPoints)[3*id+a],
+            "local point coordinates don't match");
+      }
+    }
+  }
+
+  std::size_t numChunks;
+  std::vector<boost::int64_t> connectivity;
+  std::vector<boost::int64_t> cellLocations;
+  std::vector<unsigned char> cellTypes;
+  const std::vector<double>* allPoints;
+};
+
+//----------------------------------------------------------------------------
+void verify_streaming(smtk::mesh::InterfacePtr iface,
+                      bool useVTKConnectivity,
+                      bool useLocalPoints,
+                      std::size_t maxConnectivityLength)
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  const std::size_t n = 10;
+  smtk::mesh::CollectionPtr c = create_grid(mgr, iface, n);
+  smtk::mesh::MeshSet ms = c->meshes();
+
+  smtk::mesh::Tessellation whole(useVTKConnectivity, true);
+  whole.extract(ms);
+
+  Reassemble chunks(maxConnectivityLength);
+  chunks.disableVTKStyleConnectivity(!useVTKConnectivity);
+  chunks.enableLocalPoints(useLocalPoints);
+  chunks.allPoints = &whole.points();
+  smtk::mesh::extractTessellation(ms, chunks);
+
+  //the mesh is larger than a single chunk
+  test( whole.connectivity().size() > maxConnectivityLength );
+  test( chunks.numChunks > 1, "expected more than one chunk");
+
+  const std::size_t numCells = n * n * n;
+  test( chunks.cellTypes.size() == numCells );
+  test( chunks.connectivity == whole.connectivity(), "connectivity doesn't match");
+  test( std::equal(chunks.cellLocations.begin(), chunks.cellLocations.end(),
+                   whole.cellLocations().begin()), "cell locations don't match");
+  test( std::equal(chunks.cellTypes.begin(), chunks.cellTypes.end(),
+                   whole.cellTypes().begin()), "cell types don't match");
+}
+
+}
+
+//----------------------------------------------------------------------------
+int UnitTestStreamingTessellation(int, char**)
+{
+  const bool vtkConnectivity[] = { true, false };
+  const bool localPoints[] = { false, true };
+  for(int v=0; v < 2; ++v)
+    {
+    for(int l=0; l < 2; ++l)
+      {
+      verify_streaming( smtk::mesh::native::make_interface(),
+                        vtkConnectivity[v], localPoints[l], 1000 );
+      verify_streaming( smtk::mesh::moab::make_interface(),
+                        vtkConnectivity[v], localPoints[l], 1000 );
+      }
+    }
+
+  //a limit smaller than a single cell gives every cell its own chunk
+  verify_streaming( smtk::mesh::native::make_interface(), true, true, 4 );
+
+  return 0;
+}
@@ -0,0 +1,196 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/WeldPoints.h"
+#include "smtk/mesh/moab/Interface.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/mesh/testing/cxx/helpers.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+//the groups of points joined by chains of points within tolerance, by
+//comparing every pair of points
+std::vector<std::size_t> brute_force_weld(const std::vector<double>& xyz,
+                                          double tolerance)
+{
+  const std::size_t numPoints = xyz.size() / 3;
+  std::vector<std::size_t> remap(numPoints);
+  for(std::size_t i=0; i < numPoints; ++i)
+    {
+    remap[i] = i;
+    }
+
+  //relabel until every pair within tolerance has the same, lowest, label
+  bool changed = true;
+  while(changed)
+    {
+    changed = false;
+    for(std::size_t i=0; i < numPoints; ++i)
+      {
+      for(std::size_t j=i+1; j < numPoints; ++j)
+        {
+        const double dx = xyz[3*i] - xyz[3*j];
+        const double dy = xyz[3*i+1] - xyz[3*j+1];
+        const double dz = xyz[3*i+2] - xyz[3*j+2];
+        if(dx*dx + dy*dy + dz*dz <= tolerance * tolerance &&
+           remap[i] != remap[j])
+          {
+          const std::size_t label = std::min(remap[i], remap[j]);
+          remap[i] = remap[j] = label;
+          changed = true;
+          }
+        }
+      }
+    }
+  return remap;
+}
+
+//----------------------------------------------------------------------------
+void verify_weld_array()
+{
+  //0 and 2 are jittered copies, 3 4 5 are a chain that welds as a group
+  //even though 3 and 5 are further apart than the tolerance
+  const double pts[] = { 0, 0, 0,
+                         1, 0, 0,
+                         0.005, 0, 0,
+                         2, 2, 2,
+                         2.008, 2, 2,
+                         2.016, 2, 2,
+                         5, 5, 5 };
+  std::vector<double> xyz(pts, pts + 21);
+  std::vector<std::size_t> remap;
+
+  test( smtk::mesh::weldPoints(&xyz[0], 7, 0.01, remap) == 4 );
+  test( remap.size() == 7 );
+  test( remap[0] == 0 && remap[1] == 1 && remap[2] == 0 );
+  test( remap[3] == 3 && remap[4] == 3 && remap[5] == 3, "chains should weld");
+  test( remap[6] == 6 );
+
+  //a negative tolerance welds nothing, zero only identical points
+  test( smtk::mesh::weldPoints(&xyz[0], 7, -1, remap) == 7 );
+  test( remap[2] == 2 );
+  xyz[6] = 0;
+  test( smtk::mesh::weldPoints(&xyz[0], 7, 0, remap) == 6 );
+  test( remap[2] == 0 && remap[4] == 4 );
+
+  //nothing to weld
+  test( smtk::mesh::weldPoints(&xyz[0], 0, 1, remap) == 0 );
+  test( remap.empty() );
+}
+
+//----------------------------------------------------------------------------
+void verify_weld_matches_brute_force()
+{
+  //clusters of points scattered around a few centers, so some clusters
+  //are split across bins and some chain together
+  std::srand(42);
+  std::vector<double> xyz;
+  for(int i=0; i < 400; ++i)
+    {
+    const int center = std::rand() % 20;
+    for(int a=0; a < 3; ++a)
+      {
+      const double jitter = (std::rand() / static_cast<double>(RAND_MAX)) * 0.05;
+      xyz.push_back( (center % (a + 2)) + jitter );
+      }
+    }
+
+  const double tolerances[] = { 0, 0.005, 0.02, 0.1 };
+  for(int t=0; t < 4; ++t)
+    {
+    std::vector<std::size_t> remap;
+    const std::size_t numKept =
+      smtk::mesh::weldPoints(&xyz[0], 400, tolerances[t], remap);
+    std::vector<std::size_t> expected = brute_force_weld(xyz, tolerances[t]);
+    test( remap == expected, "welding should match comparing every pair");
+
+    std::size_t expectedKept = 0;
+    for(std::size_t i=0; i < expected.size(); ++i)
+      {
+      expectedKept += (expected[i] == i) ? 1 : 0;
+      }
+    test( numKept == expectedKept );
+    }
+}
+
+//----------------------------------------------------------------------------
+//two unit hexahedra that touch at x=1 but don't share points
+void verify_weld_meshset(smtk::mesh::InterfacePtr iface)
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  test( alloc->allocatePoints(16, firstPoint, coords) );
+  for(int h=0; h < 2; ++h)
+    {
+    for(int p=0; p < 8; ++p)
+      {
+      coords[0][8*h+p] = h + ((p == 1 || p == 2 || p == 5 || p == 6) ? 1 : 0);
+      coords[1][8*h+p] = (p == 2 || p == 3 || p == 6 || p == 7) ? 1 : 0;
+      coords[2][8*h+p] = (p < 4) ? 0 : 1;
+      }
+    }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  test( alloc->allocateCells<smtk::mesh::Hexahedron>(2, hexes, conn) );
+  for(int i=0; i < 16; ++i)
+    {
+    conn[i] = firstPoint + i;
+    }
+  test( alloc->connectivityModified(hexes, 8, conn) );
+  c->createMesh( smtk::mesh::CellSet(c, hexes) );
+  test( c->points().size() == 16 );
+
+  std::vector< std::pair< smtk::mesh::Handle, smtk::mesh::Handle > > merged;
+  test( c->meshes().mergeCoincidentContactPoints(1e-6, merged) );
+  test( merged.size() == 4, "the points of the touching face should weld");
+  for(std::size_t i=0; i < merged.size(); ++i)
+    {
+    test( merged[i].first >= firstPoint + 8 && merged[i].second < firstPoint + 8 );
+    test( i == 0 || merged[i-1].first < merged[i].first );
+    }
+  test( c->points().size() == 12 );
+  test( c->meshes().points().size() == 12 );
+
+  //the second hex now uses the points of the first
+  smtk::mesh::CellSet second(c, smtk::mesh::HandleRange(hexes.back(), hexes.back()));
+  smtk::mesh::CellSet first(c, smtk::mesh::HandleRange(hexes.front(), hexes.front()));
+  test( smtk::mesh::set_intersect(first.points(), second.points()).size() == 4 );
+
+  //welding again changes nothing
+  merged.clear();
+  c->meshes().mergeCoincidentContactPoints(1e-6, merged);
+  test( merged.empty() );
+  test( c->points().size() == 12 );
+}
+
+}
+
+//----------------------------------------------------------------------------
+int UnitTestWeldPoints(int, char**)
+{
+  verify_weld_array();
+  verify_weld_matches_brute_force();
+  verify_weld_meshset( smtk::mesh::native::make_interface() );
+  verify_weld_meshset( smtk::mesh::moab::make_interface() );
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+#include "smtk/mesh/moab/Interface.h"
+#include "smtk/mesh/native/Interface.h"
+
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace smtk::model::testing;
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+class SumCoordinates : public smtk::mesh::CellForEach
+{
+public:
+  SumCoordinates(): smtk::mesh::CellForEach(true), sum(0.) {}
+  void forCell(smtk::mesh::CellType, int numPts)
+  {
+  const std::vector<double>& xyz = this->coordinates();
+  for(int i=0; i < 3 * numPts; ++i)
+    {
+    this->sum += xyz[i];
+    }
+  }
+  CellForEach* clone() const { return new SumCoordinates; }
+  void reduce(const CellForEach& piece)
+  {
+  this->sum += static_cast<const SumCoordinates&>(piece).sum;
+  }
+  double sum;
+};
+
+//----------------------------------------------------------------------------
+//fill the collection with an n x n x n block of hexahedra
+void createHexGrid(smtk::mesh::CollectionPtr c, int n)
+{
+  smtk::mesh::AllocatorPtr alloc = c->interface()->allocator();
+  const int np = n + 1;
+
+  std::vector<double*> coords;
+  smtk::mesh::Handle firstPoint;
+  alloc->allocatePoints(np * np * np, firstPoint, coords);
+  for(int k=0, p=0; k < np; ++k)
+    for(int j=0; j < np; ++j)
+      for(int i=0; i < np; ++i, ++p)
+        {
+        coords[0][p] = i;
+        coords[1][p] = j;
+        coords[2][p] = k;
+        }
+
+  smtk::mesh::HandleRange hexes;
+  smtk::mesh::Handle* conn;
+  alloc->allocateCells<smtk::mesh::Hexahedron>(n * n * n, hexes, conn);
+  for(int k=0; k < n; ++k)
+    for(int j=0; j < n; ++j)
+      for(int i=0; i < n; ++i, conn += 8)
+        {
+        smtk::mesh::Handle p = firstPoint + (k * np + j) * np + i;
+        conn[0] = p;
+        conn[1] = p + 1;
+        conn[2] = p + np + 1;
+        conn[3] = p + np;
+        conn[4] = p + np * np;
+        conn[5] = p + np * np + 1;
+        conn[6] = p + np * np + np + 1;
+        conn[7] = p + np * np + np;
+        }
+  alloc->connectivityModified(hexes, 8, conn - 8 * hexes.size());
+  c->createMesh( smtk::mesh::CellSet(c, hexes) );
+}
+
+//----------------------------------------------------------------------------
+void benchmark(smtk::mesh::InterfacePtr iface, int n)
+{
+  smtk::mesh::ManagerPtr mgr = smtk::mesh::Manager::create();
+  smtk::mesh::CollectionPtr c = mgr->makeCollection(iface);
+  Timer t;
+
+  t.mark();
+  createHexGrid(c, n);
+  std::cout << c->interfaceName() << ":\n"
+            << "  create " << n * n * n << " hexahedra  " << t.elapsed() << " s\n";
+
+  t.mark();
+  smtk::mesh::CellSet cells = c->cells();
+  std::cout << "  query cells           " << t.elapsed() << " s (" << cells.size() << ")\n";
+
+  t.mark();
+  smtk::mesh::PointSet points = cells.points();
+  std::cout << "  query points          " << t.elapsed() << " s (" << points.size() << ")\n";
+
+  t.mark();
+  std::vector<double> xyz(3 * points.size());
+  iface->getCoordinates(points.range(), &xyz[0]);
+  std::cout << "  fetch coordinates     " << t.elapsed() << " s\n";
+
+  t.mark();
+  SumCoordinates sum;
+  smtk::mesh::for_each(cells, sum);
+  std::cout << "  visit cells (coords)  " << t.elapsed() << " s (sum " << sum.sum << ")\n";
+
+  t.mark();
+  SumCoordinates parallelSum;
+  smtk::mesh::parallel_for_each(cells, parallelSum);
+  std::cout << "  parallel visit cells  " << t.elapsed() << " s (sum " << parallelSum.sum << ")\n";
+
+  t.mark();
+  smtk::mesh::MeshSet shell = c->meshes().extractShell();
+  std::cout << "  extract shell         " << t.elapsed() << " s (" << shell.cells().size() << " faces)\n";
+
+  t.mark();
+  c->meshes().mergeCoincidentContactPoints();
+  std::cout << "  merge points          " << t.elapsed() << " s (" << c->points().size() << ")\n";
+}
+
+}
+
+/**\brief Compare the moab and native mesh interfaces on a block of hexahedra.
+  *
+  * Usage: benchmarkInterfaces [hexahedraPerSide]
+  */
+int main(int argc, char* argv[])
+{
+  int n = argc > 1 ? atoi(argv[1]) : 40;
+
+  benchmark(smtk::mesh::moab::make_interface(), n);
+  benchmark(smtk::mesh::native::make_interface(), n);
+  return 0;
+}
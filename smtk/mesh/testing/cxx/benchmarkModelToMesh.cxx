@@ -0,0 +1,101 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/common/Parallel.h"
+
+#include "smtk/io/ModelToMesh.h"
+
+#include "smtk/mesh/Collection.h"
+#include "smtk/mesh/Manager.h"
+
+#include "smtk/model/Face.h"
+#include "smtk/model/Manager.h"
+#include "smtk/model/Tessellation.h"
+
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace smtk::model::testing;
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+//a model of numFaces faces, each tessellated as an m by m grid of quads
+//split into triangles
+void createFaces(smtk::model::ManagerPtr mgr, int numFaces, int m)
+{
+  smtk::model::Model model = mgr->addModel(3, 3, "benchmark");
+  for(int f=0; f < numFaces; ++f)
+    {
+    smtk::model::Tessellation tess;
+    for(int j=0; j <= m; ++j)
+      {
+      for(int i=0; i <= m; ++i)
+        {
+        tess.addCoords(f + i / double(m), j / double(m), 0.);
+        }
+      }
+    for(int j=0; j < m; ++j)
+      {
+      for(int i=0; i < m; ++i)
+        {
+        const int p = i + (m + 1) * j;
+        tess.addTriangle(p, p + 1, p + m + 2);
+        tess.addTriangle(p, p + m + 2, p + m + 1);
+        }
+      }
+    smtk::model::Face face = mgr->addFace();
+    face.setTessellation(&tess);
+    model.addCell(face);
+    }
+}
+
+//----------------------------------------------------------------------------
+void convert(const smtk::model::ManagerPtr& modelManager, std::size_t numThreads)
+{
+  smtk::common::Parallel::setNumberOfThreads(numThreads);
+  smtk::mesh::ManagerPtr meshManager = smtk::mesh::Manager::create();
+  smtk::io::ModelToMesh toMesh;
+
+  Timer t;
+  t.mark();
+  smtk::mesh::CollectionPtr c = toMesh(meshManager, modelManager);
+  std::cout << "  " << numThreads << " thread(s)  " << t.elapsed() << " s ("
+            << c->numberOfMeshes() << " meshes, "
+            << c->cells().size() << " cells)\n";
+}
+
+}
+
+/**\brief Time converting a model of many tessellated faces to a mesh
+  *        collection with one thread and with all available threads.
+  *
+  * Usage: benchmarkModelToMesh [numberOfFaces] [quadsPerSide]
+  */
+int main(int argc, char* argv[])
+{
+  int numFaces = argc > 1 ? atoi(argv[1]) : 50000;
+  int m = argc > 2 ? atoi(argv[2]) : 4;
+
+  smtk::model::ManagerPtr modelManager = smtk::model::Manager::create();
+  createFaces(modelManager, numFaces, m);
+
+  const std::size_t numThreads = smtk::common::Parallel::numberOfThreads();
+  std::cout << "ModelToMesh of " << numFaces << " faces:\n";
+  convert(modelManager, 1);
+  if(numThreads > 1)
+    {
+    convert(modelManager, numThreads);
+    }
+  return 0;
+}
@@ -0,0 +1,264 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/model/AdjacencyCache.h"
+
+#include "smtk/model/Entity.h"
+#include "smtk/model/EntityRef.h"
+#include "smtk/model/Manager.h"
+
+using namespace smtk::common;
+
+namespace smtk {
+  namespace model {
+
+namespace {
+
+// Cached tables cover entities of dimension 0 through MaxDim and
+// requested dimensions -1 (any) through MaxDim.
+const int MaxDim = 3;
+
+const ManagerEventRelationType observedRelations[] = {
+  CELL_INCLUDES_CELL,
+  CELL_HAS_USE,
+  SHELL_HAS_USE
+};
+const int numObservedRelations = sizeof(observedRelations) / sizeof(observedRelations[0]);
+
+int tableKey(AdjacencyCache::Query q, int fromDim, int toDim)
+{
+  return (static_cast<int>(q) * (MaxDim + 1) + fromDim) * (MaxDim + 2) + toDim + 1;
+}
+
+} // namespace
+
+/// Create an empty cache of \a mgr's adjacency queries.
+AdjacencyCache::AdjacencyCache(Manager* mgr)
+  : m_manager(mgr), m_rebuild(false)
+{
+  for (int i = 0; i < numObservedRelations; ++i)
+    this->m_manager->observe(
+      ManagerEventType(ANY_EVENT, observedRelations[i]),
+      &AdjacencyCache::observeRelations, this);
+}
+
+AdjacencyCache::~AdjacencyCache()
+{
+  for (int i = 0; i < numObservedRelations; ++i)
+    this->m_manager->unobserve(
+      ManagerEventType(ANY_EVENT, observedRelations[i]),
+      &AdjacencyCache::observeRelations, this);
+}
+
+/// Discard every table; each is rebuilt when next queried.
+void AdjacencyCache::clear()
+{
+  this->m_tables.clear();
+  this->m_stale.clear();
+  this->m_rebuild = false;
+}
+
+/**\brief Mark \a uid as having modified relations (or dimension).
+  *
+  * Cached answers involving \a uid are invalidated before the next query.
+  * When more entities are marked than the manager holds, every table
+  * is discarded by the next query instead.
+  */
+void AdjacencyCache::entityModified(const UUID& uid)
+{
+  if (this->m_rebuild || this->m_tables.empty())
+    return;
+  this->m_stale.push_back(uid);
+  if (this->m_stale.size() > this->m_manager->topology().size() + 64)
+    {
+    this->m_stale.clear();
+    this->m_rebuild = true;
+    }
+}
+
+/// Return the cached equivalent of Manager::lowerDimensionalBoundaries().
+UUIDs AdjacencyCache::lowerDimensionalBoundaries(const UUID& ofEntity, int lowerDimension)
+{
+  return this->query(BOUNDARIES, ofEntity, lowerDimension);
+}
+
+/// Return the cached equivalent of Manager::higherDimensionalBordants().
+UUIDs AdjacencyCache::higherDimensionalBordants(const UUID& ofEntity, int higherDimension)
+{
+  return this->query(BORDANTS, ofEntity, higherDimension);
+}
+
+/// Return the cached equivalent of Manager::adjacentEntities().
+UUIDs AdjacencyCache::adjacentEntities(const UUID& ofEntity, int ofDimension)
+{
+  return this->query(ADJACENCIES, ofEntity, ofDimension);
+}
+
+/// Return the number of tables that have been built (and not since discarded).
+std::size_t AdjacencyCache::numberOfTables() const
+{
+  return this->m_tables.size();
+}
+
+/// Mark both entities of an observed relationship as modified.
+int AdjacencyCache::observeRelations(
+  ManagerEventType event, const EntityRef& src, const EntityRef& related, void* cache)
+{
+  (void)event;
+  AdjacencyCache* self = reinterpret_cast<AdjacencyCache*>(cache);
+  if (self)
+    {
+    self->entityModified(src.entity());
+    self->entityModified(related.entity());
+    }
+  return 0;
+}
+
+/// Return the answer to \a q for \a ofEntity from its table (building the table as needed).
+UUIDs AdjacencyCache::query(Query q, const UUID& ofEntity, int dim)
+{
+  this->update();
+  const Entity* ent = this->m_manager->findEntity(ofEntity, false);
+  if (!ent)
+    return UUIDs();
+  int fromDim = ent->dimension();
+  if (fromDim < 0 || fromDim > MaxDim || dim < -1 || dim > MaxDim)
+    return this->compute(q, ofEntity, dim);
+
+  int key = tableKey(q, fromDim, dim);
+  Tables::iterator tit = this->m_tables.find(key);
+  if (tit == this->m_tables.end())
+    {
+    tit = this->m_tables.insert(std::make_pair(key, Table())).first;
+    this->build(tit->second, q, fromDim, dim);
+    }
+  Table& table(tit->second);
+
+  UUIDHashMap<std::size_t>::const_iterator rit = table.rows.find(ofEntity);
+  if (rit != table.rows.end())
+    {
+    return UUIDs(
+      table.targets.begin() + table.offsets[rit->second],
+      table.targets.begin() + table.offsets[rit->second + 1]);
+    }
+  UUIDHashMap<UUIDs>::const_iterator pit = table.patched.find(ofEntity);
+  if (pit != table.patched.end())
+    return pit->second;
+  // The entity is new or its row was invalidated; recompute it alone.
+  return table.patched.insert(std::make_pair(ofEntity, this->compute(q, ofEntity, dim))).first->second;
+}
+
+/// Compute the answer to \a q by walking entity relations.
+UUIDs AdjacencyCache::compute(Query q, const UUID& ofEntity, int dim) const
+{
+  switch (q)
+    {
+  case BOUNDARIES: return this->m_manager->computeLowerDimensionalBoundaries(ofEntity, dim);
+  case BORDANTS: return this->m_manager->computeHigherDimensionalBordants(ofEntity, dim);
+  case ADJACENCIES: return this->m_manager->computeAdjacentEntities(ofEntity, dim);
+    }
+  return UUIDs();
+}
+
+/// Fill \a table with the answer to \a q for every entity of dimension \a fromDim.
+void AdjacencyCache::build(Table& table, Query q, int fromDim, int toDim) const
+{
+  table.rows.clear();
+  table.offsets.clear();
+  table.targets.clear();
+  table.patched.clear();
+  table.invalidated = 0;
+  table.offsets.push_back(0);
+  const UUIDsToEntities& topology(this->m_manager->topology());
+  for (UUIDsToEntities::const_iterator it = topology.begin(); it != topology.end(); ++it)
+    {
+    if (it->second.dimension() != fromDim)
+      continue;
+    UUIDs answer = this->compute(q, it->first, toDim);
+    table.rows.insert(std::make_pair(it->first, table.offsets.size() - 1));
+    table.targets.insert(table.targets.end(), answer.begin(), answer.end());
+    table.offsets.push_back(table.targets.size());
+    }
+}
+
+/**\brief Invalidate rows that depend on entities marked since the last query.
+  *
+  * A boundary or bordant answer for X depends on the relations of every
+  * entity visited by walking down (or up) from X, so the rows of each
+  * modified entity and of everything above and below it are invalidated.
+  * An adjacency answer for X additionally depends on the bordants of X's
+  * boundaries, so rows above each modified entity and above anything
+  * below it are invalidated.
+  */
+void AdjacencyCache::update()
+{
+  if (this->m_rebuild)
+    {
+    this->clear();
+    return;
+    }
+  if (this->m_stale.empty())
+    return;
+
+  bool haveAdjacencies = false;
+  for (Tables::const_iterator tit = this->m_tables.begin(); tit != this->m_tables.end(); ++tit)
+    if (tit->first >= tableKey(ADJACENCIES, 0, -1))
+      haveAdjacencies = true;
+
+  UUIDs affected;
+  UUIDs affectedAdjacencies;
+  UUIDs stale(this->m_stale.begin(), this->m_stale.end());
+  this->m_stale.clear();
+  for (UUIDs::const_iterator it = stale.begin(); it != stale.end(); ++it)
+    {
+    UUIDs above = this->m_manager->computeHigherDimensionalBordants(*it, -1);
+    UUIDs below = this->m_manager->computeLowerDimensionalBoundaries(*it, -1);
+    affected.insert(*it);
+    affected.insert(above.begin(), above.end());
+    affected.insert(below.begin(), below.end());
+    if (haveAdjacencies)
+      {
+      affectedAdjacencies.insert(*it);
+      affectedAdjacencies.insert(above.begin(), above.end());
+      for (UUIDs::const_iterator bit = below.begin(); bit != below.end(); ++bit)
+        {
+        UUIDs nbrs = this->m_manager->computeHigherDimensionalBordants(*bit, -1);
+        affectedAdjacencies.insert(nbrs.begin(), nbrs.end());
+        }
+      }
+    }
+  this->invalidate(BOUNDARIES, affected);
+  this->invalidate(BORDANTS, affected);
+  if (haveAdjacencies)
+    this->invalidate(ADJACENCIES, affectedAdjacencies);
+}
+
+/// Remove the rows of \a entities from every table for query \a q.
+void AdjacencyCache::invalidate(Query q, const UUIDs& entities)
+{
+  Tables::iterator tit = this->m_tables.lower_bound(tableKey(q, 0, -1));
+  Tables::iterator tend = this->m_tables.lower_bound(tableKey(q, MaxDim + 1, -1));
+  while (tit != tend)
+    {
+    Table& table(tit->second);
+    for (UUIDs::const_iterator it = entities.begin(); it != entities.end(); ++it)
+      {
+      table.invalidated += table.rows.erase(*it);
+      table.patched.erase(*it);
+      }
+    // Once half of a table is stale, it is cheaper to rebuild it when next used.
+    if (table.invalidated > table.offsets.size() / 2 + 64)
+      this->m_tables.erase(tit++);
+    else
+      ++tit;
+    }
+}
+
+  } // namespace model
+} // namespace smtk
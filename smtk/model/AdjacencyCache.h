@@ -0,0 +1,105 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_model_AdjacencyCache_h
+#define __smtk_model_AdjacencyCache_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/PublicPointerDefs.h"
+
+#include "smtk/common/UUID.h"
+#include "smtk/common/UUIDHashMap.h"
+
+#include "smtk/model/Events.h"
+
+#include <map>
+#include <vector>
+
+namespace smtk {
+  namespace model {
+
+/**\brief Cache the answers to transitive boundary, bordant and adjacency queries.
+  *
+  * Manager::lowerDimensionalBoundaries(), Manager::higherDimensionalBordants()
+  * and Manager::adjacentEntities() normally walk entity relations recursively
+  * each time they are called.
+  * An AdjacencyCache holds their answers in compressed-sparse-row (CSR)
+  * tables, one for each kind of query and each pair of (entity dimension,
+  * requested dimension).
+  * A table is built the first time it is queried and holds a row for every
+  * entity of its dimension; repeated queries take time proportional to the
+  * size of their result.
+  *
+  * The cache is told by its manager (see Manager::entityModified()) when
+  * entity records change and also observes CELL_INCLUDES_CELL, CELL_HAS_USE
+  * and SHELL_HAS_USE events.
+  * Before the next query, the rows of modified entities and of everything
+  * above and below them are invalidated and later recomputed individually.
+  * This assumes relations are reciprocal (as the manager keeps them), since
+  * the entities affected by a change are found by walking relations in both
+  * directions from each modified entity.
+  * Tables with too many invalidated rows are discarded and rebuilt when
+  * next queried.
+  *
+  * Instances are owned by a Manager; see Manager::enableAdjacencyCache().
+  */
+class SMTKCORE_EXPORT AdjacencyCache
+{
+public:
+  /// The queries whose answers may be cached.
+  enum Query
+    {
+    BOUNDARIES, //!< Manager::lowerDimensionalBoundaries()
+    BORDANTS,   //!< Manager::higherDimensionalBordants()
+    ADJACENCIES //!< Manager::adjacentEntities()
+    };
+
+  AdjacencyCache(Manager* mgr);
+  ~AdjacencyCache();
+
+  void clear();
+  void entityModified(const smtk::common::UUID& uid);
+
+  smtk::common::UUIDs lowerDimensionalBoundaries(const smtk::common::UUID& ofEntity, int lowerDimension);
+  smtk::common::UUIDs higherDimensionalBordants(const smtk::common::UUID& ofEntity, int higherDimension);
+  smtk::common::UUIDs adjacentEntities(const smtk::common::UUID& ofEntity, int ofDimension);
+
+  std::size_t numberOfTables() const;
+
+protected:
+  /// Answers to one query for every entity of one dimension.
+  struct Table
+    {
+    smtk::common::UUIDHashMap<std::size_t> rows; // entity -> row (absent once invalidated)
+    std::vector<std::size_t> offsets;            // row -> start of its entries in targets
+    std::vector<smtk::common::UUID> targets;
+    smtk::common::UUIDHashMap<smtk::common::UUIDs> patched; // rows recomputed since the table was built
+    std::size_t invalidated;
+    };
+  typedef std::map<int,Table> Tables;
+
+  static int observeRelations(
+    ManagerEventType event, const EntityRef& src, const EntityRef& related, void* cache);
+
+  smtk::common::UUIDs query(Query q, const smtk::common::UUID& ofEntity, int dim);
+  smtk::common::UUIDs compute(Query q, const smtk::common::UUID& ofEntity, int dim) const;
+  void build(Table& table, Query q, int fromDim, int toDim) const;
+  void update();
+  void invalidate(Query q, const smtk::common::UUIDs& entities);
+
+  Manager* m_manager;
+  Tables m_tables;
+  std::vector<smtk::common::UUID> m_stale;
+  bool m_rebuild;
+};
+
+  } // namespace model
+} // namespace smtk
+
+#endif // __smtk_model_AdjacencyCache_h
@@ -26,6 +26,8 @@
 #  if defined(_MSC_VER) // Visual studio
 #    pragma warning (pop)
 #  endif
+#elif defined(SMTK_DENSE_HASH_STORAGE)
+#  include "smtk/common/UUIDHashMap.h"
 #endif // SMTK_HASH_STORAGE
 
 #include <map>
@@ -212,11 +214,16 @@ public:
 typedef std::vector<Arrangement> Arrangements;
 /// A map holding Arrangements of different ArrangementKinds.
 typedef std::map<ArrangementKind,Arrangements> KindsToArrangements;
-#ifdef SMTK_HASH_STORAGE
+#if defined(SMTK_HASH_STORAGE)
 /// Each Manager entity's UUID is mapped to a vector of Arrangment instances.
 typedef google::sparse_hash_map<smtk::common::UUID,KindsToArrangements> UUIDsToArrangements;
 /// An iterator referencing a (UUID,KindsToArrangements)-tuple.
 typedef google::sparse_hash_map<smtk::common::UUID,KindsToArrangements>::iterator UUIDWithArrangementDictionary;
+#elif defined(SMTK_DENSE_HASH_STORAGE)
+/// Each Manager entity's UUID is mapped to a vector of Arrangment instances.
+typedef smtk::common::UUIDHashMap<KindsToArrangements> UUIDsToArrangements;
+/// An iterator referencing a (UUID,KindsToArrangements)-tuple.
+typedef smtk::common::UUIDHashMap<KindsToArrangements>::iterator UUIDWithArrangementDictionary;
 #else
 /// Each Manager entity's UUID is mapped to a vector of Arrangment instances.
 typedef std::map<smtk::common::UUID,KindsToArrangements> UUIDsToArrangements;
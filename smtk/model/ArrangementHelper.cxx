@@ -71,7 +71,15 @@ void ArrangementHelper::reset(const smtk::model::EntityRef& ent)
 
   Entity* erec;
   if (ent.isValid(&erec))
+    {
+    // Former relations may no longer refer to this entity either.
+    ManagerPtr mgr = ent.manager();
+    smtk::common::UUIDArray::const_iterator rit;
+    for (rit = erec->relations().begin(); rit != erec->relations().end(); ++rit)
+      mgr->entityModified(*rit);
+    mgr->entityModified(ent.entity());
     erec->resetRelations();
+    }
 
   mutableEnt.clearArrangements();
 
@@ -24,6 +24,8 @@
 #  if defined(_MSC_VER) // Visual studio
 #    pragma warning (pop)
 #  endif
+#elif defined(SMTK_DENSE_HASH_STORAGE)
+#  include "smtk/common/UUIDHashMap.h"
 #else
 #  include <map>
 #endif
@@ -52,11 +54,16 @@ protected:
   AttributeSet m_attributes; // IDs of attributes assigned to an entity.
 };
 
-#ifdef SMTK_HASH_STORAGE
+#if defined(SMTK_HASH_STORAGE)
 /// Each Manager entity's UUID is mapped to a set of assigned attribute IDs.
 typedef google::sparse_hash_map<smtk::common::UUID,AttributeAssignments> UUIDsToAttributeAssignments;
 /// An iterator referencing a (UUID,AttributeAssignments)-tuple.
 typedef google::sparse_hash_map<smtk::common::UUID,AttributeAssignments>::iterator UUIDWithAttributeAssignments;
+#elif defined(SMTK_DENSE_HASH_STORAGE)
+/// Each Manager entity's UUID is mapped to a set of assigned attribute IDs.
+typedef smtk::common::UUIDHashMap<AttributeAssignments> UUIDsToAttributeAssignments;
+/// An iterator referencing a (UUID,AttributeAssignments)-tuple.
+typedef smtk::common::UUIDHashMap<AttributeAssignments>::iterator UUIDWithAttributeAssignments;
 #else
 /// Each Manager entity's UUID is mapped to a set of assigned attribute IDs.
 typedef std::map<smtk::common::UUID,AttributeAssignments> UUIDsToAttributeAssignments;
@@ -0,0 +1,383 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/model/CompactTessellation.h"
+
+namespace smtk {
+  namespace model {
+
+namespace {
+
+// Point IDs up to this value fit in 16-bit indices.
+const std::size_t MaxNarrowIndex = 0xffff;
+
+bool isVaryingGroup(CompactTessellation::CellGroup group)
+{
+  return group >= CompactTessellation::POLYVERTICES;
+}
+
+template<typename T>
+std::size_t bytesOf(const std::vector<T>& v)
+{
+  return v.capacity() * sizeof(T);
+}
+
+} // namespace
+
+CompactTessellation::CompactTessellation()
+{
+  this->reset();
+}
+
+/// Construct a compact copy of \a tess; see assign().
+CompactTessellation::CompactTessellation(const Tessellation& tess, CoordinatePrecision precision)
+{
+  this->assign(tess, precision);
+}
+
+/**\brief Replace the contents of this object with a compact copy of \a tess.
+  *
+  * Returns false (leaving this object empty) if \a tess holds an invalid
+  * or truncated cell or a cell that refers to a point that does not exist.
+  */
+bool CompactTessellation::assign(const Tessellation& tess, CoordinatePrecision precision)
+{
+  this->reset();
+  const std::vector<double>& coords(tess.coords());
+  size_type numPoints = coords.size() / 3;
+  this->m_wideIndices = numPoints > MaxNarrowIndex + 1;
+  if (precision == SINGLE_PRECISION)
+    this->m_floatCoords.assign(coords.begin(), coords.begin() + 3 * numPoints);
+  else
+    this->m_doubleCoords.assign(coords.begin(), coords.begin() + 3 * numPoints);
+
+  const std::vector<int>& conn(tess.conn());
+  Tessellation::size_type connSize = static_cast<Tessellation::size_type>(conn.size());
+  for (Tessellation::size_type off = tess.begin(); off != tess.end(); off = tess.nextCellOffset(off))
+    {
+    Tessellation::size_type cellType;
+    Tessellation::size_type numVerts = tess.numberOfCellVertices(off, &cellType);
+    Tessellation::size_type first = off + (cellType & TESS_VARYING_VERT_CELL ? 2 : 1);
+    Tessellation::size_type numProps =
+      Tessellation::numCellPropsFromType(cellType) +
+      numVerts * Tessellation::numVertexPropsFromType(cellType);
+    if (numVerts <= 0 || first + numVerts + numProps > connSize)
+      {
+      this->reset();
+      return false;
+      }
+    const int* ids = &conn[first];
+    for (Tessellation::size_type i = 0; i < numVerts; ++i)
+      {
+      if (ids[i] < 0 || static_cast<size_type>(ids[i]) >= numPoints)
+        {
+        this->reset();
+        return false;
+        }
+      }
+
+    CellGroup group;
+    switch (Tessellation::cellShapeFromType(cellType))
+      {
+    case TESS_VERTEX: group = VERTICES; break;
+    case TESS_POLYVERTEX: group = POLYVERTICES; break;
+    case TESS_POLYLINE: group = numVerts == 2 ? LINES : POLYLINES; break;
+    case TESS_TRIANGLE: group = TRIANGLES; break;
+    case TESS_QUAD: group = QUADS; break;
+    case TESS_POLYGON: group = POLYGONS; break;
+    case TESS_TRIANGLE_STRIP: group = TRIANGLE_STRIPS; break;
+    default:
+      this->reset();
+      return false;
+      }
+    this->appendIndices(group, ids, numVerts);
+    if (numProps > 0)
+      {
+      CellProperties props;
+      props.cell = static_cast<boost::uint32_t>(this->numberOfCells(group) - 1);
+      props.flags = cellType & TESS_PROPERTY_MASK;
+      props.offset = static_cast<boost::uint32_t>(this->m_propertyIds.size());
+      this->m_cellProperties[group].push_back(props);
+      this->m_propertyIds.insert(this->m_propertyIds.end(), ids + numVerts, ids + numVerts + numProps);
+      }
+    }
+  for (int g = 0; g < NUMBER_OF_GROUPS; ++g)
+    {
+    if (this->m_wideIndices)
+      std::vector<boost::uint32_t>(this->m_wide[g]).swap(this->m_wide[g]);
+    else
+      std::vector<boost::uint16_t>(this->m_narrow[g]).swap(this->m_narrow[g]);
+    std::vector<boost::uint32_t>(this->m_offsets[g]).swap(this->m_offsets[g]);
+    std::vector<CellProperties>(this->m_cellProperties[g]).swap(this->m_cellProperties[g]);
+    }
+  std::vector<int>(this->m_propertyIds).swap(this->m_propertyIds);
+  return true;
+}
+
+/**\brief Replace the contents of \a tess with the cells held by this object.
+  *
+  * Cells are written group by group (see the class documentation), so
+  * the result holds the same cells, with the same property IDs, as the
+  * tessellation this object was built from but possibly in another order.
+  */
+void CompactTessellation::toTessellation(Tessellation& tess) const
+{
+  tess.reset();
+  std::vector<double>& coords(tess.coords());
+  if (this->hasSinglePrecisionCoords())
+    coords.assign(this->m_floatCoords.begin(), this->m_floatCoords.end());
+  else
+    coords.assign(this->m_doubleCoords.begin(), this->m_doubleCoords.end());
+
+  std::vector<int>& conn(tess.conn());
+  for (int g = 0; g < NUMBER_OF_GROUPS; ++g)
+    {
+    CellGroup group = static_cast<CellGroup>(g);
+    size_type numCells = this->numberOfCells(group);
+    std::vector<CellProperties>::const_iterator pit = this->m_cellProperties[g].begin();
+    for (size_type c = 0; c < numCells; ++c)
+      {
+      IndexSpan ids = this->cell(group, c);
+      int flags = 0;
+      const int* propIds = NULL;
+      if (pit != this->m_cellProperties[g].end() && pit->cell == c)
+        {
+        flags = pit->flags;
+        propIds = &this->m_propertyIds[pit->offset];
+        ++pit;
+        }
+      conn.push_back(cellTypeOfGroup(group) | flags);
+      if (group == LINES || isVaryingGroup(group))
+        conn.push_back(static_cast<int>(ids.size()));
+      for (size_type i = 0; i < ids.size(); ++i)
+        conn.push_back(static_cast<int>(ids[i]));
+      if (propIds)
+        conn.insert(conn.end(), propIds, propIds +
+          Tessellation::numCellPropsFromType(flags) +
+          ids.size() * Tessellation::numVertexPropsFromType(flags));
+      }
+    }
+}
+
+/// Remove all points and cells.
+void CompactTessellation::reset()
+{
+  this->m_floatCoords.clear();
+  this->m_doubleCoords.clear();
+  this->m_wideIndices = false;
+  this->m_propertyIds.clear();
+  for (int g = 0; g < NUMBER_OF_GROUPS; ++g)
+    {
+    this->m_narrow[g].clear();
+    this->m_wide[g].clear();
+    this->m_offsets[g].clear();
+    this->m_cellProperties[g].clear();
+    if (isVaryingGroup(static_cast<CellGroup>(g)))
+      this->m_offsets[g].push_back(0);
+    }
+}
+
+/// Return the number of points whose coordinates are stored.
+CompactTessellation::size_type CompactTessellation::numberOfPoints() const
+{
+  return (this->m_floatCoords.empty() ?
+    this->m_doubleCoords.size() :
+    this->m_floatCoords.size()) / 3;
+}
+
+/// Return true when coordinates are stored as floats (see floatCoords()).
+bool CompactTessellation::hasSinglePrecisionCoords() const
+{
+  return this->m_doubleCoords.empty();
+}
+
+/// Return single-precision coordinates (x, y, z per point) or NULL if stored as doubles.
+const float* CompactTessellation::floatCoords() const
+{
+  return this->m_floatCoords.empty() ? NULL : &this->m_floatCoords[0];
+}
+
+/// Return double-precision coordinates (x, y, z per point) or NULL if stored as floats.
+const double* CompactTessellation::doubleCoords() const
+{
+  return this->m_doubleCoords.empty() ? NULL : &this->m_doubleCoords[0];
+}
+
+/// Copy the coordinates of point \a i into \a xyz, whatever their storage precision.
+void CompactTessellation::point(size_type i, double xyz[3]) const
+{
+  if (this->hasSinglePrecisionCoords())
+    for (int j = 0; j < 3; ++j)
+      xyz[j] = this->m_floatCoords[3 * i + j];
+  else
+    for (int j = 0; j < 3; ++j)
+      xyz[j] = this->m_doubleCoords[3 * i + j];
+}
+
+/// Return true when point IDs are stored as 32-bit (rather than 16-bit) integers.
+bool CompactTessellation::hasWideIndices() const
+{
+  return this->m_wideIndices;
+}
+
+/// Return the number of cells in all groups.
+CompactTessellation::size_type CompactTessellation::numberOfCells() const
+{
+  size_type total = 0;
+  for (int g = 0; g < NUMBER_OF_GROUPS; ++g)
+    total += this->numberOfCells(static_cast<CellGroup>(g));
+  return total;
+}
+
+/// Return the number of cells in the given \a group.
+CompactTessellation::size_type CompactTessellation::numberOfCells(CellGroup group) const
+{
+  if (isVaryingGroup(group))
+    return this->m_offsets[group].size() - 1;
+  size_type numIds = this->m_wideIndices ?
+    this->m_wide[group].size() :
+    this->m_narrow[group].size();
+  return numIds / pointsPerCell(group);
+}
+
+/// Return the point IDs of the \a i-th cell in \a group without copying them.
+CompactTessellation::IndexSpan CompactTessellation::cell(CellGroup group, size_type i) const
+{
+  size_type start;
+  size_type n;
+  if (isVaryingGroup(group))
+    {
+    start = this->m_offsets[group][i];
+    n = this->m_offsets[group][i + 1] - start;
+    }
+  else
+    {
+    n = pointsPerCell(group);
+    start = i * n;
+    }
+  return this->m_wideIndices ?
+    IndexSpan(&this->m_wide[group][start], n) :
+    IndexSpan(&this->m_narrow[group][start], n);
+}
+
+/**\brief Return the point IDs of every cell in \a group without copying them.
+  *
+  * For groups with a fixed number of points per cell, this is
+  * suitable for passing directly to a graphics API.
+  */
+CompactTessellation::IndexSpan CompactTessellation::indices(CellGroup group) const
+{
+  if (this->m_wideIndices)
+    return this->m_wide[group].empty() ?
+      IndexSpan() :
+      IndexSpan(&this->m_wide[group][0], this->m_wide[group].size());
+  return this->m_narrow[group].empty() ?
+    IndexSpan() :
+    IndexSpan(&this->m_narrow[group][0], this->m_narrow[group].size());
+}
+
+/// Return true when any cell has per-cell or per-vertex property IDs.
+bool CompactTessellation::hasCellProperties() const
+{
+  return !this->m_propertyIds.empty();
+}
+
+/**\brief Return the property flags of the \a i-th cell in \a group.
+  *
+  * The flags are the TESS_PROPERTY_MASK bits the cell's type had in the
+  * source Tessellation, or 0 if it had none. When nonzero, \a propertyIds
+  * is set to the IDs that followed the cell's point IDs there, in the same
+  * order; otherwise it is set to NULL.
+  */
+int CompactTessellation::cellProperties(CellGroup group, size_type i, const int*& propertyIds) const
+{
+  const std::vector<CellProperties>& props(this->m_cellProperties[group]);
+  std::size_t lo = 0;
+  std::size_t hi = props.size();
+  while (lo < hi)
+    {
+    std::size_t mid = (lo + hi) / 2;
+    if (props[mid].cell < i)
+      lo = mid + 1;
+    else
+      hi = mid;
+    }
+  if (lo == props.size() || props[lo].cell != i)
+    {
+    propertyIds = NULL;
+    return 0;
+    }
+  propertyIds = &this->m_propertyIds[props[lo].offset];
+  return props[lo].flags;
+}
+
+/// Return the number of points in each cell of \a group (or 0 if it varies).
+CompactTessellation::size_type CompactTessellation::pointsPerCell(CellGroup group)
+{
+  switch (group)
+    {
+  case VERTICES: return 1;
+  case LINES: return 2;
+  case TRIANGLES: return 3;
+  case QUADS: return 4;
+  default: break;
+    }
+  return 0;
+}
+
+/// Return the Tessellation cell type used to represent cells of \a group.
+int CompactTessellation::cellTypeOfGroup(CellGroup group)
+{
+  switch (group)
+    {
+  case VERTICES: return TESS_VERTEX;
+  case LINES: return TESS_POLYLINE;
+  case TRIANGLES: return TESS_TRIANGLE;
+  case QUADS: return TESS_QUAD;
+  case POLYVERTICES: return TESS_POLYVERTEX;
+  case POLYLINES: return TESS_POLYLINE;
+  case POLYGONS: return TESS_POLYGON;
+  case TRIANGLE_STRIPS: return TESS_TRIANGLE_STRIP;
+  default: break;
+    }
+  return TESS_INVALID_CELL;
+}
+
+/// Return the number of bytes allocated to hold coordinates, connectivity and cell properties.
+std::size_t CompactTessellation::memoryUsed() const
+{
+  std::size_t total =
+    bytesOf(this->m_floatCoords) + bytesOf(this->m_doubleCoords) + bytesOf(this->m_propertyIds);
+  for (int g = 0; g < NUMBER_OF_GROUPS; ++g)
+    total +=
+      bytesOf(this->m_narrow[g]) + bytesOf(this->m_wide[g]) +
+      bytesOf(this->m_offsets[g]) + bytesOf(this->m_cellProperties[g]);
+  return total;
+}
+
+/// Return the number of bytes \a tess has allocated to hold coordinates and connectivity.
+std::size_t CompactTessellation::memoryUsed(const Tessellation& tess)
+{
+  return bytesOf(tess.coords()) + bytesOf(tess.conn());
+}
+
+/// Append the \a n point IDs in \a ids as a new cell of \a group.
+void CompactTessellation::appendIndices(CellGroup group, const int* ids, size_type n)
+{
+  if (this->m_wideIndices)
+    this->m_wide[group].insert(this->m_wide[group].end(), ids, ids + n);
+  else
+    this->m_narrow[group].insert(this->m_narrow[group].end(), ids, ids + n);
+  if (isVaryingGroup(group))
+    this->m_offsets[group].push_back(static_cast<boost::uint32_t>(
+        this->m_wideIndices ? this->m_wide[group].size() : this->m_narrow[group].size()));
+}
+
+  } // namespace model
+} // namespace smtk
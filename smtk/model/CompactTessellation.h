@@ -0,0 +1,166 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_model_CompactTessellation_h
+#define __smtk_model_CompactTessellation_h
+
+#include "smtk/CoreExports.h"
+
+#include "smtk/model/Tessellation.h"
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace smtk {
+  namespace model {
+
+/**\brief A read-optimized, structure-of-arrays copy of a Tessellation.
+  *
+  * Tessellation interleaves a cell-type header (and, for some cells,
+  * a vertex count) with the point IDs of every cell and stores point
+  * coordinates as doubles.
+  * That suits incremental construction and Three.js export, but every
+  * traversal must decode the headers cell by cell.
+  *
+  * A CompactTessellation groups cells by shape instead.
+  * Each group holds only point IDs, packed into 16-bit integers when
+  * there are no more than 65536 points and 32-bit integers otherwise.
+  * Groups whose cells have a varying number of points also hold an
+  * array of offsets into their point IDs.
+  * Coordinates are stored as single-precision floats by default.
+  *
+  * Cells are visited in shape order (vertices, then lines, and so on),
+  * not in the order they appear in the source tessellation.
+  * Two-point polylines are stored as lines.
+  * Per-cell and per-vertex property IDs (material, normal, color and
+  * UV IDs) are kept in a side table holding only the cells that have
+  * them, so toTessellation() reproduces every cell of the source.
+  *
+  * This is an opt-in representation for consumers that traverse
+  * tessellations many times; the model manager stores Tessellation.
+  */
+class SMTKCORE_EXPORT CompactTessellation
+{
+public:
+  typedef std::size_t size_type;
+
+  /// The shapes into which cells are grouped.
+  enum CellGroup
+    {
+    VERTICES,        //!< TESS_VERTEX cells.
+    LINES,           //!< TESS_POLYLINE cells with exactly 2 points.
+    TRIANGLES,       //!< TESS_TRIANGLE cells.
+    QUADS,           //!< TESS_QUAD cells.
+    POLYVERTICES,    //!< TESS_POLYVERTEX cells.
+    POLYLINES,       //!< TESS_POLYLINE cells with more than 2 points.
+    POLYGONS,        //!< TESS_POLYGON cells.
+    TRIANGLE_STRIPS, //!< TESS_TRIANGLE_STRIP cells.
+    NUMBER_OF_GROUPS
+    };
+
+  /// How point coordinates should be stored.
+  enum CoordinatePrecision
+    {
+    SINGLE_PRECISION, //!< Store coordinates as floats (half the memory).
+    DOUBLE_PRECISION  //!< Store coordinates as doubles (no loss of precision).
+    };
+
+  /**\brief A non-owning view of a run of point IDs.
+    *
+    * The IDs are stored in either 16- or 32-bit integers
+    * (see CompactTessellation::hasWideIndices()); operator[]
+    * hides the difference while narrow() and wide() expose the
+    * underlying array for callers that specialize their loops.
+    */
+  class IndexSpan
+  {
+  public:
+    IndexSpan()
+      : m_narrow(NULL), m_wide(NULL), m_size(0) { }
+    IndexSpan(const boost::uint16_t* ids, size_type n)
+      : m_narrow(ids), m_wide(NULL), m_size(n) { }
+    IndexSpan(const boost::uint32_t* ids, size_type n)
+      : m_narrow(NULL), m_wide(ids), m_size(n) { }
+
+    size_type size() const
+      { return this->m_size; }
+    bool empty() const
+      { return this->m_size == 0; }
+    boost::uint32_t operator [] (size_type i) const
+      { return this->m_wide ? this->m_wide[i] : this->m_narrow[i]; }
+
+    const boost::uint16_t* narrow() const
+      { return this->m_narrow; }
+    const boost::uint32_t* wide() const
+      { return this->m_wide; }
+
+  protected:
+    const boost::uint16_t* m_narrow;
+    const boost::uint32_t* m_wide;
+    size_type m_size;
+  };
+
+  CompactTessellation();
+  CompactTessellation(const Tessellation& tess, CoordinatePrecision precision = SINGLE_PRECISION);
+
+  bool assign(const Tessellation& tess, CoordinatePrecision precision = SINGLE_PRECISION);
+  void toTessellation(Tessellation& tess) const;
+  void reset();
+
+  size_type numberOfPoints() const;
+  bool hasSinglePrecisionCoords() const;
+  const float* floatCoords() const;
+  const double* doubleCoords() const;
+  void point(size_type i, double xyz[3]) const;
+
+  bool hasWideIndices() const;
+  size_type numberOfCells() const;
+  size_type numberOfCells(CellGroup group) const;
+  IndexSpan cell(CellGroup group, size_type i) const;
+  IndexSpan indices(CellGroup group) const;
+
+  bool hasCellProperties() const;
+  int cellProperties(CellGroup group, size_type i, const int*& propertyIds) const;
+
+  static size_type pointsPerCell(CellGroup group);
+  static int cellTypeOfGroup(CellGroup group);
+
+  std::size_t memoryUsed() const;
+  static std::size_t memoryUsed(const Tessellation& tess);
+
+protected:
+  /// Where the property IDs of a cell that has any are kept.
+  struct CellProperties
+  {
+    boost::uint32_t cell;   // The cell's index within its group.
+    int flags;              // The TESS_PROPERTY_MASK bits of the cell's type.
+    boost::uint32_t offset; // The start of the cell's IDs in m_propertyIds.
+  };
+
+  void appendIndices(CellGroup group, const int* ids, size_type n);
+
+  std::vector<float> m_floatCoords;
+  std::vector<double> m_doubleCoords;
+  bool m_wideIndices;
+  std::vector<boost::uint16_t> m_narrow[NUMBER_OF_GROUPS];
+  std::vector<boost::uint32_t> m_wide[NUMBER_OF_GROUPS];
+  // For groups whose cells have varying numbers of points,
+  // the start of each cell's IDs (plus one past the last cell).
+  std::vector<boost::uint32_t> m_offsets[NUMBER_OF_GROUPS];
+  // Cells with property IDs, in order of their index within each group.
+  std::vector<CellProperties> m_cellProperties[NUMBER_OF_GROUPS];
+  std::vector<int> m_propertyIds;
+};
+
+  } // namespace model
+} // namespace smtk
+
+#endif // __smtk_model_CompactTessellation_h
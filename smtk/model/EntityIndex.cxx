@@ -0,0 +1,273 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/model/EntityIndex.h"
+
+#include "smtk/model/Entity.h"
+#include "smtk/model/EntityRef.h"
+#include "smtk/model/Manager.h"
+
+using namespace smtk::common;
+
+namespace smtk {
+  namespace model {
+
+namespace {
+
+/// Re-index the value of property \a pname on \a uid held in \a store.
+template<typename V>
+void reindexProperty(
+  const UUID& uid, const std::string& pname,
+  EntityKeyIndex<V>& index, const PropertyStore<V>& store)
+{
+  index.update(uid, store.find(uid, pname));
+}
+
+/// Index every entity holding property \a pname in \a store.
+template<typename V>
+void buildPropertyIndex(
+  const std::string& pname, EntityKeyIndex<V>& index, const PropertyStore<V>& store)
+{
+  index.clear();
+  typename PropertyStore<V>::PropertyId pid = store.propertyId(pname);
+  if (pid == PropertyStore<V>::InvalidProperty)
+    return;
+  const typename PropertyStore<V>::Column& col(store.column(pid));
+  typename PropertyStore<V>::RowId numRows =
+    static_cast<typename PropertyStore<V>::RowId>(col.present.size());
+  for (typename PropertyStore<V>::RowId row = 0; row < numRows; ++row)
+    if (col.present[row])
+      index.update(store.rowEntity(row), &col.values[row]);
+}
+
+/// Return the entities with property \a pname equal to \a pval, verifying each against \a store.
+template<typename V>
+UUIDs entitiesWithPropertyValue(
+  const std::string& pname, const V& pval,
+  const std::map<std::string,EntityKeyIndex<V> >& indices,
+  const PropertyStore<V>& store)
+{
+  UUIDs result;
+  typename std::map<std::string,EntityKeyIndex<V> >::const_iterator iit = indices.find(pname);
+  if (iit == indices.end())
+    return result;
+  const UUIDs* matches = iit->second.find(pval);
+  if (!matches)
+    return result;
+  for (UUIDs::const_iterator it = matches->begin(); it != matches->end(); ++it)
+    {
+    const V* current = store.find(*it, pname);
+    if (current && *current == pval)
+      result.insert(result.end(), *it);
+    }
+  return result;
+}
+
+} // namespace
+
+/// Create an index of \a mgr's entities.
+EntityIndex::EntityIndex(Manager* mgr)
+  : m_manager(mgr), m_rebuild(false)
+{
+  this->rebuild();
+}
+
+/// Discard all indexed data and re-index every entity (and registered property) in the manager.
+void EntityIndex::rebuild()
+{
+  this->m_stale.clear();
+  this->m_rebuild = false;
+  this->m_flags.clear();
+  const UUIDsToEntities& topology(this->m_manager->topology());
+  for (UUIDsToEntities::const_iterator it = topology.begin(); it != topology.end(); ++it)
+    {
+    BitFlags flags = it->second.entityFlags();
+    this->m_flags.update(it->first, &flags);
+    }
+
+  std::map<std::string,EntityKeyIndex<FloatList> >::iterator fit;
+  for (fit = this->m_floatIndices.begin(); fit != this->m_floatIndices.end(); ++fit)
+    buildPropertyIndex(fit->first, fit->second, this->m_manager->floatProperties());
+  std::map<std::string,EntityKeyIndex<StringList> >::iterator sit;
+  for (sit = this->m_stringIndices.begin(); sit != this->m_stringIndices.end(); ++sit)
+    buildPropertyIndex(sit->first, sit->second, this->m_manager->stringProperties());
+  std::map<std::string,EntityKeyIndex<IntegerList> >::iterator iit;
+  for (iit = this->m_integerIndices.begin(); iit != this->m_integerIndices.end(); ++iit)
+    buildPropertyIndex(iit->first, iit->second, this->m_manager->integerProperties());
+}
+
+/**\brief Mark \a uid as needing to be re-indexed before the next query.
+  *
+  * The manager calls this whenever it changes an entity record or property.
+  * When more entities are marked than the manager holds, the marks are
+  * discarded and the whole index is rebuilt by the next query instead.
+  */
+void EntityIndex::entityModified(const UUID& uid)
+{
+  if (this->m_rebuild)
+    return;
+  this->m_stale.push_back(uid);
+  if (this->m_stale.size() > this->m_manager->topology().size() + 64)
+    {
+    this->m_stale.clear();
+    this->m_rebuild = true;
+    }
+}
+
+/**\brief Index the values of the named property so entities may be found by value.
+  *
+  * Returns true if the property was newly registered and false if it was
+  * already indexed (or \a ptype is invalid).
+  */
+bool EntityIndex::indexProperty(PropertyType ptype, const std::string& pname)
+{
+  switch (ptype)
+    {
+  case FLOAT_PROPERTY:
+    if (this->m_floatIndices.find(pname) != this->m_floatIndices.end())
+      return false;
+    buildPropertyIndex(pname, this->m_floatIndices[pname], this->m_manager->floatProperties());
+    return true;
+  case STRING_PROPERTY:
+    if (this->m_stringIndices.find(pname) != this->m_stringIndices.end())
+      return false;
+    buildPropertyIndex(pname, this->m_stringIndices[pname], this->m_manager->stringProperties());
+    return true;
+  case INTEGER_PROPERTY:
+    if (this->m_integerIndices.find(pname) != this->m_integerIndices.end())
+      return false;
+    buildPropertyIndex(pname, this->m_integerIndices[pname], this->m_manager->integerProperties());
+    return true;
+  default:
+    break;
+    }
+  return false;
+}
+
+/// Return true when values of the named property are indexed.
+bool EntityIndex::isPropertyIndexed(PropertyType ptype, const std::string& pname) const
+{
+  switch (ptype)
+    {
+  case FLOAT_PROPERTY: return this->m_floatIndices.find(pname) != this->m_floatIndices.end();
+  case STRING_PROPERTY: return this->m_stringIndices.find(pname) != this->m_stringIndices.end();
+  case INTEGER_PROPERTY: return this->m_integerIndices.find(pname) != this->m_integerIndices.end();
+  default: break;
+    }
+  return false;
+}
+
+/// Return entities whose flags match \a mask, using the same rules as Manager::entitiesMatchingFlags().
+UUIDs EntityIndex::entitiesMatchingFlags(BitFlags mask, bool exactMatch)
+{
+  this->update();
+  UUIDs result;
+  const UUIDsToEntities& topology(this->m_manager->topology());
+  EntityKeyIndex<BitFlags>::Buckets::const_iterator bit;
+  for (bit = this->m_flags.buckets().begin(); bit != this->m_flags.buckets().end(); ++bit)
+    {
+    BitFlags masked = bit->first & mask;
+    if ((masked && mask == ANY_ENTITY) ||
+      (!exactMatch && masked) ||
+      (exactMatch && masked == mask))
+      {
+      for (UUIDs::const_iterator it = bit->second.begin(); it != bit->second.end(); ++it)
+        {
+        // Entities may be removed without notification (e.g., by Manager::unarrangeEntity).
+        if (topology.find(*it) != topology.end())
+          result.insert(result.end(), *it);
+        }
+      }
+    }
+  return result;
+}
+
+/// Return entities of dimension \a dim, using the same rules as Manager::entitiesOfDimension().
+UUIDs EntityIndex::entitiesOfDimension(int dim)
+{
+  this->update();
+  UUIDs result;
+  const UUIDsToEntities& topology(this->m_manager->topology());
+  EntityKeyIndex<BitFlags>::Buckets::const_iterator bit;
+  for (bit = this->m_flags.buckets().begin(); bit != this->m_flags.buckets().end(); ++bit)
+    {
+    if (Entity(bit->first, -1).dimension() == dim)
+      {
+      for (UUIDs::const_iterator it = bit->second.begin(); it != bit->second.end(); ++it)
+        {
+        if (topology.find(*it) != topology.end())
+          result.insert(result.end(), *it);
+        }
+      }
+    }
+  return result;
+}
+
+/// Return entities whose indexed property \a pname is exactly \a pval.
+UUIDs EntityIndex::entitiesWithProperty(const std::string& pname, const FloatList& pval)
+{
+  this->update();
+  return entitiesWithPropertyValue(pname, pval, this->m_floatIndices, this->m_manager->floatProperties());
+}
+
+/// Return entities whose indexed property \a pname is exactly \a pval.
+UUIDs EntityIndex::entitiesWithProperty(const std::string& pname, const StringList& pval)
+{
+  this->update();
+  return entitiesWithPropertyValue(pname, pval, this->m_stringIndices, this->m_manager->stringProperties());
+}
+
+/// Return entities whose indexed property \a pname is exactly \a pval.
+UUIDs EntityIndex::entitiesWithProperty(const std::string& pname, const IntegerList& pval)
+{
+  this->update();
+  return entitiesWithPropertyValue(pname, pval, this->m_integerIndices, this->m_manager->integerProperties());
+}
+
+/// Re-index every entity marked stale since the last query.
+void EntityIndex::update()
+{
+  if (this->m_rebuild)
+    {
+    this->rebuild();
+    return;
+    }
+  std::vector<UUID> stale;
+  stale.swap(this->m_stale);
+  for (std::vector<UUID>::const_iterator it = stale.begin(); it != stale.end(); ++it)
+    this->reindex(*it);
+}
+
+/// Re-index the type flags and registered properties of \a uid.
+void EntityIndex::reindex(const UUID& uid)
+{
+  const Entity* ent = this->m_manager->findEntity(uid, false);
+  if (ent)
+    {
+    BitFlags flags = ent->entityFlags();
+    this->m_flags.update(uid, &flags);
+    }
+  else
+    {
+    this->m_flags.update(uid, NULL);
+    }
+
+  std::map<std::string,EntityKeyIndex<FloatList> >::iterator fit;
+  for (fit = this->m_floatIndices.begin(); fit != this->m_floatIndices.end(); ++fit)
+    reindexProperty(uid, fit->first, fit->second, this->m_manager->floatProperties());
+  std::map<std::string,EntityKeyIndex<StringList> >::iterator sit;
+  for (sit = this->m_stringIndices.begin(); sit != this->m_stringIndices.end(); ++sit)
+    reindexProperty(uid, sit->first, sit->second, this->m_manager->stringProperties());
+  std::map<std::string,EntityKeyIndex<IntegerList> >::iterator iit;
+  for (iit = this->m_integerIndices.begin(); iit != this->m_integerIndices.end(); ++iit)
+    reindexProperty(uid, iit->first, iit->second, this->m_manager->integerProperties());
+}
+
+  } // namespace model
+} // namespace smtk
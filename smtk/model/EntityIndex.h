@@ -0,0 +1,151 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_model_EntityIndex_h
+#define __smtk_model_EntityIndex_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/PublicPointerDefs.h"
+
+#include "smtk/common/UUID.h"
+#include "smtk/common/UUIDHashMap.h"
+
+#include "smtk/model/EntityTypeBits.h"
+#include "smtk/model/FloatData.h"
+#include "smtk/model/IntegerData.h"
+#include "smtk/model/PropertyType.h"
+#include "smtk/model/StringData.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace smtk {
+  namespace model {
+
+/**\brief Map each indexed entity to a single key and each key to its entities.
+  *
+  * This is used by EntityIndex both for entity type flags and for the
+  * values of registered properties.
+  */
+template<typename K>
+class EntityKeyIndex
+{
+public:
+  typedef std::map<K,smtk::common::UUIDs> Buckets;
+
+  /// Move \a uid into the bucket for \a key (or out of the index when \a key is NULL).
+  void update(const smtk::common::UUID& uid, const K* key)
+    {
+    typename EntityBuckets::iterator eit = this->m_entities.find(uid);
+    if (eit != this->m_entities.end())
+      {
+      if (key && eit->second->first == *key)
+        return;
+      eit->second->second.erase(uid);
+      if (eit->second->second.empty())
+        this->m_buckets.erase(eit->second);
+      if (!key)
+        {
+        this->m_entities.erase(eit);
+        return;
+        }
+      }
+    else if (!key)
+      {
+      return;
+      }
+    typename Buckets::iterator bit = this->m_buckets.insert(
+      std::make_pair(*key, smtk::common::UUIDs())).first;
+    bit->second.insert(uid);
+    this->m_entities[uid] = bit;
+    }
+
+  void clear()
+    {
+    this->m_buckets.clear();
+    this->m_entities.clear();
+    }
+
+  const Buckets& buckets() const { return this->m_buckets; }
+
+  /// Return the entities whose key is \a key (or NULL if there are none).
+  const smtk::common::UUIDs* find(const K& key) const
+    {
+    typename Buckets::const_iterator bit = this->m_buckets.find(key);
+    return bit == this->m_buckets.end() ? NULL : &bit->second;
+    }
+
+protected:
+  typedef smtk::common::UUIDHashMap<typename Buckets::iterator> EntityBuckets;
+
+  Buckets m_buckets;
+  EntityBuckets m_entities;
+};
+
+/**\brief Optional secondary indexes over the entities and properties of a Manager.
+  *
+  * An EntityIndex holds entities bucketed by their exact type flags
+  * (which include dimension bits) so that Manager::entitiesMatchingFlags()
+  * and Manager::entitiesOfDimension() only visit distinct flag values
+  * and matching entities rather than the whole model.
+  * It may also hold, for each property name registered with
+  * indexProperty(), a map from property values to entities so that
+  * Manager::findEntitiesByPropertyAs() is proportional to the size
+  * of its result.
+  *
+  * The index is told by its manager (see Manager::entityModified()) when
+  * entity records or properties change.
+  * Entities named this way are marked as stale and re-indexed the next
+  * time a query is made, so notifications made before a change is
+  * complete (such as those made before erasure) are handled properly.
+  * Query results are verified against the manager before being returned.
+  *
+  * Property values modified in place (via references returned by
+  * Manager::floatProperty() or views returned by EntityRef::floatProperties()
+  * and friends) are re-indexed as long as the modification is complete
+  * before the next query.
+  *
+  * Instances are owned by a Manager; see Manager::enableEntityIndex().
+  */
+class SMTKCORE_EXPORT EntityIndex
+{
+public:
+  EntityIndex(Manager* mgr);
+
+  void rebuild();
+  void entityModified(const smtk::common::UUID& uid);
+
+  bool indexProperty(PropertyType ptype, const std::string& pname);
+  bool isPropertyIndexed(PropertyType ptype, const std::string& pname) const;
+
+  smtk::common::UUIDs entitiesMatchingFlags(BitFlags mask, bool exactMatch);
+  smtk::common::UUIDs entitiesOfDimension(int dim);
+
+  smtk::common::UUIDs entitiesWithProperty(const std::string& pname, const FloatList& pval);
+  smtk::common::UUIDs entitiesWithProperty(const std::string& pname, const StringList& pval);
+  smtk::common::UUIDs entitiesWithProperty(const std::string& pname, const IntegerList& pval);
+
+protected:
+  void update();
+  void reindex(const smtk::common::UUID& uid);
+
+  Manager* m_manager;
+  EntityKeyIndex<BitFlags> m_flags;
+  std::map<std::string,EntityKeyIndex<FloatList> > m_floatIndices;
+  std::map<std::string,EntityKeyIndex<StringList> > m_stringIndices;
+  std::map<std::string,EntityKeyIndex<IntegerList> > m_integerIndices;
+  std::vector<smtk::common::UUID> m_stale;
+  bool m_rebuild;
+};
+
+  } // namespace model
+} // namespace smtk
+
+#endif // __smtk_model_EntityIndex_h
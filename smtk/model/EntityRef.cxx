@@ -132,6 +132,7 @@ void EntityRef::setDimensionBits(BitFlags dimBits)
       {
       BitFlags old = entRec->entityFlags() & ~ANY_DIMENSION;
       entRec->setEntityFlags(old | dimBits);
+      mgr->entityModified(this->m_entity);
       }
     }
 }
@@ -507,7 +508,10 @@ EntityRef& EntityRef::addRawRelation(const EntityRef& ent)
     {
     Entity* entRec = mgr->findEntity(this->m_entity);
     if (entRec)
+      {
       entRec->appendRelation(ent.entity());
+      mgr->entityModified(this->m_entity);
+      }
     }
   return *this;
 }
@@ -537,7 +541,10 @@ EntityRef& EntityRef::findOrAddRawRelation(const EntityRef& ent)
         entRec->relations().end(),
         ent.entity())
       == entRec->relations().end())
+      {
       entRec->appendRelation(ent.entity());
+      mgr->entityModified(this->m_entity);
+      }
     }
   return *this;
 }
@@ -773,8 +780,8 @@ std::set<std::string> EntityRef::floatPropertyNames() const
   std::set<std::string> pnames;
   if (this->hasFloatProperties())
     {
-    const FloatData& props(this->floatProperties());
-    for (FloatData::const_iterator it = props.begin(); it != props.end(); ++it)
+    ConstFloatProperties props(this->floatProperties());
+    for (ConstFloatProperties::iterator it = props.begin(); it != props.end(); ++it)
       {
       pnames.insert(it->first);
       }
@@ -782,16 +789,22 @@ std::set<std::string> EntityRef::floatPropertyNames() const
   return pnames;
 }
 
-FloatData& EntityRef::floatProperties()
+/**\brief Return a view of all the floating-point properties of this entity.
+  *
+  * The view is empty (but may still be assigned to) when the entity
+  * has no floating-point properties.
+  */
+FloatProperties EntityRef::floatProperties()
 {
   ManagerPtr mgr = this->m_manager.lock();
-  return mgr->floatProperties().find(this->m_entity)->second;
+  mgr->entityModified(this->m_entity); // the view may be used to modify properties
+  return mgr->floatProperties()[this->m_entity];
 }
 
-FloatData const& EntityRef::floatProperties() const
+ConstFloatProperties EntityRef::floatProperties() const
 {
   ManagerPtr mgr = this->m_manager.lock();
-  return mgr->floatProperties().find(this->m_entity)->second;
+  return mgr->floatProperties()[this->m_entity];
 }
 
 
@@ -865,8 +878,8 @@ std::set<std::string> EntityRef::stringPropertyNames() const
   std::set<std::string> pnames;
   if (this->hasStringProperties())
     {
-    const StringData& props(this->stringProperties());
-    for (StringData::const_iterator it = props.begin(); it != props.end(); ++it)
+    ConstStringProperties props(this->stringProperties());
+    for (ConstStringProperties::iterator it = props.begin(); it != props.end(); ++it)
       {
       pnames.insert(it->first);
       }
@@ -874,16 +887,22 @@ std::set<std::string> EntityRef::stringPropertyNames() const
   return pnames;
 }
 
-StringData& EntityRef::stringProperties()
+/**\brief Return a view of all the string properties of this entity.
+  *
+  * The view is empty (but may still be assigned to) when the entity
+  * has no string properties.
+  */
+StringProperties EntityRef::stringProperties()
 {
   ManagerPtr mgr = this->m_manager.lock();
-  return mgr->stringProperties().find(this->m_entity)->second;
+  mgr->entityModified(this->m_entity); // the view may be used to modify properties
+  return mgr->stringProperties()[this->m_entity];
 }
 
-StringData const& EntityRef::stringProperties() const
+ConstStringProperties EntityRef::stringProperties() const
 {
   ManagerPtr mgr = this->m_manager.lock();
-  return mgr->stringProperties().find(this->m_entity)->second;
+  return mgr->stringProperties()[this->m_entity];
 }
 
 
@@ -957,8 +976,8 @@ std::set<std::string> EntityRef::integerPropertyNames() const
   std::set<std::string> pnames;
   if (this->hasIntegerProperties())
     {
-    const IntegerData& props(this->integerProperties());
-    for (IntegerData::const_iterator it = props.begin(); it != props.end(); ++it)
+    ConstIntegerProperties props(this->integerProperties());
+    for (ConstIntegerProperties::iterator it = props.begin(); it != props.end(); ++it)
       {
       pnames.insert(it->first);
       }
@@ -966,16 +985,22 @@ std::set<std::string> EntityRef::integerPropertyNames() const
   return pnames;
 }
 
-IntegerData& EntityRef::integerProperties()
+/**\brief Return a view of all the integer properties of this entity.
+  *
+  * The view is empty (but may still be assigned to) when the entity
+  * has no integer properties.
+  */
+IntegerProperties EntityRef::integerProperties()
 {
   ManagerPtr mgr = this->m_manager.lock();
-  return mgr->integerProperties().find(this->m_entity)->second;
+  mgr->entityModified(this->m_entity); // the view may be used to modify properties
+  return mgr->integerProperties()[this->m_entity];
 }
 
-IntegerData const& EntityRef::integerProperties() const
+ConstIntegerProperties EntityRef::integerProperties() const
 {
   ManagerPtr mgr = this->m_manager.lock();
-  return mgr->integerProperties().find(this->m_entity)->second;
+  return mgr->integerProperties()[this->m_entity];
 }
 
 /// Return the number of arrangements of the given kind \a k.
@@ -1190,67 +1215,49 @@ std::size_t entityrefHash(const EntityRef& c)
  */
 
 /*! \fn EntityRef::properties<T>()
- *  \brief Return a pointer to the properties of the entity, creating an entry as required.
+ *  \brief Return a view of the properties of the entity, creating entries as required.
  *
- * Unlike the hasProperties() method, this will return a valid pointer as long as the
+ * Unlike the hasProperties() method, this will return a view with a valid store as long as the
  * manager and entity of the entityref are valid.
- * If the entity does not already have any properties of the given type, a new
- * StringData, FloatData, or IntegerData instance is created and added to the
- * appropriate map.
+ * If the entity does not already have any properties of the given type, the
+ * view is empty; assigning a value through it adds the entity to the
+ * appropriate property store.
  *
  * This templated version exists for use in functions where the
  * property type is a template parameter.
  */
 template<>
 SMTKCORE_EXPORT
-StringData* EntityRef::properties<StringData>()
+StringProperties EntityRef::properties<StringData>()
 {
-  if (!this->hasStringProperties())
-    {
-    if (!this->manager() || !this->entity())
-      return NULL;
-    StringData blank;
-    this->manager()->stringProperties().insert(
-      std::pair<UUID,StringData>(this->entity(), blank));
-    }
-  return &(this->stringProperties());
+  if (!this->manager() || !this->entity())
+    return StringProperties();
+  return this->stringProperties();
 }
 
 template<>
 SMTKCORE_EXPORT
-FloatData* EntityRef::properties<FloatData>()
+FloatProperties EntityRef::properties<FloatData>()
 {
-  if (!this->hasFloatProperties())
-    {
-    if (!this->manager() || !this->entity())
-      return NULL;
-    FloatData blank;
-    this->manager()->floatProperties().insert(
-      std::pair<UUID,FloatData>(this->entity(), blank));
-    }
-  return &(this->floatProperties());
+  if (!this->manager() || !this->entity())
+    return FloatProperties();
+  return this->floatProperties();
 }
 
 template<>
 SMTKCORE_EXPORT
-IntegerData* EntityRef::properties<IntegerData>()
+IntegerProperties EntityRef::properties<IntegerData>()
 {
-  if (!this->hasIntegerProperties())
-    {
-    if (!this->manager() || !this->entity())
-      return NULL;
-    IntegerData blank;
-    this->manager()->integerProperties().insert(
-      std::pair<UUID,IntegerData>(this->entity(), blank));
-    }
-  return &(this->integerProperties());
+  if (!this->manager() || !this->entity())
+    return IntegerProperties();
+  return this->integerProperties();
 }
 
 /*! \fn EntityRef::hasProperties<T>() const
  *! \fn EntityRef::hasProperties<T>()
- *  \brief Return a pointer to the properties of the entity or null if none exist.
+ *  \brief Return a view of the properties of the entity or an invalid view if none exist.
  *
- * Unlike the properties() method, this will return a NULL pointer
+ * Unlike the properties() method, this will return a view with no store
  * if the entity does not already have any properties of the given type.
  *
  * This templated version exists for use in functions where the
@@ -1258,56 +1265,56 @@ IntegerData* EntityRef::properties<IntegerData>()
  */
 template<>
 SMTKCORE_EXPORT
-StringData* EntityRef::hasProperties<StringData>()
+StringProperties EntityRef::hasProperties<StringData>()
 {
   if (this->hasStringProperties())
-    return &(this->stringProperties());
-  return NULL;
+    return this->stringProperties();
+  return StringProperties();
 }
 
 template<>
 SMTKCORE_EXPORT
-const StringData* EntityRef::hasProperties<StringData>() const
+ConstStringProperties EntityRef::hasProperties<StringData>() const
 {
   if (this->hasStringProperties())
-    return &(this->stringProperties());
-  return NULL;
+    return this->stringProperties();
+  return ConstStringProperties();
 }
 
 template<>
 SMTKCORE_EXPORT
-FloatData* EntityRef::hasProperties<FloatData>()
+FloatProperties EntityRef::hasProperties<FloatData>()
 {
   if (this->hasFloatProperties())
-    return &(this->floatProperties());
-  return NULL;
+    return this->floatProperties();
+  return FloatProperties();
 }
 
 template<>
 SMTKCORE_EXPORT
-const FloatData* EntityRef::hasProperties<FloatData>() const
+ConstFloatProperties EntityRef::hasProperties<FloatData>() const
 {
   if (this->hasFloatProperties())
-    return &(this->floatProperties());
-  return NULL;
+    return this->floatProperties();
+  return ConstFloatProperties();
 }
 
 template<>
 SMTKCORE_EXPORT
-IntegerData* EntityRef::hasProperties<IntegerData>()
+IntegerProperties EntityRef::hasProperties<IntegerData>()
 {
   if (this->hasIntegerProperties())
-    return &(this->integerProperties());
-  return NULL;
+    return this->integerProperties();
+  return IntegerProperties();
 }
 
 template<>
 SMTKCORE_EXPORT
-const IntegerData* EntityRef::hasProperties<IntegerData>() const
+ConstIntegerProperties EntityRef::hasProperties<IntegerData>() const
 {
   if (this->hasIntegerProperties())
-    return &(this->integerProperties());
-  return NULL;
+    return this->integerProperties();
+  return ConstIntegerProperties();
 }
 
 /*! \fn EntityRef::removeProperty<T>(const std::string& name)
@@ -184,9 +184,9 @@ public:
 
 #ifndef SHIBOKEN_SKIP
   // For T = {IntegerData, FloatData, StringData}:
-  template<typename T> T* properties();
-  template<typename T> T* hasProperties();
-  template<typename T> const T* hasProperties() const;
+  template<typename T> typename PropertyStore<typename T::mapped_type>::Row properties();
+  template<typename T> typename PropertyStore<typename T::mapped_type>::Row hasProperties();
+  template<typename T> typename PropertyStore<typename T::mapped_type>::ConstRow hasProperties() const;
   template<typename T> bool removeProperty(const std::string& name);
 #endif // SHIBOKEN_SKIP
 
@@ -198,8 +198,8 @@ public:
   bool removeFloatProperty(const std::string& propName);
   bool hasFloatProperties() const;
   std::set<std::string> floatPropertyNames() const;
-  FloatData& floatProperties();
-  FloatData const& floatProperties() const;
+  FloatProperties floatProperties();
+  ConstFloatProperties floatProperties() const;
 
   void setStringProperty(const std::string& propName, const smtk::model::String& propValue);
   void setStringProperty(const std::string& propName, const smtk::model::StringList& propValue);
@@ -209,8 +209,8 @@ public:
   bool removeStringProperty(const std::string& propName);
   bool hasStringProperties() const;
   std::set<std::string> stringPropertyNames() const;
-  StringData& stringProperties();
-  StringData const& stringProperties() const;
+  StringProperties stringProperties();
+  ConstStringProperties stringProperties() const;
 
   void setIntegerProperty(const std::string& propName, smtk::model::Integer propValue);
   void setIntegerProperty(const std::string& propName, const smtk::model::IntegerList& propValue);
@@ -220,8 +220,8 @@ public:
   bool removeIntegerProperty(const std::string& propName);
   bool hasIntegerProperties() const;
   std::set<std::string> integerPropertyNames() const;
-  IntegerData& integerProperties();
-  IntegerData const& integerProperties() const;
+  IntegerProperties integerProperties();
+  ConstIntegerProperties integerProperties() const;
 
   int numberOfArrangementsOfKind(ArrangementKind k) const;
   Arrangement* findArrangement(ArrangementKind k, int index);
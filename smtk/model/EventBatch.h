@@ -0,0 +1,53 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_model_EventBatch_h
+#define __smtk_model_EventBatch_h
+
+#include "smtk/model/Manager.h"
+
+namespace smtk {
+  namespace model {
+
+/**\brief Collect a manager's events for batched observers for the lifetime of this object.
+  *
+  * Construct one on the stack around code that modifies a model heavily;
+  * observers registered with Manager::observeBatched() are notified once,
+  * with deduplicated arrays of entities, when it goes out of scope.
+  * A null manager is ignored.
+  *
+  * \sa Manager::beginEventBatch()
+  */
+class EventBatch
+{
+public:
+  EventBatch(ManagerPtr mgr)
+    : m_manager(mgr)
+    {
+    if (this->m_manager)
+      this->m_manager->beginEventBatch();
+    }
+  ~EventBatch()
+    {
+    if (this->m_manager)
+      this->m_manager->endEventBatch();
+    }
+
+protected:
+  ManagerPtr m_manager;
+
+private:
+  EventBatch(const EventBatch&); // Not implemented.
+  void operator = (const EventBatch&); // Not implemented.
+};
+
+  } // namespace model
+} // namespace smtk
+
+#endif // __smtk_model_EventBatch_h
@@ -70,6 +70,10 @@ enum ManagerEventChangeType
   * Likewise CELL_INCLUDES_CELL will always provide the higher-dimensional
   * parent cell before the lower-dimensional, embedded child cell.
   *
+  * Entities added in bulk by Manager::insertEntities() are also reported
+  * with a single ENTITY_ENTRY event to OneToManyCallback observers; the
+  * source entity is invalid and the new entities are the related entities.
+  *
   * @sa ManagerEventChangeType
   */
 enum ManagerEventRelationType
@@ -133,7 +137,11 @@ typedef std::pair<OneToOneCallback,void*> OneToOneObserver;
 /// A trigger entry for an event-observer pair.
 typedef std::pair<ManagerEventType,OneToOneObserver> OneToOneTrigger;
 
-/// Callbacks for one-to-many relationships between entities. WARNING: Likely to change in future releases.
+/**\brief Callbacks for one-to-many relationships between entities. WARNING: Likely to change in future releases.
+  *
+  * Observers registered with Manager::observeBatched() also use this
+  * signature to receive deduplicated events of any kind in bulk.
+  */
 typedef int (*OneToManyCallback)(
   ManagerEventType, const smtk::model::EntityRef&, const smtk::model::EntityRefArray&, void*);
 /// An observer of a one-to-many relationship-event.
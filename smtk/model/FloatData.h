@@ -10,9 +10,11 @@
 #ifndef __smtk_model_FloatData_h
 #define __smtk_model_FloatData_h
 
+#include "smtk/Options.h" // for SMTK_HASH_STORAGE
 #include "smtk/SystemConfig.h"
 
 #include "smtk/common/UUID.h"
+#include "smtk/model/PropertyStore.h"
 
 #ifdef SMTK_HASH_STORAGE
 #  if defined(_MSC_VER) // Visual studio
@@ -37,11 +39,12 @@ namespace smtk {
     typedef std::vector<Float> FloatList;
 #ifdef SMTK_HASH_STORAGE
     typedef google::sparse_hash_map<std::string,FloatList> FloatData;
-    typedef google::sparse_hash_map<smtk::common::UUID,FloatData> UUIDsToFloatData;
 #else // SMTK_HASH_STORAGE
     typedef std::map<std::string,FloatList> FloatData;
-    typedef std::map<smtk::common::UUID,FloatData> UUIDsToFloatData;
 #endif // SMTK_HASH_STORAGE
+    typedef PropertyStore<FloatList> UUIDsToFloatData;
+    typedef UUIDsToFloatData::Row FloatProperties;
+    typedef UUIDsToFloatData::ConstRow ConstFloatProperties;
 
     typedef UUIDsToFloatData::iterator UUIDWithFloatProperties;
     typedef FloatData::iterator PropertyNameWithFloats;
@@ -10,9 +10,11 @@
 #ifndef __smtk_model_IntegerData_h
 #define __smtk_model_IntegerData_h
 
+#include "smtk/Options.h" // for SMTK_HASH_STORAGE
 #include "smtk/SystemConfig.h"
 
 #include "smtk/common/UUID.h"
+#include "smtk/model/PropertyStore.h"
 
 #ifdef SMTK_HASH_STORAGE
 #  if defined(_MSC_VER) // Visual studio
@@ -37,11 +39,12 @@ namespace smtk {
     typedef std::vector<long> IntegerList;
 #ifdef SMTK_HASH_STORAGE
     typedef google::sparse_hash_map<std::string,IntegerList> IntegerData;
-    typedef google::sparse_hash_map<smtk::common::UUID,IntegerData> UUIDsToIntegerData;
 #else // SMTK_HASH_STORAGE
     typedef std::map<std::string,IntegerList> IntegerData;
-    typedef std::map<smtk::common::UUID,IntegerData> UUIDsToIntegerData;
 #endif // SMTK_HASH_STORAGE
+    typedef PropertyStore<IntegerList> UUIDsToIntegerData;
+    typedef UUIDsToIntegerData::Row IntegerProperties;
+    typedef UUIDsToIntegerData::ConstRow ConstIntegerProperties;
 
     typedef UUIDsToIntegerData::iterator UUIDWithIntegerProperties;
     typedef IntegerData::iterator PropertyNameWithIntegers;
@@ -46,6 +46,20 @@
 using namespace std;
 using namespace smtk::common;
 
+namespace {
+
+// Return true when any observer in \a triggers is registered for \a event.
+template<typename Trigger>
+bool hasObserversOf(const std::set<Trigger>& triggers, const smtk::model::ManagerEventType& event)
+{
+  typedef typename Trigger::second_type Observer;
+  typename std::set<Trigger>::const_iterator it = triggers.lower_bound(
+    Trigger(event, Observer(typename Observer::first_type(), static_cast<void*>(NULL))));
+  return it != triggers.end() && it->first == event;
+}
+
+} // namespace
+
 namespace smtk {
   namespace model {
 
@@ -66,7 +80,10 @@ Manager::Manager() :
   m_meshes( smtk::mesh::Manager::create() ),
   m_attributeAssignments(new UUIDsToAttributeAssignments),
   m_sessions(new UUIDsToSessions),
-  m_globalCounters(2,1) // first entry is session counter, second is model counter
+  m_globalCounters(2,1), // first entry is session counter, second is model counter
+  m_eventBatchDepth(0),
+  m_snapshotEpoch(0),
+  m_snapshotStale(false)
 {
   // TODO: throw() when topology == NULL?
 }
@@ -90,7 +107,10 @@ Manager::Manager(
     m_meshes( meshes ),
     m_attributeAssignments(attribs),
     m_sessions(new UUIDsToSessions),
-    m_globalCounters(2,1) // first entry is session counter, second is model counter
+    m_globalCounters(2,1), // first entry is session counter, second is model counter
+    m_eventBatchDepth(0),
+    m_snapshotEpoch(0),
+    m_snapshotStale(false)
 {
 }
 
@@ -285,6 +305,8 @@ SessionInfoBits Manager::erase(const UUID& uid, SessionInfoBits flags)
     this->m_topology->erase(uid);
     }
 
+  this->entityModified(uid);
+
   return actual;
 }
 
@@ -353,6 +375,134 @@ UUID Manager::unusedUUID()
   return actual;
 }
 
+/**\brief Return \a count currently-unused UUIDs.
+  *
+  * UUIDs are generated in a single batch. Each is checked against
+  * existing entities; a collision among the returned UUIDs themselves
+  * is no more likely than between any two random UUIDs.
+  */
+UUIDArray Manager::unusedUUIDs(std::size_t count)
+{
+  UUIDArray result;
+  result.reserve(count);
+  this->m_uuidGenerator.random(count, result);
+  for (UUIDArray::iterator it = result.begin(); it != result.end(); ++it)
+    {
+    while (this->m_topology->find(*it) != this->m_topology->end())
+      {
+      *it = this->m_uuidGenerator.random();
+      }
+    }
+  return result;
+}
+
+/**\brief Prepare to insert \a count more entities.
+  *
+  * When entity storage is hashed, this allocates space so that
+  * many insertions do not repeatedly grow the table.
+  * It has no effect when entities are held in an ordered map.
+  */
+void Manager::reserveEntities(std::size_t count)
+{
+#if defined(SMTK_HASH_STORAGE)
+  this->m_topology->resize(this->m_topology->size() + count);
+#elif defined(SMTK_DENSE_HASH_STORAGE)
+  this->m_topology->reserve(this->m_topology->size() + count);
+#else
+  (void)count;
+#endif
+}
+
+/**\brief Insert many entity \a records (and, optionally, their \a arrangements) in one pass.
+  *
+  * This is intended for sessions that transcribe many entities at once.
+  * Obtain \a uids with unusedUUIDs() first so that \a records may refer
+  * to each other in their relations; both vectors must be the same length.
+  * If \a arrangements is not empty, it must also be the same length and
+  * holds the arrangements of each record.
+  *
+  * Unlike setEntity(), records are transcribed as-is: the caller is
+  * expected to provide relations in both directions (as arrangements
+  * index into each entity's relations). Default arrangements
+  * (such as the HAS_USE placeholders of faces) are still added to
+  * records whose arrangements do not include them.
+  *
+  * Rather than one event per entity, a single (ADD_EVENT, ENTITY_ENTRY)
+  * event is sent to one-to-many observers with an invalid source and
+  * all the new entities as related entities. Per-entity events are still
+  * sent to condition observers of ENTITY_ENTRY when any are registered.
+  *
+  * A nil or existing UUID, a UUID that appears more than once in \a uids,
+  * or mismatched input lengths is an error;
+  * an exception is thrown before any record is inserted.
+  */
+void Manager::insertEntities(
+  const UUIDArray& uids,
+  const std::vector<Entity>& records,
+  const std::vector<KindsToArrangements>& arrangements)
+{
+  if (uids.size() != records.size() ||
+    (!arrangements.empty() && arrangements.size() != records.size()))
+    {
+    std::ostringstream msg;
+    msg << "Mismatched batch: " << uids.size() << " UUIDs, " << records.size() << " records, "
+      << arrangements.size() << " arrangements";
+    throw msg.str();
+    }
+  UUIDArray::const_iterator uit;
+  for (uit = uids.begin(); uit != uids.end(); ++uit)
+    {
+    if (uit->isNull() || this->m_topology->find(*uit) != this->m_topology->end())
+      {
+      std::ostringstream msg;
+      msg << (uit->isNull() ? "Nil" : "Duplicate") << " UUID '" << *uit << "' in batch";
+      throw msg.str();
+      }
+    }
+  UUIDArray sorted(uids);
+  std::sort(sorted.begin(), sorted.end());
+  UUIDArray::const_iterator dup = std::adjacent_find(sorted.begin(), sorted.end());
+  if (dup != sorted.end())
+    {
+    std::ostringstream msg;
+    msg << "Duplicate UUID '" << *dup << "' in batch";
+    throw msg.str();
+    }
+
+  this->reserveEntities(uids.size());
+  std::vector<Entity>::const_iterator rit = records.begin();
+  std::size_t ii = 0;
+  for (uit = uids.begin(); uit != uids.end(); ++uit, ++rit, ++ii)
+    {
+    if (!arrangements.empty() && !arrangements[ii].empty())
+      (*this->m_arrangements)[*uit] = arrangements[ii];
+    std::pair<UUID,Entity> entry(*uit, *rit);
+    this->prepareForEntity(entry);
+    this->m_topology->insert(entry);
+    this->entityModified(*uit);
+    }
+
+  ManagerEventType event = std::make_pair(ADD_EVENT, ENTITY_ENTRY);
+  bool perEntity = hasObserversOf(this->m_conditionTriggers, event);
+  bool coalesced =
+    hasObserversOf(this->m_oneToManyTriggers, event) ||
+    hasObserversOf(this->m_batchedTriggers, event);
+  if (perEntity || coalesced)
+    {
+    ManagerPtr self = shared_from_this();
+    EntityRefArray added;
+    added.reserve(uids.size());
+    for (uit = uids.begin(); uit != uids.end(); ++uit)
+      {
+      added.push_back(EntityRef(self, *uit));
+      if (perEntity)
+        this->trigger(event, added.back());
+      }
+    if (coalesced)
+      this->trigger(event, EntityRef(self, UUID::null()), added);
+    }
+}
+
 /// Insert a new cell of the specified \a dimension, returning an iterator with a new, unique UUID.
 Manager::iter_type Manager::insertEntityOfTypeAndDimension(BitFlags entityFlags, int dim)
 {
@@ -406,6 +556,7 @@ Manager::iter_type Manager::setEntityOfTypeAndDimension(const UUID& uid, BitFlag
 
   if (result.second)
     {
+    this->entityModified(uid);
     this->trigger(std::make_pair(ADD_EVENT, ENTITY_ENTRY),
       EntityRef(this->shared_from_this(), uid));
     }
@@ -437,12 +588,14 @@ Manager::iter_type Manager::setEntity(const UUID& uid, Entity& c)
     this->removeEntityReferences(it);
     it->second = c;
     this->insertEntityReferences(it);
+    this->entityModified(uid);
     return it;
     }
   std::pair<UUID,Entity> entry(uid,c);
   this->prepareForEntity(entry);
   it = this->m_topology->insert(entry).first;
   this->insertEntityReferences(it);
+  this->entityModified(uid);
   return it;
 }
 
@@ -652,9 +805,17 @@ UUIDs Manager::boundaryEntities(const UUIDs& ofEntities, int ofDimension) const
   * regardless of their dimension.
   */
 UUIDs Manager::lowerDimensionalBoundaries(const UUID& ofEntity, int lowerDimension)
+{
+  if (this->m_adjacency)
+    return this->m_adjacency->lowerDimensionalBoundaries(ofEntity, lowerDimension);
+  return this->computeLowerDimensionalBoundaries(ofEntity, lowerDimension);
+}
+
+/// Walk entity relations to find lower-dimensional boundaries (without consulting any cache).
+UUIDs Manager::computeLowerDimensionalBoundaries(const UUID& ofEntity, int lowerDimension) const
 {
   UUIDs result;
-  UUIDsToEntities::iterator it = this->m_topology->find(ofEntity);
+  UUIDsToEntities::const_iterator it = this->m_topology->find(ofEntity);
   if (it == this->m_topology->end())
     {
     return result;
@@ -699,9 +860,17 @@ UUIDs Manager::lowerDimensionalBoundaries(const UUID& ofEntity, int lowerDimensi
   * regardless of their dimension.
   */
 UUIDs Manager::higherDimensionalBordants(const UUID& ofEntity, int higherDimension)
+{
+  if (this->m_adjacency)
+    return this->m_adjacency->higherDimensionalBordants(ofEntity, higherDimension);
+  return this->computeHigherDimensionalBordants(ofEntity, higherDimension);
+}
+
+/// Walk entity relations to find higher-dimensional bordants (without consulting any cache).
+UUIDs Manager::computeHigherDimensionalBordants(const UUID& ofEntity, int higherDimension) const
 {
   UUIDs result;
-  UUIDsToEntities::iterator it = this->m_topology->find(ofEntity);
+  UUIDsToEntities::const_iterator it = this->m_topology->find(ofEntity);
   if (it == this->m_topology->end())
     {
     return result;
@@ -726,19 +895,40 @@ UUIDs Manager::higherDimensionalBordants(const UUID& ofEntity, int higherDimensi
   return result;
 }
 
-/// Return entities of the requested dimension that share a boundary relationship with the passed entity.
+/**\brief Return entities of the requested dimension that share a boundary relationship with the passed entity.
+  *
+  * Two entities are adjacent when they share any lower-dimensional boundary
+  * (so two faces are adjacent when they share an edge or a vertex).
+  * The passed entity is never reported as adjacent to itself.
+  * Passing -1 will return adjacent entities of any dimension.
+  */
 UUIDs Manager::adjacentEntities(const UUID& ofEntity, int ofDimension)
 {
-  // FIXME: Implement adjacency
-  (void)ofEntity;
-  (void)ofDimension;
+  if (this->m_adjacency)
+    return this->m_adjacency->adjacentEntities(ofEntity, ofDimension);
+  return this->computeAdjacentEntities(ofEntity, ofDimension);
+}
+
+/// Walk entity relations to find adjacent entities (without consulting any cache).
+UUIDs Manager::computeAdjacentEntities(const UUID& ofEntity, int ofDimension) const
+{
   UUIDs result;
+  UUIDs bdys = this->computeLowerDimensionalBoundaries(ofEntity, -1);
+  for (UUIDs::const_iterator bit = bdys.begin(); bit != bdys.end(); ++bit)
+    {
+    UUIDs nbrs = this->computeHigherDimensionalBordants(*bit, ofDimension);
+    result.insert(nbrs.begin(), nbrs.end());
+    }
+  result.erase(ofEntity);
   return result;
 }
 
 /// Return all entities of the requested dimension that are present in the solid.
 UUIDs Manager::entitiesMatchingFlags(BitFlags mask, bool exactMatch)
 {
+  if (this->m_index)
+    return this->m_index->entitiesMatchingFlags(mask, exactMatch);
+
   UUIDs result;
   for (UUIDWithEntity it = this->m_topology->begin(); it != this->m_topology->end(); ++it)
     {
@@ -756,6 +946,9 @@ UUIDs Manager::entitiesMatchingFlags(BitFlags mask, bool exactMatch)
 /// Return all entities of the requested dimension that are present in the solid.
 UUIDs Manager::entitiesOfDimension(int dim)
 {
+  if (this->m_index)
+    return this->m_index->entitiesOfDimension(dim);
+
   UUIDs result;
   for (UUIDWithEntity it = this->m_topology->begin(); it != this->m_topology->end(); ++it)
     {
@@ -768,6 +961,199 @@ UUIDs Manager::entitiesOfDimension(int dim)
 }
 //@}
 
+/**\brief Create (or destroy) secondary indexes used to speed up entity queries.
+  *
+  * When enabled, entitiesMatchingFlags(), entitiesOfDimension() and
+  * findEntitiesByPropertyAs() (for properties passed to indexProperty())
+  * take time proportional to the size of their result rather than
+  * the number of entities in the manager.
+  * The index is disabled by default since it must be kept up to date
+  * as entities and properties change.
+  *
+  * \sa EntityIndex
+  */
+void Manager::enableEntityIndex(bool enable)
+{
+  if (!enable)
+    this->m_index.reset();
+  else if (!this->m_index)
+    this->m_index = smtk::shared_ptr<EntityIndex>(new EntityIndex(this));
+}
+
+/// Return true when secondary indexes are being maintained for this manager.
+bool Manager::hasEntityIndex() const
+{
+  return !!this->m_index;
+}
+
+/**\brief Index values of the property \a pname so findEntitiesByProperty() need not scan all entities.
+  *
+  * This enables the entity index if it was not already enabled.
+  * Returns true when the property was newly indexed.
+  */
+bool Manager::indexProperty(PropertyType ptype, const std::string& pname)
+{
+  this->enableEntityIndex();
+  return this->m_index->indexProperty(ptype, pname);
+}
+
+/**\brief Notify secondary indexes that \a uid has been (or is about to be) modified in place.
+  *
+  * Manager methods call this as needed; it is public so that views which
+  * modify entity records or properties directly can do the same.
+  */
+void Manager::entityModified(const UUID& uid)
+{
+  this->m_snapshotStale = true;
+  if (this->m_index)
+    this->m_index->entityModified(uid);
+  if (this->m_adjacency)
+    this->m_adjacency->entityModified(uid);
+}
+
+/// Notify the entity index that a property of \a uid has been (or is about to be) changed.
+void Manager::propertyModified(const UUID& uid)
+{
+  this->m_snapshotStale = true;
+  if (this->m_index)
+    this->m_index->entityModified(uid);
+}
+
+/**\brief Cache (or stop caching) the answers to transitive boundary, bordant and adjacency queries.
+  *
+  * When enabled, lowerDimensionalBoundaries(), higherDimensionalBordants()
+  * and adjacentEntities() are answered from tables built the first time
+  * each is asked about entities of a given dimension; subsequent queries
+  * take time proportional to the size of their result.
+  * The cache is disabled by default since entity records may be modified
+  * in place (via findEntity()) without notifying it; callers that do so
+  * must call entityModified() on each entity whose relations they change.
+  *
+  * \sa AdjacencyCache
+  */
+void Manager::enableAdjacencyCache(bool enable)
+{
+  if (!enable)
+    this->m_adjacency.reset();
+  else if (!this->m_adjacency)
+    this->m_adjacency = smtk::shared_ptr<AdjacencyCache>(new AdjacencyCache(this));
+}
+
+/// Return true when adjacency queries are being cached for this manager.
+bool Manager::hasAdjacencyCache() const
+{
+  return !!this->m_adjacency;
+}
+
+/**\brief Maintain read-only snapshots of this manager for concurrent readers.
+  *
+  * No part of a Manager is safe to modify while other threads read it.
+  * When snapshots are enabled, the writer (normally an Operator, which
+  * calls publishSnapshot() after each operation that changes the model)
+  * periodically publishes a copy of the manager's entity, arrangement, property,
+  * tessellation and attribute-association records.
+  * Any number of reader threads may then call snapshot() and use the
+  * const methods of the returned manager (findEntity(), boundaryEntities(),
+  * bordantEntities(), property getters, tessellations(), etc.) without
+  * locks while the writer continues to modify the live manager.
+  * A reader holding a snapshot sees a consistent model until it releases
+  * the snapshot; the snapshot is freed once its last reader releases it.
+  *
+  * Publishing copies the records above, so it costs time proportional
+  * to the size of the model. Mesh data is shared with (not copied into)
+  * snapshots and is not covered.
+  *
+  * Enabling snapshots publishes one immediately; disabling them releases
+  * the manager's reference to the latest snapshot.
+  */
+void Manager::enableSnapshots(bool enable)
+{
+  if (enable)
+    {
+    if (!this->m_snapshot)
+      this->publishSnapshot();
+    }
+  else
+    {
+#ifdef smtk_has_atomic_shared_ptr
+    smtk::atomic_store(&this->m_snapshot, ConstManagerPtr());
+#else
+    this->m_snapshot = ConstManagerPtr();
+#endif
+    }
+}
+
+/// Return true when snapshots are being published. Only call this from the writing thread.
+bool Manager::hasSnapshots() const
+{
+  return !!this->m_snapshot;
+}
+
+/**\brief Publish a read-only copy of this manager for use by other threads.
+  *
+  * This must only be called by the thread that modifies the manager.
+  * The new snapshot's snapshotEpoch() is one greater than the previous one.
+  */
+void Manager::publishSnapshot()
+{
+  ManagerPtr snap(new Manager(
+      smtk::shared_ptr<UUIDsToEntities>(new UUIDsToEntities(*this->m_topology)),
+      smtk::shared_ptr<UUIDsToArrangements>(new UUIDsToArrangements(*this->m_arrangements)),
+      smtk::shared_ptr<UUIDsToTessellations>(new UUIDsToTessellations(*this->m_tessellations)),
+      smtk::shared_ptr<UUIDsToTessellations>(new UUIDsToTessellations(*this->m_analysisMesh)),
+      this->m_meshes,
+      smtk::shared_ptr<UUIDsToAttributeAssignments>(
+        new UUIDsToAttributeAssignments(*this->m_attributeAssignments))));
+  *snap->m_floatData = *this->m_floatData;
+  *snap->m_stringData = *this->m_stringData;
+  *snap->m_integerData = *this->m_integerData;
+  snap->m_snapshotEpoch = ++this->m_snapshotEpoch;
+  this->m_snapshotStale = false;
+#ifdef smtk_has_atomic_shared_ptr
+  smtk::atomic_store(&this->m_snapshot, ConstManagerPtr(snap));
+#else
+  // Without atomic shared-pointer access, readers must synchronize with the writer.
+  this->m_snapshot = snap;
+#endif
+}
+
+/**\brief Return true when the manager may have changed since the last snapshot was published.
+  *
+  * Manager methods that add, remove or modify entities, arrangements or
+  * properties (and anything that calls entityModified()) set this flag;
+  * publishSnapshot() clears it.
+  * Records changed in place through the non-const container accessors
+  * (topology(), tessellations(), etc.) are not tracked unless the caller
+  * also calls entityModified().
+  */
+bool Manager::isSnapshotStale() const
+{
+  return this->m_snapshotStale;
+}
+
+/**\brief Return the most recently published snapshot (or a null pointer when snapshots are disabled).
+  *
+  * This may be called from any thread and never waits for the writer
+  * to finish modifying the manager.
+  */
+ConstManagerPtr Manager::snapshot() const
+{
+#ifdef smtk_has_atomic_shared_ptr
+  return smtk::atomic_load(&this->m_snapshot);
+#else
+  return this->m_snapshot;
+#endif
+}
+
+/**\brief Return the number of snapshots published so far.
+  *
+  * When called on a snapshot, this is the epoch at which it was published.
+  */
+unsigned long Manager::snapshotEpoch() const
+{
+  return this->m_snapshotEpoch;
+}
+
 /**\brief Return the smtk::model::Entity associated with \a uid (or NULL).
   *
   * Note that even the const version of this method may invalidate other
@@ -841,6 +1227,8 @@ void Manager::insertEntityReferences(const UUIDWithEntity& c)
     if (ref)
       {
       ref->appendRelation(c->first);
+      if (this->m_adjacency)
+        this->m_adjacency->entityModified(*bit);
       }
     }
 }
@@ -871,6 +1259,8 @@ void Manager::elideEntityReferences(const UUIDWithEntity& c)
           *rit = UUID::null();
           }
         }
+      if (this->m_adjacency)
+        this->m_adjacency->entityModified(*bit);
       }
     }
 }
@@ -886,6 +1276,8 @@ void Manager::removeEntityReferences(const UUIDWithEntity& c)
     if (ref)
       {
       ref->invalidateRelation(c->first);
+      if (this->m_adjacency)
+        this->m_adjacency->entityModified(*bit);
       }
     }
 }
@@ -933,17 +1325,19 @@ void Manager::setFloatProperty(
 {
   if (!entity.isNull())
     {
-    (*this->m_floatData)[entity][propName] = propValue;
+    this->m_floatData->set(entity, propName, propValue);
+    this->propertyModified(entity);
     }
 }
 
 smtk::model::FloatList const& Manager::floatProperty(
   const UUID& entity, const std::string& propName) const
 {
-  if (!entity.isNull())
+  // Do not create an entry; const methods must be safe to call from many threads.
+  const FloatList* value = this->m_floatData->find(entity, propName);
+  if (value)
     {
-    FloatData& floats((*this->m_floatData)[entity]);
-    return floats[propName];
+    return *value;
     }
   static FloatList dummy;
   return dummy;
@@ -954,8 +1348,9 @@ smtk::model::FloatList& Manager::floatProperty(
 {
   if (!entity.isNull())
     {
-    FloatData& floats((*this->m_floatData)[entity]);
-    return floats[propName];
+    // The caller may modify the returned value; re-index it before the next query.
+    this->propertyModified(entity);
+    return this->m_floatData->value(entity, propName);
     }
   static FloatList dummy;
   return dummy;
@@ -964,33 +1359,17 @@ smtk::model::FloatList& Manager::floatProperty(
 bool Manager::hasFloatProperty(
   const UUID& entity, const std::string& propName) const
 {
-  UUIDsToFloatData::const_iterator uit = this->m_floatData->find(entity);
-  if (uit == this->m_floatData->end())
-    {
-    return false;
-    }
-  FloatData::const_iterator sit = uit->second.find(propName);
-  // FIXME: Should we return true even when the array (*sit) is empty?
-  return sit == uit->second.end() ? false : true;
+  // FIXME: Should we return true even when the array is empty?
+  return this->m_floatData->find(entity, propName) != NULL;
 }
 
 bool Manager::removeFloatProperty(
   const UUID& entity,
   const std::string& propName)
 {
-  UUIDsToFloatData::iterator uit = this->m_floatData->find(entity);
-  if (uit == this->m_floatData->end())
-    {
+  if (!this->m_floatData->remove(entity, propName))
     return false;
-    }
-  FloatData::iterator sit = uit->second.find(propName);
-  if (sit == uit->second.end())
-    {
-    return false;
-    }
-  uit->second.erase(sit);
-  if (uit->second.empty())
-    this->m_floatData->erase(uit);
+  this->propertyModified(entity);
   return true;
 }
 
@@ -1021,17 +1400,19 @@ void Manager::setStringProperty(
 {
   if (!entity.isNull())
     {
-    (*this->m_stringData)[entity][propName] = propValue;
+    this->m_stringData->set(entity, propName, propValue);
+    this->propertyModified(entity);
     }
 }
 
 smtk::model::StringList const& Manager::stringProperty(
   const UUID& entity, const std::string& propName) const
 {
-  if (!entity.isNull())
+  // Do not create an entry; const methods must be safe to call from many threads.
+  const StringList* value = this->m_stringData->find(entity, propName);
+  if (value)
     {
-    StringData& strings((*this->m_stringData)[entity]);
-    return strings[propName];
+    return *value;
     }
   static StringList dummy;
   return dummy;
@@ -1042,8 +1423,9 @@ smtk::model::StringList& Manager::stringProperty(
 {
   if (!entity.isNull())
     {
-    StringData& strings((*this->m_stringData)[entity]);
-    return strings[propName];
+    // The caller may modify the returned value; re-index it before the next query.
+    this->propertyModified(entity);
+    return this->m_stringData->value(entity, propName);
     }
   static StringList dummy;
   return dummy;
@@ -1052,33 +1434,17 @@ smtk::model::StringList& Manager::stringProperty(
 bool Manager::hasStringProperty(
   const UUID& entity, const std::string& propName) const
 {
-  UUIDsToStringData::const_iterator uit = this->m_stringData->find(entity);
-  if (uit == this->m_stringData->end())
-    {
-    return false;
-    }
-  StringData::const_iterator sit = uit->second.find(propName);
-  // FIXME: Should we return true even when the array (*sit) is empty?
-  return sit == uit->second.end() ? false : true;
+  // FIXME: Should we return true even when the array is empty?
+  return this->m_stringData->find(entity, propName) != NULL;
 }
 
 bool Manager::removeStringProperty(
   const UUID& entity,
   const std::string& propName)
 {
-  UUIDsToStringData::iterator uit = this->m_stringData->find(entity);
-  if (uit == this->m_stringData->end())
-    {
+  if (!this->m_stringData->remove(entity, propName))
     return false;
-    }
-  StringData::iterator sit = uit->second.find(propName);
-  if (sit == uit->second.end())
-    {
-    return false;
-    }
-  uit->second.erase(sit);
-  if (uit->second.empty())
-    this->m_stringData->erase(uit);
+  this->propertyModified(entity);
   return true;
 }
 
@@ -1109,17 +1475,19 @@ void Manager::setIntegerProperty(
 {
   if (!entity.isNull())
     {
-    (*this->m_integerData)[entity][propName] = propValue;
+    this->m_integerData->set(entity, propName, propValue);
+    this->propertyModified(entity);
     }
 }
 
 smtk::model::IntegerList const& Manager::integerProperty(
   const UUID& entity, const std::string& propName) const
 {
-  if (!entity.isNull())
+  // Do not create an entry; const methods must be safe to call from many threads.
+  const IntegerList* value = this->m_integerData->find(entity, propName);
+  if (value)
     {
-    IntegerData& integers((*this->m_integerData)[entity]);
-    return integers[propName];
+    return *value;
     }
   static IntegerList dummy;
   return dummy;
@@ -1130,8 +1498,9 @@ smtk::model::IntegerList& Manager::integerProperty(
 {
   if (!entity.isNull())
     {
-    IntegerData& integers((*this->m_integerData)[entity]);
-    return integers[propName];
+    // The caller may modify the returned value; re-index it before the next query.
+    this->propertyModified(entity);
+    return this->m_integerData->value(entity, propName);
     }
   static IntegerList dummy;
   return dummy;
@@ -1140,33 +1509,17 @@ smtk::model::IntegerList& Manager::integerProperty(
 bool Manager::hasIntegerProperty(
   const UUID& entity, const std::string& propName) const
 {
-  UUIDsToIntegerData::const_iterator uit = this->m_integerData->find(entity);
-  if (uit == this->m_integerData->end())
-    {
-    return false;
-    }
-  IntegerData::const_iterator sit = uit->second.find(propName);
-  // FIXME: Should we return true even when the array (*sit) is empty?
-  return sit == uit->second.end() ? false : true;
+  // FIXME: Should we return true even when the array is empty?
+  return this->m_integerData->find(entity, propName) != NULL;
 }
 
 bool Manager::removeIntegerProperty(
   const UUID& entity,
   const std::string& propName)
 {
-  UUIDsToIntegerData::iterator uit = this->m_integerData->find(entity);
-  if (uit == this->m_integerData->end())
-    {
-    return false;
-    }
-  IntegerData::iterator sit = uit->second.find(propName);
-  if (sit == uit->second.end())
-    {
+  if (!this->m_integerData->remove(entity, propName))
     return false;
-    }
-  uit->second.erase(sit);
-  if (uit->second.empty())
-    this->m_integerData->erase(uit);
+  this->propertyModified(entity);
   return true;
 }
 
@@ -1908,9 +2261,12 @@ bool Manager::removeTessellation(const smtk::common::UUID& entityId, bool remove
 {
   bool didRemove;
   UUIDWithTessellation tref = this->m_tessellations->find(entityId);
-  didRemove = (tref == this->m_tessellations->end());
+  didRemove = (tref != this->m_tessellations->end());
   if (didRemove)
+    {
     this->m_tessellations->erase(tref);
+    this->m_snapshotStale = true;
+    }
 
   if (removeGen)
     this->removeIntegerProperty(entityId, SMTK_TESS_GEN_PROP);
@@ -1960,6 +2316,10 @@ int Manager::arrangeEntity(const UUID& entityId, ArrangementKind kind, const Arr
     index = static_cast<int>(kit->second.size());
     kit->second.push_back(arr);
     }
+  // Arrangements accompany changes to relations.
+  this->m_snapshotStale = true;
+  if (this->m_adjacency)
+    this->m_adjacency->entityModified(entityId);
   return index;
 }
 
@@ -1992,6 +2352,7 @@ int Manager::unarrangeEntity(const UUID& entityId, ArrangementKind k, int index,
 
   // TODO: notify relation + entity (or their delegates) of imminent removal?
   ak->second.erase(ak->second.begin() + index);
+  this->m_snapshotStale = true;
   ++result;
 
   // Now, if we removed the last arrangement of this kind, kill the kind-dictionary entry
@@ -2027,6 +2388,17 @@ int Manager::unarrangeEntity(const UUID& entityId, ArrangementKind k, int index,
   if (removeIfLast && canRemoveEntity)
     {
     // TODO: notify entity of removal.
+    if (this->m_adjacency)
+      {
+      const Entity* ent = this->findEntity(entityId, false);
+      if (ent)
+        {
+        UUIDArray::const_iterator rit;
+        for (rit = ent->relations().begin(); rit != ent->relations().end(); ++rit)
+          this->m_adjacency->entityModified(*rit);
+        }
+      this->m_adjacency->entityModified(entityId);
+      }
     this->m_topology->erase(entityId);
     ++result;
     }
@@ -2889,7 +3261,10 @@ bool Manager::associateAttribute(
       allowed = false;
     }
   if (allowed)
+    {
     (*this->m_attributeAssignments)[toEntity].associateAttribute(attribId);
+    this->m_snapshotStale = true;
+    }
   return allowed;
 }
 
@@ -2910,6 +3285,7 @@ bool Manager::disassociateAttribute(
     }
   if ((didRemove = ref->second.disassociateAttribute(attribId)))
     {
+    this->m_snapshotStale = true;
     // If the AttributeAssignments instance is now empty, remove it.
     // (Only do this for std::map storage, as it triggers assertion
     // failures in sparsehash for no discernable reason.)
@@ -3646,9 +4022,122 @@ void Manager::unobserve(OperatorEventType event, BareOperatorCallback functionHa
       BareOperatorObserver(functionHandle, callData)));
 }
 
+/**\brief Request batched notification from this manager instance when \a event occurs.
+  *
+  * Batched observers are called with an array of entities rather than
+  * once per event.
+  * Events that occur between beginEventBatch() and endEventBatch() (such as
+  * those caused by an Operator) are collected, and duplicates are discarded.
+  * When the outermost batch ends, each batched observer is called once per
+  * distinct source entity of each event type it observes.
+  * The related entities are passed as an array, in no particular order.
+  * Entity-condition events (those reported to ConditionCallback observers)
+  * have no source entity; they are reported with an invalid source and
+  * the affected entities as the related entities, just like entities
+  * added by insertEntities().
+  * Events that occur outside of any batch are delivered immediately.
+  *
+  * Event types are delivered in the order of ManagerEventType values, so
+  * entities that were added and then removed in the same batch appear in
+  * both the ADD_EVENT and DEL_EVENT notifications (in that order).
+  *
+  * Observers registered with observe() are unaffected by batches:
+  * they are still called immediately, once per event.
+  */
+void Manager::observeBatched(ManagerEventType event, OneToManyCallback functionHandle, void* callData)
+{
+  if (event.first == ANY_EVENT)
+    {
+    int i;
+    int iend = static_cast<int>(ANY_EVENT);
+    for (i = static_cast<int>(ADD_EVENT); i != iend; ++i)
+      {
+      event.first = static_cast<ManagerEventChangeType>(i);
+      this->observeBatched(event, functionHandle, callData);
+      }
+
+    return;
+    }
+
+  this->m_batchedTriggers.insert(
+    OneToManyTrigger(event,
+      OneToManyObserver(functionHandle, callData)));
+}
+
+/// Decline further batched notification from this manager instance when \a event occurs.
+void Manager::unobserveBatched(ManagerEventType event, OneToManyCallback functionHandle, void* callData)
+{
+  if (event.first == ANY_EVENT)
+    {
+    int i;
+    int iend = static_cast<int>(ANY_EVENT);
+    for (i = static_cast<int>(ADD_EVENT); i != iend; ++i)
+      {
+      event.first = static_cast<ManagerEventChangeType>(i);
+      this->unobserveBatched(event, functionHandle, callData);
+      }
+
+    return;
+    }
+
+  this->m_batchedTriggers.erase(
+    OneToManyTrigger(event,
+      OneToManyObserver(functionHandle, callData)));
+}
+
+/**\brief Start collecting events for batched observers.
+  *
+  * Batches may be nested; events are delivered when the outermost
+  * batch ends. Every call must be matched by a call to endEventBatch();
+  * see EventBatch for a scoped way to do this.
+  */
+void Manager::beginEventBatch()
+{
+  ++this->m_eventBatchDepth;
+}
+
+/**\brief Stop collecting events, delivering them to batched observers if this ends the outermost batch.
+  *
+  * Events triggered by observers as they are notified are delivered
+  * immediately (unless an observer begins a new batch).
+  */
+void Manager::endEventBatch()
+{
+  if (this->m_eventBatchDepth <= 0 || --this->m_eventBatchDepth > 0)
+    return;
+
+  std::map<ManagerEventType,std::map<UUID,UUIDs> > pending;
+  pending.swap(this->m_batchedEvents);
+  ManagerPtr self = shared_from_this();
+  std::map<ManagerEventType,std::map<UUID,UUIDs> >::const_iterator eit;
+  for (eit = pending.begin(); eit != pending.end(); ++eit)
+    {
+    std::map<UUID,UUIDs>::const_iterator sit;
+    for (sit = eit->second.begin(); sit != eit->second.end(); ++sit)
+      {
+      EntityRefArray related;
+      related.reserve(sit->second.size());
+      for (UUIDs::const_iterator rit = sit->second.begin(); rit != sit->second.end(); ++rit)
+        related.push_back(EntityRef(self, *rit));
+      EntityRef src(self, sit->first);
+      std::set<OneToManyTrigger>::const_iterator tit = this->m_batchedTriggers.lower_bound(
+        OneToManyTrigger(eit->first, OneToManyObserver(OneToManyCallback(), static_cast<void*>(NULL))));
+      for (; tit != this->m_batchedTriggers.end() && tit->first == eit->first; ++tit)
+        (*tit->second.first)(tit->first, src, related, tit->second.second);
+      }
+    }
+}
+
+/// Return true when events are being collected for batched observers.
+bool Manager::isBatchingEvents() const
+{
+  return this->m_eventBatchDepth > 0;
+}
+
 /// Called by this Manager instance or EntityRef instances referencing it when \a event occurs.
 void Manager::trigger(ManagerEventType event, const smtk::model::EntityRef& src)
 {
+  this->m_snapshotStale = true;
   std::set<ConditionTrigger>::const_iterator begin =
     this->m_conditionTriggers.lower_bound(
       ConditionTrigger(event,
@@ -3659,11 +4148,15 @@ void Manager::trigger(ManagerEventType event, const smtk::model::EntityRef& src)
         ConditionObserver(ConditionCallback(), static_cast<void*>(NULL))));
   for (std::set<ConditionTrigger>::const_iterator it = begin; it != end; ++it)
     (*it->second.first)(it->first, src, it->second.second);
+
+  if (hasObserversOf(this->m_batchedTriggers, event))
+    this->batchEvent(event, UUID::null(), UUIDs(&src.entity(), &src.entity() + 1));
 }
 
 /// Called by this Manager instance or EntityRef instances referencing it when \a event occurs.
 void Manager::trigger(ManagerEventType event, const smtk::model::EntityRef& src, const smtk::model::EntityRef& related)
 {
+  this->m_snapshotStale = true;
   std::set<OneToOneTrigger>::const_iterator begin =
     this->m_oneToOneTriggers.lower_bound(
       OneToOneTrigger(event,
@@ -3674,11 +4167,15 @@ void Manager::trigger(ManagerEventType event, const smtk::model::EntityRef& src,
         OneToOneObserver(OneToOneCallback(), static_cast<void*>(NULL))));
   for (std::set<OneToOneTrigger>::const_iterator it = begin; it != end; ++it)
     (*it->second.first)(it->first, src, related, it->second.second);
+
+  if (hasObserversOf(this->m_batchedTriggers, event))
+    this->batchEvent(event, src.entity(), UUIDs(&related.entity(), &related.entity() + 1));
 }
 
 /// Called by this Manager instance or EntityRef instances referencing it when \a event occurs.
 void Manager::trigger(ManagerEventType event, const smtk::model::EntityRef& src, const smtk::model::EntityRefArray& related)
 {
+  this->m_snapshotStale = true;
   std::set<OneToManyTrigger>::const_iterator begin =
     this->m_oneToManyTriggers.lower_bound(
       OneToManyTrigger(event,
@@ -3689,6 +4186,14 @@ void Manager::trigger(ManagerEventType event, const smtk::model::EntityRef& src,
         OneToManyObserver(OneToManyCallback(), static_cast<void*>(NULL))));
   for (std::set<OneToManyTrigger>::const_iterator it = begin; it != end; ++it)
     (*it->second.first)(it->first, src, related, it->second.second);
+
+  if (hasObserversOf(this->m_batchedTriggers, event))
+    {
+    UUIDs relatedIds;
+    for (EntityRefArray::const_iterator rit = related.begin(); rit != related.end(); ++rit)
+      relatedIds.insert(rit->entity());
+    this->batchEvent(event, src.entity(), relatedIds);
+    }
 }
 
 /// Called by this Manager instance or Session instances referencing it when \a event occurs.
@@ -3701,6 +4206,23 @@ void Manager::trigger(OperatorEventType event, const smtk::model::Operator& src)
   for (std::set<BareOperatorTrigger>::const_iterator it = begin; it != this->m_operatorTriggers.end() && it->first == event; ++it)
     (*it->second.first)(it->first, src, it->second.second);
 }
+
+/// Deliver \a event to batched observers, or hold it until the current batch ends.
+void Manager::batchEvent(ManagerEventType event, const UUID& src, const UUIDs& related)
+{
+  if (this->m_eventBatchDepth > 0)
+    {
+    UUIDs& pending(this->m_batchedEvents[event][src]);
+    pending.insert(related.begin(), related.end());
+    pending.erase(UUID::null());
+    return;
+    }
+
+  // Not in a batch; deliver the event alone.
+  this->beginEventBatch();
+  this->batchEvent(event, src, related);
+  this->endEventBatch();
+}
 //@}
 
   } // namespace model
@@ -19,6 +19,8 @@
 #include "smtk/model/Arrangement.h"
 #include "smtk/model/AttributeAssignments.h"
 #include "smtk/model/Entity.h"
+#include "smtk/model/AdjacencyCache.h"
+#include "smtk/model/EntityIndex.h"
 #include "smtk/model/Events.h"
 #include "smtk/model/FloatData.h"
 #include "smtk/model/IntegerData.h"
@@ -42,6 +44,8 @@
 #  if defined(_MSC_VER) // Visual studio
 #    pragma warning (pop)
 #  endif
+#elif defined(SMTK_DENSE_HASH_STORAGE)
+#  include "smtk/common/UUIDHashMap.h"
 #else
 #  include <map>
 #endif
@@ -75,9 +79,16 @@
 namespace smtk {
   namespace model {
 
-#ifdef SMTK_HASH_STORAGE
+#if defined(SMTK_HASH_STORAGE)
 /// Store information mapping IDs to Entity records. This is the primary storage for SMTK models.
 typedef google::sparse_hash_map<smtk::common::UUID,Entity> UUIDsToEntities;
+#elif defined(SMTK_DENSE_HASH_STORAGE)
+/**\brief Store information mapping IDs to Entity records. This is the primary storage for SMTK models.
+  *
+  * Each entity is assigned a stable 32-bit slot index (see UUIDHashMap::indexOf())
+  * that callers may hold in place of repeated UUID lookups.
+  */
+typedef smtk::common::UUIDHashMap<Entity> UUIDsToEntities;
 #else
 /// Store information mapping IDs to Entity records. This is the primary storage for SMTK models.
 typedef std::map<smtk::common::UUID,Entity> UUIDsToEntities;
@@ -148,7 +159,28 @@ public:
   smtk::common::UUIDs entitiesMatchingFlags(BitFlags mask, bool exactMatch = true);
   smtk::common::UUIDs entitiesOfDimension(int dim);
 
+  void enableEntityIndex(bool enable = true);
+  bool hasEntityIndex() const;
+  bool indexProperty(PropertyType ptype, const std::string& pname);
+  void entityModified(const smtk::common::UUID& uid);
+
+  void enableAdjacencyCache(bool enable = true);
+  bool hasAdjacencyCache() const;
+
+  void enableSnapshots(bool enable = true);
+  bool hasSnapshots() const;
+  void publishSnapshot();
+  bool isSnapshotStale() const;
+  ConstManagerPtr snapshot() const;
+  unsigned long snapshotEpoch() const;
+
   smtk::common::UUID unusedUUID();
+  smtk::common::UUIDArray unusedUUIDs(std::size_t count);
+  void reserveEntities(std::size_t count);
+  void insertEntities(
+    const smtk::common::UUIDArray& uids,
+    const std::vector<Entity>& records,
+    const std::vector<KindsToArrangements>& arrangements = std::vector<KindsToArrangements>());
   iter_type insertEntityOfTypeAndDimension(BitFlags entityFlags, int dim);
   iter_type insertEntity(Entity& cell);
   iter_type setEntityOfTypeAndDimension(const smtk::common::UUID& uid, BitFlags entityFlags, int dim);
@@ -378,6 +410,11 @@ public:
   void unobserve(ManagerEventType event, OneToOneCallback functionHandle, void* callData);
   void unobserve(ManagerEventType event, OneToManyCallback functionHandle, void* callData);
   void unobserve(OperatorEventType event, BareOperatorCallback functionHandle, void* callData);
+  void observeBatched(ManagerEventType event, OneToManyCallback functionHandle, void* callData);
+  void unobserveBatched(ManagerEventType event, OneToManyCallback functionHandle, void* callData);
+  void beginEventBatch();
+  void endEventBatch();
+  bool isBatchingEvents() const;
   void trigger(ManagerEventType event, const smtk::model::EntityRef& src);
   void trigger(ManagerEventType event, const smtk::model::EntityRef& src, const smtk::model::EntityRef& related);
   void trigger(ManagerEventType event, const smtk::model::EntityRef& src, const smtk::model::EntityRefArray& related);
@@ -387,6 +424,11 @@ public:
 
 protected:
   friend class smtk::attribute::System;
+  friend class AdjacencyCache;
+
+  smtk::common::UUIDs computeLowerDimensionalBoundaries(const smtk::common::UUID& ofEntity, int lowerDimension) const;
+  smtk::common::UUIDs computeHigherDimensionalBordants(const smtk::common::UUID& ofEntity, int higherDimension) const;
+  smtk::common::UUIDs computeAdjacentEntities(const smtk::common::UUID& ofEntity, int ofDimension) const;
 
   void assignDefaultNamesWithOwner(
     const UUIDWithEntity& irec,
@@ -396,7 +438,9 @@ protected:
     bool nokids);
   std::string assignDefaultName(const smtk::common::UUID& uid, BitFlags entityFlags);
   IntegerList& entityCounts(const smtk::common::UUID& modelId, BitFlags entityFlags);
+  void batchEvent(ManagerEventType event, const smtk::common::UUID& src, const smtk::common::UUIDs& related);
   void prepareForEntity(std::pair<smtk::common::UUID,Entity>& entry);
+  void propertyModified(const smtk::common::UUID& uid);
 
   // Below are all the different things that can be mapped to a UUID:
   smtk::shared_ptr<UUIDsToEntities> m_topology;
@@ -419,26 +463,41 @@ protected:
   std::set<OneToOneTrigger> m_oneToOneTriggers;
   std::set<OneToManyTrigger> m_oneToManyTriggers;
   std::set<BareOperatorTrigger> m_operatorTriggers;
+  std::set<OneToManyTrigger> m_batchedTriggers;
+  int m_eventBatchDepth;
+  std::map<ManagerEventType,std::map<smtk::common::UUID,smtk::common::UUIDs> > m_batchedEvents;
 
   smtk::io::Logger m_log;
+
+  smtk::shared_ptr<EntityIndex> m_index;
+  smtk::shared_ptr<AdjacencyCache> m_adjacency;
+  ConstManagerPtr m_snapshot;
+  unsigned long m_snapshotEpoch;
+  bool m_snapshotStale;
 };
 
 template<typename Collection>
 Collection Manager::findEntitiesByPropertyAs(const std::string& pname, Integer pval)
 {
   Collection collection;
-  UUIDWithIntegerProperties pit;
-  for (pit = this->m_integerData->begin(); pit != this->m_integerData->end(); ++pit)
+  if (this->m_index && this->m_index->isPropertyIndexed(INTEGER_PROPERTY, pname))
+    {
+    EntityRef::EntityRefsFromUUIDs(
+      collection, shared_from_this(), this->m_index->entitiesWithProperty(pname, IntegerList(1, pval)));
+    return collection;
+    }
+  UUIDsToIntegerData::PropertyId pid = this->m_integerData->propertyId(pname);
+  if (pid == UUIDsToIntegerData::InvalidProperty)
+    return collection;
+  const UUIDsToIntegerData::Column& col(this->m_integerData->column(pid));
+  UUIDsToIntegerData::RowId numRows = static_cast<UUIDsToIntegerData::RowId>(col.present.size());
+  for (UUIDsToIntegerData::RowId row = 0; row < numRows; ++row)
     {
-    PropertyNameWithIntegers it;
-    for (it = pit->second.begin(); it != pit->second.end(); ++it)
+    if (col.present[row] && col.values[row].size() == 1 && col.values[row][0] == pval)
       {
-      if (it->first == pname && it->second.size() == 1 && it->second[0] == pval)
-        {
-        typename Collection::value_type entry(shared_from_this(), pit->first);
-        if (entry.isValid())
-          collection.insert(collection.end(), entry);
-        }
+      typename Collection::value_type entry(shared_from_this(), this->m_integerData->rowEntity(row));
+      if (entry.isValid())
+        collection.insert(collection.end(), entry);
       }
     }
   return collection;
@@ -448,18 +507,24 @@ template<typename Collection>
 Collection Manager::findEntitiesByPropertyAs(const std::string& pname, const IntegerList& pval)
 {
   Collection collection;
-  UUIDWithIntegerProperties pit;
-  for (pit = this->m_integerData->begin(); pit != this->m_integerData->end(); ++pit)
+  if (this->m_index && this->m_index->isPropertyIndexed(INTEGER_PROPERTY, pname))
     {
-    PropertyNameWithIntegers it;
-    for (it = pit->second.begin(); it != pit->second.end(); ++it)
+    EntityRef::EntityRefsFromUUIDs(
+      collection, shared_from_this(), this->m_index->entitiesWithProperty(pname, pval));
+    return collection;
+    }
+  UUIDsToIntegerData::PropertyId pid = this->m_integerData->propertyId(pname);
+  if (pid == UUIDsToIntegerData::InvalidProperty)
+    return collection;
+  const UUIDsToIntegerData::Column& col(this->m_integerData->column(pid));
+  UUIDsToIntegerData::RowId numRows = static_cast<UUIDsToIntegerData::RowId>(col.present.size());
+  for (UUIDsToIntegerData::RowId row = 0; row < numRows; ++row)
+    {
+    if (col.present[row] && col.values[row] == pval)
       {
-      if (it->first == pname && it->second == pval)
-        {
-        typename Collection::value_type entry(shared_from_this(), pit->first);
-        if (entry.isValid())
-          collection.insert(collection.end(), entry);
-        }
+      typename Collection::value_type entry(shared_from_this(), this->m_integerData->rowEntity(row));
+      if (entry.isValid())
+        collection.insert(collection.end(), entry);
       }
     }
   return collection;
@@ -469,18 +534,24 @@ template<typename Collection>
 Collection Manager::findEntitiesByPropertyAs(const std::string& pname, Float pval)
 {
   Collection collection;
-  UUIDWithFloatProperties pit;
-  for (pit = this->m_floatData->begin(); pit != this->m_floatData->end(); ++pit)
+  if (this->m_index && this->m_index->isPropertyIndexed(FLOAT_PROPERTY, pname))
     {
-    PropertyNameWithFloats it;
-    for (it = pit->second.begin(); it != pit->second.end(); ++it)
+    EntityRef::EntityRefsFromUUIDs(
+      collection, shared_from_this(), this->m_index->entitiesWithProperty(pname, FloatList(1, pval)));
+    return collection;
+    }
+  UUIDsToFloatData::PropertyId pid = this->m_floatData->propertyId(pname);
+  if (pid == UUIDsToFloatData::InvalidProperty)
+    return collection;
+  const UUIDsToFloatData::Column& col(this->m_floatData->column(pid));
+  UUIDsToFloatData::RowId numRows = static_cast<UUIDsToFloatData::RowId>(col.present.size());
+  for (UUIDsToFloatData::RowId row = 0; row < numRows; ++row)
+    {
+    if (col.present[row] && col.values[row].size() == 1 && col.values[row][0] == pval)
       {
-      if (it->first == pname && it->second.size() == 1 && it->second[0] == pval)
-        {
-        typename Collection::value_type entry(shared_from_this(), pit->first);
-        if (entry.isValid())
-          collection.insert(collection.end(), entry);
-        }
+      typename Collection::value_type entry(shared_from_this(), this->m_floatData->rowEntity(row));
+      if (entry.isValid())
+        collection.insert(collection.end(), entry);
       }
     }
   return collection;
@@ -490,18 +561,24 @@ template<typename Collection>
 Collection Manager::findEntitiesByPropertyAs(const std::string& pname, const FloatList& pval)
 {
   Collection collection;
-  UUIDWithFloatProperties pit;
-  for (pit = this->m_floatData->begin(); pit != this->m_floatData->end(); ++pit)
+  if (this->m_index && this->m_index->isPropertyIndexed(FLOAT_PROPERTY, pname))
+    {
+    EntityRef::EntityRefsFromUUIDs(
+      collection, shared_from_this(), this->m_index->entitiesWithProperty(pname, pval));
+    return collection;
+    }
+  UUIDsToFloatData::PropertyId pid = this->m_floatData->propertyId(pname);
+  if (pid == UUIDsToFloatData::InvalidProperty)
+    return collection;
+  const UUIDsToFloatData::Column& col(this->m_floatData->column(pid));
+  UUIDsToFloatData::RowId numRows = static_cast<UUIDsToFloatData::RowId>(col.present.size());
+  for (UUIDsToFloatData::RowId row = 0; row < numRows; ++row)
     {
-    PropertyNameWithFloats it;
-    for (it = pit->second.begin(); it != pit->second.end(); ++it)
+    if (col.present[row] && col.values[row] == pval)
       {
-      if (it->first == pname && it->second == pval)
-        {
-        typename Collection::value_type entry(shared_from_this(), pit->first);
-        if (entry.isValid())
-          collection.insert(collection.end(), entry);
-        }
+      typename Collection::value_type entry(shared_from_this(), this->m_floatData->rowEntity(row));
+      if (entry.isValid())
+        collection.insert(collection.end(), entry);
       }
     }
   return collection;
@@ -511,18 +588,24 @@ template<typename Collection>
 Collection Manager::findEntitiesByPropertyAs(const std::string& pname, const std::string& pval)
 {
   Collection collection;
-  UUIDWithStringProperties pit;
-  for (pit = this->m_stringData->begin(); pit != this->m_stringData->end(); ++pit)
+  if (this->m_index && this->m_index->isPropertyIndexed(STRING_PROPERTY, pname))
+    {
+    EntityRef::EntityRefsFromUUIDs(
+      collection, shared_from_this(), this->m_index->entitiesWithProperty(pname, StringList(1, pval)));
+    return collection;
+    }
+  UUIDsToStringData::PropertyId pid = this->m_stringData->propertyId(pname);
+  if (pid == UUIDsToStringData::InvalidProperty)
+    return collection;
+  const UUIDsToStringData::Column& col(this->m_stringData->column(pid));
+  UUIDsToStringData::RowId numRows = static_cast<UUIDsToStringData::RowId>(col.present.size());
+  for (UUIDsToStringData::RowId row = 0; row < numRows; ++row)
     {
-    PropertyNameWithStrings it;
-    for (it = pit->second.begin(); it != pit->second.end(); ++it)
+    if (col.present[row] && col.values[row].size() == 1 && col.values[row][0] == pval)
       {
-      if (it->first == pname && it->second.size() == 1 && it->second[0] == pval)
-        {
-        typename Collection::value_type entry(shared_from_this(), pit->first);
-        if (entry.isValid())
-          collection.insert(collection.end(), entry);
-        }
+      typename Collection::value_type entry(shared_from_this(), this->m_stringData->rowEntity(row));
+      if (entry.isValid())
+        collection.insert(collection.end(), entry);
       }
     }
   return collection;
@@ -532,18 +615,24 @@ template<typename Collection>
 Collection Manager::findEntitiesByPropertyAs(const std::string& pname, const StringList& pval)
 {
   Collection collection;
-  UUIDWithStringProperties pit;
-  for (pit = this->m_stringData->begin(); pit != this->m_stringData->end(); ++pit)
+  if (this->m_index && this->m_index->isPropertyIndexed(STRING_PROPERTY, pname))
+    {
+    EntityRef::EntityRefsFromUUIDs(
+      collection, shared_from_this(), this->m_index->entitiesWithProperty(pname, pval));
+    return collection;
+    }
+  UUIDsToStringData::PropertyId pid = this->m_stringData->propertyId(pname);
+  if (pid == UUIDsToStringData::InvalidProperty)
+    return collection;
+  const UUIDsToStringData::Column& col(this->m_stringData->column(pid));
+  UUIDsToStringData::RowId numRows = static_cast<UUIDsToStringData::RowId>(col.present.size());
+  for (UUIDsToStringData::RowId row = 0; row < numRows; ++row)
     {
-    PropertyNameWithStrings it;
-    for (it = pit->second.begin(); it != pit->second.end(); ++it)
+    if (col.present[row] && col.values[row] == pval)
       {
-      if (it->first == pname && it->second == pval)
-        {
-        typename Collection::value_type entry(shared_from_this(), pit->first);
-        if (entry.isValid())
-          collection.insert(collection.end(), entry);
-        }
+      typename Collection::value_type entry(shared_from_this(), this->m_stringData->rowEntity(row));
+      if (entry.isValid())
+        collection.insert(collection.end(), entry);
       }
     }
   return collection;
@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //=========================================================================
 #include "smtk/model/Operator.h"
+#include "smtk/model/EventBatch.h"
 #include "smtk/model/Manager.h"
 
 #include "smtk/io/ExportJSON.h"
@@ -46,6 +47,19 @@ using smtk::attribute::MeshItem;
 namespace smtk {
   namespace model {
 
+// Return true when the result lists entities the operation created, modified or removed.
+static bool reportsChanges(const OperatorResult& result)
+{
+  static const char* names[] = { "created", "modified", "expunged", "tess_changed" };
+  for (std::size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+    {
+    ModelEntityItem::Ptr item = result->findModelEntity(names[i]);
+    if (item && item->numberOfValues() > 0)
+      return true;
+    }
+  return false;
+}
+
 /// Constructor. Initialize the session to a NULL pointer.
 Operator::Operator()
 {
@@ -96,7 +110,11 @@ OperatorResult Operator::operate()
     {
     std::size_t logStart = this->log().numberOfRecords();
     if (!this->trigger(WILL_OPERATE))
+      {
+      // Batched observers of the manager hear of changes once the operation completes.
+      EventBatch batch(this->manager());
       result = this->operateInternal();
+      }
     else
       result = this->createResult(OPERATION_CANCELED);
     smtk::attribute::IntItem::Ptr assignNamesItem;
@@ -125,6 +143,12 @@ OperatorResult Operator::operate()
       result->findString("log")->appendValue(logstr);
       free(logstr);
       }
+    // Make any changes visible to threads reading manager snapshots.
+    // Publishing copies the model, so skip it when nothing changed.
+    ManagerPtr mgr = this->manager();
+    if (mgr && mgr->hasSnapshots() &&
+      (mgr->isSnapshotStale() || reportsChanges(result)))
+      mgr->publishSnapshot();
     this->trigger(DID_OPERATE, result);
     }
   else
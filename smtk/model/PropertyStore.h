@@ -0,0 +1,471 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_model_PropertyStore_h
+#define __smtk_model_PropertyStore_h
+/** \file PropertyStore.h
+ * Columnar storage for property values attached to model entities.
+ */
+
+#include "smtk/common/UUID.h"
+#include "smtk/common/UUIDHashMap.h"
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace smtk {
+  namespace model {
+
+/**\brief Columnar, interned-key storage for one type of entity property.
+  *
+  * Every entity holding at least one property is assigned a row via a
+  * compact UUID-to-row index whose rows are reused once released.
+  * Property names are interned once per store and each name owns a
+  * column of values indexed directly by row, along with a bitmap of the
+  * rows that hold the property. This means that a name such as "color"
+  * is stored once no matter how many entities are colored, that finding
+  * all entities with a given property scans only that property's column,
+  * and that testing whether a row holds a property is a single bit test.
+  *
+  * The store presents the same shape as the map-of-maps it replaces:
+  * iterating it yields (UUID, Row) entries and each Row is a view of one
+  * entity's properties that behaves like a std::map from property names
+  * to values. Rows are lightweight views; they hold no values themselves.
+  *
+  * References to values remain valid until the value is removed:
+  * columns and the values within each column are held in deques that
+  * only grow or shrink at their end, so neither interning new names nor
+  * adding values moves existing values.
+  */
+template<typename V>
+class PropertyStore
+{
+public:
+  typedef V mapped_type;
+  typedef std::size_t size_type;
+  typedef boost::uint32_t PropertyId;
+  typedef boost::uint32_t RowId;
+
+  /// The id returned for property names that have never been interned.
+  static const PropertyId InvalidProperty = 0xffffffffu;
+
+  /**\brief The values of a single property indexed by row.
+    *
+    * A column extends only as far as the last row holding the property;
+    * rows before it that lack the property hold a default value.
+    */
+  struct Column
+  {
+    typedef std::deque<V> Values;
+
+    Column() : count(0) { }
+
+    Values values;
+    std::vector<bool> present;
+    size_type count;
+
+    bool has(RowId row) const { return row < this->present.size() && this->present[row]; }
+  };
+
+protected:
+  /// Each row records how many properties are set so it can be released when empty.
+  typedef smtk::common::UUIDHashMap<boost::uint32_t> RowIndex;
+
+public:
+  /**\brief A view of the properties of a single entity.
+    *
+    * The view is templated on the constness of the store it references.
+    */
+  template<typename S, typename VV>
+  class RowView
+  {
+  public:
+    /// An (interned name, value) pair reported when iterating over a row.
+    struct Entry
+    {
+      Entry(const std::string& nn, VV& vv) : first(nn), second(vv) { }
+      const std::string& first;
+      VV& second;
+    };
+
+    /// Iterate over the properties set on one entity, testing one bit per interned name.
+    class iterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef Entry value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef Entry reference;
+      struct pointer
+      {
+        pointer(const Entry& ee) : entry(ee) { }
+        const Entry* operator -> () const { return &this->entry; }
+        Entry entry;
+      };
+
+      iterator() : m_store(NULL), m_row(0), m_column(0) { }
+      iterator(S* store, RowId row, PropertyId column)
+        : m_store(store), m_row(row), m_column(column)
+        { this->skip(); }
+
+      reference operator * () const
+        {
+        return Entry(
+          this->m_store->m_names[this->m_column],
+          this->m_store->m_columns[this->m_column].values[this->m_row]);
+        }
+      pointer operator -> () const { return pointer(**this); }
+
+      iterator& operator ++ ()
+        {
+        ++this->m_column;
+        this->skip();
+        return *this;
+        }
+      iterator operator ++ (int)
+        {
+        iterator tmp(*this);
+        ++(*this);
+        return tmp;
+        }
+
+      bool operator == (const iterator& other) const
+        { return this->m_column == other.m_column && this->m_row == other.m_row && this->m_store == other.m_store; }
+      bool operator != (const iterator& other) const
+        { return !(*this == other); }
+
+      /// The interned id of the property this iterator references.
+      PropertyId propertyId() const { return this->m_column; }
+
+    protected:
+      friend class RowView<S,VV>;
+      friend class PropertyStore<V>;
+
+      void skip()
+        {
+        if (!this->m_store)
+          return;
+        PropertyId numColumns = static_cast<PropertyId>(this->m_store->m_columns.size());
+        while (this->m_column < numColumns && !this->m_store->m_columns[this->m_column].has(this->m_row))
+          ++this->m_column;
+        }
+
+      S* m_store;
+      RowId m_row;
+      PropertyId m_column;
+    };
+    typedef iterator const_iterator;
+
+    RowView() : m_store(NULL) { }
+    RowView(S* store, const smtk::common::UUID& uid) : m_store(store), m_entity(uid) { }
+    template<typename S2, typename VV2>
+    RowView(const RowView<S2,VV2>& other) : m_store(other.store()), m_entity(other.entity()) { }
+
+    S* store() const { return this->m_store; }
+    const smtk::common::UUID& entity() const { return this->m_entity; }
+
+    /// Return true when the entity has at least one property in the store.
+    bool isValid() const { return this->m_store && this->row() != RowIndex::InvalidIndex; }
+    bool empty() const { return !this->isValid(); }
+    size_type size() const
+      {
+      RowId rr = this->row();
+      return rr == RowIndex::InvalidIndex ? 0 : this->m_store->m_rows.atIndex(rr)->second;
+      }
+
+    iterator begin() const
+      {
+      RowId rr = this->row();
+      return rr == RowIndex::InvalidIndex ? this->end() : iterator(this->m_store, rr, 0);
+      }
+    iterator end() const
+      {
+      return iterator(this->m_store, this->row(),
+        this->m_store ? static_cast<PropertyId>(this->m_store->m_columns.size()) : 0);
+      }
+
+    iterator find(const std::string& name) const
+      {
+      RowId rr = this->row();
+      PropertyId pid = this->m_store ? this->m_store->propertyId(name) : InvalidProperty;
+      if (rr == RowIndex::InvalidIndex || pid == InvalidProperty || !this->m_store->m_columns[pid].has(rr))
+        return this->end();
+      return iterator(this->m_store, rr, pid);
+      }
+    size_type count(const std::string& name) const
+      { return this->find(name) == this->end() ? 0 : 1; }
+
+    /// Return the value of \a name, creating it (and the entity's row) if needed.
+    VV& operator [] (const std::string& name) const
+      { return this->m_store->value(this->m_entity, name); }
+
+    size_type erase(const std::string& name) const
+      { return this->m_store->remove(this->m_entity, name) ? 1 : 0; }
+    void erase(const iterator& it) const
+      { this->m_store->remove(this->m_entity, it.m_column); }
+
+  protected:
+    RowId row() const { return this->m_store ? this->m_store->m_rows.indexOf(this->m_entity) : RowIndex::InvalidIndex; }
+
+    S* m_store;
+    smtk::common::UUID m_entity;
+  };
+
+  typedef RowView<PropertyStore<V>, V> Row;
+  typedef RowView<const PropertyStore<V>, const V> ConstRow;
+
+  /**\brief Iterate over every entity that has at least one property.
+    *
+    * Dereferencing yields an entry whose \a first member is the entity's
+    * UUID and whose \a second member is a Row view of its properties.
+    */
+  template<typename S, typename R>
+  class EntityIterator
+  {
+  public:
+    struct Entry
+    {
+      Entry(const smtk::common::UUID& uid, S* store) : first(uid), second(store, uid) { }
+      const smtk::common::UUID& first;
+      R second;
+    };
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Entry value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Entry reference;
+    struct pointer
+    {
+      pointer(const Entry& ee) : entry(ee) { }
+      const Entry* operator -> () const { return &this->entry; }
+      Entry entry;
+    };
+
+    EntityIterator() : m_store(NULL) { }
+    EntityIterator(S* store, RowIndex::const_iterator it) : m_store(store), m_it(it) { }
+    template<typename S2, typename R2>
+    EntityIterator(const EntityIterator<S2,R2>& other) : m_store(other.m_store), m_it(other.m_it) { }
+
+    reference operator * () const { return Entry(this->m_it->first, this->m_store); }
+    pointer operator -> () const { return pointer(**this); }
+
+    EntityIterator& operator ++ () { ++this->m_it; return *this; }
+    EntityIterator operator ++ (int)
+      {
+      EntityIterator tmp(*this);
+      ++this->m_it;
+      return tmp;
+      }
+
+    template<typename S2, typename R2>
+    bool operator == (const EntityIterator<S2,R2>& other) const { return this->m_it == other.m_it; }
+    template<typename S2, typename R2>
+    bool operator != (const EntityIterator<S2,R2>& other) const { return this->m_it != other.m_it; }
+
+  protected:
+    template<typename S2, typename R2> friend class EntityIterator;
+
+    S* m_store;
+    RowIndex::const_iterator m_it;
+  };
+
+  typedef EntityIterator<PropertyStore<V>, Row> iterator;
+  typedef EntityIterator<const PropertyStore<V>, ConstRow> const_iterator;
+
+  PropertyStore() { }
+
+  /**@name Property names.
+    *
+    * Names are interned the first time a value is stored under them
+    * and are never removed; an interned id is stable for the life of the store.
+    */
+  ///@{
+  PropertyId propertyId(const std::string& name) const
+    {
+    std::map<std::string,PropertyId>::const_iterator it = this->m_nameIds.find(name);
+    return it == this->m_nameIds.end() ? InvalidProperty : it->second;
+    }
+
+  PropertyId internPropertyName(const std::string& name)
+    {
+    std::map<std::string,PropertyId>::const_iterator it = this->m_nameIds.find(name);
+    if (it != this->m_nameIds.end())
+      return it->second;
+    PropertyId pid = static_cast<PropertyId>(this->m_names.size());
+    this->m_names.push_back(name);
+    this->m_columns.push_back(Column());
+    this->m_nameIds[name] = pid;
+    return pid;
+    }
+
+  const std::string& propertyName(PropertyId pid) const { return this->m_names[pid]; }
+  size_type numberOfPropertyNames() const { return this->m_names.size(); }
+  ///@}
+
+  /**@name Column access.
+    *
+    * Scanning a column visits only entities that have the property.
+    */
+  ///@{
+  const Column& column(PropertyId pid) const { return this->m_columns[pid]; }
+  /// Return the UUID of the entity assigned to \a row (valid only for rows present in some column).
+  const smtk::common::UUID& rowEntity(RowId row) const { return this->m_rows.atIndex(row)->first; }
+  ///@}
+
+  /**@name Per-value access.
+    *
+    */
+  ///@{
+  const V* find(const smtk::common::UUID& uid, PropertyId pid) const
+    {
+    if (pid == InvalidProperty)
+      return NULL;
+    RowId row = this->m_rows.indexOf(uid);
+    const Column& col(this->m_columns[pid]);
+    return col.has(row) ? &col.values[row] : NULL;
+    }
+  V* find(const smtk::common::UUID& uid, PropertyId pid)
+    {
+    return const_cast<V*>(const_cast<const PropertyStore<V>*>(this)->find(uid, pid));
+    }
+  const V* find(const smtk::common::UUID& uid, const std::string& name) const
+    { return this->find(uid, this->propertyId(name)); }
+  V* find(const smtk::common::UUID& uid, const std::string& name)
+    { return this->find(uid, this->propertyId(name)); }
+
+  /// Return the value of \a name on \a uid, creating an empty value if none exists.
+  V& value(const smtk::common::UUID& uid, const std::string& name)
+    {
+    PropertyId pid = this->internPropertyName(name);
+    RowId row = this->m_rows.indexOf(uid);
+    if (row == RowIndex::InvalidIndex)
+      row = this->m_rows.insert(std::make_pair(uid, static_cast<boost::uint32_t>(0))).first.index();
+    Column& col(this->m_columns[pid]);
+    if (!col.has(row))
+      {
+      if (row >= col.present.size())
+        {
+        col.present.resize(row + 1, false);
+        col.values.resize(row + 1);
+        }
+      col.present[row] = true;
+      ++col.count;
+      ++this->m_rows.atIndex(row)->second;
+      }
+    return col.values[row];
+    }
+
+  void set(const smtk::common::UUID& uid, const std::string& name, const V& val)
+    { this->value(uid, name) = val; }
+
+  bool remove(const smtk::common::UUID& uid, const std::string& name)
+    { return this->remove(uid, this->propertyId(name)); }
+
+  bool remove(const smtk::common::UUID& uid, PropertyId pid)
+    {
+    if (pid == InvalidProperty)
+      return false;
+    RowId row = this->m_rows.indexOf(uid);
+    Column& col(this->m_columns[pid]);
+    if (!this->removeFromColumn(col, row))
+      return false;
+    RowIndex::iterator rit = this->m_rows.atIndex(row);
+    if (--rit->second == 0)
+      this->m_rows.erase(rit);
+    return true;
+    }
+  ///@}
+
+  /**@name Per-entity access.
+    *
+    * These mirror the std::map interface of the per-entity dictionaries
+    * this store replaces.
+    */
+  ///@{
+  iterator begin() { return iterator(this, this->m_rows.begin()); }
+  const_iterator begin() const { return const_iterator(this, this->m_rows.begin()); }
+  iterator end() { return iterator(this, this->m_rows.end()); }
+  const_iterator end() const { return const_iterator(this, this->m_rows.end()); }
+
+  iterator find(const smtk::common::UUID& uid)
+    { return iterator(this, const_cast<const RowIndex&>(this->m_rows).find(uid)); }
+  const_iterator find(const smtk::common::UUID& uid) const
+    { return const_iterator(this, this->m_rows.find(uid)); }
+
+  /// Return a view of the properties of \a uid (the entity need not have any yet).
+  Row operator [] (const smtk::common::UUID& uid) { return Row(this, uid); }
+  ConstRow row(const smtk::common::UUID& uid) const { return ConstRow(this, uid); }
+
+  /// The number of entities with at least one property.
+  size_type size() const { return this->m_rows.size(); }
+  bool empty() const { return this->m_rows.empty(); }
+  size_type count(const smtk::common::UUID& uid) const { return this->m_rows.count(uid); }
+
+  /// Remove every property of \a uid.
+  size_type erase(const smtk::common::UUID& uid)
+    {
+    RowId row = this->m_rows.indexOf(uid);
+    if (row == RowIndex::InvalidIndex)
+      return 0;
+    PropertyId numColumns = static_cast<PropertyId>(this->m_columns.size());
+    for (PropertyId pid = 0; pid < numColumns; ++pid)
+      this->removeFromColumn(this->m_columns[pid], row);
+    this->m_rows.erase(uid);
+    return 1;
+    }
+  template<typename S, typename R>
+  void erase(const EntityIterator<S,R>& it)
+    { this->erase(it->first); }
+
+  void clear()
+    {
+    typename std::deque<Column>::iterator cit;
+    for (cit = this->m_columns.begin(); cit != this->m_columns.end(); ++cit)
+      *cit = Column();
+    this->m_rows.clear();
+    }
+  ///@}
+
+protected:
+  template<typename S, typename VV> friend class RowView;
+
+  /// Release the value \a row holds in \a col, returning false if it held none.
+  static bool removeFromColumn(Column& col, RowId row)
+    {
+    if (!col.has(row))
+      return false;
+    V released;
+    std::swap(col.values[row], released);
+    col.present[row] = false;
+    --col.count;
+    // Trim absent rows from the end so the column ends at its last value.
+    while (!col.present.empty() && !col.present.back())
+      {
+      col.present.pop_back();
+      col.values.pop_back();
+      }
+    return true;
+    }
+
+  RowIndex m_rows;
+  std::vector<std::string> m_names;
+  std::map<std::string,PropertyId> m_nameIds;
+  std::deque<Column> m_columns;
+};
+
+  } // namespace model
+} // namespace smtk
+
+#endif // __smtk_model_PropertyStore_h
@@ -343,7 +343,9 @@ public:
   smtk::io::Logger& log();
 
 protected:
+  friend class io::ExportBinary;
   friend class io::ExportJSON;
+  friend class io::ImportBinary;
   friend class io::ImportJSON;
   friend class Manager;
 
@@ -0,0 +1,43 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/model/SessionIOBinary.h"
+
+#include "smtk/model/Manager.h"
+
+namespace smtk {
+  namespace model {
+
+/**\brief Decode the \a size bytes of \a sessionData for the given \a modelMgr.
+  *
+  * The bytes are those exportBinary() produced; they may live in a
+  * memory-mapped file, so copy anything that must outlive the call.
+  * Subclasses should return 1 on success and 0 on failure.
+  */
+int SessionIOBinary::importBinary(ManagerPtr modelMgr, const char* sessionData, std::size_t size)
+{
+  (void)modelMgr;
+  (void)sessionData;
+  (void)size;
+  return 1;
+}
+
+/**\brief Encode information into \a sessionData for the given \a modelMgr.
+  *
+  * Subclasses should return 1 on success and 0 on failure.
+  */
+int SessionIOBinary::exportBinary(ManagerPtr modelMgr, std::string& sessionData)
+{
+  (void)modelMgr;
+  (void)sessionData;
+  return 1;
+}
+
+  } // namespace model
+} // namespace smtk
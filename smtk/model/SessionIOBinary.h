@@ -0,0 +1,41 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef __smtk_model_SessionIOBinary_h
+#define __smtk_model_SessionIOBinary_h
+
+#include "smtk/model/SessionIO.h"
+
+#include <string>
+
+namespace smtk {
+  namespace model {
+
+/**\brief A base class for delegating session I/O to/from binary model archives.
+  *
+  * ExportBinary and ImportBinary ask each session for a delegate
+  * with createIODelegate("binary"). The session's data is an opaque
+  * block of bytes stored alongside the session's record in the archive.
+  *
+  * Subclasses should implement both
+  * importBinary and exportBinary methods.
+  */
+class SMTKCORE_EXPORT SessionIOBinary : public SessionIO
+{
+public:
+  smtkTypeMacro(SessionIOBinary);
+
+  virtual int importBinary(ManagerPtr modelMgr, const char* sessionData, std::size_t size);
+  virtual int exportBinary(ManagerPtr modelMgr, std::string& sessionData);
+};
+
+  } // namespace model
+} // namespace smtk
+
+#endif // __smtk_model_SessionIOBinary_h
@@ -14,9 +14,11 @@
  */
 
 
+#include "smtk/Options.h" // for SMTK_HASH_STORAGE
 #include "smtk/SystemConfig.h"
 
 #include "smtk/common/UUID.h"
+#include "smtk/model/PropertyStore.h"
 
 #ifdef SMTK_HASH_STORAGE
 #  if defined(_MSC_VER) // Visual studio
@@ -44,14 +46,16 @@ namespace smtk {
 #ifdef SMTK_HASH_STORAGE
     /// A dictionary of property names mapped to their values (string vectors)
     typedef google::sparse_hash_map<std::string,StringList> StringData;
-    /// A dictionary of model entities mapped to all the string properties defined on them.
-    typedef google::sparse_hash_map<smtk::common::UUID,StringData> UUIDsToStringData;
 #else // SMTK_HASH_STORAGE
     /// A dictionary of property names mapped to their values (string vectors)
     typedef std::map<std::string,StringList> StringData;
-    /// A dictionary of model entities mapped to all the string properties defined on them.
-    typedef std::map<smtk::common::UUID,StringData> UUIDsToStringData;
 #endif // SMTK_HASH_STORAGE
+    /// Columnar storage of the string properties defined on model entities.
+    typedef PropertyStore<StringList> UUIDsToStringData;
+    /// A view of all the string properties defined on one model entity.
+    typedef UUIDsToStringData::Row StringProperties;
+    /// A read-only view of all the string properties defined on one model entity.
+    typedef UUIDsToStringData::ConstRow ConstStringProperties;
 
     /// A convenient typedef that describes how an iterator to model-entity string properties is used.
     typedef UUIDsToStringData::iterator UUIDWithStringProperties;
@@ -10,7 +10,12 @@
 #ifndef __smtk_model_Tessellation_h
 #define __smtk_model_Tessellation_h
 
+#include "smtk/Options.h" // for SMTK_HASH_STORAGE
+
 #include "smtk/common/UUID.h"
+#ifdef SMTK_DENSE_HASH_STORAGE
+#  include "smtk/common/UUIDHashMap.h"
+#endif // SMTK_DENSE_HASH_STORAGE
 
 #ifdef SMTK_HASH_STORAGE
 #  if defined(_MSC_VER) // Visual studio
@@ -155,9 +160,12 @@ protected:
   std::vector<int> m_conn;
 };
 
-#ifdef SMTK_HASH_STORAGE
+#if defined(SMTK_HASH_STORAGE)
 typedef google::sparse_hash_map<smtk::common::UUID,Tessellation> UUIDsToTessellations;
 typedef google::sparse_hash_map<smtk::common::UUID,Tessellation>::iterator UUIDWithTessellation;
+#elif defined(SMTK_DENSE_HASH_STORAGE)
+typedef smtk::common::UUIDHashMap<Tessellation> UUIDsToTessellations;
+typedef smtk::common::UUIDHashMap<Tessellation>::iterator UUIDWithTessellation;
 #else // SMTK_HASH_STORAGE
 typedef std::map<smtk::common::UUID,Tessellation> UUIDsToTessellations;
 typedef std::map<smtk::common::UUID,Tessellation>::iterator UUIDWithTessellation;
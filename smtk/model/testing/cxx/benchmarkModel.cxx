@@ -8,20 +8,88 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //=========================================================================
 #include "smtk/model/Manager.h"
+#include "smtk/io/ExportBinary.h"
 #include "smtk/io/ExportJSON.h"
+#include "smtk/io/ImportBinary.h"
 #include "smtk/io/ImportJSON.h"
 #include "smtk/model/testing/cxx/helpers.h"
 
+#include "smtk/common/UUIDHashMap.h"
+
 #include "cJSON.h"
 
+#if defined(_MSC_VER) // Visual studio
+#  pragma warning (push)
+#  pragma warning (disable : 4996)  // Overeager "unsafe" parameter check
+#endif
+#include "sparsehash/sparse_hash_map"
+#if defined(_MSC_VER) // Visual studio
+#  pragma warning (pop)
+#endif
+
 #include <iostream>
 #include <fstream>
+#include <map>
 
 using namespace smtk::common;
 using namespace smtk::model;
 using namespace smtk::model::testing;
 using namespace smtk::io;
 
+/**\brief Time missed and successful lookups in a copy of \a topology held in a \a Storage container.
+  *
+  * Hits are performed by following each entity's relations so that the
+  * access pattern resembles traversals performed by model queries.
+  */
+template<typename Storage>
+void benchmarkLookups(const std::string& label, const UUIDsToEntities& topology, Timer& t)
+{
+  Storage storage;
+  storage.insert(topology.begin(), topology.end());
+  double deltaT;
+
+  // #### Misses
+  int numMisses = 2000000;
+  std::size_t found = 0;
+  UUID nil;
+  t.mark();
+  for (int i = 0; i < numMisses; ++i)
+    {
+    if (storage.find(nil) != storage.end())
+      ++found;
+    (*nil.begin())++; // twiddling bits should still result in a missing UUID.
+    }
+  deltaT = t.elapsed();
+  std::cout
+    << label << ": " << numMisses << " missed lookups (" << found << " found) "
+    << deltaT << " seconds " << (numMisses / deltaT) << " missed lookups/sec\n";
+
+  // #### Hits
+  typename Storage::iterator it = storage.begin();
+  while (it != storage.end() && it->second.relations().empty())
+    ++it;
+  if (it == storage.end())
+    return;
+  int numHits = 2000000;
+  found = 0;
+  t.mark();
+  for (int i = 0; i < numHits; ++i)
+    {
+    if (storage.find(it->second.relations().front()) != storage.end())
+      ++found;
+    do
+      {
+      ++it;
+      if (it == storage.end()) it = storage.begin();
+      }
+    while (it->second.relations().empty());
+    }
+  deltaT = t.elapsed();
+  std::cout
+    << label << ": " << numHits << " good lookups (" << found << " found) "
+    << deltaT << " seconds " << (numHits / deltaT) << " good lookups/sec\n";
+}
+
 int main(int argc, char* argv[])
 {
   (void)argc;
@@ -32,7 +100,7 @@ int main(int argc, char* argv[])
   double deltaT;
 
   // ### Benchmark entity creation ###
-  // This includes generating new UUIDs which takes up the bulk of the time.
+  // This includes creating uses, shells, and their arrangements one at a time.
   int numObj = 1000;
   t.mark();
   for (int i = 0; i < numObj; ++i)
@@ -46,7 +114,31 @@ int main(int argc, char* argv[])
     << "  " << sm->topology().size() << " entities " << deltaT << " seconds "
     << (sm->topology().size() / deltaT) << " entities/sec\n";
 
+  // ### Benchmark batched entity creation ###
+  // Insert the cells of numObj tetrahedra one at a time and then in bulk
+  // (with UUIDs generated in one batch and a single coalesced event).
+    {
+    double singleTime;
+    ManagerPtr single = Manager::create();
+    t.mark();
+    createTetCells(single, numObj, false);
+    singleTime = t.elapsed();
+    std::cout
+      << "  " << single->topology().size() << " cells inserted individually " << singleTime << " seconds "
+      << (single->topology().size() / singleTime) << " entities/sec\n";
+
+    ManagerPtr batched = Manager::create();
+    t.mark();
+    createTetCells(batched, numObj, true);
+    deltaT = t.elapsed();
+    std::cout
+      << "  " << batched->topology().size() << " cells inserted as a batch " << deltaT << " seconds "
+      << (batched->topology().size() / deltaT) << " entities/sec (" << (singleTime / deltaT) << "x)\n";
+    }
+
   // ### Benchmark entity lookup ###
+  // Time findEntity() on the manager, which uses whichever storage
+  // backend SMTK was configured with.
   // #### Misses
   int numMisses = 2000000;
   t.mark();
@@ -59,7 +151,7 @@ int main(int argc, char* argv[])
     }
   deltaT = t.elapsed();
   std::cout
-    << numMisses << " missed lookups " << deltaT << " seconds "
+    << "findEntity: " << numMisses << " missed lookups " << deltaT << " seconds "
     << (numMisses / deltaT) << " missed lookups/sec\n";
 
   // #### Hits
@@ -75,15 +167,149 @@ int main(int argc, char* argv[])
     Entity* ent = sm->findEntity(it->second.relations().front());
     (void)ent;
     do
+      {
       ++it;
-    while (it != sm->topology().end() && it->second.relations().empty());
-    if (it == sm->topology().end()) it = sm->topology().begin();
+      if (it == sm->topology().end()) it = sm->topology().begin();
+      }
+    while (it->second.relations().empty());
     }
   deltaT = t.elapsed();
   std::cout
-    << numHits << " missed lookups " << deltaT << " seconds "
+    << "findEntity: " << numHits << " good lookups " << deltaT << " seconds "
     << (numHits / deltaT) << " good lookups/sec\n";
 
+  // Run the same hit/miss workload against each storage backend
+  // by copying the manager's entity records into each container type.
+  benchmarkLookups<std::map<UUID,Entity> >("std::map", sm->topology(), t);
+  benchmarkLookups<google::sparse_hash_map<UUID,Entity> >("sparse_hash_map", sm->topology(), t);
+  benchmarkLookups<UUIDHashMap<Entity> >("UUIDHashMap", sm->topology(), t);
+
+  // #### Slot-index lookups (UUIDHashMap only)
+  // Callers may hold slot indices rather than repeating UUID lookups.
+    {
+    UUIDHashMap<Entity> dense;
+    dense.insert(sm->topology().begin(), sm->topology().end());
+    std::vector<UUIDHashMap<Entity>::index_type> slots;
+    for (UUIDHashMap<Entity>::iterator dit = dense.begin(); dit != dense.end(); ++dit)
+      {
+      UUIDArray::const_iterator rit;
+      for (rit = dit->second.relations().begin(); rit != dit->second.relations().end(); ++rit)
+        {
+        slots.push_back(dense.indexOf(*rit));
+        }
+      }
+    int numIndexed = 2000000;
+    std::size_t nslots = slots.size();
+    std::size_t found = 0;
+    t.mark();
+    for (int i = 0; i < numIndexed; ++i)
+      {
+      if (dense.atIndex(slots[i % nslots]) != dense.end())
+        ++found;
+      }
+    deltaT = t.elapsed();
+    std::cout
+      << "UUIDHashMap: " << numIndexed << " indexed lookups (" << found << " found) "
+      << deltaT << " seconds " << (numIndexed / deltaT) << " indexed lookups/sec\n";
+    }
+
+  // ### Benchmark property storage and search ###
+  // Every entity gets the same handful of property names so that
+  // interning and per-property columns are exercised.
+  FloatList rgba(4, 0.5);
+  int numTagged = 0;
+  t.mark();
+  for (UUIDWithEntity eit = sm->topology().begin(); eit != sm->topology().end(); ++eit, ++numTagged)
+    {
+    sm->setFloatProperty(eit->first, "color", rgba);
+    sm->setIntegerProperty(eit->first, "visible", numTagged % 2);
+    sm->setStringProperty(eit->first, "SMTK_TESS_GEN_PROP", "0");
+    sm->setIntegerProperty(eit->first, "pedigree", numTagged);
+    }
+  deltaT = t.elapsed();
+  std::cout
+    << numTagged << " entities given 4 properties " << deltaT << " seconds "
+    << (4 * numTagged / deltaT) << " properties/sec\n";
+
+  int numSearches = 20;
+  std::size_t numMatched = 0;
+  t.mark();
+  for (int i = 0; i < numSearches; ++i)
+    {
+    numMatched += sm->findEntitiesByProperty("visible", static_cast<Integer>(i % 2)).size();
+    }
+  deltaT = t.elapsed();
+  std::cout
+    << numSearches << " property searches (" << numMatched << " matches) " << deltaT << " seconds "
+    << (numSearches / deltaT) << " searches/sec\n";
+
+  // ### Benchmark indexed queries ###
+  // Time type-flag queries and selective property searches both with
+  // and without the manager's secondary indexes.
+  int numQueries = 20;
+  for (int indexed = 0; indexed < 2; ++indexed)
+    {
+    const char* label = indexed ? "indexed" : "unindexed";
+    if (indexed)
+      {
+      t.mark();
+      sm->indexProperty(INTEGER_PROPERTY, "pedigree");
+      deltaT = t.elapsed();
+      std::cout << "  " << deltaT << " seconds to build index\n";
+      }
+    numMatched = 0;
+    t.mark();
+    for (int i = 0; i < numQueries; ++i)
+      {
+      numMatched += sm->entitiesMatchingFlags(i % 2 ? VOLUME : VERTEX, true).size();
+      }
+    deltaT = t.elapsed();
+    std::cout
+      << numQueries << " " << label << " flag queries (" << numMatched << " matches) " << deltaT << " seconds "
+      << (numQueries / deltaT) << " queries/sec\n";
+
+    numMatched = 0;
+    t.mark();
+    for (int i = 0; i < numQueries; ++i)
+      {
+      numMatched += sm->findEntitiesByProperty("pedigree", static_cast<Integer>(i * 7)).size();
+      }
+    deltaT = t.elapsed();
+    std::cout
+      << numQueries << " " << label << " property searches (" << numMatched << " matches) " << deltaT << " seconds "
+      << (numQueries / deltaT) << " searches/sec\n";
+    }
+  sm->enableEntityIndex(false);
+
+  // ### Benchmark adjacency queries ###
+  // Ask every face for its vertices and adjacent faces, and every vertex
+  // for its volumes, first by walking relations and then with the cache.
+  // The first cached pass builds the tables the later passes use.
+    {
+    UUIDs faces = sm->entitiesMatchingFlags(FACE, true);
+    UUIDs verts = sm->entitiesMatchingFlags(VERTEX, true);
+    for (int pass = 0; pass < 3; ++pass)
+      {
+      const char* label = pass == 0 ? "uncached" : (pass == 1 ? "cache-building" : "cached");
+      sm->enableAdjacencyCache(pass > 0);
+      numMatched = 0;
+      t.mark();
+      for (UUIDs::const_iterator it = faces.begin(); it != faces.end(); ++it)
+        {
+        numMatched += sm->lowerDimensionalBoundaries(*it, 0).size();
+        numMatched += sm->adjacentEntities(*it, 2).size();
+        }
+      for (UUIDs::const_iterator it = verts.begin(); it != verts.end(); ++it)
+        numMatched += sm->higherDimensionalBordants(*it, 3).size();
+      deltaT = t.elapsed();
+      std::size_t numAdjQueries = 2 * faces.size() + verts.size();
+      std::cout
+        << numAdjQueries << " " << label << " adjacency queries (" << numMatched << " matches) "
+        << deltaT << " seconds " << (numAdjQueries / deltaT) << " queries/sec\n";
+      }
+    sm->enableAdjacencyCache(false);
+    }
+
   // ### Benchmark JSON export ###
   t.mark();
   std::string json = ExportJSON::fromModelManager(sm);
@@ -95,6 +321,11 @@ int main(int argc, char* argv[])
   deltaT = t.elapsed();
   std::cout << jsonTime << " seconds to generate JSON, " << deltaT << " seconds to write\n";
 
+  t.mark();
+  ExportJSON::fromModelManagerToFile(sm, "/tmp/benchmark-streamed.json");
+  deltaT = t.elapsed();
+  std::cout << deltaT << " seconds to stream JSON to a file\n";
+
   // ### Benchmark JSON import ###
     {
     ManagerPtr sm2 = Manager::create();
@@ -104,5 +335,32 @@ int main(int argc, char* argv[])
     }
   std::cout << deltaT << " seconds to ingest JSON\n";
 
+  // For comparison, ingest it through a cJSON tree as ImportJSON used to.
+    {
+    ManagerPtr sm3 = Manager::create();
+    t.mark();
+    cJSON* root = cJSON_Parse(json.c_str());
+    ImportJSON::ofManager(cJSON_GetObjectItem(root, "topo"), sm3);
+    cJSON_Delete(root);
+    deltaT = t.elapsed();
+    }
+  std::cout << deltaT << " seconds to ingest JSON through a cJSON tree\n";
+
+  // ### Benchmark binary archives ###
+  t.mark();
+  ExportBinary::fromModelManagerToFile(sm, "/tmp/benchmark.smtkb");
+  deltaT = t.elapsed();
+  std::cout << deltaT << " seconds to write a binary archive\n";
+
+    {
+    ManagerPtr sm4 = Manager::create();
+    t.mark();
+    ImportBinary::intoModelManagerFromFile("/tmp/benchmark.smtkb", sm4);
+    deltaT = t.elapsed();
+    std::cout
+      << deltaT << " seconds to load " << sm4->topology().size()
+      << " entities from a binary archive\n";
+    }
+
   return 0;
 }
@@ -0,0 +1,92 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/model/Manager.h"
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include <boost/thread/thread.hpp>
+
+#include <iostream>
+
+using namespace smtk::common;
+using namespace smtk::model;
+using namespace smtk::model::testing;
+
+/// Perform \a numQueries boundary/bordant queries on the latest snapshot of \a sm.
+void readSnapshots(ManagerPtr sm, const UUIDArray* cells, int numQueries, std::size_t* found)
+{
+  std::size_t ncells = cells->size();
+  for (int i = 0; i < numQueries; ++i)
+    {
+    // Fetch a fresh snapshot regularly, as an interactive reader would.
+    ConstManagerPtr snap = sm->snapshot();
+    for (int j = 0; j < 100 && i < numQueries; ++j, ++i)
+      {
+      const UUID& uid((*cells)[i % ncells]);
+      *found += snap->boundaryEntities(uid, -1).size();
+      *found += snap->bordantEntities(uid, +1).size();
+      if (snap->findEntity(uid, false))
+        ++(*found);
+      }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  ManagerPtr sm = Manager::create();
+  Timer t;
+  double deltaT;
+
+  int numObj = 1000;
+  UUIDArray cells;
+  for (int i = 0; i < numObj; ++i)
+    {
+    UUIDArray uids = createTet(sm);
+    cells.insert(cells.end(), uids.begin(), uids.begin() + 22);
+    }
+
+  // ### Benchmark publishing ###
+  // Each publication copies the model, so its cost grows with model size.
+  int numPublish = 10;
+  t.mark();
+  sm->enableSnapshots();
+  for (int i = 1; i < numPublish; ++i)
+    sm->publishSnapshot();
+  deltaT = t.elapsed();
+  std::cout
+    << numPublish << " snapshots of " << sm->topology().size() << " entities published " << deltaT << " seconds "
+    << (numPublish / deltaT) << " snapshots/sec\n";
+
+  // ### Benchmark concurrent reads ###
+  // Each thread performs the same number of queries; perfect scaling
+  // keeps the aggregate rate proportional to the number of threads.
+  int numQueries = 200000;
+  double serialRate = 0.;
+  for (int numThreads = 1; numThreads <= 8; numThreads *= 2)
+    {
+    std::vector<std::size_t> found(numThreads, 0);
+    boost::thread_group readers;
+    t.mark();
+    for (int i = 0; i < numThreads; ++i)
+      readers.create_thread(boost::bind(&readSnapshots, sm, &cells, numQueries, &found[i]));
+    readers.join_all();
+    deltaT = t.elapsed();
+    double rate = numThreads * numQueries / deltaT;
+    if (numThreads == 1)
+      serialRate = rate;
+    std::cout
+      << numThreads << " threads " << (numThreads * numQueries) << " queries (" << found[0] << " found by first) "
+      << deltaT << " seconds " << rate << " queries/sec (" << (rate / serialRate) << "x)\n";
+    }
+
+  return 0;
+}
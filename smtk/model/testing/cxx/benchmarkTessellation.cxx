@@ -0,0 +1,142 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/model/CompactTessellation.h"
+#include "smtk/model/Tessellation.h"
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include <iostream>
+
+using namespace smtk::model;
+using namespace smtk::model::testing;
+
+/// Fill \a tess with a triangulated \a n x \a n grid of points outlined by lines.
+void createGrid(Tessellation& tess, int n)
+{
+  for (int j = 0; j < n; ++j)
+    for (int i = 0; i < n; ++i)
+      tess.addCoords(i, j, 0.01 * ((i * j) % 7));
+  for (int j = 0; j + 1 < n; ++j)
+    {
+    for (int i = 0; i + 1 < n; ++i)
+      {
+      int p = j * n + i;
+      tess.addTriangle(p, p + 1, p + n + 1);
+      tess.addTriangle(p, p + n + 1, p + n);
+      }
+    tess.addLine(j * n, (j + 1) * n);
+    tess.addLine(j * n + n - 1, (j + 1) * n + n - 1);
+    }
+}
+
+/// Visit every cell of \a tess as a consumer of the interleaved layout must.
+double traverse(const Tessellation& tess)
+{
+  double sum = 0.;
+  const std::vector<double>& coords(tess.coords());
+  std::vector<int> conn;
+  for (Tessellation::size_type off = tess.begin(); off != tess.end(); off = tess.nextCellOffset(off))
+    {
+    conn.clear();
+    tess.vertexIdsOfCell(off, conn);
+    for (std::vector<int>::const_iterator it = conn.begin(); it != conn.end(); ++it)
+      sum += coords[3 * *it + 2];
+    }
+  return sum;
+}
+
+/// Return the point IDs in \a ids as an array of the integer type given by the second argument.
+const boost::uint16_t* rawIds(const CompactTessellation::IndexSpan& ids, boost::uint16_t)
+{
+  return ids.narrow();
+}
+
+const boost::uint32_t* rawIds(const CompactTessellation::IndexSpan& ids, boost::uint32_t)
+{
+  return ids.wide();
+}
+
+/// Visit every cell of \a tess group by group, specialized on index and coordinate width.
+template<typename I, typename C>
+double traverse(const CompactTessellation& tess, const C* coords)
+{
+  double sum = 0.;
+  for (int g = 0; g < CompactTessellation::NUMBER_OF_GROUPS; ++g)
+    {
+    CompactTessellation::IndexSpan all = tess.indices(static_cast<CompactTessellation::CellGroup>(g));
+    const I* ids = rawIds(all, I());
+    for (std::size_t i = 0; i < all.size(); ++i)
+      sum += coords[3 * ids[i] + 2];
+    }
+  return sum;
+}
+
+double traverse(const CompactTessellation& tess)
+{
+  if (tess.hasSinglePrecisionCoords())
+    return tess.hasWideIndices() ?
+      traverse<boost::uint32_t>(tess, tess.floatCoords()) :
+      traverse<boost::uint16_t>(tess, tess.floatCoords());
+  return tess.hasWideIndices() ?
+    traverse<boost::uint32_t>(tess, tess.doubleCoords()) :
+    traverse<boost::uint16_t>(tess, tess.doubleCoords());
+}
+
+int main(int argc, char* argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  Timer t;
+  double deltaT;
+  int numPasses = 20;
+
+  // Grids of 250^2 and 500^2 points exercise 16- and 32-bit indices.
+  for (int n = 250; n <= 500; n *= 2)
+    {
+    Tessellation tess;
+    createGrid(tess, n);
+    std::size_t looseBytes = CompactTessellation::memoryUsed(tess);
+
+    double sum = 0.;
+    t.mark();
+    for (int i = 0; i < numPasses; ++i)
+      sum += traverse(tess);
+    double looseTime = t.elapsed();
+    std::cout
+      << n * n << " points, Tessellation: " << looseBytes << " bytes, "
+      << numPasses << " traversals " << looseTime << " seconds (sum " << sum << ")\n";
+
+    for (int p = 0; p < 2; ++p)
+      {
+      CompactTessellation::CoordinatePrecision precision = p == 0 ?
+        CompactTessellation::SINGLE_PRECISION :
+        CompactTessellation::DOUBLE_PRECISION;
+      t.mark();
+      CompactTessellation compact(tess, precision);
+      deltaT = t.elapsed();
+      std::size_t bytes = compact.memoryUsed();
+      std::cout
+        << "  " << (p == 0 ? "float" : "double") << " coords, "
+        << (compact.hasWideIndices() ? 32 : 16) << "-bit indices: built in " << deltaT << " seconds, "
+        << bytes << " bytes (" << (static_cast<double>(looseBytes) / bytes) << "x smaller)\n";
+
+      sum = 0.;
+      t.mark();
+      for (int i = 0; i < numPasses; ++i)
+        sum += traverse(compact);
+      deltaT = t.elapsed();
+      std::cout
+        << "    " << numPasses << " traversals " << deltaT << " seconds (sum " << sum << ") "
+        << (looseTime / deltaT) << "x faster\n";
+      }
+    }
+
+  return 0;
+}
@@ -80,7 +80,7 @@ void ReportEntity(ManagerPtr sm, UUIDWithEntity& eit)
   fpit = sm->floatPropertiesForEntity(eit->first);
   if (fpit != sm->floatProperties().end())
     {
-    PropertyNameWithFloats fpval;
+    FloatProperties::iterator fpval;
     std::cout << "        " << fpit->second.size() << " float properties:\n";
     for (fpval = fpit->second.begin(); fpval != fpit->second.end(); ++fpval)
       {
@@ -93,7 +93,7 @@ void ReportEntity(ManagerPtr sm, UUIDWithEntity& eit)
   spit = sm->stringPropertiesForEntity(eit->first);
   if (spit != sm->stringProperties().end())
     {
-    PropertyNameWithStrings spval;
+    StringProperties::iterator spval;
     std::cout << "        " << spit->second.size() << " string properties:\n";
     for (spval = spit->second.begin(); spval != spit->second.end(); ++spval)
       {
@@ -106,7 +106,7 @@ void ReportEntity(ManagerPtr sm, UUIDWithEntity& eit)
   ipit = sm->integerPropertiesForEntity(eit->first);
   if (ipit != sm->integerProperties().end())
     {
-    PropertyNameWithIntegers ipval;
+    IntegerProperties::iterator ipval;
     std::cout << "        " << ipit->second.size() << " integer properties:\n";
     for (ipval = ipit->second.begin(); ipval != ipit->second.end(); ++ipval)
       {
@@ -264,6 +264,68 @@ UUIDArray createTet(smtk::model::ManagerPtr sm)
   return uids;
 }
 
+/**\brief Create the 22 cells of \a numTets tetrahedra (without uses, shells, or tessellations).
+  *
+  * The cells and relations match those created by createTet().
+  * When \a batch is true, UUIDs are generated and records are
+  * inserted in bulk with Manager::insertEntities(); otherwise
+  * each cell is inserted individually with Manager::insertEntity().
+  * Either way, the UUIDs of all cells are returned in order.
+  */
+UUIDArray createTetCells(smtk::model::ManagerPtr sm, int numTets, bool batch)
+{
+  // The dimension of each cell followed by its relations (terminated by -1):
+  static const int cells[22][8] = {
+      {0, -1}, {0, -1}, {0, -1}, {0, -1}, {0, -1}, {0, -1}, {0, -1},
+      {1, 0, 1, -1}, {1, 1, 2, -1}, {1, 2, 0, -1},
+      {1, 3, 4, -1}, {1, 4, 5, -1}, {1, 5, 3, -1},
+      {1, 0, 6, -1}, {1, 1, 6, -1}, {1, 2, 6, -1},
+      {2, 7, 8, 9, 10, 11, 12, -1},
+      {2, 10, 12, 11, -1},
+      {2, 7, 13, 14, -1},
+      {2, 8, 14, 15, -1},
+      {2, 9, 15, 13, -1},
+      {3, 16, 17, 18, 19, 20, -1}
+  };
+
+  UUIDArray uids;
+  if (!batch)
+    {
+    for (int t = 0; t < numTets; ++t)
+      {
+      UUIDArray::size_type base = uids.size();
+      for (int i = 0; i < 22; ++i)
+        {
+        Entity cell(CELL_ENTITY, cells[i][0]);
+        for (int j = 1; cells[i][j] >= 0; ++j)
+          cell.pushRelation(uids[base + cells[i][j]]);
+        uids.push_back(sm->insertEntity(cell)->first);
+        }
+      }
+    return uids;
+    }
+
+  uids = sm->unusedUUIDs(22 * numTets);
+  std::vector<Entity> records;
+  records.reserve(uids.size());
+  for (int t = 0; t < numTets; ++t)
+    {
+    std::size_t base = records.size();
+    for (int i = 0; i < 22; ++i)
+      {
+      records.push_back(Entity(CELL_ENTITY, cells[i][0]));
+      for (int j = 1; cells[i][j] >= 0; ++j)
+        {
+        // Records are transcribed as-is, so add the reverse relation, too.
+        records.back().pushRelation(uids[base + cells[i][j]]);
+        records[base + cells[i][j]].pushRelation(uids[base + i]);
+        }
+      }
+    }
+  sm->insertEntities(uids, records);
+  return uids;
+}
+
 /** Report an integer as a hexadecimal value.
   *
   * The constant will be zero-padded to a width of 8.
@@ -20,6 +20,7 @@ namespace smtk {
     namespace testing {
 
 smtk::common::UUIDArray createTet(smtk::model::ManagerPtr sm);
+smtk::common::UUIDArray createTetCells(smtk::model::ManagerPtr sm, int numTets = 1, bool batch = false);
 
 /// Report an integer as a hexadecimal value.
 class hexconst
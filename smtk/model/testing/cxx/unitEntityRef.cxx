@@ -103,16 +103,18 @@ void testComplexVertexChain()
 }
 
 template<typename D, typename T>
-void templatedPropertyTest(smtk::model::EntityRef entity, T*& data, const std::string& tname, D val)
+void templatedPropertyTest(smtk::model::EntityRef entity, const std::string& tname, D val)
 {
+  typename PropertyStore<typename T::mapped_type>::Row data;
   data = entity.hasProperties<T>();
-  test(data == NULL, std::string("Expected new entity to not have ") + tname);
+  test(data.empty(), std::string("Expected new entity to not have ") + tname);
   data = entity.properties<T>();
-  test(data != NULL, std::string("Expected properties<") + tname + "> to create data");
-  (*data)["foo"] = typename T::mapped_type(1, val);
+  test(data.store() != NULL, std::string("Expected properties<") + tname + "> to create data");
+  data["foo"] = typename T::mapped_type(1, val);
+  test(entity.hasProperties<T>().size() == 1, std::string("Expected properties<") + tname + "> to hold an entry");
   test(entity.removeProperty<T>("foo"),   std::string("Expected removeProperty<") + tname + "> to remove entry");
   test(!entity.removeProperty<T>("bar"),  std::string("Expected removeProperty<") + tname + "> to not remove missing entry");
-  test(entity.hasProperties<T>() == NULL, std::string("Expected removing only " ) + tname + " entry to remove map");
+  test(entity.hasProperties<T>().empty(), std::string("Expected removing only " ) + tname + " entry to remove map");
 }
 
 void testTemplatedPropertyMethods()
@@ -120,13 +122,9 @@ void testTemplatedPropertyMethods()
   ManagerPtr sm = Manager::create();
   Vertex vert = sm->addVertex();
 
-  StringData* sd;
-  FloatData* fd;
-  IntegerData* id;
-
-  templatedPropertyTest<String,StringData>(vert, sd, "StringData", "string");
-  templatedPropertyTest<Float,FloatData>(vert, fd, "FloatData", 0.0);
-  templatedPropertyTest<Integer,IntegerData>(vert, id, "IntegerData", 0);
+  templatedPropertyTest<String,StringData>(vert, "StringData", "string");
+  templatedPropertyTest<Float,FloatData>(vert, "FloatData", 0.0);
+  templatedPropertyTest<Integer,IntegerData>(vert, "IntegerData", 0);
 }
 
 void testMiscConstructionMethods()
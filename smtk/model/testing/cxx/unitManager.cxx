@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //=========================================================================
 #include "smtk/model/CellEntity.h"
+#include "smtk/model/EventBatch.h"
 #include "smtk/model/Manager.h"
 #include "smtk/model/Model.h"
 #include "smtk/io/ExportJSON.h"
@@ -18,6 +19,8 @@
 
 #include "cJSON.h"
 
+#include <sstream>
+
 using smtk::shared_ptr;
 using namespace smtk::common;
 using namespace smtk::model;
@@ -55,6 +58,216 @@ int addEntityToModel(ManagerEventType evt, const smtk::model::EntityRef& src, co
   return 0;
 }
 
+static int batchCount = 0;
+static std::size_t batchSize = 0;
+
+int entityBatchEvent(ManagerEventType evt, const smtk::model::EntityRef& src, const smtk::model::EntityRefArray& related, void*)
+{
+  if (evt.first == ADD_EVENT && !src.isValid())
+    {
+    ++batchCount;
+    batchSize += related.size();
+    }
+  return 0;
+}
+
+/// Verify that entities inserted in bulk match those inserted one at a time.
+void testBatchInsertion()
+{
+  ManagerPtr single = Manager::create();
+  ManagerPtr batched = Manager::create();
+  batched->observe(std::make_pair(ANY_EVENT,ENTITY_ENTRY), &entityBatchEvent, NULL);
+
+  int numTets = 3;
+  UUIDArray suids = createTetCells(single, numTets, false);
+  UUIDArray buids = createTetCells(batched, numTets, true);
+  test(batchCount == 1 && batchSize == buids.size(), "Expected a single, coalesced event for the batch");
+  test(suids.size() == buids.size(), "Expected the same number of cells");
+  test(single->topology().size() == batched->topology().size(), "Expected the same number of entities");
+
+  // Map UUIDs in the single-insertion manager to those in the batched manager.
+  std::map<UUID,UUID> s2b;
+  for (UUIDArray::size_type i = 0; i < suids.size(); ++i)
+    s2b[suids[i]] = buids[i];
+  for (UUIDArray::size_type i = 0; i < suids.size(); ++i)
+    {
+    const Entity* sent = single->findEntity(suids[i]);
+    const Entity* bent = batched->findEntity(buids[i]);
+    test(sent && bent, "Expected both entities to exist");
+    test(sent->entityFlags() == bent->entityFlags(), "Expected matching entity flags");
+    test(sent->relations().size() == bent->relations().size(), "Expected matching relation counts");
+    for (UUIDArray::size_type j = 0; j < sent->relations().size(); ++j)
+      test(s2b[sent->relations()[j]] == bent->relations()[j], "Expected matching relations");
+    test(
+      single->arrangementsOfKindForEntity(suids[i], HAS_USE).size() ==
+      batched->arrangementsOfKindForEntity(buids[i], HAS_USE).size(),
+      "Expected matching default arrangements");
+    }
+
+  // Inserting a batch containing an existing UUID should fail without inserting anything.
+  UUIDArray dups = batched->unusedUUIDs(2);
+  dups.push_back(buids[0]);
+  std::vector<Entity> recs(3, Entity(CELL_ENTITY, 0));
+  bool threw = false;
+  try
+    {
+    batched->insertEntities(dups, recs);
+    }
+  catch (const std::string&)
+    {
+    threw = true;
+    }
+  test(threw, "Expected a batch with an existing UUID to be rejected");
+  test(!batched->findEntity(dups[0], false), "Expected a rejected batch to insert nothing");
+
+  // So should a batch that holds the same new UUID twice.
+  dups = batched->unusedUUIDs(2);
+  dups.push_back(dups[0]);
+  threw = false;
+  try
+    {
+    batched->insertEntities(dups, recs);
+    }
+  catch (const std::string&)
+    {
+    threw = true;
+    }
+  test(threw, "Expected a batch with a repeated UUID to be rejected");
+  test(!batched->findEntity(dups[0], false) && !batched->findEntity(dups[1], false),
+    "Expected a rejected batch to insert nothing");
+  batched->unobserve(std::make_pair(ANY_EVENT,ENTITY_ENTRY), &entityBatchEvent, NULL);
+}
+
+static std::vector<std::pair<ManagerEventType,std::size_t> > batchedEvents;
+
+int recordBatchedEvent(ManagerEventType evt, const smtk::model::EntityRef&, const smtk::model::EntityRefArray& related, void*)
+{
+  batchedEvents.push_back(std::make_pair(evt, related.size()));
+  return 0;
+}
+
+/// Verify that events are collected, deduplicated and grouped while a batch is open.
+void testEventBatching()
+{
+  ManagerPtr sm = Manager::create();
+  sm->observeBatched(std::make_pair(ANY_EVENT,ENTITY_ENTRY), &recordBatchedEvent, NULL);
+  sm->observeBatched(std::make_pair(ADD_EVENT,CELL_INCLUDES_CELL), &recordBatchedEvent, NULL);
+  sm->observe(std::make_pair(ANY_EVENT,ENTITY_ENTRY), &entityManagerEvent, NULL);
+
+  // Outside of a batch, each event is delivered immediately.
+  int unbatchedCount = entCount;
+  UUIDArray uids = createTet(sm);
+  int numEntries = 0;
+  for (std::size_t i = 0; i < batchedEvents.size(); ++i)
+    {
+    test(batchedEvents[i].second == 1, "Expected a single entity per callback outside a batch");
+    if (batchedEvents[i].first == std::make_pair(ADD_EVENT,ENTITY_ENTRY))
+      ++numEntries;
+    }
+  test(numEntries == entCount - unbatchedCount, "Expected one batched callback per entity outside a batch");
+
+  batchedEvents.clear();
+  unbatchedCount = entCount;
+    {
+    EventBatch outer(sm);
+    createTet(sm);
+      {
+      EventBatch inner(sm);
+      createTet(sm);
+      // Duplicate relationship events are reported once per source.
+      for (int i = 0; i < 2; ++i)
+        {
+        sm->trigger(std::make_pair(ADD_EVENT,CELL_INCLUDES_CELL), EntityRef(sm, uids[21]), EntityRef(sm, uids[20]));
+        sm->trigger(std::make_pair(ADD_EVENT,CELL_INCLUDES_CELL), EntityRef(sm, uids[21]), EntityRef(sm, uids[19]));
+        }
+      sm->trigger(std::make_pair(ADD_EVENT,CELL_INCLUDES_CELL), EntityRef(sm, uids[20]), EntityRef(sm, uids[15]));
+      }
+    test(batchedEvents.empty(), "Expected no batched callbacks until the outermost batch ends");
+    test(sm->isBatchingEvents(), "Expected to be batching events");
+    }
+  test(!sm->isBatchingEvents(), "Expected batching to have ended");
+  test(entCount - unbatchedCount == 2 * numEntries, "Expected unbatched observers to be called once per event");
+  test(batchedEvents.size() == 3, "Expected one callback per event type and source");
+  test(batchedEvents[0].first == std::make_pair(ADD_EVENT,ENTITY_ENTRY) &&
+    static_cast<int>(batchedEvents[0].second) == 2 * numEntries,
+    "Expected all new entities in a single callback");
+  test(batchedEvents[1].second + batchedEvents[2].second == 3, "Expected duplicate events to be discarded");
+
+  // Once the batch has ended, events are delivered immediately again.
+  batchedEvents.clear();
+  sm->erase(uids[0]);
+  test(batchedEvents.size() == 1 && batchedEvents[0].first == std::make_pair(DEL_EVENT,ENTITY_ENTRY),
+    "Expected removal to be reported");
+  sm->unobserveBatched(std::make_pair(ANY_EVENT,ENTITY_ENTRY), &recordBatchedEvent, NULL);
+  sm->unobserveBatched(std::make_pair(ADD_EVENT,CELL_INCLUDES_CELL), &recordBatchedEvent, NULL);
+  sm->unobserve(std::make_pair(ANY_EVENT,ENTITY_ENTRY), &entityManagerEvent, NULL);
+  batchedEvents.clear();
+  createTet(sm);
+  test(batchedEvents.empty(), "Expected no callbacks after unobserving");
+}
+
+/// Verify that queries answered by the entity index match those answered by scanning all entities.
+void checkEntityIndex(ManagerPtr sm, const std::string& when)
+{
+  BitFlags masks[] = {
+    ANY_ENTITY, CELL_ENTITY, VERTEX, EDGE, FACE, VOLUME, USE_ENTITY, SHELL_ENTITY, MODEL_ENTITY };
+  int numMasks = sizeof(masks) / sizeof(masks[0]);
+  std::vector<UUIDs> exact, inexact, dims;
+  std::vector<EntityRefs> byName;
+
+  sm->enableEntityIndex(false);
+  for (int i = 0; i < numMasks; ++i)
+    {
+    exact.push_back(sm->entitiesMatchingFlags(masks[i], true));
+    inexact.push_back(sm->entitiesMatchingFlags(masks[i], false));
+    }
+  for (int dim = -1; dim <= 3; ++dim)
+    dims.push_back(sm->entitiesOfDimension(dim));
+  byName.push_back(sm->findEntitiesByPropertyAs<EntityRefs>("name", "Tetrahedron"));
+  byName.push_back(sm->findEntitiesByPropertyAs<EntityRefs>("velocity", static_cast<Integer>(42)));
+
+  test(sm->indexProperty(STRING_PROPERTY, "name"), "Expected \"name\" to be newly indexed (" + when + ")");
+  test(!sm->indexProperty(STRING_PROPERTY, "name"), "Expected \"name\" to already be indexed (" + when + ")");
+  test(sm->indexProperty(INTEGER_PROPERTY, "velocity"), "Expected \"velocity\" to be newly indexed (" + when + ")");
+  test(sm->hasEntityIndex(), "Expected indexProperty to enable the entity index (" + when + ")");
+  for (int i = 0; i < numMasks; ++i)
+    {
+    test(sm->entitiesMatchingFlags(masks[i], true) == exact[i], "Indexed exact flag match differs (" + when + ")");
+    test(sm->entitiesMatchingFlags(masks[i], false) == inexact[i], "Indexed inexact flag match differs (" + when + ")");
+    }
+  for (int dim = -1; dim <= 3; ++dim)
+    test(sm->entitiesOfDimension(dim) == dims[dim + 1], "Indexed dimension query differs (" + when + ")");
+  test(sm->findEntitiesByPropertyAs<EntityRefs>("name", "Tetrahedron") == byName[0], "Indexed string search differs (" + when + ")");
+  test(sm->findEntitiesByPropertyAs<EntityRefs>("velocity", static_cast<Integer>(42)) == byName[1], "Indexed integer search differs (" + when + ")");
+}
+
+/**\brief Verify that cached adjacency queries match those of a freshly built cache.
+  *
+  * The manager's cache is enabled on first use and kept afterwards so that
+  * later calls verify that it has been invalidated as the model changed.
+  */
+void checkAdjacencyCache(ManagerPtr sm, const std::string& when)
+{
+  sm->enableAdjacencyCache();
+  AdjacencyCache fresh(sm.get());
+  for (int pass = 0; pass < 2; ++pass)
+    {
+    // The first pass builds tables that the second pass answers from.
+    for (UUIDWithEntity it = sm->topology().begin(); it != sm->topology().end(); ++it)
+      {
+      for (int dim = -1; dim <= 3; ++dim)
+        {
+        test(sm->lowerDimensionalBoundaries(it->first, dim) == fresh.lowerDimensionalBoundaries(it->first, dim),
+          "Cached boundaries differ (" + when + ")");
+        test(sm->higherDimensionalBordants(it->first, dim) == fresh.higherDimensionalBordants(it->first, dim),
+          "Cached bordants differ (" + when + ")");
+        test(sm->adjacentEntities(it->first, dim) == fresh.adjacentEntities(it->first, dim),
+          "Cached adjacencies differ (" + when + ")");
+        }
+      }
+    }
+}
+
 int main(int argc, char* argv[])
 {
   (void)argc;
@@ -138,10 +351,84 @@ int main(int argc, char* argv[])
   search2 = sm->findEntitiesByProperty("velocity", 42.03125);
   test(search2.size() == 1 && search2.begin()->entity() == uids[21], "search2 42.03125");
 
+  // Test that property names are interned once and hold one column of values
+  UUIDsToFloatData::PropertyId velocityId = sm->floatProperties().propertyId("velocity");
+  test(velocityId != UUIDsToFloatData::InvalidProperty, "Expected \"velocity\" to be interned");
+  test(sm->floatProperties().column(velocityId).count == 2, "Expected 2 entries in \"velocity\" column");
+  test(sm->removeFloatProperty(uids[0], "velocity"), "Expected to remove \"velocity\"");
+  test(!sm->removeFloatProperty(uids[0], "velocity"), "Expected \"velocity\" to already be removed");
+  test(sm->floatProperties().column(velocityId).count == 1, "Expected 1 entry in \"velocity\" column");
+  test(sm->findEntitiesByProperty("velocity", v3).empty(), "Expected no match for removed property");
+  sm->setFloatProperty(uids[0], "velocity", v3);
+  test(sm->floatProperties().propertyId("velocity") == velocityId, "Expected property id to be stable");
+
+  // Test that references to property values survive interning new names
+  // and adding values to other entities.
+  FloatList& heldFloat(sm->floatProperty(uids[0], "velocity"));
+  StringList& heldString(sm->stringProperty(uids[1], "held"));
+  IntegerList& heldInteger(sm->integerProperty(uids[2], "held"));
+  heldString.push_back("kept");
+  heldInteger.push_back(17);
+  UUIDArray strangers;
+  for (int i = 0; i < 200; ++i)
+    {
+    std::ostringstream pname;
+    pname << "grow" << i;
+    UUID grower = uids[i % uids.size()];
+    sm->setFloatProperty(grower, pname.str(), i);
+    sm->setStringProperty(grower, pname.str(), pname.str());
+    sm->setIntegerProperty(grower, pname.str(), i);
+    strangers.push_back(UUID::random());
+    sm->setIntegerProperty(strangers.back(), "held", i);
+    }
+  test(&heldFloat == &sm->floatProperty(uids[0], "velocity") && heldFloat == v3,
+    "Expected float property reference to remain valid");
+  test(&heldString == &sm->stringProperty(uids[1], "held") && heldString[0] == "kept",
+    "Expected string property reference to remain valid");
+  test(&heldInteger == &sm->integerProperty(uids[2], "held") && heldInteger[0] == 17,
+    "Expected integer property reference to remain valid");
+  const UUIDsToIntegerData::Column& grow199(
+    sm->integerProperties().column(sm->integerProperties().propertyId("grow199")));
+  test(grow199.count == 1 && grow199.values.size() == grow199.present.size() &&
+    grow199.present.back(), "Expected columns to end at the last row that has the property");
+  for (int i = 0; i < 200; ++i)
+    {
+    std::ostringstream pname;
+    pname << "grow" << i;
+    UUID grower = uids[i % uids.size()];
+    sm->removeFloatProperty(grower, pname.str());
+    sm->removeStringProperty(grower, pname.str());
+    sm->removeIntegerProperty(grower, pname.str());
+    sm->removeIntegerProperty(strangers[i], "held");
+    }
+  sm->removeStringProperty(uids[1], "held");
+  sm->removeIntegerProperty(uids[2], "held");
+
   // Test EntityRefs-return version of entitiesMatchingFlagsAs<T>
   search2 = sm->findEntitiesOfType(smtk::model::VOLUME, true);
   test(search2.size() == 1 && search2.begin()->entity() == uids[21]);
 
+  // Test that the optional entity index agrees with exhaustive searches
+  // and tracks changes made after it was enabled.
+  checkEntityIndex(sm, "initial");
+  checkAdjacencyCache(sm, "initial");
+  search2 = sm->findEntitiesByProperty("name", "Tetrahedron");
+  test(search2.size() == 1 && search2.begin()->entity() == uids[21], "Indexed search for name failed");
+  sm->setStringProperty(uids[20], "name", "Tetrahedron");
+  search2 = sm->findEntitiesByProperty("name", "Tetrahedron");
+  test(search2.size() == 2, "Indexed search did not see a new property value");
+  sm->stringProperty(uids[20], "name")[0] = "Octahedron";
+  search2 = sm->findEntitiesByProperty("name", "Tetrahedron");
+  test(search2.size() == 1, "Indexed search did not see a property modified in place");
+  EntityRef(sm, uids[20]).properties<StringData>()["name"] = StringList(1, "Tetrahedron");
+  search2 = sm->findEntitiesByProperty("name", "Tetrahedron");
+  test(search2.size() == 2, "Indexed search did not see a property set through a view");
+  test(sm->removeStringProperty(uids[20], "name"), "Expected to remove \"name\"");
+  search2 = sm->findEntitiesByProperty("name", "Tetrahedron");
+  test(search2.size() == 1, "Indexed search did not see a removed property");
+  search2 = sm->findEntitiesOfType(smtk::model::VOLUME, true);
+  test(search2.size() == 1 && search2.begin()->entity() == uids[21], "Indexed type search failed");
+
   // Test addModel
   UUIDArray::size_type modelStart = uids.size();
   for (int i = 0; i < 53; ++i)
@@ -203,6 +490,11 @@ int main(int argc, char* argv[])
   test(sm->unarrangeEntity(uids[21], HAS_USE, 0, true) == 2, "Detaching a Volume/VolumeUse failed.");
   test(sm->findEntity(uids[21]) == NULL, "unarrangeEntity(..., true) failed to remove the entity afterwards.");
   test(sm->erase(uids[0]), "Failed to erase a vertex.");
+  checkEntityIndex(sm, "after erasure");
+  checkAdjacencyCache(sm, "after erasure");
+
+  testBatchInsertion();
+  testEventBatching();
 
   std::cout << entCount << " total entities:\n";
   std::cout << "subgroups " << subgroups << "\n";
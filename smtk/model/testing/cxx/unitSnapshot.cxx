@@ -0,0 +1,276 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/AutoInit.h"
+
+#include "smtk/model/Manager.h"
+#include "smtk/model/Operator.h"
+#include "smtk/model/SessionRef.h"
+#include "smtk/model/Vertex.h"
+#include "smtk/model/testing/cxx/helpers.h"
+
+#include "smtk/attribute/IntItem.h"
+#include "smtk/attribute/StringItem.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <boost/thread/thread.hpp>
+
+#include <iostream>
+
+using namespace smtk::common;
+using namespace smtk::model;
+using namespace smtk::model::testing;
+
+smtkComponentInitMacro(smtk_set_property_operator);
+
+namespace {
+
+const char* removeTessellationXML =
+  "<SMTK_AttributeSystem Version=\"2\">"
+  "  <Definitions>"
+  "    <AttDef Type=\"remove tessellation\" BaseType=\"operator\">"
+  "      <AssociationsDef Name=\"Entities\" NumberOfRequiredValues=\"1\" Extensible=\"true\">"
+  "        <MembershipMask>any</MembershipMask>"
+  "      </AssociationsDef>"
+  "    </AttDef>"
+  "    <AttDef Type=\"result(remove tessellation)\" BaseType=\"result\"/>"
+  "  </Definitions>"
+  "</SMTK_AttributeSystem>";
+
+/// Remove the tessellations (but not their generation numbers) of the associated entities.
+class RemoveTessellation : public Operator
+{
+public:
+  smtkTypeMacro(RemoveTessellation);
+  smtkCreateMacro(RemoveTessellation);
+  smtkSharedFromThisMacro(Operator);
+  smtkDeclareModelOperator();
+
+protected:
+  // The result deliberately lists no entities, so only the manager's
+  // own change tracking can cause a snapshot to be published.
+  virtual OperatorResult operateInternal()
+    {
+    EntityRefArray entities = this->associatedEntitiesAs<EntityRefArray>();
+    for (EntityRefArray::iterator it = entities.begin(); it != entities.end(); ++it)
+      it->removeTessellation(false);
+    return this->createResult(OPERATION_SUCCEEDED);
+    }
+};
+
+smtk::model::OperatorPtr RemoveTessellation::baseCreate()
+{ return RemoveTessellation::create(); }
+
+std::string RemoveTessellation::operatorName("remove tessellation");
+std::string RemoveTessellation::className() const { return "RemoveTessellation"; }
+
+const int numReaders = 4;
+const int numGenerations = 200;
+
+/// Snapshots must not change when the live manager does.
+void testSnapshotIsolation()
+{
+  ManagerPtr sm = Manager::create();
+  UUIDArray uids = createTet(sm);
+
+  test(!sm->snapshot(), "Snapshots should be disabled by default.");
+  sm->enableSnapshots();
+  test(sm->hasSnapshots(), "Snapshots should be enabled.");
+  ConstManagerPtr first = sm->snapshot();
+  test(first && first->snapshotEpoch() == 1, "Enabling snapshots should publish one.");
+  test(first->topology().size() == sm->topology().size(), "Snapshot should hold every entity.");
+
+  sm->setIntegerProperty(uids[0], "generation", 1);
+  sm->erase(uids[1]);
+  test(!first->hasIntegerProperty(uids[0], "generation"), "Snapshot saw an unpublished property.");
+  test(first->findEntity(uids[1], false) != NULL, "Snapshot saw an unpublished erasure.");
+  test(sm->snapshot() == first, "Snapshot should not change until published.");
+
+  sm->publishSnapshot();
+  ConstManagerPtr second = sm->snapshot();
+  test(second != first && second->snapshotEpoch() == 2, "Publishing should advance the epoch.");
+  test(second->integerProperty(uids[0], "generation") == IntegerList(1, 1), "Published property missing.");
+  test(second->findEntity(uids[1], false) == NULL, "Published erasure missing.");
+  test(!first->hasIntegerProperty(uids[0], "generation"), "Old snapshot modified by publishing.");
+
+  sm->enableSnapshots(false);
+  test(!sm->hasSnapshots() && !sm->snapshot(), "Snapshots should be disabled.");
+  test(first->topology().size() > second->topology().size(), "Readers should retain released snapshots.");
+}
+
+/// Operators should publish a snapshot once they complete.
+void testOperatorPublishes()
+{
+  ManagerPtr sm = Manager::create();
+  SessionRef sess = sm->createSession("native");
+  UUIDArray uids = createTet(sm);
+  sm->enableSnapshots();
+  unsigned long epoch = sm->snapshot()->snapshotEpoch();
+
+  OperatorPtr op = sess.op("set property");
+  test(!!op, "No \"set property\" operator.");
+  op->specification()->findString("name")->setValue("generation");
+  op->specification()->findInt("integer value")->appendValue(7);
+  op->associateEntity(EntityRef(sm, uids[0]));
+  OperatorResult result = op->operate();
+  test(result->findInt("outcome")->value() == OPERATION_SUCCEEDED, "Operator failed.");
+
+  ConstManagerPtr snap = sm->snapshot();
+  test(snap->snapshotEpoch() == epoch + 1, "Operator did not publish a snapshot.");
+  test(snap->integerProperty(uids[0], "generation") == IntegerList(1, 7), "Operator changes not published.");
+  test(!sm->isSnapshotStale(), "Publishing should clear the stale flag.");
+
+  // An operation that changes nothing should not pay for a new snapshot.
+  op->specification()->findString("name")->setValue("");
+  result = op->operate();
+  test(result->findInt("outcome")->value() == OPERATION_FAILED, "Operator should have failed.");
+  test(sm->snapshot() == snap, "Operator published a snapshot without changing the model.");
+
+  test(!sm->removeIntegerProperty(uids[1], "generation"), "Removed a property that was never set.");
+  test(!sm->isSnapshotStale(), "Removing nothing should not mark the snapshot stale.");
+  sm->setIntegerProperty(uids[1], "generation", 8);
+  test(sm->isSnapshotStale(), "Setting a property should mark the snapshot stale.");
+}
+
+/// Removing a tessellation inside an operator should publish the removal.
+void testRemovedTessellationPublished()
+{
+  ManagerPtr sm = Manager::create();
+  SessionRef sess = sm->createSession("native");
+  sess.session()->registerOperator(
+    RemoveTessellation::operatorName, removeTessellationXML, &RemoveTessellation::baseCreate);
+  UUIDArray uids = createTet(sm);
+  Tessellation tess;
+  tess.addCoords(0., 0., 0.);
+  sm->setTessellation(uids[0], tess);
+  sm->enableSnapshots();
+  ConstManagerPtr snap = sm->snapshot();
+  test(snap->tessellations().find(uids[0]) != snap->tessellations().end(),
+    "Snapshot should hold the tessellation.");
+
+  test(!sm->removeTessellation(UUID::random(), false), "Nothing should be removed from an untessellated entity.");
+  test(!sm->isSnapshotStale(), "Removing nothing should not mark the snapshot stale.");
+
+  OperatorPtr op = sess.op("remove tessellation");
+  test(!!op, "No \"remove tessellation\" operator.");
+  op->associateEntity(EntityRef(sm, uids[0]));
+  OperatorResult result = op->operate();
+  test(result->findInt("outcome")->value() == OPERATION_SUCCEEDED, "Operator failed.");
+  test(sm->tessellations().find(uids[0]) == sm->tessellations().end(), "Tessellation was not removed.");
+
+  ConstManagerPtr removed = sm->snapshot();
+  test(removed != snap, "Removing a tessellation did not publish a snapshot.");
+  test(removed->tessellations().find(uids[0]) == removed->tessellations().end(),
+    "Published snapshot still holds the removed tessellation.");
+}
+
+/// Repeatedly tag every entity with a new generation number and publish the result.
+void writeGenerations(ManagerPtr sm, UUIDArray uids)
+{
+  for (int gen = 1; gen <= numGenerations; ++gen)
+    {
+    for (UUIDArray::const_iterator it = uids.begin(); it != uids.end(); ++it)
+      sm->setIntegerProperty(*it, "generation", gen);
+    // Modify the topology as well so readers traverse changing relations.
+    if (gen % 2)
+      sm->insertVertex(sm->unusedUUID());
+    sm->publishSnapshot();
+    }
+}
+
+/// Verify that every snapshot seen is consistent and that epochs never go backwards.
+void readGenerations(ManagerPtr sm, UUIDArray uids, std::size_t numBoundary, int* failures)
+{
+  unsigned long lastEpoch = 0;
+  Integer lastGen = 0;
+  for (;;)
+    {
+    ConstManagerPtr snap = sm->snapshot();
+    if (snap->snapshotEpoch() < lastEpoch)
+      ++(*failures);
+    lastEpoch = snap->snapshotEpoch();
+
+    const IntegerList& first(snap->integerProperty(uids[0], "generation"));
+    Integer gen = first.empty() ? 0 : first[0];
+    if (gen < lastGen)
+      ++(*failures);
+    lastGen = gen;
+    for (UUIDArray::const_iterator it = uids.begin(); it != uids.end(); ++it)
+      {
+      const IntegerList& value(snap->integerProperty(*it, "generation"));
+      if ((value.empty() ? 0 : value[0]) != gen)
+        ++(*failures);
+      if (!snap->findEntity(*it, false))
+        ++(*failures);
+      }
+    if (snap->boundaryEntities(uids[0], 2).size() != numBoundary || snap->bordantEntities(uids[1], 3).size() != 1)
+      ++(*failures);
+    if (gen == numGenerations)
+      break;
+    }
+}
+
+/// Run one writer and several readers concurrently.
+void testConcurrentReaders()
+{
+  ManagerPtr sm = Manager::create();
+  UUIDArray tet = createTet(sm);
+  // Every cell of the tetrahedron, starting with its volume (uids[0]) and one face (uids[1]).
+  UUIDArray uids;
+  uids.push_back(tet[21]);
+  uids.push_back(tet[20]);
+  for (int i = 0; i < 20; ++i)
+    uids.push_back(tet[i]);
+  std::size_t numBoundary = sm->boundaryEntities(uids[0], 2).size();
+  test(numBoundary == 5, "Expected 5 faces bounding the volume.");
+  sm->enableSnapshots();
+
+  int failures[numReaders];
+  boost::thread_group readers;
+  for (int i = 0; i < numReaders; ++i)
+    {
+    failures[i] = 0;
+    readers.create_thread(boost::bind(&readGenerations, sm, uids, numBoundary, &failures[i]));
+    }
+  boost::thread writer(boost::bind(&writeGenerations, sm, uids));
+  writer.join();
+  readers.join_all();
+
+  for (int i = 0; i < numReaders; ++i)
+    {
+    std::cout << "Reader " << i << ": " << failures[i] << " inconsistencies\n";
+    test(failures[i] == 0, "Reader saw an inconsistent snapshot.");
+    }
+  test(sm->snapshot()->snapshotEpoch() == numGenerations + 1, "Wrong number of snapshots published.");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  try
+    {
+    testSnapshotIsolation();
+    testOperatorPublishes();
+    testRemovedTessellationPublished();
+    testConcurrentReaders();
+    }
+  catch (const std::string& msg)
+    {
+    (void) msg; // Ignore the message; it's already been printed.
+    std::cerr << "Exiting...\n";
+    return 1;
+    }
+
+  return 0;
+}
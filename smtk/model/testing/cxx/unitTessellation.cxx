@@ -9,12 +9,108 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //
 //=============================================================================
+#include "smtk/model/CompactTessellation.h"
 #include "smtk/model/Tessellation.h"
 
 #include "smtk/common/testing/cxx/helpers.h"
 
+#include <algorithm>
+
 using namespace smtk::model;
 
+/// Return the connectivity entries of each cell in \a tess, sorted.
+std::vector<std::vector<int> > cellRecords(const Tessellation& tess)
+{
+  std::vector<std::vector<int> > records;
+  const std::vector<int>& conn(tess.conn());
+  for (Tessellation::size_type off = tess.begin(); off != tess.end(); )
+    {
+    Tessellation::size_type next = tess.nextCellOffset(off);
+    records.push_back(std::vector<int>(
+        conn.begin() + off, next == tess.end() ? conn.end() : conn.begin() + next));
+    off = next;
+    }
+  std::sort(records.begin(), records.end());
+  return records;
+}
+
+/// Verify that a CompactTessellation groups the cells of \a tess by shape.
+void testCompactTessellation(Tessellation& tess)
+{
+  tess.addLine(0, 5);
+  CompactTessellation compact(tess);
+  test(!compact.hasWideIndices(), "Expected 16-bit indices for a small tessellation.");
+  test(compact.hasSinglePrecisionCoords(), "Expected single-precision coordinates by default.");
+  test(compact.numberOfPoints() == 7, "Expected 7 points.");
+  test(compact.numberOfCells() == 8, "Expected 8 cells.");
+  test(compact.numberOfCells(CompactTessellation::VERTICES) == 1, "Expected 1 vertex.");
+  test(compact.numberOfCells(CompactTessellation::POLYVERTICES) == 1, "Expected 1 polyvertex.");
+  test(compact.numberOfCells(CompactTessellation::LINES) == 1, "Expected 1 line.");
+  test(compact.numberOfCells(CompactTessellation::TRIANGLES) == 1, "Expected 1 triangle.");
+  test(compact.numberOfCells(CompactTessellation::QUADS) == 1, "Expected 1 quad.");
+  test(compact.numberOfCells(CompactTessellation::POLYLINES) == 1, "Expected 1 polyline.");
+  test(compact.numberOfCells(CompactTessellation::POLYGONS) == 1, "Expected 1 polygon.");
+  test(compact.numberOfCells(CompactTessellation::TRIANGLE_STRIPS) == 1, "Expected 1 triangle strip.");
+
+  CompactTessellation::IndexSpan tri = compact.cell(CompactTessellation::TRIANGLES, 0);
+  test(tri.size() == 3 && tri[0] == 2 && tri[1] == 4 && tri[2] == 3, "Incorrect triangle connectivity.");
+  CompactTessellation::IndexSpan poly = compact.cell(CompactTessellation::POLYGONS, 0);
+  test(poly.size() == 6 && poly[4] == 5 && poly.narrow() && !poly.wide(), "Incorrect polygon connectivity.");
+
+  // Property IDs are kept aside for only the cells that have them.
+  const int* props;
+  test(compact.hasCellProperties(), "Expected cell properties to be kept.");
+  test(compact.cellProperties(CompactTessellation::TRIANGLES, 0, props) == 0 && !props,
+    "Expected no properties on the triangle.");
+  test(compact.cellProperties(CompactTessellation::LINES, 0, props) == 0 && !props,
+    "Expected no properties on the line.");
+  test(compact.cellProperties(CompactTessellation::VERTICES, 0, props) ==
+    (TESS_FACE_MATERIAL | TESS_FACE_VERTEX_NORMAL) && props[0] == 100,
+    "Incorrect vertex properties.");
+  test(compact.cellProperties(CompactTessellation::POLYLINES, 0, props) ==
+    (TESS_FACE_MATERIAL | TESS_FACE_UV | TESS_FACE_VERTEX_NORMAL | TESS_FACE_VERTEX_COLOR) &&
+    props[0] == 100 && props[1] == 10 && props[2] == 0 && props[6] == 3 && props[11] == 3,
+    "Incorrect polyline properties.");
+
+  double xyz[3];
+  compact.point(4, xyz);
+  test(xyz[0] == 1. && xyz[1] == 3. && xyz[2] == 0., "Incorrect point coordinates.");
+
+  // Converting back should preserve every cell, though grouped by shape.
+  Tessellation regrouped;
+  compact.toTessellation(regrouped);
+  test(cellRecords(regrouped) == cellRecords(tess), "Cells or their properties changed by round trip.");
+  CompactTessellation again(regrouped, CompactTessellation::DOUBLE_PRECISION);
+  test(!again.hasSinglePrecisionCoords() && again.doubleCoords() && !again.floatCoords(),
+    "Expected double-precision coordinates.");
+  for (int g = 0; g < CompactTessellation::NUMBER_OF_GROUPS; ++g)
+    {
+    CompactTessellation::CellGroup group = static_cast<CompactTessellation::CellGroup>(g);
+    test(again.numberOfCells(group) == compact.numberOfCells(group), "Cell count changed by round trip.");
+    CompactTessellation::IndexSpan before = compact.indices(group);
+    CompactTessellation::IndexSpan after = again.indices(group);
+    test(before.size() == after.size(), "Index count changed by round trip.");
+    for (std::size_t i = 0; i < before.size(); ++i)
+      test(before[i] == after[i], "Connectivity changed by round trip.");
+    }
+
+  // Large tessellations need wide indices.
+  Tessellation big;
+  for (int i = 0; i < 70000; ++i)
+    big.addCoords(i, 0., 0.);
+  big.addTriangle(0, 65536, 69999);
+  test(compact.assign(big), "Expected a large tessellation to be accepted.");
+  test(compact.hasWideIndices(), "Expected 32-bit indices for a large tessellation.");
+  tri = compact.cell(CompactTessellation::TRIANGLES, 0);
+  test(tri.wide() && tri[1] == 65536 && tri[2] == 69999, "Incorrect wide triangle connectivity.");
+  test(compact.memoryUsed() < CompactTessellation::memoryUsed(big) / 2, "Expected compact storage to be at least 2x smaller.");
+
+  // References to missing points are rejected.
+  big.addTriangle(0, 1, 70000);
+  test(!compact.assign(big), "Expected a cell with a bad point ID to be rejected.");
+  test(compact.numberOfPoints() == 0 && compact.numberOfCells() == 0, "Expected a rejected tessellation to leave no data.");
+}
+
 int main()
 {
   Tessellation tess;
@@ -156,5 +252,7 @@ int main()
     conn.clear();
     }
 
+  testCompactTessellation(tess);
+
   return 0;
 }